@@ -0,0 +1,47 @@
+# Concatenates the interpreter-core modules into one stb-style header for
+# embedders. Invoked at build time via cmake -P with SOURCE_DIR and
+# OUTPUT_FILE defined.
+#
+#   cmake -DSOURCE_DIR=src -DOUTPUT_FILE=chip8_single.h -P amalgamate.cmake
+#
+# Headers come first (each keeps its own include guard), then every
+# translation unit wrapped in CHIP8_SINGLE_IMPLEMENTATION. Local
+# #include "..." lines are stripped — everything they named is already in
+# the file — while system and SDL includes pass through untouched. Order
+# matters only for the headers: chip8.h leads because the rest include it.
+
+set(amalgam_headers
+    chip8.h arena.h telemetry.h clock.h disasm.h trace.h debug.h
+    profile.h romdb.h eventlog.h latency.h heatmap.h decodestat.h energy.h
+    crashdump.h alloctrap.h patch.h)
+set(amalgam_sources
+    chip8.c arena.c telemetry.c clock.c disasm.c trace.c debug.c
+    profile.c romdb.c eventlog.c latency.c heatmap.c decodestat.c energy.c
+    crashdump.c alloctrap.c patch.c)
+
+set(out "// chip8_single.h — amalgamated interpreter core.
+// Generated by amalgamate.cmake\; do not edit.
+//
+// Include this wherever the core API is needed. In exactly one
+// translation unit, define CHIP8_SINGLE_IMPLEMENTATION before including
+// it to get the function bodies. With the dispatch loop compiled in the
+// embedder's own TU the compiler inlines across what used to be the
+// library boundary, no LTO required. SDL3 headers must be on the include
+// path\; the core uses SDL only for logging, timing, and allocation.
+")
+
+foreach(name ${amalgam_headers})
+    file(READ "${SOURCE_DIR}/${name}" content)
+    string(REGEX REPLACE "#include \"[^\"]*\"[^\n]*\n" "" content "${content}")
+    string(APPEND out "\n/* ==== src/${name} ==== */\n\n${content}")
+endforeach()
+
+string(APPEND out "\n#ifdef CHIP8_SINGLE_IMPLEMENTATION\n")
+foreach(name ${amalgam_sources})
+    file(READ "${SOURCE_DIR}/${name}" content)
+    string(REGEX REPLACE "#include \"[^\"]*\"[^\n]*\n" "" content "${content}")
+    string(APPEND out "\n/* ==== src/${name} ==== */\n\n${content}")
+endforeach()
+string(APPEND out "\n#endif // CHIP8_SINGLE_IMPLEMENTATION\n")
+
+file(WRITE "${OUTPUT_FILE}" "${out}")
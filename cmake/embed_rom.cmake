@@ -0,0 +1,16 @@
+# Generates a C file embedding a ROM image as a byte array. Invoked at
+# build time via cmake -P with ROM_FILE and OUTPUT_FILE defined.
+#
+#   cmake -DROM_FILE=roms/game.ch8 -DOUTPUT_FILE=embedded_rom.c -P embed_rom.cmake
+
+file(READ "${ROM_FILE}" rom_hex HEX)
+string(REGEX REPLACE "([0-9a-f][0-9a-f])" "0x\\1," rom_bytes "${rom_hex}")
+string(LENGTH "${rom_hex}" hex_length)
+math(EXPR rom_size "${hex_length} / 2")
+
+file(WRITE "${OUTPUT_FILE}" "// Generated from ${ROM_FILE} by embed_rom.cmake; do not edit
+#include <stddef.h>
+
+const unsigned char embedded_rom[] = {${rom_bytes}};
+const size_t embedded_rom_size = ${rom_size};
+")
@@ -0,0 +1,58 @@
+#include <stdbool.h>
+#include <stdlib.h>
+#ifdef CHIP8_ALLOC_TRIPWIRE
+#include <execinfo.h>
+#include <unistd.h>
+#endif
+#include <SDL3/SDL.h>
+
+#include "telemetry.h"
+#include "alloctrap.h"
+
+_Thread_local bool alloctrap_armed = false;
+
+static SDL_malloc_func real_malloc;
+static SDL_calloc_func real_calloc;
+static SDL_realloc_func real_realloc;
+static SDL_free_func real_free;
+
+// An allocation landed inside a tick window. Release builds count it and
+// carry on; tripwire builds die right here so the culprit is on the stack.
+static void alloctrap_hit(const char *which) {
+    telemetry_tick_allocs.value++;
+#ifdef CHIP8_ALLOC_TRIPWIRE
+    SDL_Log("Fatal: %s inside the tick hot path", which);
+    void *frames[32];
+    backtrace_symbols_fd(frames, backtrace(frames, 32), STDERR_FILENO);
+    abort();
+#endif
+}
+
+static void *SDLCALL trap_malloc(size_t size) {
+    if (alloctrap_armed) {
+        alloctrap_hit("malloc");
+    }
+    return real_malloc(size);
+}
+
+static void *SDLCALL trap_calloc(size_t nmemb, size_t size) {
+    if (alloctrap_armed) {
+        alloctrap_hit("calloc");
+    }
+    return real_calloc(nmemb, size);
+}
+
+static void *SDLCALL trap_realloc(void *mem, size_t size) {
+    if (alloctrap_armed) {
+        alloctrap_hit("realloc");
+    }
+    return real_realloc(mem, size);
+}
+
+void alloctrap_install(void) {
+    // Delegating wrappers: installing mid-run is safe because every path
+    // still ends at the original functions (frees of earlier allocations
+    // included)
+    SDL_GetMemoryFunctions(&real_malloc, &real_calloc, &real_realloc, &real_free);
+    SDL_SetMemoryFunctions(trap_malloc, trap_calloc, trap_realloc, real_free);
+}
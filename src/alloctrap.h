@@ -0,0 +1,29 @@
+#ifndef ALLOCTRAP_H
+#define ALLOCTRAP_H
+
+#include <stdbool.h>
+
+/**
+ * Hot-Path Allocation Tripwire
+ *
+ * Guarantees the tick path stays heap-free as features accumulate. The
+ * allocator is interposed through SDL_SetMemoryFunctions (everything in
+ * this codebase allocates through SDL); between the tick-begin and
+ * tick-end markers any malloc/calloc/realloc bumps a telemetry counter,
+ * and under a CHIP8_ALLOC_TRIPWIRE build it aborts with a backtrace so
+ * the regression is caught at the allocation site, not in a histogram
+ * weeks later.
+ */
+
+// Per-thread arm flag: only the thread inside a tick window trips, so the
+// render, audio, and drain threads allocate freely
+extern _Thread_local bool alloctrap_armed;
+
+// Interposes the allocator; call once before the main loop
+void alloctrap_install(void);
+
+// Tick window markers: one thread-local store each
+static inline void alloctrap_enter(void) { alloctrap_armed = true; }
+static inline void alloctrap_leave(void) { alloctrap_armed = false; }
+
+#endif // ALLOCTRAP_H
@@ -0,0 +1,177 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <SDL3/SDL.h>
+
+#include "archive.h"
+#include "savestate.h"
+#include "telemetry.h"
+
+#define ARCHIVE_MAGIC 0x52413843u // "C8AR" little-endian
+#define ARCHIVE_VERSION 1
+#define ARCHIVE_HEADER_SIZE 24 // magic u32, version u32, count u64, capacity u64
+#define ARCHIVE_INITIAL_CAPACITY 256
+
+// One record: wall-clock stamp, cycle stamp, savestate bytes. Stamps lead
+// so a timestamp probe touches only the record's first page.
+#define ARCHIVE_RECORD_SIZE (8 + 8 + CHIP8_SAVESTATE_SIZE)
+
+static uint8_t *archive_map;
+static int archive_fd = -1;
+static uint64_t archive_records; // Mirrors the header count
+static uint64_t archive_capacity;
+
+static size_t archive_file_size(uint64_t capacity) {
+    return ARCHIVE_HEADER_SIZE + (size_t)capacity * ARCHIVE_RECORD_SIZE;
+}
+
+static uint8_t *archive_record(uint64_t index) {
+    return archive_map + ARCHIVE_HEADER_SIZE + (size_t)index * ARCHIVE_RECORD_SIZE;
+}
+
+static uint64_t archive_stamp(uint64_t index) {
+    uint64_t stamp;
+    memcpy(&stamp, archive_record(index), 8);
+    return stamp;
+}
+
+static bool archive_remap(uint64_t capacity) {
+    if (ftruncate(archive_fd, (off_t)archive_file_size(capacity)) != 0) {
+        SDL_Log("Error growing archive to %llu records", (unsigned long long)capacity);
+        return false;
+    }
+    if (archive_map != NULL) {
+        munmap(archive_map, archive_file_size(archive_capacity));
+    }
+    archive_map = mmap(NULL, archive_file_size(capacity),
+                       PROT_READ | PROT_WRITE, MAP_SHARED, archive_fd, 0);
+    if (archive_map == MAP_FAILED) {
+        archive_map = NULL;
+        SDL_Log("Error mapping archive");
+        return false;
+    }
+    archive_capacity = capacity;
+    memcpy(archive_map + 16, &archive_capacity, 8);
+    return true;
+}
+
+bool archive_open(const char *filename) {
+    archive_fd = open(filename, O_RDWR | O_CREAT, 0644);
+    if (archive_fd < 0) {
+        SDL_Log("Error opening archive file: %s", filename);
+        return false;
+    }
+
+    off_t existing = lseek(archive_fd, 0, SEEK_END);
+    if (existing >= ARCHIVE_HEADER_SIZE) {
+        // Existing archive: validate the header and resume after its tail
+        uint32_t header[2];
+        if (pread(archive_fd, header, 8, 0) != 8 ||
+            header[0] != ARCHIVE_MAGIC || header[1] != ARCHIVE_VERSION) {
+            SDL_Log("Not a savestate archive: %s", filename);
+            close(archive_fd);
+            archive_fd = -1;
+            return false;
+        }
+        uint64_t counts[2];
+        pread(archive_fd, counts, 16, 8);
+        archive_records = counts[0];
+        if (!archive_remap(counts[1] != 0 ? counts[1] : ARCHIVE_INITIAL_CAPACITY)) {
+            close(archive_fd);
+            archive_fd = -1;
+            return false;
+        }
+        SDL_Log("Archive %s: resuming after %llu snapshots", filename,
+                (unsigned long long)archive_records);
+    } else {
+        archive_records = 0;
+        if (!archive_remap(ARCHIVE_INITIAL_CAPACITY)) {
+            close(archive_fd);
+            archive_fd = -1;
+            return false;
+        }
+        uint32_t header[2] = {ARCHIVE_MAGIC, ARCHIVE_VERSION};
+        memcpy(archive_map, header, 8);
+        memcpy(archive_map + 8, &archive_records, 8);
+    }
+    return true;
+}
+
+bool archive_append(const chip8_state_t *state) {
+    if (archive_map == NULL) {
+        return false;
+    }
+    // Double in place when full: the existing records never move or copy
+    if (archive_records == archive_capacity &&
+        !archive_remap(archive_capacity * 2)) {
+        return false;
+    }
+
+    uint8_t *record = archive_record(archive_records);
+    uint64_t stamp = telemetry_now_ns();
+    memcpy(record, &stamp, 8);
+    memcpy(record + 8, &state->cycle_count, 8);
+    chip8_save_state(state, record + 16, CHIP8_SAVESTATE_SIZE);
+
+    // Count last: a crash mid-record leaves the archive at its old length
+    archive_records++;
+    memcpy(archive_map + 8, &archive_records, 8);
+    msync(archive_map, archive_file_size(archive_capacity), MS_ASYNC);
+    return true;
+}
+
+int archive_count(void) {
+    return (int)archive_records;
+}
+
+int archive_find(uint64_t timestamp_ns) {
+    if (archive_records == 0 || archive_stamp(0) > timestamp_ns) {
+        return -1;
+    }
+    // Newest record stamped at or before the target; stamps are appended
+    // in order, so this is a plain binary search over the mapping
+    uint64_t lo = 0;
+    uint64_t hi = archive_records - 1;
+    while (lo < hi) {
+        uint64_t mid = (lo + hi + 1) / 2;
+        if (archive_stamp(mid) <= timestamp_ns) {
+            lo = mid;
+        } else {
+            hi = mid - 1;
+        }
+    }
+    return (int)lo;
+}
+
+uint64_t archive_cycle(int index) {
+    if (archive_map == NULL || index < 0 || (uint64_t)index >= archive_records) {
+        return 0;
+    }
+    uint64_t cycle;
+    memcpy(&cycle, archive_record((uint64_t)index) + 8, 8);
+    return cycle;
+}
+
+bool archive_load(chip8_state_t *state, int index) {
+    if (archive_map == NULL || index < 0 || (uint64_t)index >= archive_records) {
+        return false;
+    }
+    return chip8_load_state(state, archive_record((uint64_t)index) + 16,
+                            CHIP8_SAVESTATE_SIZE);
+}
+
+void archive_close(void) {
+    if (archive_map == NULL) {
+        return;
+    }
+    msync(archive_map, archive_file_size(archive_capacity), MS_SYNC);
+    munmap(archive_map, archive_file_size(archive_capacity));
+    archive_map = NULL;
+    close(archive_fd);
+    archive_fd = -1;
+    archive_records = 0;
+    archive_capacity = 0;
+}
@@ -0,0 +1,46 @@
+#ifndef ARCHIVE_H
+#define ARCHIVE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "chip8.h"
+
+/**
+ * Savestate Archive
+ *
+ * A single memory-mapped container holding thousands of snapshots from one
+ * run: fixed-stride records (a timestamp/cycle stamp plus savestate bytes)
+ * behind a small header. Fixed stride makes access by ordinal pure
+ * arithmetic into the mapping, lookup by timestamp a binary search over the
+ * stamps, and loading snapshot 4000 a page fault rather than a file parse —
+ * chip8_load_state reads straight from the mapping, journal-style. The file
+ * doubles in place as records append, so a long session never copies what
+ * it already wrote.
+ */
+
+// Maps (creating or reopening) the archive file. Reopening an existing
+// archive resumes appending after its last snapshot.
+bool archive_open(const char *filename);
+
+// Appends one snapshot stamped with the current wall clock and cycle count
+bool archive_append(const chip8_state_t *state);
+
+// Snapshots currently in the archive
+int archive_count(void);
+
+// Index of the newest snapshot stamped at or before timestamp_ns, or -1
+// if the archive has nothing that old
+int archive_find(uint64_t timestamp_ns);
+
+// Cycle stamp of snapshot `index` (the state's cycle_count when it was
+// appended), or 0 when out of range
+uint64_t archive_cycle(int index);
+
+// Restores snapshot `index` straight from the mapping
+bool archive_load(chip8_state_t *state, int index);
+
+// Flushes and unmaps. Safe to call without an archive open.
+void archive_close(void);
+
+#endif // ARCHIVE_H
@@ -0,0 +1,71 @@
+#include <string.h>
+#include <SDL3/SDL.h>
+
+#include "arena.h"
+
+// Cache-line granularity, same rationale as the session pool: buffers
+// from different subsystems never share a line
+#define ARENA_LINE 64
+#define ARENA_LEDGER 16
+
+typedef struct arena_entry {
+    const char *subsystem;
+    size_t bytes;
+} arena_entry_t;
+
+static uint8_t *arena_base;
+static size_t arena_capacity;
+static size_t arena_used;
+
+static arena_entry_t ledger[ARENA_LEDGER];
+static int ledger_count;
+
+bool arena_init(size_t capacity) {
+    arena_base = SDL_aligned_alloc(ARENA_LINE, capacity);
+    if (arena_base == NULL) {
+        SDL_Log("Couldn't reserve %zu byte instrumentation arena", capacity);
+        return false;
+    }
+    arena_capacity = capacity;
+    arena_used = 0;
+    ledger_count = 0;
+    return true;
+}
+
+void *arena_alloc(const char *subsystem, size_t bytes) {
+    bytes = (bytes + ARENA_LINE - 1) / ARENA_LINE * ARENA_LINE;
+    if (arena_base == NULL || arena_capacity - arena_used < bytes) {
+        SDL_Log("Instrumentation arena can't fit %zu bytes for %s "
+                "(%zu of %zu used)", bytes, subsystem, arena_used, arena_capacity);
+        return NULL;
+    }
+
+    uint8_t *block = arena_base + arena_used;
+    arena_used += bytes;
+    memset(block, 0, bytes);
+    if (ledger_count < ARENA_LEDGER) {
+        ledger[ledger_count].subsystem = subsystem;
+        ledger[ledger_count].bytes = bytes;
+        ledger_count++;
+    }
+    return block;
+}
+
+void arena_report(void) {
+    if (arena_base == NULL) {
+        return;
+    }
+    SDL_Log("Instrumentation arena: %zu of %zu bytes reserved",
+            arena_used, arena_capacity);
+    for (int i = 0; i < ledger_count; i++) {
+        SDL_Log("  %-16s %zu bytes", ledger[i].subsystem, ledger[i].bytes);
+    }
+}
+
+void arena_shutdown(void) {
+    SDL_aligned_free(arena_base);
+    arena_base = NULL;
+    arena_capacity = 0;
+    arena_used = 0;
+    ledger_count = 0;
+}
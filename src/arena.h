@@ -0,0 +1,32 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+#include <stdbool.h>
+
+/**
+ * Instrumentation Arena
+ *
+ * One upfront reservation for every opt-in instrumentation buffer (trace
+ * ring, event log ring, script commands, decode statistics). The frontend
+ * sums the budgets of the features the command line enabled, reserves
+ * that much once, and the subsystems carve their buffers out of it at
+ * start — so turning instrumentation on in production never allocates
+ * mid-run, and the report declares exactly what the flags cost.
+ */
+
+// Reserves the arena; capacity should be the sum of the enabled
+// subsystems' *_ARENA_BYTES budgets (each a multiple of the line size)
+bool arena_init(size_t capacity);
+
+// Carves `bytes` out of the arena, zeroed and cache-line aligned, and
+// records the subsystem in the ledger. Never freed individually; returns
+// NULL (with a log line) when the arena is absent or exhausted.
+void *arena_alloc(const char *subsystem, size_t bytes);
+
+// Logs the reservation and the per-subsystem carve-outs
+void arena_report(void);
+
+void arena_shutdown(void);
+
+#endif // ARENA_H
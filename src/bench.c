@@ -0,0 +1,456 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <SDL3/SDL.h>
+
+#include "chip8.h"
+#include "telemetry.h"
+
+/**
+ * Chip-8 Benchmark Harness
+ *
+ * Loads a ROM, disables pacing, and executes a fixed instruction budget.
+ * Pass 1 runs the bare fetch-execute loop and reports sustained MIPS.
+ * Pass 2 re-runs with per-instruction timing and reports per-opcode-group
+ * counts and time, split into draw vs. everything else.
+ *
+ * Every ROM run is appended to chip8_bench.log (ROM hash, host
+ * fingerprint, build id, MIPS, p99 step time, host topology, calibration
+ * MIPS, normalized MIPS) and compared against the median of the stored
+ * runs for the same ROM on the same host. A result outside the noise
+ * threshold is flagged and the exit code is 2, so a deployment gate can
+ * refuse a build that slowed the interpreter down.
+ *
+ * Raw MIPS from a heterogeneous fleet aren't comparable, so every run
+ * first times a fixed calibration kernel — an integer dispatch microloop
+ * with no draw or memory traffic — and also reports the ROM's MIPS
+ * divided by the kernel's. The division cancels the host term: the
+ * normalized figure is checked against the fleet-wide median for the
+ * ROM across all hosts, so one regression threshold covers x86 servers
+ * and ARM kiosks without a stored baseline per machine.
+ *
+ * `chip8_bench --micro [iterations]` instead drives individual opcode
+ * handlers in isolation over synthesized state — no ROM, no dispatch —
+ * reporting ns/op per handler. Each handler runs several timed batches
+ * after a warmup batch; the minimum batch rejects scheduler and thermal
+ * outliers and the median shows the spread.
+ */
+
+static const char *group_names[16] = {
+    "0NNN", "1NNN", "2NNN", "3XNN", "4XNN", "5XY0", "6XNN", "7XNN",
+    "8XYn", "9XY0", "ANNN", "BNNN", "CXNN", "DXYN", "EXnn", "FXnn"
+};
+
+#define RESULTS_FILE "chip8_bench.log"
+#define RESULTS_NOISE 0.10   // Regression threshold against the stored median
+#define RESULTS_HISTORY 256  // Most recent prior runs consulted per (ROM, host)
+
+// One record per line, space-separated, no field may contain a space:
+// <rom hash hex> <host fingerprint> <build id> <MIPS> <p99 step ns>
+//   [<topology> <calibration MIPS> <normalized MIPS>]
+// The bracketed fields are absent from records written before the
+// calibration kernel existed; the parser accepts both.
+static void results_sanitize(char *s) {
+    for (; *s != '\0'; s++) {
+        if (*s == ' ') {
+            *s = '-';
+        }
+    }
+}
+
+static double results_median(const double *values, int count) {
+    double sorted[RESULTS_HISTORY];
+    for (int i = 0; i < count; i++) {
+        double v = values[i];
+        int at = i;
+        while (at > 0 && sorted[at - 1] > v) {
+            sorted[at] = sorted[at - 1];
+            at--;
+        }
+        sorted[at] = v;
+    }
+    return sorted[count / 2];
+}
+
+// Compares this run against the stored history and appends it: raw MIPS
+// and p99 against the per-host baseline, normalized MIPS against the
+// fleet-wide baseline for the ROM across every host. Returns true when
+// the run regressed past the noise threshold.
+static bool results_check_and_append(uint64_t rom_hash, double mips, uint64_t p99_ns,
+                                     double calib, double norm) {
+    char host[64];
+    char build[64];
+    char topology[64];
+    snprintf(host, sizeof(host), "%s-%dc-%dMB", SDL_GetPlatform(),
+             SDL_GetNumLogicalCPUCores(), SDL_GetSystemRAM());
+    snprintf(build, sizeof(build), "%s-%s", __DATE__, __TIME__);
+    // What normalization can't cancel (core count, cache line, SIMD
+    // width) rides along so an outlier can be attributed offline
+    snprintf(topology, sizeof(topology), "%s/%dc/%dB-line/simd%d",
+             SDL_GetPlatform(), SDL_GetNumLogicalCPUCores(),
+             SDL_GetCPUCacheLineSize(), (int)SDL_GetSIMDAlignment());
+    results_sanitize(host);
+    results_sanitize(build);
+    results_sanitize(topology);
+
+    // Prior runs, newest RESULTS_HISTORY kept (the file is append-only,
+    // so later lines are newer): MIPS/p99 filtered to this host, the
+    // normalized figure pooled across the whole fleet
+    double prior_mips[RESULTS_HISTORY];
+    double prior_p99[RESULTS_HISTORY];
+    double prior_norm[RESULTS_HISTORY];
+    int prior = 0;
+    int prior_fleet = 0;
+    FILE *file = fopen(RESULTS_FILE, "r");
+    if (file != NULL) {
+        char line[512];
+        while (fgets(line, sizeof(line), file) != NULL) {
+            unsigned long long hash, p99;
+            char line_host[64], line_build[64], line_topo[64];
+            double line_mips, line_calib, line_norm;
+            int fields = sscanf(line, "%llx %63s %63s %lf %llu %63s %lf %lf",
+                                &hash, line_host, line_build, &line_mips, &p99,
+                                line_topo, &line_calib, &line_norm);
+            if (fields < 5 || hash != rom_hash) {
+                continue;
+            }
+            if (fields >= 8) {
+                prior_norm[prior_fleet % RESULTS_HISTORY] = line_norm;
+                prior_fleet++;
+            }
+            if (strcmp(line_host, host) != 0) {
+                continue;
+            }
+            prior_mips[prior % RESULTS_HISTORY] = line_mips;
+            prior_p99[prior % RESULTS_HISTORY] = (double)p99;
+            prior++;
+        }
+        fclose(file);
+        if (prior > RESULTS_HISTORY) {
+            prior = RESULTS_HISTORY;
+        }
+        if (prior_fleet > RESULTS_HISTORY) {
+            prior_fleet = RESULTS_HISTORY;
+        }
+    }
+
+    bool regressed = false;
+    if (prior > 0) {
+        double base_mips = results_median(prior_mips, prior);
+        double base_p99 = results_median(prior_p99, prior);
+        printf("\nbaseline (%d stored runs): %.2f MIPS, p99 %.0f ns\n",
+               prior, base_mips, base_p99);
+        if (mips < base_mips * (1.0 - RESULTS_NOISE)) {
+            printf("REGRESSION: %.2f MIPS is %.1f%% below baseline\n",
+                   mips, 100.0 * (1.0 - mips / base_mips));
+            regressed = true;
+        }
+        if (base_p99 > 0.0 && (double)p99_ns > base_p99 * (1.0 + RESULTS_NOISE)) {
+            printf("REGRESSION: p99 step %llu ns is %.1f%% above baseline\n",
+                   (unsigned long long)p99_ns,
+                   100.0 * ((double)p99_ns / base_p99 - 1.0));
+            regressed = true;
+        }
+        if (!regressed) {
+            printf("within %.0f%% of baseline\n", RESULTS_NOISE * 100.0);
+        }
+    } else {
+        printf("\nno stored baseline for this ROM on this host; recording one\n");
+    }
+
+    if (prior_fleet > 0) {
+        double base_norm = results_median(prior_norm, prior_fleet);
+        printf("fleet baseline (%d runs, all hosts): %.3f normalized\n",
+               prior_fleet, base_norm);
+        if (norm < base_norm * (1.0 - RESULTS_NOISE)) {
+            printf("REGRESSION: %.3f normalized is %.1f%% below the fleet\n",
+                   norm, 100.0 * (1.0 - norm / base_norm));
+            regressed = true;
+        }
+    }
+
+    file = fopen(RESULTS_FILE, "a");
+    if (file == NULL) {
+        fprintf(stderr, "Failed to append to %s\n", RESULTS_FILE);
+        return regressed;
+    }
+    fprintf(file, "%016llx %s %s %.2f %llu %s %.2f %.4f\n",
+            (unsigned long long)rom_hash, host, build, mips,
+            (unsigned long long)p99_ns, topology, calib, norm);
+    fclose(file);
+    return regressed;
+}
+
+/* Calibration kernel: a fixed seven-instruction integer loop (loads,
+   adds, xor, shift, a never-taken skip, a backward jump) synthesized in
+   memory and stepped exactly like pass 1. No draws, no wide memory ops,
+   no timers — it measures the host's raw dispatch throughput and
+   nothing about any ROM, so it is the denominator that cancels the
+   host out of a MIPS figure. */
+#define CALIB_BUDGET 10000000
+
+static const uint8_t calib_kernel[] = {
+    0x60, 0x01, // 6001: V0 = 1
+    0x71, 0x01, // 7101: V1 += 1
+    0x82, 0x14, // 8214: V2 += V1
+    0x83, 0x23, // 8323: V3 ^= V2
+    0x84, 0x16, // 8416: V4 = V1 >> 1
+    0x35, 0x42, // 3542: skip if V5 == 0x42 (never: V5 stays 0)
+    0x12, 0x00, // 1200: loop
+};
+
+static double calibrate(void) {
+    chip8_state_t *state = SDL_malloc(sizeof(chip8_state_t));
+    chip8_init(state);
+    chip8_load_rom_memory(state, calib_kernel, sizeof(calib_kernel));
+
+    uint64_t t0 = SDL_GetPerformanceCounter();
+    for (uint64_t i = 0; i < CALIB_BUDGET; i++) {
+        chip8_step(state);
+    }
+    double seconds = (double)(SDL_GetPerformanceCounter() - t0)
+                   / SDL_GetPerformanceFrequency();
+    SDL_free(state);
+    return CALIB_BUDGET / seconds / 1e6;
+}
+
+static void virtual_timer_tick(chip8_state_t *state, uint64_t i) {
+    if (i % (CHIP8_DEFAULT_IPS / 60) == 0) {
+        chip8_vblank(state);
+    }
+}
+
+/* The handlers under test have external linkage in chip8.c; declared
+   here rather than widening the public header for a bench-only need. */
+void chip8_op_set(chip8_state_t *state, uint8_t reg, uint8_t value);
+void chip8_op_add(chip8_state_t *state, uint8_t reg, uint8_t value);
+void chip8_op_add_reg(chip8_state_t *state, uint8_t reg_x, uint8_t reg_y);
+void chip8_op_xor(chip8_state_t *state, uint8_t reg_x, uint8_t reg_y);
+void chip8_op_shr(chip8_state_t *state, uint8_t reg_x, uint8_t reg_y);
+void chip8_op_rand(chip8_state_t *state, uint8_t reg_x, uint8_t value);
+void chip8_op_jmp(chip8_state_t *state, uint16_t address);
+void chip8_op_push(chip8_state_t *state, uint16_t address);
+void chip8_op_pop(chip8_state_t *state);
+void chip8_op_skip_equal(chip8_state_t *state, uint8_t reg, uint8_t value);
+void chip8_op_skip_key(chip8_state_t *state, uint8_t reg_x);
+void chip8_op_add_index(chip8_state_t *state, uint8_t reg_x);
+void chip8_op_coded_conversion(chip8_state_t *state, uint8_t reg_x);
+void chip8_op_store_memory_fixed(chip8_state_t *state, uint8_t reg_x);
+void chip8_op_load_memory_fixed(chip8_state_t *state, uint8_t reg_x);
+void chip8_op_draw(chip8_state_t *state, uint8_t reg_x, uint8_t reg_y, uint8_t value);
+void chip8_op_hires(chip8_state_t *state);
+void chip8_op_scroll_down(chip8_state_t *state, uint8_t n);
+void chip8_op_scroll_right(chip8_state_t *state);
+void chip8_op_scroll_left(chip8_state_t *state);
+
+// One iteration per call, written so the state is ready for the next
+// iteration without any reset work inside the timed loop
+static void micro_set(chip8_state_t *s)      { chip8_op_set(s, 1, 0x42); }
+static void micro_add(chip8_state_t *s)      { chip8_op_add(s, 1, 1); }
+static void micro_add_reg(chip8_state_t *s)  { chip8_op_add_reg(s, 1, 2); }
+static void micro_xor(chip8_state_t *s)      { chip8_op_xor(s, 1, 2); }
+static void micro_shr(chip8_state_t *s)      { chip8_op_shr(s, 1, 2); }
+static void micro_rand(chip8_state_t *s)     { chip8_op_rand(s, 1, 0xFF); }
+static void micro_jmp(chip8_state_t *s)      { chip8_op_jmp(s, 0x300); }
+static void micro_call_ret(chip8_state_t *s) { chip8_op_push(s, 0x300); chip8_op_pop(s); }
+static void micro_skip_eq(chip8_state_t *s)  { chip8_op_skip_equal(s, 1, 0); }
+static void micro_skip_key(chip8_state_t *s) { chip8_op_skip_key(s, 1); }
+static void micro_add_idx(chip8_state_t *s)  { chip8_op_add_index(s, 0); }
+static void micro_bcd(chip8_state_t *s)      { s->index_register = 0x300; chip8_op_coded_conversion(s, 1); }
+static void micro_store16(chip8_state_t *s)  { chip8_op_store_memory_fixed(s, 15); }
+static void micro_load16(chip8_state_t *s)   { chip8_op_load_memory_fixed(s, 15); }
+static void micro_draw(chip8_state_t *s)     { chip8_op_draw(s, 1, 2, 5); }
+static void micro_scroll_dn(chip8_state_t *s) { chip8_op_scroll_down(s, 1); }
+static void micro_scroll_r(chip8_state_t *s)  { chip8_op_scroll_right(s); }
+static void micro_scroll_l(chip8_state_t *s)  { chip8_op_scroll_left(s); }
+
+static void micro_setup_regs(chip8_state_t *s) {
+    s->registers[1] = 123; // BCD digits, xor/add operands
+    s->registers[2] = 77;
+    s->index_register = 0x300;
+}
+
+// Draws hit the sprite pattern cache after the first fetch, like a ROM's
+// steady state; the glyph at 0 makes a stable 8x5 sprite. XOR garbage
+// accumulating in vram is irrelevant to the handler cost.
+static void micro_setup_draw(chip8_state_t *s) {
+    s->registers[1] = 8;
+    s->registers[2] = 4;
+    s->index_register = 0;
+}
+
+static void micro_setup_draw_hires(chip8_state_t *s) {
+    chip8_op_hires(s);
+    micro_setup_draw(s);
+}
+
+typedef struct micro_case {
+    const char *name;
+    void (*setup)(chip8_state_t *state); // Once per state init; may be NULL
+    void (*run)(chip8_state_t *state);   // One iteration
+    int ops;                             // Handler calls per iteration
+} micro_case_t;
+
+static const micro_case_t micro_cases[] = {
+    {"6XNN set",            NULL,                   micro_set,      1},
+    {"7XNN add",            NULL,                   micro_add,      1},
+    {"8XY4 add_reg",        micro_setup_regs,       micro_add_reg,  1},
+    {"8XY3 xor",            micro_setup_regs,       micro_xor,      1},
+    {"8XY6 shr",            micro_setup_regs,       micro_shr,      1},
+    {"CXNN rand",           NULL,                   micro_rand,     1},
+    {"1NNN jmp",            NULL,                   micro_jmp,      1},
+    {"2NNN+00EE call/ret",  NULL,                   micro_call_ret, 2},
+    {"3XNN skip_equal",     NULL,                   micro_skip_eq,  1},
+    {"EX9E skip_key",       NULL,                   micro_skip_key, 1},
+    {"FX1E add_index",      micro_setup_regs,       micro_add_idx,  1},
+    {"FX33 bcd",            micro_setup_regs,       micro_bcd,      1},
+    {"FX55 store x16",      micro_setup_regs,       micro_store16,  1},
+    {"FX65 load x16",       micro_setup_regs,       micro_load16,   1},
+    {"DXYN draw 8x5",       micro_setup_draw,       micro_draw,     1},
+    {"DXYN draw 8x5 hires", micro_setup_draw_hires, micro_draw,     1},
+    // The SCHIP scrolls must stay packed-row operations (memmove and
+    // word shifts); a per-pixel regression shows up here as a ~100x jump
+    {"00CN scroll down",    micro_setup_draw_hires, micro_scroll_dn, 1},
+    {"00FB scroll right",   micro_setup_draw_hires, micro_scroll_r,  1},
+    {"00FC scroll left",    micro_setup_draw_hires, micro_scroll_l,  1},
+};
+
+#define MICRO_BATCHES 15
+
+static int micro_main(uint64_t iterations) {
+    chip8_state_t state;
+    double ns_per_tick = 1e9 / SDL_GetPerformanceFrequency();
+
+    printf("%-20s %10s %10s\n", "handler", "min ns/op", "med ns/op");
+    for (size_t c = 0; c < sizeof(micro_cases) / sizeof(micro_cases[0]); c++) {
+        const micro_case_t *mc = &micro_cases[c];
+
+        chip8_init(&state);
+        if (mc->setup != NULL) {
+            mc->setup(&state);
+        }
+
+        // Warmup batch primes caches and branch predictors, then the
+        // timed batches; the minimum is the outlier-free cost
+        uint64_t batch_ticks[MICRO_BATCHES];
+        for (int batch = -1; batch < MICRO_BATCHES; batch++) {
+            uint64_t before = SDL_GetPerformanceCounter();
+            for (uint64_t i = 0; i < iterations; i++) {
+                mc->run(&state);
+            }
+            if (batch >= 0) {
+                batch_ticks[batch] = SDL_GetPerformanceCounter() - before;
+            }
+        }
+
+        // Insertion sort; min and median fall out
+        for (int i = 1; i < MICRO_BATCHES; i++) {
+            uint64_t ticks = batch_ticks[i];
+            int at = i;
+            while (at > 0 && batch_ticks[at - 1] > ticks) {
+                batch_ticks[at] = batch_ticks[at - 1];
+                at--;
+            }
+            batch_ticks[at] = ticks;
+        }
+
+        double per_op = ns_per_tick / (double)(iterations * mc->ops);
+        printf("%-20s %10.2f %10.2f\n", mc->name,
+               batch_ticks[0] * per_op, batch_ticks[MICRO_BATCHES / 2] * per_op);
+    }
+    return 0;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 2) {
+        fprintf(stderr, "Usage: %s <ROM file> [instruction budget]\n"
+                        "       %s --micro [iterations]\n", argv[0], argv[0]);
+        return 1;
+    }
+
+    if (SDL_strcmp(argv[1], "--micro") == 0) {
+        uint64_t iterations = 100000;
+        if (argc >= 3) {
+            iterations = SDL_strtoull(argv[2], NULL, 10);
+        }
+        return micro_main(iterations);
+    }
+
+    uint64_t budget = 50000000;
+    if (argc >= 3) {
+        budget = SDL_strtoull(argv[2], NULL, 10);
+    }
+
+    chip8_state_t state;
+
+    // Calibration first, before the caches warm up on ROM traffic
+    double calib = calibrate();
+    printf("calibration kernel: %.2f MIPS\n", calib);
+
+    // Pass 1: bare loop, sustained MIPS
+    chip8_init(&state);
+    if (!chip8_load_rom(&state, argv[1])) {
+        return 1;
+    }
+
+    uint64_t t0 = SDL_GetPerformanceCounter();
+    for (uint64_t i = 0; i < budget; i++) {
+        chip8_step(&state);
+        virtual_timer_tick(&state, i);
+    }
+    uint64_t t1 = SDL_GetPerformanceCounter();
+
+    double seconds = (double)(t1 - t0) / SDL_GetPerformanceFrequency();
+    printf("%llu instructions in %.3fs: %.2f MIPS\n",
+           (unsigned long long)budget, seconds, budget / seconds / 1e6);
+
+    // Pass 2: per-instruction timing, per-group breakdown. The same
+    // samples feed a histogram for the tail (p99) the MIPS average hides.
+    uint64_t group_count[16] = {0};
+    uint64_t group_ticks[16] = {0};
+    static telemetry_hist_t step_hist = {.name = "bench step"};
+    double ns_per_tick = 1e9 / SDL_GetPerformanceFrequency();
+
+    chip8_init(&state);
+    if (!chip8_load_rom(&state, argv[1])) {
+        return 1;
+    }
+
+    for (uint64_t i = 0; i < budget; i++) {
+        uint8_t group = state.memory[state.program_counter] >> 4;
+
+        uint64_t before = SDL_GetPerformanceCounter();
+        chip8_step(&state);
+        uint64_t ticks = SDL_GetPerformanceCounter() - before;
+        group_ticks[group] += ticks;
+        group_count[group]++;
+        telemetry_record(&step_hist, (uint64_t)(ticks * ns_per_tick));
+
+        virtual_timer_tick(&state, i);
+    }
+    uint64_t draw_ticks = group_ticks[0xD];
+    uint64_t other_ticks = 0;
+
+    printf("\n%-6s %12s %12s %8s\n", "group", "count", "time(ms)", "ns/op");
+    for (int group = 0; group < 16; group++) {
+        if (group_count[group] == 0) {
+            continue;
+        }
+        if (group != 0xD) {
+            other_ticks += group_ticks[group];
+        }
+        printf("%-6s %12llu %12.2f %8.1f\n",
+               group_names[group],
+               (unsigned long long)group_count[group],
+               group_ticks[group] * ns_per_tick / 1e6,
+               group_ticks[group] * ns_per_tick / group_count[group]);
+    }
+    printf("\ndraw: %.2fms, non-draw: %.2fms\n",
+           draw_ticks * ns_per_tick / 1e6, other_ticks * ns_per_tick / 1e6);
+
+    uint64_t p99_ns = telemetry_percentile(&step_hist, 0.99);
+    double mips = budget / seconds / 1e6;
+    double norm = mips / calib;
+    printf("normalized: %.4f (ROM MIPS / calibration MIPS)\n", norm);
+    return results_check_and_append(state.rom_hash, mips, p99_ns, calib, norm) ? 2 : 0;
+}
@@ -0,0 +1,188 @@
+#include <stdint.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include <SDL3/SDL.h>
+
+#include "chip8.h"
+#include "clock.h"
+#include "archive.h"
+#include "replay.h"
+#include "bisect.h"
+
+#define BISECT_MAX_WORKERS 64
+
+typedef struct bisect_probe {
+    const char *replay_file;
+    int snapshot;         // Archive ordinal the probe resumes from
+    uint64_t end_cycle;   // Exclusive; UINT64_MAX runs the replay out
+    uint64_t fault_cycle; // First fault inside the segment; 0 = clean
+    bool ok;              // Snapshot and cursor loaded, segment executed
+    pthread_t thread;
+} bisect_probe_t;
+
+/* One probe: restore the snapshot, wind a private replay cursor past the
+   events the snapshot already reflects, and frame-step to the segment end
+   or the first fault. Frames use the same quantum the virtual clock and
+   the QA stepper use — ips/60 instructions then one timer tick — so the
+   probe crosses every boundary at the same cycle counts the recorded run
+   did and event injection lands identically. */
+static void *bisect_probe_run(void *arg) {
+    bisect_probe_t *probe = arg;
+    probe->fault_cycle = 0;
+    probe->ok = false;
+
+    chip8_state_t *state = SDL_malloc(sizeof(chip8_state_t));
+    if (state == NULL) {
+        return NULL;
+    }
+    chip8_init(state);
+
+    replay_cursor_t cursor;
+    if (!replay_cursor_open(&cursor, probe->replay_file)) {
+        SDL_free(state);
+        return NULL;
+    }
+
+    // The snapshot carries memory, registers, vram, and the mid-run rng;
+    // the cycle stamp lives in the archive record and the run-wide knobs
+    // (profile, clock mode, ips) in the replay header
+    if (!archive_load(state, probe->snapshot)) {
+        replay_cursor_close(&cursor);
+        SDL_free(state);
+        return NULL;
+    }
+    chip8_set_profile(state, (chip8_profile_t)cursor.profile);
+    chip8_set_virtual_clock(state, cursor.virtual_clock);
+    state->ips = cursor.ips;
+    state->cycle_count = archive_cycle(probe->snapshot);
+    state->fault_cycle = 0;
+    state->next_vblank_cycle = state->cycle_count + chip8_clock_budget(state);
+    replay_cursor_seek(&cursor, state->cycle_count);
+
+    while (state->cycle_count < probe->end_cycle) {
+        replay_cursor_apply(&cursor, state);
+        int ran = chip8_run(state, (int)chip8_clock_budget(state));
+        chip8_vblank(state);
+        // Same realignment the QA stepper uses: the frame just run by
+        // hand counts as the tick
+        state->next_vblank_cycle = state->cycle_count + chip8_clock_budget(state);
+
+        if (state->fault_cycle != 0) {
+            break;
+        }
+        if (ran == 0 && !state->waiting_display &&
+            replay_cursor_next_cycle(&cursor) > state->cycle_count) {
+            // Parked (spin or FX0A wait) with no event due: the segment
+            // has settled and nothing inside it can fault anymore
+            break;
+        }
+    }
+
+    // A fault in the final frame's overshoot past end_cycle belongs to
+    // the next window — its probe starts from the snapshot stamped there
+    if (state->fault_cycle <= probe->end_cycle) {
+        probe->fault_cycle = state->fault_cycle;
+    }
+    probe->ok = true;
+
+    replay_cursor_close(&cursor);
+    SDL_free(state);
+    return NULL;
+}
+
+bool bisect_run(const char *archive_file, const char *replay_file, int workers) {
+    if (workers < 1) {
+        workers = 1;
+    }
+    if (workers > BISECT_MAX_WORKERS) {
+        workers = BISECT_MAX_WORKERS;
+    }
+
+    // Header sanity up front: probes force the recorded clock mode, and
+    // only the virtual clock makes windows replay at exact cycle counts
+    replay_cursor_t cursor;
+    if (!replay_cursor_open(&cursor, replay_file)) {
+        return false;
+    }
+    bool virtual_clock = cursor.virtual_clock;
+    replay_cursor_close(&cursor);
+    if (!virtual_clock) {
+        SDL_Log("Replay was recorded on the wall clock; bisection needs a "
+                "--virtual-clock recording to reproduce faults exactly");
+        return false;
+    }
+
+    if (!archive_open(archive_file)) {
+        return false;
+    }
+    int count = archive_count();
+    if (count == 0) {
+        SDL_Log("Archive %s holds no snapshots", archive_file);
+        archive_close();
+        return false;
+    }
+
+    // Window k runs from snapshot k to snapshot k+1's cycle stamp; the
+    // last window runs the replay out. Each round carves the suspect
+    // range into one contiguous segment per worker, probes them all in
+    // parallel, and recurses into the earliest one that faults.
+    int lo = 0;
+    int hi = count;
+    uint64_t fault_cycle = 0;
+    int probes_run = 0;
+    bisect_probe_t probes[BISECT_MAX_WORKERS];
+
+    for (;;) {
+        int width = hi - lo;
+        int segments = width < workers ? width : workers;
+        if (segments < 2 && width > 1) {
+            segments = 2; // A lone worker still halves the range per round
+        }
+
+        for (int s = 0; s < segments; s++) {
+            int seg_hi = lo + width * (s + 1) / segments;
+            probes[s].replay_file = replay_file;
+            probes[s].snapshot = lo + width * s / segments;
+            probes[s].end_cycle = seg_hi < count ? archive_cycle(seg_hi) : UINT64_MAX;
+            pthread_create(&probes[s].thread, NULL, bisect_probe_run, &probes[s]);
+        }
+        for (int s = 0; s < segments; s++) {
+            pthread_join(probes[s].thread, NULL);
+        }
+        probes_run += segments;
+
+        int winner = -1;
+        for (int s = 0; s < segments; s++) {
+            if (!probes[s].ok) {
+                SDL_Log("Probe from snapshot %d failed to load", probes[s].snapshot);
+                archive_close();
+                return false;
+            }
+            if (winner < 0 && probes[s].fault_cycle != 0) {
+                winner = s;
+            }
+        }
+        if (winner < 0) {
+            SDL_Log("Fault did not reproduce in snapshots %d..%d: the run may "
+                    "predate the archive or not be deterministic", lo, hi - 1);
+            archive_close();
+            return false;
+        }
+
+        hi = lo + width * (winner + 1) / segments;
+        lo = lo + width * winner / segments;
+        fault_cycle = probes[winner].fault_cycle;
+        if (hi - lo == 1) {
+            break;
+        }
+    }
+
+    uint64_t window_start = archive_cycle(lo);
+    SDL_Log("First fault at cycle %llu, %llu cycles after snapshot %d of %d "
+            "(%d probes)",
+            (unsigned long long)fault_cycle,
+            (unsigned long long)(fault_cycle - window_start),
+            lo, count, probes_run);
+    archive_close();
+    return true;
+}
@@ -0,0 +1,31 @@
+#ifndef BISECT_H
+#define BISECT_H
+
+#include <stdbool.h>
+
+/**
+ * Crash Bisection
+ *
+ * Finds the first faulting instruction of a long recorded run without
+ * re-executing it from the start. The inputs are the run's savestate
+ * archive (archive.h, one snapshot per second) and its input recording
+ * (replay.h): the snapshots split the run into windows, and a probe can
+ * replay any window in isolation — O(1) snapshot load, then the replay
+ * cursor injects exactly the inputs that window saw. Bisection probes
+ * one window per worker in parallel, keeps the earliest window whose
+ * probe faults (per-state fault_cycle, so probes never confuse each
+ * other), and recurses into it until a single snapshot interval remains.
+ * A ten-hour run narrows in log time while every core holds one 7KB
+ * state — the whole search is smaller than one frame of video.
+ *
+ * Faults reproduce exactly only for runs recorded under the virtual
+ * clock (--virtual-clock), where event injection lands on the same
+ * instruction counts; wall-clock recordings are refused.
+ */
+
+// Bisects the archive/replay pair from one recorded run and logs the
+// first faulting window and cycle. Returns false if the fault does not
+// reproduce (a non-deterministic run, or a fault older than the archive).
+bool bisect_run(const char *archive_file, const char *replay_file, int workers);
+
+#endif // BISECT_H
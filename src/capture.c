@@ -0,0 +1,136 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <string.h>
+#include <pthread.h>
+#include <SDL3/SDL.h>
+
+#include "arena.h"
+#include "capture.h"
+
+#define CAPTURE_RING 32 // Must be a power of two
+#define CAPTURE_WIDTH 128
+#define CAPTURE_HEIGHT 64
+#define CAPTURE_LUMA_ON 235 // Studio-range white and black
+#define CAPTURE_LUMA_OFF 16
+
+typedef struct capture_slot {
+    uint64_t timestamp_ns;
+    uint32_t hires;
+    uint32_t padding;
+    uint8_t vram[2048]; // Both packed bit planes
+} capture_slot_t;
+
+_Static_assert(CAPTURE_RING * sizeof(capture_slot_t) == CAPTURE_ARENA_BYTES,
+               "capture arena budget must match the ring size");
+
+bool capture_enabled;
+
+static capture_slot_t *ring; // Arena-backed, carved out in capture_start
+static atomic_uint_fast64_t ring_head; // Next slot to write (producer)
+static atomic_uint_fast64_t ring_tail; // Next slot to read (encoder)
+static uint64_t dropped;
+
+static FILE *capture_file;
+static pthread_t encoder;
+static atomic_bool encoder_running;
+
+// Expands the packed planes to one luma plane: a pixel lit on either
+// plane is white, matching the composite any palette shows. Lo-res
+// pixels are doubled in both axes so the stream geometry is constant.
+static void capture_expand(const capture_slot_t *slot, uint8_t *luma) {
+    const uint64_t (*vram)[64][2] = (const uint64_t (*)[64][2])slot->vram;
+
+    for (int y = 0; y < CAPTURE_HEIGHT; y++) {
+        int row = slot->hires ? y : y / 2;
+        for (int x = 0; x < CAPTURE_WIDTH; x++) {
+            int col = slot->hires ? x : x / 2;
+            uint64_t lit = vram[0][row][col >> 6] | vram[1][row][col >> 6];
+            luma[y * CAPTURE_WIDTH + x] =
+                (lit >> (63 - (col & 63))) & 1 ? CAPTURE_LUMA_ON : CAPTURE_LUMA_OFF;
+        }
+    }
+}
+
+static void *capture_encode(void *arg) {
+    uint8_t luma[CAPTURE_WIDTH * CAPTURE_HEIGHT];
+
+    while (atomic_load_explicit(&encoder_running, memory_order_acquire) ||
+           atomic_load(&ring_tail) != atomic_load(&ring_head)) {
+        uint64_t head = atomic_load_explicit(&ring_head, memory_order_acquire);
+        uint64_t tail = atomic_load_explicit(&ring_tail, memory_order_relaxed);
+
+        if (tail == head) {
+            SDL_DelayNS(1000000); // Nothing queued, back off 1ms
+            continue;
+        }
+
+        while (tail != head) {
+            capture_expand(&ring[tail & (CAPTURE_RING - 1)], luma);
+            fputs("FRAME\n", capture_file);
+            fwrite(luma, 1, sizeof(luma), capture_file);
+            tail++;
+        }
+        atomic_store_explicit(&ring_tail, tail, memory_order_release);
+    }
+    return NULL;
+}
+
+bool capture_start(const char *filename) {
+    ring = arena_alloc("capture ring", CAPTURE_ARENA_BYTES);
+    if (ring == NULL) {
+        return false;
+    }
+
+    capture_file = fopen(filename, "wb");
+    if (capture_file == NULL) {
+        SDL_Log("Couldn't open capture file: %s", filename);
+        return false;
+    }
+    fprintf(capture_file, "YUV4MPEG2 W%d H%d F60:1 Ip A1:1 Cmono\n",
+            CAPTURE_WIDTH, CAPTURE_HEIGHT);
+
+    atomic_store(&ring_head, 0);
+    atomic_store(&ring_tail, 0);
+    dropped = 0;
+    atomic_store(&encoder_running, true);
+    pthread_create(&encoder, NULL, capture_encode, NULL);
+    capture_enabled = true;
+
+    SDL_Log("Capturing video to %s", filename);
+    return true;
+}
+
+// Called from the frame publish path. Single producer; drops frames when
+// the encoder falls behind rather than ever blocking emulation.
+void capture_push(const void *vram, bool hires, uint64_t timestamp_ns) {
+    uint64_t head = atomic_load_explicit(&ring_head, memory_order_relaxed);
+    uint64_t tail = atomic_load_explicit(&ring_tail, memory_order_acquire);
+
+    if (head - tail >= CAPTURE_RING) {
+        dropped++;
+        return;
+    }
+
+    capture_slot_t *slot = &ring[head & (CAPTURE_RING - 1)];
+    slot->timestamp_ns = timestamp_ns;
+    slot->hires = hires;
+    memcpy(slot->vram, vram, sizeof(slot->vram));
+
+    atomic_store_explicit(&ring_head, head + 1, memory_order_release);
+}
+
+void capture_stop(void) {
+    if (!capture_enabled) {
+        return;
+    }
+    capture_enabled = false;
+    atomic_store(&encoder_running, false);
+    pthread_join(encoder, NULL);
+
+    if (dropped != 0) {
+        SDL_Log("Capture dropped %llu frames", (unsigned long long)dropped);
+    }
+    fclose(capture_file);
+    capture_file = NULL;
+}
@@ -0,0 +1,31 @@
+#ifndef CAPTURE_H
+#define CAPTURE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * Video Capture
+ *
+ * Opt-in gameplay recording to a Y4M stream (YUV4MPEG2, mono, 128x64 at
+ * 60fps — ffmpeg-ready, lo-res frames pixel-doubled so the geometry
+ * never changes mid-stream). The emulation loop pays one packed-vram
+ * copy into a bounded ring; an encoder thread expands the bit planes to
+ * luma and writes the file. When the encoder falls behind, frames are
+ * dropped and counted rather than ever stalling emulation.
+ */
+
+// Arena budget: ring slots times the slot size (capture.c asserts)
+#define CAPTURE_ARENA_BYTES (32 * 2064)
+
+extern bool capture_enabled;
+
+bool capture_start(const char *filename);
+
+// Queues one frame; vram is the packed 2048-byte snapshot
+void capture_push(const void *vram, bool hires, uint64_t timestamp_ns);
+
+// Drains the queue, closes the stream, reports drops
+void capture_stop(void);
+
+#endif // CAPTURE_H
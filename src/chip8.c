@@ -1,28 +1,58 @@
 #include <stdio.h>
 #include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
 #include <time.h>
 #include <SDL3/SDL.h>
 
-#define IPS 700
-#define TIMER_DECREMENT_INTERVAL (1.0 / 60.0) // 60 Hz
-
-extern bool run_timers;
+#include "chip8.h"
+#include "trace.h"
+#include "debug.h"
+#include "profile.h"
+#include "romdb.h"
+#include "telemetry.h"
+#include "eventlog.h"
+#include "latency.h"
+#include "heatmap.h"
+#include "decodestat.h"
+#include "clock.h"
+#include "energy.h"
+#include "crashdump.h"
+#include "alloctrap.h"
+#include "patch.h"
+
+#define TURBO_SLICE 100000 // Instructions per chip8_tick call when uncapped
+
+/* Cold-path annotation for fault handling (stack faults, unknown
+   opcodes). These paths run at most once per session but their logging
+   and crash-dump calls would otherwise sit inline in hot handler bodies,
+   inflating the I-cache working set the dispatch loop has to hold for
+   the instructions that never fault. noinline keeps LTO from folding
+   them back in; cold moves them out of the hot text and biases the
+   branch layout toward the fall-through fault-free case. */
+#if defined(__GNUC__) || defined(__clang__)
+#define CHIP8_COLD __attribute__((noinline, cold))
+#else
+#define CHIP8_COLD
+#endif
+
+/* Software prefetch hint for the block dispatch loop. Out-of-order
+   desktop cores hide the decode-cache walk behind handler execution on
+   their own, but the in-order cores this runs on in fleet deployments
+   stall on it; a hint issued one record ahead overlaps the fetch with
+   the current handler instead. Fast core only — the instrumented core's
+   hook branches dominate its dispatch cost anyway. */
+#if defined(__GNUC__) || defined(__clang__)
+#define CHIP8_PREFETCH(addr) __builtin_prefetch(addr)
+#else
+#define CHIP8_PREFETCH(addr) ((void)0)
+#endif
 
 static unsigned int START_ADDRESS = 0x200;
 
-typedef struct chip8_state {
-    uint8_t memory[4096];
-    uint16_t program_counter;
-    uint16_t index_register;
-    uint16_t stack[16];
-    uint8_t stack_ptr;
-    uint8_t delay_timer;
-    uint8_t sound_timer;
-    uint8_t registers[16];
-    uint8_t vram[64 * 32];
-    uint8_t keypad[16];
-} chip8_state_t;
+void (*chip8_sound_hook)(bool on);
+
+chip8_pacing_t chip8_pacing = CHIP8_PACING_HYBRID;
 
 static const uint8_t font_data[] = {
     0xF0, 0x90, 0x90, 0x90, 0xF0, // 0
@@ -43,83 +73,298 @@ static const uint8_t font_data[] = {
     0xF0, 0x80, 0xF0, 0x80, 0x80  // F
 };
 
-static struct timespec start, end;
-static double last_timer_update = 0.0;
+// SCHIP 10-byte hi-res font (digits 0-9 only). Both fonts sit on
+// cache-line boundaries in the template image: the 5-byte font at 0
+// spans lines 0-1 and the big font starts a fresh line at 128, so an
+// FX29+DXYN glyph fetch never straddles an extra line and the sprite
+// cache fill reads whole aligned rows.
+static unsigned int BIG_FONT_ADDRESS = 128;
+
+static const uint8_t big_font_data[] = {
+    0x3C, 0x7E, 0xE7, 0xC3, 0xC3, 0xC3, 0xC3, 0xE7, 0x7E, 0x3C, // 0
+    0x18, 0x38, 0x58, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x3C, // 1
+    0x3E, 0x7F, 0xC3, 0x06, 0x0C, 0x18, 0x30, 0x60, 0xFF, 0xFF, // 2
+    0x3C, 0x7E, 0xC3, 0x03, 0x0E, 0x0E, 0x03, 0xC3, 0x7E, 0x3C, // 3
+    0x06, 0x0E, 0x1E, 0x36, 0x66, 0xC6, 0xFF, 0xFF, 0x06, 0x06, // 4
+    0xFF, 0xFF, 0xC0, 0xC0, 0xFC, 0xFE, 0x03, 0xC3, 0x7E, 0x3C, // 5
+    0x3E, 0x7C, 0xE0, 0xC0, 0xFC, 0xFE, 0xC3, 0xC3, 0x7E, 0x3C, // 6
+    0xFF, 0xFF, 0x03, 0x06, 0x0C, 0x18, 0x30, 0x60, 0x60, 0x60, // 7
+    0x3C, 0x7E, 0xC3, 0xC3, 0x7E, 0x7E, 0xC3, 0xC3, 0x7E, 0x3C, // 8
+    0x3C, 0x7E, 0xC3, 0xC3, 0x7F, 0x3F, 0x03, 0x07, 0x7E, 0x3C  // 9
+};
 
-void chip8_init(chip8_state_t* state) {
-    // Memory
-    for (int i = 0; i < 4096; i++) {
-        state->memory[i] = 0;
+// Venue fonts (chip8_set_font) replace the stock glyphs at the same
+// addresses; the template copies whichever set is active
+static uint8_t custom_font[sizeof(font_data)];
+static uint8_t custom_big_font[sizeof(big_font_data)];
+static bool custom_font_set;
+static bool custom_big_font_set;
+
+
+void chip8_build_dispatch_table(void);
+
+// FX33 digit triples for every byte value, filled alongside the dispatch
+// tables in chip8_build_dispatch_table
+static uint8_t bcd_table[256][3];
+
+// FX29/FX30 glyph addresses for every register value, stride and base
+// baked in like bcd_table bakes its divisions — the handlers are one
+// table load, no multiply or modulo on the glyph path
+static uint16_t font_index[256];
+static uint16_t big_font_index[256];
+
+void chip8_seed(chip8_state_t *state, uint32_t seed) {
+    state->rng_state = seed != 0 ? seed : 1; // Xorshift gets stuck at zero
+}
+
+// Invalidates decode cache entries whose instruction touches any byte in
+// [first, last]. Called by every opcode that writes program memory.
+// Parameters are wider than an address so callers can form `base + count`
+// without truncating at the top of the 64K address space.
+static void chip8_invalidate_decode(chip8_state_t *state, unsigned first, unsigned last) {
+    // Sprite images fetched from the written range are stale too
+    for (int i = 0; i < CHIP8_SPRITE_CACHE; i++) {
+        chip8_sprite_t *sprite = &state->sprite_cache[i];
+        if (sprite->valid && sprite->addr <= last
+            && sprite->addr + sprite->bytes > first) {
+            sprite->valid = false;
+        }
     }
-    // Store font in memory
-    for (int i = 0; i < 80; i++) {
-        state->memory[i] = font_data[i];
+
+    // A block starting up to CHIP8_MAX_BLOCK instructions earlier reaches
+    // into the range, and an instruction starting one byte earlier spans
+    // into it; kill those entries too.
+    if (first > 2 * CHIP8_MAX_BLOCK) {
+        first -= 2 * CHIP8_MAX_BLOCK;
+    } else {
+        first = 0;
     }
-    // Stack, registers, keypad
-    for (int i = 0; i < 16; i++) {
-        state->stack[i] = 0;
-        state->registers[i] = 0;
-        state->keypad[i] = 0;
+    if (last > CHIP8_MEMORY_BYTES - 1) {
+        last = CHIP8_MEMORY_BYTES - 1;
+    }
+    int killed = 0;
+    // Wider than an address: last may be the top byte of memory, which a
+    // uint16_t counter would never step past in the 64K configuration
+    for (unsigned addr = first; addr <= last; addr++) {
+        chip8_decoded_t *entry = &state->decode_cache[addr >> 1];
+        if (entry->tag != 0 && entry->tag != CHIP8_TAG_INVALIDATED) {
+            killed++;
+        }
+        entry->tag = CHIP8_TAG_INVALIDATED;
+    }
+    if (decodestat_enabled) {
+        decodestat_invalidate(killed);
     }
-    // VRAM
-    for (int i = 0; i < 64 * 32; i++) {
-        state->vram[i] = 0;
+}
+
+// Invalidation for FX33/FX55 stores: the writes mask each address with
+// CHIP8_ADDR_MASK, so a store starting near the top of memory (I is
+// unmasked after FX1E) wraps and lands low. Split the invalidation the
+// same way so it covers exactly the bytes that changed.
+static void chip8_invalidate_stored(chip8_state_t *state, uint16_t base, unsigned count) {
+    unsigned first = base & CHIP8_ADDR_MASK;
+    unsigned last = first + count - 1;
+    if (last > CHIP8_MEMORY_BYTES - 1) {
+        chip8_invalidate_decode(state, 0, last & CHIP8_ADDR_MASK);
+        last = CHIP8_MEMORY_BYTES - 1;
     }
-    // All other values
+    chip8_invalidate_decode(state, first, last);
+}
+
+// Per-state xorshift32: no libc lock, identical sequences for equal seeds
+static uint32_t chip8_rand(chip8_state_t *state) {
+    uint32_t x = state->rng_state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    state->rng_state = x;
+    return x;
+}
+
+/* Prepared boot template: every field of a freshly initialized state
+   except the rng seed, built once with bulk stores. Sweep runs construct
+   tens of thousands of sessions, and the per-field loops this replaces
+   were the dominant init cost on unoptimized builds — one memset, two
+   font copies, and a handful of non-zero fields cover everything. Zero
+   already means "fresh" for the rest by design: vram generation 0 with
+   every row stamped is all-live-and-zero, decode cache tag 0 is empty,
+   sprite cache valid 0 is empty, and the pacing fields baseline
+   themselves on first use. */
+// Guarded by a three-state flag because sweep harnesses init states from
+// many threads at once: exactly one caller builds, the rest spin until
+// the template is complete instead of copying (or zeroing) it mid-build
+enum { TEMPLATE_STALE, TEMPLATE_BUILDING, TEMPLATE_READY };
+static chip8_state_t init_template;
+static atomic_int init_template_state;
+
+static void chip8_build_init_template(void) {
+    chip8_state_t *state = &init_template;
+    memset(state, 0, sizeof(*state));
+    memcpy(state->memory, custom_font_set ? custom_font : font_data,
+           sizeof(font_data));
+    memcpy(state->memory + BIG_FONT_ADDRESS,
+           custom_big_font_set ? custom_big_font : big_font_data,
+           sizeof(big_font_data));
+    state->plane_mask = 1;
     state->program_counter = START_ADDRESS;
-    state->index_register = 0;
-    state->stack_ptr = 0;
-    state->delay_timer = 0;
-    state->sound_timer = 0;
+    state->ips = CHIP8_DEFAULT_IPS;
+    state->vram_dirty = true; // Force an initial present
+    state->dirty_count = CHIP8_DIRTY_FULL;
+    state->wait_key_latched = 0xFF;
+
+    // Build the per-profile, per-core dispatch tables (no-op after the
+    // first instance); the template carries the default selection
+    chip8_build_dispatch_table();
+    state->core = CHIP8_CORE_INSTRUMENTED;
+    chip8_set_profile(state, CHIP8_PROFILE_COSMAC);
+}
 
-    // Initalize randomness
-    srand(time(NULL));
+void chip8_init(chip8_state_t* state) {
+    int expected = TEMPLATE_STALE;
+    if (atomic_compare_exchange_strong(&init_template_state, &expected,
+                                       TEMPLATE_BUILDING)) {
+        chip8_build_init_template();
+        atomic_store_explicit(&init_template_state, TEMPLATE_READY,
+                              memory_order_release);
+    } else {
+        while (atomic_load_explicit(&init_template_state,
+                                    memory_order_acquire) != TEMPLATE_READY) {
+            // Another thread is building; the wait is one-time and short
+        }
+    }
+    memcpy(state, &init_template, sizeof(*state));
+
+    // Initalize randomness (reseedable with chip8_seed for reproducible runs)
+    chip8_seed(state, (uint32_t)time(NULL));
 
     SDL_Log("Initialized chip-8 state");
 }
 
-void chip8_load_rom(chip8_state_t* state, char const* filename) {
+void chip8_set_font(chip8_state_t *state, const uint8_t *glyphs,
+                    const uint8_t *big_glyphs) {
+    if (glyphs != NULL) {
+        memcpy(custom_font, glyphs, sizeof(custom_font));
+        custom_font_set = true;
+    }
+    if (big_glyphs != NULL) {
+        memcpy(custom_big_font, big_glyphs, sizeof(custom_big_font));
+        custom_big_font_set = true;
+    }
+    // The next init bakes the new glyphs (font swaps happen before any
+    // threaded init, so no builder can be in flight here)
+    atomic_store(&init_template_state, TEMPLATE_STALE);
+
+    // A state initialized before the swap gets patched in place; the
+    // invalidation drops any cached sprite image fetched from the range
+    if (state != NULL) {
+        if (glyphs != NULL) {
+            memcpy(state->memory, glyphs, sizeof(custom_font));
+            chip8_invalidate_decode(state, 0, sizeof(custom_font) - 1);
+        }
+        if (big_glyphs != NULL) {
+            memcpy(state->memory + BIG_FONT_ADDRESS, big_glyphs,
+                   sizeof(custom_big_font));
+            chip8_invalidate_decode(state, (uint16_t)BIG_FONT_ADDRESS,
+                                    (uint16_t)(BIG_FONT_ADDRESS
+                                               + sizeof(custom_big_font) - 1));
+        }
+    }
+}
+
+// Loads a ROM image already in memory (embedded builds, test harnesses):
+// no file I/O, just a copy into interpreter memory plus the config lookup
+bool chip8_load_rom_memory(chip8_state_t *state, const uint8_t *data, size_t size) {
+    if (size > sizeof(state->memory) - START_ADDRESS) {
+        SDL_Log("ROM doesn't fit in memory (%zu bytes, max %zu)",
+                size, sizeof(state->memory) - START_ADDRESS);
+        return false;
+    }
+
+    memcpy(&state->memory[START_ADDRESS], data, size);
+    chip8_invalidate_decode(state, START_ADDRESS, START_ADDRESS + (uint16_t)size - 1);
+    eventlog_emit(EVENT_ROM_LOADED, 0, (uint32_t)size);
+
+    // Apply any per-ROM config keyed by the ROM's content hash. Flags
+    // parsed after loading still override these.
+    state->rom_hash = romdb_hash(&state->memory[START_ADDRESS], size);
+    const romdb_entry_t *config = romdb_find(state->rom_hash);
+    if (config != NULL) {
+        chip8_set_profile(state, config->profile);
+        state->ips = config->ips;
+        SDL_Log("Applied ROM config for %016llx", (unsigned long long)state->rom_hash);
+        eventlog_emit(EVENT_ROM_CONFIG, (uint16_t)config->profile, config->ips);
+    }
+
+    return true;
+}
+
+bool chip8_load_rom(chip8_state_t* state, char const* filename) {
     // Open the file
     FILE *fptr = fopen(filename, "rb");
 
     // Check if file exists / have permissions
     if (fptr == NULL) {
         SDL_Log("Error opening file: %s", filename);
-        exit(1);
+        eventlog_emit(EVENT_ROM_ERROR, 0, 0);
+        return false;
     }
 
-    // Load ROM into memory
-    int i = 0;
-    int buffer;
-    while ((buffer = fgetc(fptr)) != EOF) {
-        uint8_t byte = (uint8_t)buffer;
-        state->memory[START_ADDRESS + i] = byte;
-        i++;
+    // Find the ROM size and check it fits in memory[0x200..0xFFF]
+    fseek(fptr, 0, SEEK_END);
+    long size = ftell(fptr);
+    fseek(fptr, 0, SEEK_SET);
+
+    if (size < 0 || size > (long)(sizeof(state->memory) - START_ADDRESS)) {
+        SDL_Log("ROM doesn't fit in memory: %s (%ld bytes, max %zu)",
+                filename, size, sizeof(state->memory) - START_ADDRESS);
+        eventlog_emit(EVENT_ROM_ERROR, 0, (uint32_t)size);
+        fclose(fptr);
+        return false;
     }
 
+    // Load the whole ROM with a single read, staged so a short read never
+    // half-populates interpreter memory
+    uint8_t data[sizeof(state->memory)];
+    size_t loaded = fread(data, 1, (size_t)size, fptr);
     fclose(fptr);
+
+    if (loaded != (size_t)size) {
+        SDL_Log("Error reading file: %s", filename);
+        return false;
+    }
+
+    // Sidecar patches (<rom>.ips) land on the staged copy, so the config
+    // lookup below keys on the patched image's hash
+    loaded = patch_apply(filename, data, loaded, sizeof(state->memory) - START_ADDRESS);
+
+    return chip8_load_rom_memory(state, data, loaded);
 }
 
 /**
  * Chip-8 Instruction Decoding
+ *
+ * Operand extraction is lazy: each handler pulls only the fields its
+ * opcode uses. static inline guarantees the shifts-and-masks fold into
+ * the handler bodies even without LTO — no call overhead in the
+ * dispatch path.
  */
-uint8_t chip8_decode_x(uint16_t instruction) {
+static inline uint8_t chip8_decode_x(uint16_t instruction) {
     return (instruction >> 8) & 0x0F; // Extracts bits 8-11
 }
 
-uint8_t chip8_decode_y(uint16_t instruction) {
+static inline uint8_t chip8_decode_y(uint16_t instruction) {
     return (instruction >> 4) & 0x0F; // Extracts bits 4-7
 }
 
-uint8_t chip8_decode_n(uint16_t instruction) {
+static inline uint8_t chip8_decode_n(uint16_t instruction) {
     return instruction & 0x0F; // Extracts bits 0-3
 }
 
-uint8_t chip8_decode_nn(uint16_t instruction) {
+static inline uint8_t chip8_decode_nn(uint16_t instruction) {
     return instruction & 0xFF; // Extracts bits 0-7 (full NN)
 }
 
-uint16_t chip8_decode_nnn(uint16_t instruction) {
+static inline uint16_t chip8_decode_nnn(uint16_t instruction) {
     return instruction & 0x0FFF; // Extracts bits 0-11 (NNN)
 }
 
@@ -128,436 +373,1602 @@ uint16_t chip8_decode_nnn(uint16_t instruction) {
  * Chip-8 Instruction Execution
  */
 
+void chip8_mark_all_dirty(chip8_state_t *state) {
+    state->vram_dirty = true;
+    state->dirty_count = CHIP8_DIRTY_FULL;
+}
+
+// Appends one sprite rect to the dirty list; a full list overflows to the
+// whole-frame sentinel rather than dropping regions
+static void chip8_mark_dirty(chip8_state_t *state, int x, int y, int w, int h) {
+    state->vram_dirty = true;
+    if (state->dirty_count >= CHIP8_DIRTY_RECTS) {
+        state->dirty_count = CHIP8_DIRTY_FULL;
+        return;
+    }
+
+    chip8_rect_t *rect = &state->dirty_rects[state->dirty_count++];
+    rect->x = (uint8_t)x;
+    rect->y = (uint8_t)y;
+    rect->w = (uint8_t)w;
+    rect->h = (uint8_t)h;
+}
+
+// O(1) clear: bumping the plane generation makes every row stale, and
+// stale rows read as zero until something draws into them
 void chip8_op_cls(chip8_state_t *state) {
-    for (int i = 0; i < sizeof(state->vram); i++) {
-        state->vram[i] = 0;
+    for (int p = 0; p < 2; p++) {
+        if (!(state->plane_mask & (1 << p))) continue;
+        state->plane_generation[p]++;
     }
-    SDL_Log("00E0: Clear screen");
+    chip8_mark_all_dirty(state);
+}
+
+// Extracted fault tails: the handlers above them stay a compare and a
+// call away from fault-free, so the dispatch loop's hot text holds only
+// the arithmetic that actually executes
+static CHIP8_COLD void chip8_fault_underflow(chip8_state_t *state) {
+    SDL_Log("Stack underflow!");
+    eventlog_emit(EVENT_STACK_UNDERFLOW, 0, state->program_counter);
+    if (state->fault_cycle == 0) {
+        state->fault_cycle = state->cycle_count;
+    }
+    crashdump_fault(state, "stack underflow");
+}
+
+static CHIP8_COLD void chip8_fault_overflow(chip8_state_t *state) {
+    SDL_Log("Stack overflow!");
+    eventlog_emit(EVENT_STACK_OVERFLOW, 0, state->program_counter);
+    if (state->fault_cycle == 0) {
+        state->fault_cycle = state->cycle_count;
+    }
+    crashdump_fault(state, "stack overflow");
 }
 
 void chip8_op_pop(chip8_state_t *state) {
     if (state->stack_ptr == 0) {
-        SDL_Log("Stack underflow!");
+        chip8_fault_underflow(state);
         return;
     }
     state->program_counter = state->stack[--state->stack_ptr];
-    SDL_Log("00EE: POP");
 }
 
 void chip8_op_jmp(chip8_state_t *state, uint16_t address) {
+    // A jump to its own address can never exit: flag it so the frontend
+    // stops burning dispatches on it
+    if (address == (uint16_t)(state->program_counter - 2)) {
+        state->idle = true;
+    }
     state->program_counter = address;
-    SDL_Log("1NNN: JMP %04X", address);
 }
 
 void chip8_op_push(chip8_state_t *state, uint16_t address) {
-    if (state->stack_ptr >= sizeof(state->stack)) {
-        SDL_Log("Stack overflow!");
+    // sizeof would count bytes, not the 16 entries
+    if (state->stack_ptr >= sizeof(state->stack) / sizeof(state->stack[0])) {
+        chip8_fault_overflow(state);
         return;
     }
     state->stack[state->stack_ptr++] = state->program_counter;
     state->program_counter = address;
-    SDL_Log("2NNN: PUSH %04X", address);
 }
 
 void chip8_op_skip_equal(chip8_state_t *state, uint8_t reg, uint8_t value) {
     if (state->registers[reg] == value) {
-        state->program_counter += 2;
+        state->program_counter = (state->program_counter + 2) & CHIP8_ADDR_MASK;
     }
-    SDL_Log("3XNN: SKIP IF V%X == %04X", reg, value);
 }
 
 void chip8_op_skip_not_equal(chip8_state_t *state, uint8_t reg, uint8_t value) {
     if (state->registers[reg] != value) {
-        state->program_counter += 2;
+        state->program_counter = (state->program_counter + 2) & CHIP8_ADDR_MASK;
     }
-    SDL_Log("4XNN: SKIP IF V%X != %04X", reg, value);
 }
 
 void chip8_op_skip_reg_equal(chip8_state_t *state, uint8_t reg_x, uint8_t reg_y) {
     if (state->registers[reg_x] == state->registers[reg_y]) {
-        state->program_counter += 2;
+        state->program_counter = (state->program_counter + 2) & CHIP8_ADDR_MASK;
     }
-    SDL_Log("5XY0: SKIP IF V%X == V%X", reg_x, reg_y);
 }
 
 void chip8_op_set(chip8_state_t *state, uint8_t reg, uint8_t value) {
     state->registers[reg] = value;
-    SDL_Log("6XNN: SET V%X, %02X", reg, value);
 }
 
 void chip8_op_add(chip8_state_t *state, uint8_t reg, uint8_t value) {
     state->registers[reg] += value;
-    SDL_Log("7XNN: ADD V%X, %02X", reg, value);
 }
 
 void chip8_op_set_reg(chip8_state_t *state, uint8_t reg_x, uint8_t reg_y) {
     state->registers[reg_x] = state->registers[reg_y];
-    SDL_Log("8XY0: SET V%X, V%X", reg_x, reg_y);
 }
 
 void chip8_op_or(chip8_state_t *state, uint8_t reg_x, uint8_t reg_y) {
     state->registers[reg_x] |= state->registers[reg_y];
     state->registers[0xF] = 0;
-    SDL_Log("8XY1: OR V%X, V%X", reg_x, reg_y);
 }
 
 void chip8_op_and(chip8_state_t *state, uint8_t reg_x, uint8_t reg_y) {
     state->registers[reg_x] &= state->registers[reg_y];
     state->registers[0xF] = 0;
-    SDL_Log("8XY2: AND V%X, V%X", reg_x, reg_y);
 }
 
 void chip8_op_xor(chip8_state_t *state, uint8_t reg_x, uint8_t reg_y) {
     state->registers[reg_x] ^= state->registers[reg_y];
     state->registers[0xF] = 0;
-    SDL_Log("8XY3: XOR V%X, V%X", reg_x, reg_y);
+}
+
+// Quirk variants of 8XY1/2/3 without the COSMAC VF reset
+void chip8_op_or_noreset(chip8_state_t *state, uint8_t reg_x, uint8_t reg_y) {
+    state->registers[reg_x] |= state->registers[reg_y];
+}
+
+void chip8_op_and_noreset(chip8_state_t *state, uint8_t reg_x, uint8_t reg_y) {
+    state->registers[reg_x] &= state->registers[reg_y];
+}
+
+void chip8_op_xor_noreset(chip8_state_t *state, uint8_t reg_x, uint8_t reg_y) {
+    state->registers[reg_x] ^= state->registers[reg_y];
 }
 
 void chip8_op_add_reg(chip8_state_t *state, uint8_t reg_x, uint8_t reg_y) {
+    // Both operands read before either write, result before flag: when X
+    // is F the flag write wins by sequence, not by evaluation order
     uint16_t sum = state->registers[reg_x] + state->registers[reg_y];
-    state->registers[reg_x] += state->registers[reg_y];
+    state->registers[reg_x] = (uint8_t)sum;
     state->registers[0xF] = sum > 255 ? 1 : 0;
-    SDL_Log("8XY4: ADD V%X, V%X", reg_x, reg_y);
 }
 
 void chip8_op_subtract_xy(chip8_state_t *state, uint8_t reg_x, uint8_t reg_y) {
     uint8_t flag = state->registers[reg_x] >= state->registers[reg_y] ? 1 : 0;
     state->registers[reg_x] -= state->registers[reg_y];
     state->registers[0xF] = flag;
-    SDL_Log("8XY5: SUB V%X, V%X", reg_x, reg_y);
 }
 
 void chip8_op_shr(chip8_state_t *state, uint8_t reg_x, uint8_t reg_y) {
-    state->registers[reg_x] = state->registers[reg_y];
+    uint8_t src = state->registers[reg_y]; // COSMAC shifts VY into VX
+    state->registers[reg_x] = src >> 1;
+    state->registers[0xF] = src & 1;
+}
+
+// Quirk variant of 8XY6: shift VX in place, ignoring VY
+void chip8_op_shr_inplace(chip8_state_t *state, uint8_t reg_x, uint8_t reg_y) {
     uint8_t shifted_value = state->registers[reg_x] & 1;
     state->registers[reg_x] >>= 1;
-    state->registers[0xF] = shifted_value & 1;
-    SDL_Log("8XY6: SHR V%X", reg_y);
+    state->registers[0xF] = shifted_value;
 }
 
 void chip8_op_subtract_yx(chip8_state_t *state, uint8_t reg_x, uint8_t reg_y) {
     uint8_t flag = state->registers[reg_y] >= state->registers[reg_x] ? 1 : 0;
     state->registers[reg_x] = state->registers[reg_y] - state->registers[reg_x];
     state->registers[0xF] = flag;
-    SDL_Log("8XY7: SUB V%X, V%X", reg_x, reg_y);
 }
 
 void chip8_op_shl(chip8_state_t *state, uint8_t reg_x, uint8_t reg_y) {
-    state->registers[reg_x] = state->registers[reg_y];
-    uint8_t shifted_value = (state->registers[reg_x] >> (sizeof(state->registers[reg_x]) * 8 - 1)) & 1;
+    uint8_t src = state->registers[reg_y];
+    state->registers[reg_x] = (uint8_t)(src << 1);
+    state->registers[0xF] = (src >> 7) & 1;
+}
+
+// Quirk variant of 8XYE: shift VX in place, ignoring VY
+void chip8_op_shl_inplace(chip8_state_t *state, uint8_t reg_x, uint8_t reg_y) {
+    uint8_t shifted_value = (state->registers[reg_x] >> 7) & 1;
     state->registers[reg_x] <<= 1;
-    state->registers[0xF] = shifted_value & 1;
-    SDL_Log("8XYE: SHR V%X", reg_y);
+    state->registers[0xF] = shifted_value;
 }
 
 void chip8_op_skip_reg_not_equal(chip8_state_t *state, uint8_t reg_x, uint8_t reg_y) {
     if (state->registers[reg_x] != state->registers[reg_y]) {
-        state->program_counter += 2;
+        state->program_counter = (state->program_counter + 2) & CHIP8_ADDR_MASK;
     }
-    SDL_Log("9XY0: SKIP IF V%X == V%X", reg_x, reg_y);
 }
 
 void chip8_op_set_index(chip8_state_t *state, uint16_t value) {
     state->index_register = value;
-    SDL_Log("ANNN: Set index register to %04X", value);
 }
 
 void chip8_op_jmp_offset(chip8_state_t *state, uint16_t value) {
-    state->program_counter = state->registers[0x0] + value;
-    SDL_Log("BNNN: JMP V0, %04X", value);
+    state->program_counter = (state->registers[0x0] + value) & CHIP8_ADDR_MASK;
 }
 
 void chip8_op_rand(chip8_state_t *state, uint8_t reg_x, uint8_t value) {
-    state->registers[reg_x] = rand() & value;
-    SDL_Log("CXNN: RAND V%X, %04X", reg_x, value);
+    state->registers[reg_x] = chip8_rand(state) & value;
 }
 
-void chip8_op_draw(chip8_state_t *state, uint8_t reg_x, uint8_t reg_y, uint8_t value) {
-    uint8_t x = state->registers[reg_x] % 64;
-    uint8_t y = state->registers[reg_y] % 32;
+// Shadow-bitmap check for the handlers that touch memory; everything else
+// executes with no awareness that watchpoints exist
+static inline void chip8_watch_check(chip8_state_t *state, uint16_t addr, bool is_write) {
+    if (debug_watch_active && debug_watched(addr)) {
+        debug_watch_hit(state, addr, is_write, state->memory[addr & CHIP8_ADDR_MASK]);
+    }
+}
 
-    state->registers[0xF] = 0;
+// Materializes one lazily-cleared row ahead of a read-modify-write: zero
+// the bits the deferred clear never wrote and bring the stamp current
+static inline void chip8_vram_touch(chip8_state_t *state, int plane, int row) {
+    if (state->row_generation[plane][row] != state->plane_generation[plane]) {
+        state->vram[plane][row][0] = 0;
+        state->vram[plane][row][1] = 0;
+        state->row_generation[plane][row] = state->plane_generation[plane];
+    }
+}
 
-    for (int row = 0; row < value; row++) {
-        uint8_t sprite = state->memory[state->index_register + row];
+// Returns the cached image for the sprite at addr, filling the entry on
+// a miss. Rows come back left-aligned at bit 63, so every later shift is
+// a plain right shift regardless of width. Active watchpoints need the
+// real per-row fetches, so they bypass the cache entirely.
+static const chip8_sprite_t *chip8_sprite_fetch(chip8_state_t *state,
+                                                uint16_t addr, int rows, int width) {
+    chip8_sprite_t *sprite = &state->sprite_cache[addr & (CHIP8_SPRITE_CACHE - 1)];
+
+    if (!sprite->valid || sprite->addr != addr || sprite->rows != rows
+        || sprite->width != width || debug_watch_active) {
+        for (int row = 0; row < rows; row++) {
+            uint64_t image;
+            if (width == 16) {
+                image = ((uint64_t)state->memory[(addr + 2 * row) & CHIP8_ADDR_MASK] << 8)
+                      | state->memory[(addr + 2 * row + 1) & CHIP8_ADDR_MASK];
+                chip8_watch_check(state, (addr + 2 * row) & CHIP8_ADDR_MASK, false);
+                chip8_watch_check(state, (addr + 2 * row + 1) & CHIP8_ADDR_MASK, false);
+            } else {
+                image = state->memory[(addr + row) & CHIP8_ADDR_MASK];
+                chip8_watch_check(state, (addr + row) & CHIP8_ADDR_MASK, false);
+            }
+            sprite->bits[row] = image << (64 - width);
+        }
+        sprite->addr = addr;
+        sprite->rows = (uint8_t)rows;
+        sprite->width = (uint8_t)width;
+        sprite->bytes = (uint8_t)(width == 16 ? rows * 2 : rows);
+        sprite->valid = !debug_watch_active;
+    }
+    return sprite;
+}
 
-        for (int col = 0; col < 8; col++) {
-            if ((x + col) >= 64 || (y + row) >= 32) continue; // Optional: skip out-of-bounds
+// XOR one sprite starting at addr into one plane; returns true if any set
+// pixel was cleared. Lo-res sprites are 8 wide on word 0 of the top 32
+// rows; hi-res spreads across the two words of a 128-bit row, splitting
+// rows that straddle column 64. Shifting past either end clips at the edge.
+static bool chip8_draw_plane(chip8_state_t *state, int p,
+                             uint16_t addr, uint8_t x, uint8_t y,
+                             int rows, int width) {
+    uint64_t (*plane)[2] = state->vram[p];
+    const chip8_sprite_t *sprite = chip8_sprite_fetch(state, addr, rows, width);
+    bool collision = false;
+
+    if (!state->hires) {
+        for (int row = 0; row < rows; row++) {
+            if ((y + row) >= 32) break; // Clip at the bottom edge
+
+            uint64_t row_bits = sprite->bits[row] >> x;
+
+            chip8_vram_touch(state, p, y + row);
+            if (plane[y + row][0] & row_bits) {
+                collision = true;
+            }
+            plane[y + row][0] ^= row_bits;
+        }
+        return collision;
+    }
 
-            uint8_t sprite_pixel = (sprite >> (7 - col)) & 0x1;
-            uint16_t vram_index = (y + row) * 64 + (x + col);
+    for (int row = 0; row < rows; row++) {
+        if ((y + row) >= 64) break;
+
+        uint64_t aligned = sprite->bits[row];
+        uint64_t hi, lo;
+        if (x < 64) {
+            hi = aligned >> x;
+            lo = x != 0 ? aligned << (64 - x) : 0;
+        } else {
+            hi = 0;
+            lo = aligned >> (x - 64);
+        }
 
-            if (sprite_pixel) {
-                if (state->vram[vram_index] == 1) {
-                    state->registers[0xF] = 1;
-                }
-                state->vram[vram_index] ^= 1;
+        chip8_vram_touch(state, p, y + row);
+        if ((plane[y + row][0] & hi) | (plane[y + row][1] & lo)) {
+            collision = true;
+        }
+        plane[y + row][0] ^= hi;
+        plane[y + row][1] ^= lo;
+    }
+    return collision;
+}
+
+// Shared draw body: `instrumented` is a compile-time constant at every
+// call site, so the fast core's clone carries none of the hook branches
+static inline void chip8_draw_impl(chip8_state_t *state, uint8_t reg_x,
+                                   uint8_t reg_y, uint8_t value, bool instrumented) {
+    if (instrumented && latency_enabled) {
+        latency_draw();
+    }
+
+    // DXY0 is the SCHIP big-sprite form: 16x16 in hi-res, 8x16 in lo-res
+    int rows = value != 0 ? value : 16;
+    int width = (value == 0 && state->hires) ? 16 : 8;
+
+    uint8_t x = state->registers[reg_x] % (state->hires ? 128 : 64);
+    uint8_t y = state->registers[reg_y] % (state->hires ? 64 : 32);
+
+    // With both planes selected the sprite data for each plane follows the
+    // previous plane's, so a two-plane draw consumes twice the bytes
+    uint16_t addr = state->index_register;
+    bool collision = false;
+
+    if (instrumented && heatmap_enabled) {
+        int bytes_per_plane = width == 16 ? rows * 2 : rows;
+        uint16_t plane_addr = addr;
+        for (int p = 0; p < 2; p++) {
+            if (state->plane_mask & (1 << p)) {
+                heatmap_read(plane_addr, bytes_per_plane);
+                plane_addr += bytes_per_plane;
             }
         }
     }
-    SDL_Log("DXYN: Draw sprite at (%X, %X) with height %X", x, y, value);
+
+    for (int p = 0; p < 2; p++) {
+        if (!(state->plane_mask & (1 << p))) continue;
+        collision |= chip8_draw_plane(state, p, addr, x, y, rows, width);
+        addr += width == 16 ? rows * 2 : rows;
+    }
+
+    state->registers[0xF] = collision;
+
+    // Record the touched region (clipped at the display edges) for the
+    // renderer's partial texture update
+    int max_x = state->hires ? 128 : 64;
+    int max_y = state->hires ? 64 : 32;
+    chip8_mark_dirty(state, x, y,
+                     x + width <= max_x ? width : max_x - x,
+                     y + rows <= max_y ? rows : max_y - y);
+}
+
+void chip8_op_draw(chip8_state_t *state, uint8_t reg_x, uint8_t reg_y, uint8_t value) {
+    chip8_draw_impl(state, reg_x, reg_y, value, true);
+}
+
+static void chip8_clear_all_planes(chip8_state_t *state) {
+    state->plane_generation[0]++;
+    state->plane_generation[1]++;
+    chip8_mark_all_dirty(state);
+}
+
+void chip8_op_lores(chip8_state_t *state) {
+    state->hires = false;
+    chip8_clear_all_planes(state); // Mode switches start from a blank screen
+}
+
+void chip8_op_hires(chip8_state_t *state) {
+    state->hires = true;
+    chip8_clear_all_planes(state);
+}
+
+// XO-CHIP FN01: select which planes subsequent draws, clears, and scrolls
+// affect
+void chip8_op_plane(chip8_state_t *state, uint8_t mask) {
+    state->plane_mask = mask & 0x3;
+}
+
+// The scrolls are row moves and word shifts on the selected planes: no
+// per-pixel work
+void chip8_op_scroll_down(chip8_state_t *state, uint8_t n) {
+    for (int p = 0; p < 2; p++) {
+        if (!(state->plane_mask & (1 << p))) continue;
+        for (int i = 0; i < 64; i++) {
+            chip8_vram_touch(state, p, i); // Whole-plane op: materialize it
+        }
+        memmove(&state->vram[p][n], &state->vram[p][0], (64 - n) * sizeof(state->vram[p][0]));
+        for (int i = 0; i < n; i++) {
+            state->vram[p][i][0] = 0;
+            state->vram[p][i][1] = 0;
+        }
+    }
+    chip8_mark_all_dirty(state);
+}
+
+void chip8_op_scroll_right(chip8_state_t *state) {
+    for (int p = 0; p < 2; p++) {
+        if (!(state->plane_mask & (1 << p))) continue;
+        for (int i = 0; i < 64; i++) {
+            chip8_vram_touch(state, p, i);
+            state->vram[p][i][1] = (state->vram[p][i][1] >> 4) | (state->vram[p][i][0] << 60);
+            state->vram[p][i][0] >>= 4;
+        }
+    }
+    chip8_mark_all_dirty(state);
+}
+
+void chip8_op_scroll_left(chip8_state_t *state) {
+    for (int p = 0; p < 2; p++) {
+        if (!(state->plane_mask & (1 << p))) continue;
+        for (int i = 0; i < 64; i++) {
+            chip8_vram_touch(state, p, i);
+            state->vram[p][i][0] = (state->vram[p][i][0] << 4) | (state->vram[p][i][1] >> 60);
+            state->vram[p][i][1] <<= 4;
+        }
+    }
+    chip8_mark_all_dirty(state);
+}
+
+// SCHIP 00FD exits the interpreter; spin in place and go idle so the
+// frontend stops dispatching
+void chip8_op_exit(chip8_state_t *state) {
+    state->program_counter -= 2;
+    state->idle = true;
+}
+
+static inline void chip8_skip_key_impl(chip8_state_t *state, uint8_t reg_x,
+                                       bool instrumented) {
+    if (chip8_key_down(state, state->registers[reg_x])) {
+        if (instrumented && latency_enabled) {
+            latency_skip_consumed();
+        }
+        state->program_counter = (state->program_counter + 2) & CHIP8_ADDR_MASK;
+    }
 }
 
 void chip8_op_skip_key(chip8_state_t *state, uint8_t reg_x) {
-    if (state->keypad[state->registers[reg_x]]) {
-        state->program_counter += 2;
+    chip8_skip_key_impl(state, reg_x, true);
+}
+
+static inline void chip8_skip_not_key_impl(chip8_state_t *state, uint8_t reg_x,
+                                           bool instrumented) {
+    if (!chip8_key_down(state, state->registers[reg_x])) {
+        state->program_counter = (state->program_counter + 2) & CHIP8_ADDR_MASK;
+    } else if (instrumented && latency_enabled) {
+        latency_skip_consumed(); // EXA1 saw the key down: it was consumed
     }
-    SDL_Log("EX9E: SKIP V%X", reg_x);
 }
 
 void chip8_op_skip_not_key(chip8_state_t *state, uint8_t reg_x) {
-    if (!state->keypad[state->registers[reg_x]]) {
-        state->program_counter += 2;
-    }
-    SDL_Log("EXA1: SKIP NOT V%X", reg_x);
+    chip8_skip_not_key_impl(state, reg_x, true);
 }
 
 void chip8_op_get_delay_timer(chip8_state_t *state, uint8_t reg_x) {
     state->registers[reg_x] = state->delay_timer;
-    SDL_Log("FX07: SET V%X, DLY", reg_x);
 }
 
 void chip8_op_halt_key(chip8_state_t *state, uint8_t reg_x) {
-    SDL_Log("FX0A: HALT KEY V%X", reg_x);
+    // Park rather than re-dispatch. pc backs onto this instruction so a
+    // savestate taken mid-wait re-enters it on restore, but the scheduler
+    // executes nothing until the wait resolves — no spin on title screens.
+    state->program_counter -= 2;
+    state->waiting_key = true;
+    state->wait_key_reg = reg_x;
+    state->wait_key_latched = 0xFF;
+    state->idle = true; // Nothing can change until the frontend sees a key
+}
 
-    for (int i = 0; i < 16; i++) {
-        if (state->keypad[i]) {
-            state->registers[reg_x] = i;
-            return;
+// Resolves an FX0A park: latch the first pressed key, complete on its
+// release (the original interpreter waited for release too) by storing
+// the key and stepping past the instruction. Returns true while blocked.
+static bool chip8_key_wait_blocked(chip8_state_t *state) {
+    if (!state->waiting_key) {
+        return false;
+    }
+
+    if (state->wait_key_latched == 0xFF) {
+        uint16_t keys = atomic_load_explicit(&state->keypad, memory_order_relaxed);
+        for (int i = 0; i < 16; i++) {
+            if ((keys >> i) & 1) {
+                state->wait_key_latched = (uint8_t)i;
+                break;
+            }
         }
     }
-    state->program_counter -= 2; // Repeat this instruction
+    if (state->wait_key_latched == 0xFF || chip8_key_down(state, state->wait_key_latched)) {
+        state->idle = true; // Still waiting (for a press, or for its release)
+        return true;
+    }
+
+    state->registers[state->wait_key_reg] = state->wait_key_latched;
+    state->waiting_key = false;
+    state->program_counter = (state->program_counter + 2) & CHIP8_ADDR_MASK;
+    state->idle = false;
+    return false;
 }
 
 void chip8_op_set_delay_timer(chip8_state_t *state, uint8_t reg_x) {
     state->delay_timer = state->registers[reg_x];
-    SDL_Log("FX15: SET DLY, V%X", reg_x);
 }
 
 void chip8_op_set_sound_timer(chip8_state_t *state, uint8_t reg_x) {
+    bool was_on = state->sound_timer > 0;
     state->sound_timer = state->registers[reg_x];
-    SDL_Log("FX18: SET SND, V%X", reg_x);
+    if (chip8_sound_hook != NULL && (state->sound_timer > 0) != was_on) {
+        chip8_sound_hook(state->sound_timer > 0);
+    }
 }
 
 void chip8_op_add_index(chip8_state_t *state, uint8_t reg_x) {
     state->index_register += state->registers[reg_x];
-    SDL_Log("FX1E: ADDINDEX V%X", reg_x);
 }
 
 void chip8_op_font_char(chip8_state_t *state, uint8_t reg_x) {
-    state->index_register = state->registers[reg_x] * 5;
-    SDL_Log("FX29: LD FONT, V%X", reg_x);
+    state->index_register = font_index[state->registers[reg_x]];
+}
+
+void chip8_op_big_font_char(chip8_state_t *state, uint8_t reg_x) {
+    state->index_register = big_font_index[state->registers[reg_x]];
+}
+
+static inline void chip8_coded_conversion_impl(chip8_state_t *state, uint8_t reg_x,
+                                               bool instrumented) {
+    // Precomputed digit triple: one table load instead of two divisions
+    // and three modulos — FX33 sits on score loops in a lot of ROMs
+    const uint8_t *digits = bcd_table[state->registers[reg_x]];
+    state->memory[state->index_register & CHIP8_ADDR_MASK] = digits[0];
+    state->memory[(state->index_register + 1) & CHIP8_ADDR_MASK] = digits[1];
+    state->memory[(state->index_register + 2) & CHIP8_ADDR_MASK] = digits[2];
+    chip8_invalidate_stored(state, state->index_register, 3);
+    if (instrumented) {
+        for (int i = 0; i < 3; i++) {
+            chip8_watch_check(state, (state->index_register + i) & CHIP8_ADDR_MASK, true);
+        }
+        if (heatmap_enabled) {
+            heatmap_write(state->index_register, 3);
+        }
+    }
 }
 
 void chip8_op_coded_conversion(chip8_state_t *state, uint8_t reg_x) {
-    state->memory[state->index_register] = (state->registers[reg_x] / 100) % 10;
-    state->memory[state->index_register + 1] = (state->registers[reg_x] / 10) % 10;
-    state->memory[state->index_register + 2] = state->registers[reg_x] % 10;
-    SDL_Log("FX33: CONVERT V%X", reg_x);
+    chip8_coded_conversion_impl(state, reg_x, true);
 }
 
-void chip8_op_store_memory(chip8_state_t *state, uint8_t reg_x) {
+static inline void chip8_store_memory_impl(chip8_state_t *state, uint8_t reg_x,
+                                           bool advance_index, bool instrumented) {
+    if (instrumented && heatmap_enabled) {
+        heatmap_write(state->index_register, reg_x + 1);
+    }
     for (int i = 0; i <= reg_x; i++) {
-        state->memory[state->index_register + i] = state->registers[i];
+        uint16_t addr = (state->index_register + i) & CHIP8_ADDR_MASK;
+        state->memory[addr] = state->registers[i];
+        if (instrumented) {
+            chip8_watch_check(state, addr, true);
+        }
+    }
+    chip8_invalidate_stored(state, state->index_register, reg_x + 1u);
+    if (advance_index) {
+        state->index_register += reg_x + 1;
     }
-    state->index_register += reg_x + 1;
-    SDL_Log("FX55: STORE V0->V%X", reg_x);
 }
 
-void chip8_op_load_memory(chip8_state_t *state, uint8_t reg_x) {
+static inline void chip8_load_memory_impl(chip8_state_t *state, uint8_t reg_x,
+                                          bool advance_index, bool instrumented) {
+    if (instrumented && heatmap_enabled) {
+        heatmap_read(state->index_register, reg_x + 1);
+    }
     for (int i = 0; i <= reg_x; i++) {
-        state->registers[i] = state->memory[state->index_register + i];
+        state->registers[i] = state->memory[(state->index_register + i) & CHIP8_ADDR_MASK];
+    }
+    if (advance_index) {
+        state->index_register += reg_x + 1;
+    }
+}
+
+void chip8_op_store_memory(chip8_state_t *state, uint8_t reg_x) {
+    chip8_store_memory_impl(state, reg_x, true, true);
+}
+
+void chip8_op_load_memory(chip8_state_t *state, uint8_t reg_x) {
+    chip8_load_memory_impl(state, reg_x, true, true);
+}
+
+// Quirk variants of FX55/FX65 that leave the index register unchanged
+void chip8_op_store_memory_fixed(chip8_state_t *state, uint8_t reg_x) {
+    chip8_store_memory_impl(state, reg_x, false, true);
+}
+
+void chip8_op_load_memory_fixed(chip8_state_t *state, uint8_t reg_x) {
+    chip8_load_memory_impl(state, reg_x, false, true);
+}
+
+void chip8_op_store_flags(chip8_state_t *state, uint8_t reg_x) {
+    for (int i = 0; i <= reg_x && i < 8; i++) {
+        state->rpl_flags[i] = state->registers[i];
+    }
+}
+
+void chip8_op_load_flags(chip8_state_t *state, uint8_t reg_x) {
+    for (int i = 0; i <= reg_x && i < 8; i++) {
+        state->registers[i] = state->rpl_flags[i];
     }
-    state->index_register += reg_x + 1;
-    SDL_Log("FX65: LOAD V0->V%X", reg_x);
 }
 
 /**
- * Chip-8 Emulation
+ * Chip-8 Instruction Dispatch
+ *
+ * Instead of re-decoding every instruction through a nested switch, a
+ * 65536-entry handler table is built once at startup. Execution is then a
+ * single indexed indirect call per instruction. Each handler decodes only
+ * the operands it actually needs. One table is generated per quirk
+ * profile; a state's profile selects its table once, so quirks cost
+ * nothing at dispatch time.
  */
 
-void chip8_execute(chip8_state_t *state, uint16_t instruction) {
-    uint8_t first_nibble = (instruction >> 12) & 0x0F; // Extracts bits 12-15
-    
-    uint8_t reg_x = chip8_decode_x(instruction);
-    uint8_t reg_y = chip8_decode_y(instruction);
+static chip8_handler_t dispatch_tables[CHIP8_PROFILE_COUNT][CHIP8_CORE_COUNT][65536];
+
+static const chip8_quirks_t profile_quirks[CHIP8_PROFILE_COUNT] = {
+    [CHIP8_PROFILE_COSMAC] = {.vf_reset = true,  .shift_uses_y = true,  .index_increment = true,  .display_wait = true},
+    [CHIP8_PROFILE_MODERN] = {.vf_reset = false, .shift_uses_y = false, .index_increment = false, .display_wait = false},
+};
+
+// Cold outright: it only ever runs on a broken ROM, and as a dispatch
+// table entry it can't inline anyway — the annotation just moves its
+// body out of the hot text
+static CHIP8_COLD void chip8_exec_unknown(chip8_state_t *state, uint16_t instruction) {
+    SDL_Log("Unknown or unimplemented instruction: %04X at PC: %03X", instruction, state->program_counter - 2);
+    if (state->fault_cycle == 0) {
+        state->fault_cycle = state->cycle_count;
+    }
+    crashdump_fault(state, "unknown opcode");
+}
+
+static void chip8_exec_cls(chip8_state_t *state, uint16_t instruction) {
+    chip8_op_cls(state);
+}
+
+static void chip8_exec_lores(chip8_state_t *state, uint16_t instruction) {
+    chip8_op_lores(state);
+}
+
+static void chip8_exec_hires(chip8_state_t *state, uint16_t instruction) {
+    chip8_op_hires(state);
+}
+
+static void chip8_exec_scroll_down(chip8_state_t *state, uint16_t instruction) {
+    chip8_op_scroll_down(state, chip8_decode_n(instruction));
+}
+
+static void chip8_exec_scroll_right(chip8_state_t *state, uint16_t instruction) {
+    chip8_op_scroll_right(state);
+}
+
+static void chip8_exec_scroll_left(chip8_state_t *state, uint16_t instruction) {
+    chip8_op_scroll_left(state);
+}
+
+static void chip8_exec_exit(chip8_state_t *state, uint16_t instruction) {
+    chip8_op_exit(state);
+}
+
+static void chip8_exec_plane(chip8_state_t *state, uint16_t instruction) {
+    chip8_op_plane(state, chip8_decode_x(instruction));
+}
+
+static void chip8_exec_pop(chip8_state_t *state, uint16_t instruction) {
+    chip8_op_pop(state);
+}
+
+static void chip8_exec_jmp(chip8_state_t *state, uint16_t instruction) {
+    chip8_op_jmp(state, chip8_decode_nnn(instruction));
+}
+
+static void chip8_exec_push(chip8_state_t *state, uint16_t instruction) {
+    chip8_op_push(state, chip8_decode_nnn(instruction));
+}
+
+static void chip8_exec_skip_equal(chip8_state_t *state, uint16_t instruction) {
+    chip8_op_skip_equal(state, chip8_decode_x(instruction), chip8_decode_nn(instruction));
+}
+
+static void chip8_exec_skip_not_equal(chip8_state_t *state, uint16_t instruction) {
+    chip8_op_skip_not_equal(state, chip8_decode_x(instruction), chip8_decode_nn(instruction));
+}
+
+static void chip8_exec_skip_reg_equal(chip8_state_t *state, uint16_t instruction) {
+    chip8_op_skip_reg_equal(state, chip8_decode_x(instruction), chip8_decode_y(instruction));
+}
+
+static void chip8_exec_set(chip8_state_t *state, uint16_t instruction) {
+    chip8_op_set(state, chip8_decode_x(instruction), chip8_decode_nn(instruction));
+}
+
+static void chip8_exec_add(chip8_state_t *state, uint16_t instruction) {
+    chip8_op_add(state, chip8_decode_x(instruction), chip8_decode_nn(instruction));
+}
+
+static void chip8_exec_set_reg(chip8_state_t *state, uint16_t instruction) {
+    chip8_op_set_reg(state, chip8_decode_x(instruction), chip8_decode_y(instruction));
+}
+
+static void chip8_exec_or(chip8_state_t *state, uint16_t instruction) {
+    chip8_op_or(state, chip8_decode_x(instruction), chip8_decode_y(instruction));
+}
+
+static void chip8_exec_and(chip8_state_t *state, uint16_t instruction) {
+    chip8_op_and(state, chip8_decode_x(instruction), chip8_decode_y(instruction));
+}
+
+static void chip8_exec_xor(chip8_state_t *state, uint16_t instruction) {
+    chip8_op_xor(state, chip8_decode_x(instruction), chip8_decode_y(instruction));
+}
+
+static void chip8_exec_or_noreset(chip8_state_t *state, uint16_t instruction) {
+    chip8_op_or_noreset(state, chip8_decode_x(instruction), chip8_decode_y(instruction));
+}
+
+static void chip8_exec_and_noreset(chip8_state_t *state, uint16_t instruction) {
+    chip8_op_and_noreset(state, chip8_decode_x(instruction), chip8_decode_y(instruction));
+}
+
+static void chip8_exec_xor_noreset(chip8_state_t *state, uint16_t instruction) {
+    chip8_op_xor_noreset(state, chip8_decode_x(instruction), chip8_decode_y(instruction));
+}
+
+static void chip8_exec_add_reg(chip8_state_t *state, uint16_t instruction) {
+    chip8_op_add_reg(state, chip8_decode_x(instruction), chip8_decode_y(instruction));
+}
+
+static void chip8_exec_subtract_xy(chip8_state_t *state, uint16_t instruction) {
+    chip8_op_subtract_xy(state, chip8_decode_x(instruction), chip8_decode_y(instruction));
+}
+
+static void chip8_exec_shr(chip8_state_t *state, uint16_t instruction) {
+    chip8_op_shr(state, chip8_decode_x(instruction), chip8_decode_y(instruction));
+}
+
+static void chip8_exec_shr_inplace(chip8_state_t *state, uint16_t instruction) {
+    chip8_op_shr_inplace(state, chip8_decode_x(instruction), chip8_decode_y(instruction));
+}
+
+static void chip8_exec_subtract_yx(chip8_state_t *state, uint16_t instruction) {
+    chip8_op_subtract_yx(state, chip8_decode_x(instruction), chip8_decode_y(instruction));
+}
+
+static void chip8_exec_shl(chip8_state_t *state, uint16_t instruction) {
+    chip8_op_shl(state, chip8_decode_x(instruction), chip8_decode_y(instruction));
+}
+
+static void chip8_exec_shl_inplace(chip8_state_t *state, uint16_t instruction) {
+    chip8_op_shl_inplace(state, chip8_decode_x(instruction), chip8_decode_y(instruction));
+}
+
+static void chip8_exec_skip_reg_not_equal(chip8_state_t *state, uint16_t instruction) {
+    chip8_op_skip_reg_not_equal(state, chip8_decode_x(instruction), chip8_decode_y(instruction));
+}
+
+static void chip8_exec_set_index(chip8_state_t *state, uint16_t instruction) {
+    chip8_op_set_index(state, chip8_decode_nnn(instruction));
+}
+
+static void chip8_exec_jmp_offset(chip8_state_t *state, uint16_t instruction) {
+    chip8_op_jmp_offset(state, chip8_decode_nnn(instruction));
+}
+
+static void chip8_exec_rand(chip8_state_t *state, uint16_t instruction) {
+    chip8_op_rand(state, chip8_decode_x(instruction), chip8_decode_nn(instruction));
+}
+
+static void chip8_exec_draw(chip8_state_t *state, uint16_t instruction) {
+    chip8_op_draw(state, chip8_decode_x(instruction), chip8_decode_y(instruction), chip8_decode_n(instruction));
+}
+
+// Display-wait variant: draw, then park the instruction stream until the
+// next 60Hz tick releases it. The park is scheduler state; no sleeping
+// happens in the handler.
+static void chip8_exec_draw_wait(chip8_state_t *state, uint16_t instruction) {
+    chip8_op_draw(state, chip8_decode_x(instruction), chip8_decode_y(instruction), chip8_decode_n(instruction));
+    state->waiting_display = true;
+}
+
+static void chip8_exec_skip_key(chip8_state_t *state, uint16_t instruction) {
+    chip8_op_skip_key(state, chip8_decode_x(instruction));
+}
+
+static void chip8_exec_skip_not_key(chip8_state_t *state, uint16_t instruction) {
+    chip8_op_skip_not_key(state, chip8_decode_x(instruction));
+}
+
+static void chip8_exec_get_delay_timer(chip8_state_t *state, uint16_t instruction) {
+    chip8_op_get_delay_timer(state, chip8_decode_x(instruction));
+}
+
+static void chip8_exec_halt_key(chip8_state_t *state, uint16_t instruction) {
+    chip8_op_halt_key(state, chip8_decode_x(instruction));
+}
+
+static void chip8_exec_set_delay_timer(chip8_state_t *state, uint16_t instruction) {
+    chip8_op_set_delay_timer(state, chip8_decode_x(instruction));
+}
+
+static void chip8_exec_set_sound_timer(chip8_state_t *state, uint16_t instruction) {
+    chip8_op_set_sound_timer(state, chip8_decode_x(instruction));
+}
+
+static void chip8_exec_add_index(chip8_state_t *state, uint16_t instruction) {
+    chip8_op_add_index(state, chip8_decode_x(instruction));
+}
+
+static void chip8_exec_font_char(chip8_state_t *state, uint16_t instruction) {
+    chip8_op_font_char(state, chip8_decode_x(instruction));
+}
+
+static void chip8_exec_big_font_char(chip8_state_t *state, uint16_t instruction) {
+    chip8_op_big_font_char(state, chip8_decode_x(instruction));
+}
+
+static void chip8_exec_store_flags(chip8_state_t *state, uint16_t instruction) {
+    chip8_op_store_flags(state, chip8_decode_x(instruction));
+}
+
+static void chip8_exec_load_flags(chip8_state_t *state, uint16_t instruction) {
+    chip8_op_load_flags(state, chip8_decode_x(instruction));
+}
+
+static void chip8_exec_coded_conversion(chip8_state_t *state, uint16_t instruction) {
+    chip8_op_coded_conversion(state, chip8_decode_x(instruction));
+}
+
+static void chip8_exec_store_memory(chip8_state_t *state, uint16_t instruction) {
+    chip8_op_store_memory(state, chip8_decode_x(instruction));
+}
+
+static void chip8_exec_load_memory(chip8_state_t *state, uint16_t instruction) {
+    chip8_op_load_memory(state, chip8_decode_x(instruction));
+}
+
+static void chip8_exec_store_memory_fixed(chip8_state_t *state, uint16_t instruction) {
+    chip8_op_store_memory_fixed(state, chip8_decode_x(instruction));
+}
+
+static void chip8_exec_load_memory_fixed(chip8_state_t *state, uint16_t instruction) {
+    chip8_op_load_memory_fixed(state, chip8_decode_x(instruction));
+}
+
+// Fast-core twins of the handlers that carry instrumentation: the same
+// decode and impl, called with instrumented = false so the hooks (and
+// the watchpoint probes) constant-fold away. Handlers without hooks are
+// shared between the cores.
+static void chip8_exec_draw_fast(chip8_state_t *state, uint16_t instruction) {
+    chip8_draw_impl(state, chip8_decode_x(instruction), chip8_decode_y(instruction),
+                    chip8_decode_n(instruction), false);
+}
+
+static void chip8_exec_draw_wait_fast(chip8_state_t *state, uint16_t instruction) {
+    chip8_draw_impl(state, chip8_decode_x(instruction), chip8_decode_y(instruction),
+                    chip8_decode_n(instruction), false);
+    state->waiting_display = true;
+}
+
+static void chip8_exec_skip_key_fast(chip8_state_t *state, uint16_t instruction) {
+    chip8_skip_key_impl(state, chip8_decode_x(instruction), false);
+}
+
+static void chip8_exec_skip_not_key_fast(chip8_state_t *state, uint16_t instruction) {
+    chip8_skip_not_key_impl(state, chip8_decode_x(instruction), false);
+}
+
+static void chip8_exec_coded_conversion_fast(chip8_state_t *state, uint16_t instruction) {
+    chip8_coded_conversion_impl(state, chip8_decode_x(instruction), false);
+}
+
+static void chip8_exec_store_memory_fast(chip8_state_t *state, uint16_t instruction) {
+    chip8_store_memory_impl(state, chip8_decode_x(instruction), true, false);
+}
+
+static void chip8_exec_load_memory_fast(chip8_state_t *state, uint16_t instruction) {
+    chip8_load_memory_impl(state, chip8_decode_x(instruction), true, false);
+}
+
+static void chip8_exec_store_memory_fixed_fast(chip8_state_t *state, uint16_t instruction) {
+    chip8_store_memory_impl(state, chip8_decode_x(instruction), false, false);
+}
+
+static void chip8_exec_load_memory_fixed_fast(chip8_state_t *state, uint16_t instruction) {
+    chip8_load_memory_impl(state, chip8_decode_x(instruction), false, false);
+}
+
+// Maps an instrumented handler to its fast-core twin while the tables
+// are built; identity for the handlers the cores share
+static chip8_handler_t chip8_fast_variant(chip8_handler_t handler) {
+    if (handler == chip8_exec_draw) return chip8_exec_draw_fast;
+    if (handler == chip8_exec_draw_wait) return chip8_exec_draw_wait_fast;
+    if (handler == chip8_exec_skip_key) return chip8_exec_skip_key_fast;
+    if (handler == chip8_exec_skip_not_key) return chip8_exec_skip_not_key_fast;
+    if (handler == chip8_exec_coded_conversion) return chip8_exec_coded_conversion_fast;
+    if (handler == chip8_exec_store_memory) return chip8_exec_store_memory_fast;
+    if (handler == chip8_exec_load_memory) return chip8_exec_load_memory_fast;
+    if (handler == chip8_exec_store_memory_fixed) return chip8_exec_store_memory_fixed_fast;
+    if (handler == chip8_exec_load_memory_fixed) return chip8_exec_load_memory_fixed_fast;
+    return handler;
+}
+
+// Resolves one instruction word to its handler under a quirk profile. Only
+// used while building the dispatch tables, never on the execution path.
+static chip8_handler_t chip8_resolve_handler(uint16_t instruction, const chip8_quirks_t *quirks) {
+    uint8_t first_nibble = (instruction >> 12) & 0x0F;
     uint8_t value_n = chip8_decode_n(instruction);
     uint8_t value_nn = chip8_decode_nn(instruction);
-    uint16_t value_nnn = chip8_decode_nnn(instruction);
-    
-    switch(first_nibble) {
+
+    switch (first_nibble) {
         case 0x0:
+            if ((value_nn & 0xF0) == 0xC0) {
+                return chip8_exec_scroll_down; // 00CN
+            }
             switch (value_nn) {
-                case 0xE0:
-                    chip8_op_cls(state);
-                    break;
-                case 0xEE:
-                    chip8_op_pop(state);
-                    break;
-                default:
-                    break;
+                case 0xE0: return chip8_exec_cls;
+                case 0xEE: return chip8_exec_pop;
+                case 0xFB: return chip8_exec_scroll_right;
+                case 0xFC: return chip8_exec_scroll_left;
+                case 0xFD: return chip8_exec_exit;
+                case 0xFE: return chip8_exec_lores;
+                case 0xFF: return chip8_exec_hires;
+                default: return chip8_exec_unknown;
             }
-            break;
-        case 0x1:
-            chip8_op_jmp(state, value_nnn);
-            break;
-        case 0x2:
-            chip8_op_push(state, value_nnn);
-            break;
-        case 0x3:
-            chip8_op_skip_equal(state, reg_x, value_nn);
-            break;
-        case 0x4:
-            chip8_op_skip_not_equal(state, reg_x, value_nn);
-            break;
-        case 0x5:
-            chip8_op_skip_reg_equal(state, reg_x, reg_y);
-            break;
-        case 0x6:
-            chip8_op_set(state, reg_x, value_nn);
-            break;
-        case 0x7:
-            chip8_op_add(state, reg_x, value_nn);
-            break;
+        case 0x1: return chip8_exec_jmp;
+        case 0x2: return chip8_exec_push;
+        case 0x3: return chip8_exec_skip_equal;
+        case 0x4: return chip8_exec_skip_not_equal;
+        case 0x5: return value_n == 0x0 ? chip8_exec_skip_reg_equal : chip8_exec_unknown;
+        case 0x6: return chip8_exec_set;
+        case 0x7: return chip8_exec_add;
         case 0x8:
             switch (value_n) {
-                case 0x0:
-                    chip8_op_set_reg(state, reg_x, reg_y);
-                    break;
-                case 0x1:
-                    chip8_op_or(state, reg_x, reg_y);
-                    break;
-                case 0x2:
-                    chip8_op_and(state, reg_x, reg_y);
-                    break;
-                case 0x3:
-                    chip8_op_xor(state, reg_x, reg_y);
-                    break;
-                case 0x4:
-                    chip8_op_add_reg(state, reg_x, reg_y);
-                    break;
-                case 0x5:
-                    chip8_op_subtract_xy(state, reg_x, reg_y);
-                    break;
-                case 0x6:
-                    chip8_op_shr(state, reg_x, reg_y);
-                    break;
-                case 0x7:
-                    chip8_op_subtract_yx(state, reg_x, reg_y);
-                    break;
-                case 0xE:
-                    chip8_op_shl(state, reg_x, reg_y);
-                    break;
-                default:
-                    break;
+                case 0x0: return chip8_exec_set_reg;
+                case 0x1: return quirks->vf_reset ? chip8_exec_or : chip8_exec_or_noreset;
+                case 0x2: return quirks->vf_reset ? chip8_exec_and : chip8_exec_and_noreset;
+                case 0x3: return quirks->vf_reset ? chip8_exec_xor : chip8_exec_xor_noreset;
+                case 0x4: return chip8_exec_add_reg;
+                case 0x5: return chip8_exec_subtract_xy;
+                case 0x6: return quirks->shift_uses_y ? chip8_exec_shr : chip8_exec_shr_inplace;
+                case 0x7: return chip8_exec_subtract_yx;
+                case 0xE: return quirks->shift_uses_y ? chip8_exec_shl : chip8_exec_shl_inplace;
+                default: return chip8_exec_unknown;
             }
-            break;
-        case 0x9:
-            chip8_op_skip_reg_not_equal(state, reg_x, reg_y);
-            break;
-        case 0xA:
-            chip8_op_set_index(state, value_nnn);
-            break;
-        case 0xB:
-            chip8_op_jmp_offset(state, value_nnn);
-            break;
-        case 0xC:
-            chip8_op_rand(state, reg_x, value_nn);
-            break;
-        case 0xD:
-            chip8_op_draw(state, reg_x, reg_y, value_n);
-            break;
+        case 0x9: return value_n == 0x0 ? chip8_exec_skip_reg_not_equal : chip8_exec_unknown;
+        case 0xA: return chip8_exec_set_index;
+        case 0xB: return chip8_exec_jmp_offset;
+        case 0xC: return chip8_exec_rand;
+        case 0xD: return quirks->display_wait ? chip8_exec_draw_wait : chip8_exec_draw;
         case 0xE:
-            switch(value_nn) {
-                case 0x9E:
-                    chip8_op_skip_key(state, reg_x);
-                    break;
-                case 0xA1:
-                    chip8_op_skip_not_key(state, reg_x);
-                    break;
-                default:
-                    break;
+            switch (value_nn) {
+                case 0x9E: return chip8_exec_skip_key;
+                case 0xA1: return chip8_exec_skip_not_key;
+                default: return chip8_exec_unknown;
             }
-            break;
         case 0xF:
             switch (value_nn) {
-                case 0x07:
-                    chip8_op_get_delay_timer(state, reg_x);
-                    break;
-                case 0x0A:
-                    chip8_op_halt_key(state, reg_x);
-                    break;
-                case 0x15:
-                    chip8_op_set_delay_timer(state, reg_x);
-                    break;
-                case 0x18:
-                    chip8_op_set_sound_timer(state, reg_x);
-                    break;
-                case 0x1E:
-                    chip8_op_add_index(state, reg_x);
-                    break;
-                case 0x29:
-                    chip8_op_font_char(state, reg_x);
-                    break;
-                case 0x33:
-                    chip8_op_coded_conversion(state, reg_x);
-                    break;
-                case 0x55:
-                    chip8_op_store_memory(state, reg_x);
-                    break;
-                case 0x65:
-                    chip8_op_load_memory(state, reg_x);
-                    break;
-                default:
-                    break;
+                case 0x01: return chip8_exec_plane;
+                case 0x07: return chip8_exec_get_delay_timer;
+                case 0x0A: return chip8_exec_halt_key;
+                case 0x15: return chip8_exec_set_delay_timer;
+                case 0x18: return chip8_exec_set_sound_timer;
+                case 0x1E: return chip8_exec_add_index;
+                case 0x29: return chip8_exec_font_char;
+                case 0x30: return chip8_exec_big_font_char;
+                case 0x33: return chip8_exec_coded_conversion;
+                case 0x55: return quirks->index_increment ? chip8_exec_store_memory
+                                                          : chip8_exec_store_memory_fixed;
+                case 0x65: return quirks->index_increment ? chip8_exec_load_memory
+                                                          : chip8_exec_load_memory_fixed;
+                case 0x75: return chip8_exec_store_flags;
+                case 0x85: return chip8_exec_load_flags;
+                default: return chip8_exec_unknown;
             }
+        default: return chip8_exec_unknown;
+    }
+}
+
+void chip8_build_dispatch_table(void) {
+    if (dispatch_tables[0][0][0] != NULL) {
+        return; // Already built
+    }
+    for (int profile = 0; profile < CHIP8_PROFILE_COUNT; profile++) {
+        for (uint32_t instruction = 0; instruction < 65536; instruction++) {
+            chip8_handler_t handler =
+                chip8_resolve_handler((uint16_t)instruction, &profile_quirks[profile]);
+            dispatch_tables[profile][CHIP8_CORE_INSTRUMENTED][instruction] = handler;
+            dispatch_tables[profile][CHIP8_CORE_FAST][instruction] =
+                chip8_fast_variant(handler);
+        }
+    }
+
+    // The FX33 digit table rides along: built once, read forever
+    for (int value = 0; value < 256; value++) {
+        bcd_table[value][0] = (uint8_t)(value / 100);
+        bcd_table[value][1] = (uint8_t)(value / 10 % 10);
+        bcd_table[value][2] = (uint8_t)(value % 10);
+    }
+
+    // Glyph address tables, same scheme. Out-of-range values keep the
+    // stride arithmetic they always had (FX29 never masked here), so
+    // ROMs leaning on that quirk still land where they used to.
+    for (int value = 0; value < 256; value++) {
+        font_index[value] = (uint16_t)(value * 5);
+        big_font_index[value] = (uint16_t)(BIG_FONT_ADDRESS + (value % 10) * 10);
+    }
+}
+
+// Selects a quirk profile by swapping the state's dispatch table. Cached
+// decode entries hold handlers from the old table, so the cache is flushed.
+void chip8_set_profile(chip8_state_t *state, chip8_profile_t profile) {
+    state->profile = profile;
+    state->dispatch = dispatch_tables[profile][state->core];
+    for (int i = 0; i < CHIP8_MEMORY_BYTES / 2; i++) {
+        state->decode_cache[i].tag = 0;
+    }
+}
+
+/* Arbitrary quirk corners for the triage tooling. The two shipped
+   profiles cover two of the 16 combinations; differential triage needs
+   the rest. Tables are built lazily per combination and kept for the
+   process lifetime — only tooling asks, so production sessions never
+   carry them. */
+static chip8_handler_t *quirk_tables[CHIP8_QUIRK_COMBOS][CHIP8_CORE_COUNT];
+
+void chip8_set_quirk_mask(chip8_state_t *state, unsigned mask) {
+    mask &= CHIP8_QUIRK_COMBOS - 1;
+    if (quirk_tables[mask][0] == NULL) {
+        const chip8_quirks_t quirks = {
+            .vf_reset = (mask & CHIP8_QUIRK_VF_RESET) != 0,
+            .shift_uses_y = (mask & CHIP8_QUIRK_SHIFT_USES_Y) != 0,
+            .index_increment = (mask & CHIP8_QUIRK_INDEX_INCREMENT) != 0,
+            .display_wait = (mask & CHIP8_QUIRK_DISPLAY_WAIT) != 0,
+        };
+        for (int core = 0; core < CHIP8_CORE_COUNT; core++) {
+            quirk_tables[mask][core] = SDL_malloc(65536 * sizeof(chip8_handler_t));
+            if (quirk_tables[mask][core] == NULL) {
+                SDL_Log("Couldn't build quirk table %X; dispatch unchanged", mask);
+                for (int j = 0; j < core; j++) {
+                    SDL_free(quirk_tables[mask][j]);
+                    quirk_tables[mask][j] = NULL;
+                }
+                return;
+            }
+        }
+        for (uint32_t instruction = 0; instruction < 65536; instruction++) {
+            chip8_handler_t handler =
+                chip8_resolve_handler((uint16_t)instruction, &quirks);
+            quirk_tables[mask][CHIP8_CORE_INSTRUMENTED][instruction] = handler;
+            quirk_tables[mask][CHIP8_CORE_FAST][instruction] =
+                chip8_fast_variant(handler);
+        }
+    }
+    state->dispatch = quirk_tables[mask][state->core];
+    for (int i = 0; i < CHIP8_MEMORY_BYTES / 2; i++) {
+        state->decode_cache[i].tag = 0;
+    }
+}
+
+// Selects the core variant (see chip8_core_t): same mechanism as a
+// profile change — swap the table, flush the cached handlers
+void chip8_set_core(chip8_state_t *state, chip8_core_t core) {
+    state->core = core;
+    state->dispatch = dispatch_tables[state->profile][core];
+    for (int i = 0; i < CHIP8_MEMORY_BYTES / 2; i++) {
+        state->decode_cache[i].tag = 0;
+    }
+}
+
+/* Hot-patches the dispatch to match what the optional layers currently
+   need: with every enable flag off the fast table runs — handler twins
+   with the hook branches constant-folded away, so dormant
+   instrumentation costs literally nothing — and turning any layer on
+   swaps the pointers live, no restart. Call after flipping a flag. */
+void chip8_core_autoselect(chip8_state_t *state) {
+    bool hooks_needed = trace_enabled || profile_enabled || decodestat_enabled ||
+                        debug_active || debug_watch_active ||
+                        heatmap_enabled || latency_enabled;
+    chip8_core_t core = hooks_needed ? CHIP8_CORE_INSTRUMENTED : CHIP8_CORE_FAST;
+    if (core != state->core) {
+        chip8_set_core(state, core);
+    }
+}
+
+// Switches timer derivation between CLOCK_MONOTONIC and the executed-
+// instruction count. Re-baselines so the next tick lands one interval out.
+void chip8_set_virtual_clock(chip8_state_t *state, bool enabled) {
+    state->virtual_clock = enabled;
+    state->next_vblank_cycle = state->cycle_count;
+    chip8_clock_rebase(state);
+}
+
+/**
+ * Chip-8 Emulation
+ */
+
+void chip8_execute(chip8_state_t *state, uint16_t instruction) {
+    if (trace_enabled) {
+        trace_emit(state->program_counter - 2, instruction);
+    }
+    state->dispatch[instruction](state, instruction);
+}
+
+// Bumps the execution counters for one opcode: a top-nibble count plus a
+// sub-count for the grouped 0x8/0xE/0xF opcodes
+static inline void chip8_count_opcode(chip8_state_t *state, uint16_t opcode) {
+    uint8_t group = opcode >> 12;
+    state->cycle_count++;
+    state->opcode_count[group]++;
+
+    if (group == 0x8) {
+        state->opcode_count_8[opcode & 0xF]++;
+    } else if (group == 0xE) {
+        state->opcode_count_e[opcode & 0xFF]++;
+    } else if (group == 0xF) {
+        state->opcode_count_f[opcode & 0xFF]++;
+    }
+}
+
+// Fetches, decodes, and executes the instruction at pc, going through the
+// predecoded cache. A hit skips the memory fetch and dispatch table load;
+// tight loops decode each instruction exactly once. `instrumented` is a
+// compile-time constant, cloning the loop once with every hook and once
+// (for the fast core) with none.
+static inline void chip8_step_impl(chip8_state_t *state, bool instrumented) {
+    if (state->waiting_display) {
+        return; // Parked until chip8_vblank releases us
+    }
+    if (chip8_key_wait_blocked(state)) {
+        return; // Parked until the awaited key is pressed and released
+    }
+
+    uint16_t pc = state->program_counter;
+    if (instrumented && profile_enabled) {
+        profile_sample(pc);
+    }
+    chip8_decoded_t *entry = &state->decode_cache[pc >> 1];
+
+    if (entry->tag != (uint16_t)(pc + 1)) {
+        if (instrumented && decodestat_enabled) {
+            decodestat_miss(pc, entry->tag == 0 ? DECODESTAT_COLD
+                              : entry->tag == CHIP8_TAG_INVALIDATED ? DECODESTAT_INVALIDATED
+                              : DECODESTAT_CROSSED);
+        }
+        // A jump to 0xFFF makes the second fetch byte wrap
+        uint16_t instruction = (state->memory[pc] << 8) | state->memory[(pc + 1) & CHIP8_ADDR_MASK];
+        entry->handler = state->dispatch[instruction];
+        entry->opcode = instruction;
+        entry->tag = pc + 1;
+        entry->fuse = CHIP8_FUSE_NONE; // Singles never carry a pair
+        if (instrumented && debug_active) {
+            debug_patch(state, pc, entry); // Swap in a breakpoint trap
+        }
+    } else if (instrumented && decodestat_enabled) {
+        decodestat_hit();
+    }
+
+    state->program_counter = (pc + 2) & CHIP8_ADDR_MASK;
+    crashdump_record(pc, 1); // Flight recorder: both cores, no flag test
+
+    if (instrumented && trace_enabled) {
+        trace_emit(pc, entry->opcode);
+    }
+    chip8_count_opcode(state, entry->opcode);
+    entry->handler(state, entry->opcode);
+}
+
+void chip8_step(chip8_state_t *state) {
+    if (state->core == CHIP8_CORE_FAST) {
+        chip8_step_impl(state, false);
+    } else {
+        chip8_step_impl(state, true);
+    }
+}
+
+/* Superinstruction handlers for the instruction pairs that dominate hot
+   loops across the corpus: ANNN feeding DXYN (set index, draw) and 6XNN
+   feeding 3XNN (load immediate, compare against immediate). The leading
+   half is inlined here and the trailing half runs through the partner's
+   cached handler — one tail call instead of a second trip around the
+   dispatch loop — so its quirk-profile variant (display wait, clipping)
+   is honored unchanged. On entry pc has already advanced past the leading
+   instruction and points at the partner, whose cache entry is valid
+   because both halves live in the same decoded block. */
+static void chip8_exec_fused_index_draw(chip8_state_t *state, uint16_t instruction) {
+    state->index_register = chip8_decode_nnn(instruction);
+    chip8_decoded_t *pair = &state->decode_cache[state->program_counter >> 1];
+    state->program_counter = (state->program_counter + 2) & CHIP8_ADDR_MASK;
+    chip8_count_opcode(state, pair->opcode);
+    pair->handler(state, pair->opcode);
+}
+
+static void chip8_exec_fused_load_cmp(chip8_state_t *state, uint16_t instruction) {
+    state->registers[chip8_decode_x(instruction)] = chip8_decode_nn(instruction);
+    chip8_decoded_t *pair = &state->decode_cache[state->program_counter >> 1];
+    state->program_counter = (state->program_counter + 2) & CHIP8_ADDR_MASK;
+    chip8_count_opcode(state, pair->opcode);
+    pair->handler(state, pair->opcode);
+}
+
+// Indexed by the fuse field of a pair-head entry
+static const chip8_handler_t chip8_fused_handlers[] = {
+    NULL, chip8_exec_fused_index_draw, chip8_exec_fused_load_cmp,
+};
+
+// True if instruction must terminate a straight-line block: anything that
+// can divert the program counter, plus the opcodes that write program
+// memory (so nothing inside a block can invalidate it while it runs).
+static bool chip8_ends_block(uint16_t instruction) {
+    switch (instruction >> 12) {
+        case 0x0: return (instruction & 0xFF) != 0xE0; // 00EE and unknowns
+        case 0x1: case 0x2: case 0xB: return true; // Jumps and calls
+        case 0x3: case 0x4: case 0x5: case 0x9: case 0xE: return true; // Skips
+        case 0xD: return true; // Draws may park under the display-wait quirk
+        case 0xF: {
+            uint8_t nn = instruction & 0xFF;
+            return nn == 0x0A || nn == 0x33 || nn == 0x55;
+        }
+        default: return false;
+    }
+}
+
+// Predecodes the straight-line block starting at pc. Entries for
+// consecutive instructions are adjacent in the cache; the head entry
+// records the block length.
+static inline void chip8_decode_block(chip8_state_t *state, uint16_t pc,
+                                      bool instrumented) {
+    chip8_decoded_t *head = &state->decode_cache[pc >> 1];
+    uint16_t len = 0;
+
+    while (len < CHIP8_MAX_BLOCK && pc + 1 < CHIP8_MEMORY_BYTES) {
+        chip8_decoded_t *entry = &state->decode_cache[pc >> 1];
+        uint16_t instruction = (state->memory[pc] << 8) | state->memory[pc + 1];
+
+        entry->handler = state->dispatch[instruction];
+        entry->opcode = instruction;
+        entry->tag = pc + 1;
+        entry->block_len = 1; // Mid-block entries stay valid single steps
+        entry->fuse = CHIP8_FUSE_NONE;
+        if (instrumented && debug_active) {
+            debug_patch(state, pc, entry); // Swap in a breakpoint trap
+        }
+        len++;
+
+        if (chip8_ends_block(instruction)) {
             break;
-        default:
-            SDL_Log("Unknown or unimplemented instruction: %04X at PC: %03X", instruction, state->program_counter - 2);
+        }
+        pc += 2;
+    }
+    head->block_len = len;
+
+    /* Peephole fusion over the block tail. Both trailing opcodes (DXYN,
+       3XNN) terminate blocks, so the tail is the only place a fusible
+       pair can sit. Fast core only: the instrumented core keeps one
+       dispatch per instruction so breakpoints, traces, and the profiler
+       see every pc. */
+    if (!instrumented && len >= 2) {
+        uint16_t lead = head[len - 2].opcode;
+        uint16_t trail = head[len - 1].opcode;
+        if ((lead & 0xF000) == 0xA000 && (trail & 0xF000) == 0xD000) {
+            head[len - 2].fuse = CHIP8_FUSE_INDEX_DRAW;
+        } else if ((lead & 0xF000) == 0x6000 && (trail & 0xF000) == 0x3000) {
+            head[len - 2].fuse = CHIP8_FUSE_LOAD_CMP;
+        }
+    }
+}
+
+// Public predecode entry point: fills the cache for the straight-line
+// block at pc without executing anything (the static disassembler seeds
+// the whole code map through this at ROM load)
+void chip8_predecode(chip8_state_t *state, uint16_t pc) {
+    chip8_decode_block(state, pc, state->core != CHIP8_CORE_FAST);
+}
+
+// Executes one basic block per dispatch: a predecoded straight-line run
+// whose only branching/memory-writing instruction is the last one, so the
+// inner loop needs no tag re-checks. Returns instructions executed.
+// Specialized like chip8_step_impl: the fast clone has no hook branches.
+static inline int chip8_run_block_impl(chip8_state_t *state, bool instrumented) {
+    if (state->waiting_display) {
+        return 0; // Parked until chip8_vblank releases us
+    }
+    if (chip8_key_wait_blocked(state)) {
+        return 0; // Parked until the awaited key is pressed and released
+    }
+
+    uint16_t pc = state->program_counter;
+    if (instrumented && profile_enabled) {
+        profile_sample(pc); // Block-head attribution is enough to find loops
+    }
+    chip8_decoded_t *entry = &state->decode_cache[pc >> 1];
+
+    if (entry->tag != (uint16_t)(pc + 1)) {
+        if (instrumented && decodestat_enabled) {
+            decodestat_miss(pc, entry->tag == 0 ? DECODESTAT_COLD
+                              : entry->tag == CHIP8_TAG_INVALIDATED ? DECODESTAT_INVALIDATED
+                              : DECODESTAT_CROSSED);
+        }
+        chip8_decode_block(state, pc, instrumented);
+    } else if (instrumented && decodestat_enabled) {
+        decodestat_hit(); // Block-head attribution, like the profiler
+    }
+
+    int len = entry->block_len;
+    crashdump_record(pc, (uint16_t)len); // Flight recorder: both cores, no flag test
+    for (int i = 0; i < len; i++) {
+        state->program_counter = (state->program_counter + 2) & CHIP8_ADDR_MASK;
+
+        if (instrumented && trace_enabled) {
+            trace_emit(pc + 2 * i, entry[i].opcode);
+        }
+        chip8_count_opcode(state, entry[i].opcode);
+        if (!instrumented) {
+            if (i + 1 < len) {
+                CHIP8_PREFETCH(&entry[i + 1]); // Next record, behind this dispatch
+            }
+            if (entry[i].fuse != CHIP8_FUSE_NONE) {
+                if (entry[i].fuse == CHIP8_FUSE_INDEX_DRAW) {
+                    // The lead ANNN carries the sprite address, so the
+                    // row fetch for the paired DXYN can start now
+                    CHIP8_PREFETCH(&state->memory[entry[i].opcode & 0x0FFF]);
+                }
+                // Superinstruction: one dispatch runs the pair (the handler
+                // counts the partner opcode itself), skip the partner entry
+                chip8_fused_handlers[entry[i].fuse](state, entry[i].opcode);
+                i++;
+                continue;
+            }
+        }
+        entry[i].handler(state, entry[i].opcode);
+    }
+    return len;
+}
+
+int chip8_run_block(chip8_state_t *state) {
+    if (state->core == CHIP8_CORE_FAST) {
+        return chip8_run_block_impl(state, false);
+    }
+    return chip8_run_block_impl(state, true);
+}
+
+// Fused batch entry point: runs ~n instructions as whole decoded blocks
+// (overshooting by at most one block) without returning to the caller in
+// between, so the frontend pays its per-iteration overhead once per batch
+// instead of once per instruction. Stops early when the core parks for
+// display wait (returning what ran) or goes idle in a spin/key wait.
+int chip8_run(chip8_state_t *state, int n) {
+    int executed;
+    chip8_run_budget(state, n, &executed);
+    return executed;
+}
+
+// Budgeted entry point for external schedulers: same fused-block batch as
+// chip8_run, but the exit reason comes back with the executed count, so a
+// host multiplexing many sessions on few threads knows whether to
+// reschedule the session (budget spent) or park it on the event that will
+// unblock it (vblank, key, input). No clock, no sleep: pacing stays the
+// caller's problem by design.
+chip8_run_exit_t chip8_run_budget(chip8_state_t *state, int budget, int *executed) {
+    int ran_total = 0;
+    chip8_run_exit_t reason = CHIP8_RUN_BUDGET;
+
+    while (ran_total < budget) {
+        if (state->idle) {
+            reason = CHIP8_RUN_IDLE;
             break;
+        }
+        int ran = chip8_run_block(state);
+        if (ran == 0) {
+            reason = state->waiting_display ? CHIP8_RUN_DISPLAY : CHIP8_RUN_KEYWAIT;
+            break;
+        }
+        ran_total += ran;
+    }
+
+    *executed = ran_total;
+    return reason;
+}
+
+// Writes the execution counters as JSON for offline analysis (e.g. deciding
+// whether a ROM is draw-bound or ALU-bound)
+bool chip8_counters_write_json(const chip8_state_t *state, const char *filename) {
+    FILE *fptr = fopen(filename, "w");
+    if (fptr == NULL) {
+        SDL_Log("Error opening counters file: %s", filename);
+        return false;
+    }
+
+    fprintf(fptr, "{\n  \"groups\": {");
+    for (int i = 0; i < 16; i++) {
+        fprintf(fptr, "%s\"%X\": %llu", i == 0 ? "" : ", ", i,
+                (unsigned long long)state->opcode_count[i]);
+    }
+    fprintf(fptr, "},\n  \"8xy\": {");
+    for (int i = 0; i < 16; i++) {
+        fprintf(fptr, "%s\"%X\": %llu", i == 0 ? "" : ", ", i,
+                (unsigned long long)state->opcode_count_8[i]);
+    }
+    fprintf(fptr, "},\n  \"exnn\": {");
+    bool first = true;
+    for (int i = 0; i < 256; i++) {
+        if (state->opcode_count_e[i] != 0) {
+            fprintf(fptr, "%s\"%02X\": %llu", first ? "" : ", ", i,
+                    (unsigned long long)state->opcode_count_e[i]);
+            first = false;
+        }
+    }
+    fprintf(fptr, "},\n  \"fxnn\": {");
+    first = true;
+    for (int i = 0; i < 256; i++) {
+        if (state->opcode_count_f[i] != 0) {
+            fprintf(fptr, "%s\"%02X\": %llu", first ? "" : ", ", i,
+                    (unsigned long long)state->opcode_count_f[i]);
+            first = false;
+        }
+    }
+    fprintf(fptr, "}\n}\n");
+
+    fclose(fptr);
+    return true;
+}
+
+// Display export with the lazy clear resolved: rows the deferred clear
+// never wrote come out as the zeros they architecturally are. Safe to
+// call from the emulation thread between instructions.
+void chip8_vram_snapshot(const chip8_state_t *state, void *dst) {
+    uint64_t *out = dst;
+    for (int p = 0; p < 2; p++) {
+        for (int i = 0; i < 64; i++) {
+            *out++ = chip8_vram_word(state, p, i, 0);
+            *out++ = chip8_vram_word(state, p, i, 1);
+        }
     }
 }
 
-void* chip8_timer_tick(void* arg) {
-    chip8_state_t* state = (chip8_state_t*)arg;
+// Fast boot: capture the prepared image once — after init, ROM load, and
+// any predecode — then restart with one struct copy instead of re-zeroing
+// memory and re-reading the ROM file. The copy carries the decode cache,
+// which stays valid because memory comes back byte-identical.
+void chip8_capture_boot(const chip8_state_t *state, chip8_state_t *boot) {
+    memcpy(boot, state, sizeof(*boot));
+}
 
-    struct timespec req;
-    req.tv_sec = 0;
-    req.tv_nsec = TIMER_DECREMENT_INTERVAL * 1e9; // Convert seconds to nanoseconds
+void chip8_boot(chip8_state_t *state, const chip8_state_t *boot) {
+    memcpy(state, boot, sizeof(*state));
+    chip8_mark_all_dirty(state); // The screen on display is stale now
+}
 
-    while (run_timers) {
-        nanosleep(&req, NULL);
+// FNV-1a over the architecturally visible output state (vram, registers,
+// pc). Used by the headless runner, the supervisor, and golden-output tests
+// to compare runs.
+uint64_t chip8_state_hash(const chip8_state_t *state) {
+    uint64_t rows[2][64][2]; // Resolved image, so lazy clears hash as zeros
+    chip8_vram_snapshot(state, rows);
+
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    const uint8_t *sections[3] = {
+        (const uint8_t *)rows,
+        state->registers,
+        (const uint8_t *)&state->program_counter
+    };
+    size_t lengths[3] = {
+        sizeof(rows),
+        sizeof(state->registers),
+        sizeof(state->program_counter)
+    };
+
+    for (int section = 0; section < 3; section++) {
+        for (size_t i = 0; i < lengths[section]; i++) {
+            hash ^= sections[section][i];
+            hash *= 0x100000001b3ULL;
+        }
+    }
+    return hash;
+}
 
-        if (state->delay_timer > 0) {
-            state->delay_timer--;
+// One tick of the 60Hz display clock: decrement the timers and release any
+// display-wait park. Every scheduler (wall-clock or virtual) funnels its
+// 60Hz boundaries through here.
+void chip8_vblank(chip8_state_t *state) {
+    if (state->delay_timer > 0) {
+        state->delay_timer--;
+    }
+    if (state->sound_timer > 0) {
+        state->sound_timer--;
+        if (state->sound_timer == 0 && chip8_sound_hook != NULL) {
+            chip8_sound_hook(false);
         }
-        if (state->sound_timer > 0) {
-            state->sound_timer--;
+    }
+    state->waiting_display = false;
+}
+
+// Applies however many 60Hz ticks have elapsed since the last call. The
+// boundaries come from the clock module (wall-clock or cycle-derived);
+// run from the main loop, so timer reads and writes all happen on one
+// thread: no timer thread, no data race.
+void chip8_update_timers(chip8_state_t* state) {
+    int due = chip8_clock_ticks_due(state);
+    while (due-- > 0) {
+        chip8_vblank(state);
+    }
+}
+
+/* Waits out the rest of a quantum under the selected pacing policy.
+   The hybrid strategy sleeps to a margin before the deadline — one
+   scheduler quantum plus the measured overshoot EWMA, which feeds back
+   so kernels that oversleep push the margin out — then spins the last
+   stretch with pause instructions. Pure sleep and pure spin are the
+   policy's two endpoints. */
+static void chip8_pace_until(chip8_state_t *state, uint64_t deadline_ns) {
+    uint64_t now = telemetry_now_ns();
+
+    if (chip8_pacing != CHIP8_PACING_SPIN) {
+        uint64_t margin = chip8_pacing == CHIP8_PACING_HYBRID
+                        ? 1000000ULL + state->sleep_overshoot_ns : 0;
+        if (now + margin < deadline_ns) {
+            uint64_t wake_ns = deadline_ns - margin;
+            struct timespec wake = {
+                .tv_sec = (time_t)(wake_ns / 1000000000ULL),
+                .tv_nsec = (long)(wake_ns % 1000000000ULL)
+            };
+            clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &wake, NULL);
+            now = telemetry_now_ns();
+            uint64_t overshoot = now > wake_ns ? now - wake_ns : 0;
+            state->sleep_overshoot_ns = (state->sleep_overshoot_ns * 7 + overshoot) / 8;
         }
     }
+
+    if (chip8_pacing != CHIP8_PACING_SLEEP) {
+        while (now < deadline_ns) {
+            SDL_CPUPauseInstruction();
+            now = telemetry_now_ns();
+        }
+    }
+
+    // How far past the deadline we landed: the jitter our kiosk stutter
+    // reports should correlate with
+    telemetry_record(&telemetry_sleep_overshoot,
+                     now > deadline_ns ? now - deadline_ns : 0);
 }
 
-void chip8_tick(chip8_state_t* state) {
-    clock_gettime(CLOCK_MONOTONIC, &start);
+static void chip8_tick_impl(chip8_state_t* state) {
+    chip8_update_timers(state);
+
+    // Idle spin (self-jump or key wait): nothing to compute until the
+    // frontend delivers input, so skip the batch and the pacing sleep and
+    // let the caller block on events instead
+    if (state->idle) {
+        state->deadline_valid = false;
+        return;
+    }
+
+    // Uncapped turbo: run a large slice and return without sleeping, so the
+    // caller's event handling stays responsive
+    uint64_t exec_start = telemetry_now_ns();
 
-    // Fetch instruction
-    uint8_t byte_a = state->memory[state->program_counter];
-    uint8_t byte_b = state->memory[state->program_counter + 1];
-    uint16_t instruction = (byte_a << 8) | byte_b;
-    state->program_counter += 2;
+    if (state->ips == 0) {
+        chip8_run(state, TURBO_SLICE);
+        telemetry_record(&telemetry_tick_exec, telemetry_now_ns() - exec_start);
+        state->deadline_valid = false; // Re-baseline pacing when the cap returns
+        return;
+    }
 
-    // Execute instruction
-    chip8_execute(state, instruction);
+    // First call establishes the deadline baseline
+    if (!state->deadline_valid) {
+        struct timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        state->next_deadline_ns = (uint64_t)now.tv_sec * 1000000000ULL
+                                + (uint64_t)now.tv_nsec;
+        state->deadline_valid = true;
+    }
 
-    clock_gettime(CLOCK_MONOTONIC, &end);
+    // Execute one quantum's worth of instructions in one fused batch. A
+    // display-wait park ends the quantum early: the next 60Hz timer update
+    // is exactly the vblank that releases it. The energy governor may
+    // shrink the batch below the clock budget to hold its duty target.
+    int budget = (int)chip8_clock_budget(state);
+    if (energy_enabled) {
+        budget = energy_budget(budget);
+    }
+    chip8_run(state, budget);
 
-    // Calculate remaining time to sleep
-    double elapsed_time = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
-    double remaining_time = (1.0 / IPS) - elapsed_time;
-    if (remaining_time > 0) {
-        struct timespec req;
-        req.tv_sec = (time_t)remaining_time;
-        req.tv_nsec = (long)((remaining_time - req.tv_sec) * 1e9);
-        nanosleep(&req, NULL); // Sleep for the remaining time
+    uint64_t exec_ns = telemetry_now_ns() - exec_start;
+    telemetry_record(&telemetry_tick_exec, exec_ns);
+    if (energy_enabled) {
+        energy_account(state, exec_ns);
     }
+
+    // Advance the absolute deadline by one quantum. Pacing to an absolute
+    // time carries drift over: if we woke late, the next quantum is shorter.
+    state->next_deadline_ns += CHIP8_CLOCK_QUANTUM_NS;
+    chip8_pace_until(state, state->next_deadline_ns);
+}
+
+// Heap tripwire brackets around the whole quantum: any allocation between
+// the markers is a regression — counted in release builds, fatal with a
+// backtrace under CHIP8_ALLOC_TRIPWIRE (see alloctrap.h)
+void chip8_tick(chip8_state_t *state) {
+    alloctrap_enter();
+    chip8_tick_impl(state);
+    alloctrap_leave();
 }
\ No newline at end of file
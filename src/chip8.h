@@ -0,0 +1,349 @@
+#ifndef CHIP8_H
+#define CHIP8_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+/**
+ * Chip-8 Core
+ *
+ * Self-contained interpreter state plus the public API. The state struct is
+ * exposed so frontends and tools can inspect registers, vram, and the
+ * keypad directly; everything below the "derived state" marker is rebuilt
+ * on demand and must not be serialized.
+ */
+
+#define CHIP8_DEFAULT_IPS 700
+#define QUANTUM_HZ 60 // Scheduler wakeups per second
+
+/* Memory size as a compile-time parameter: 4K classic by default, 64K
+   for XO-CHIP extended-memory builds (-DCHIP8_MEMORY_BYTES=65536). A
+   power of two, so every address wrap stays one AND with a constant the
+   compiler folds into the handler — sizing at runtime would put a field
+   load and a variable mask on the fast core's hottest path for the 4K
+   ROMs that dominate the corpus. Everything indexed by address (decode
+   cache, watch map, code map, savestate image) derives from it. */
+#ifndef CHIP8_MEMORY_BYTES
+#define CHIP8_MEMORY_BYTES 4096
+#endif
+#define CHIP8_ADDR_MASK (CHIP8_MEMORY_BYTES - 1)
+
+typedef struct chip8_state chip8_state_t;
+
+typedef void (*chip8_handler_t)(chip8_state_t *state, uint16_t instruction);
+
+// One predecoded instruction. tag is the pc of the cached instruction plus
+// one (so zero always means invalid). block_len is the number of
+// instructions in the straight-line block starting here (1 for entries
+// decoded mid-block). fuse marks this instruction as the head of a fused
+// pair (see the superinstruction ids below); handler always stays the
+// plain single-instruction handler so the entry remains a valid single
+// step regardless.
+typedef struct chip8_decoded {
+    chip8_handler_t handler;
+    uint16_t opcode;
+    uint16_t tag;
+    uint16_t block_len;
+    uint8_t fuse;
+} chip8_decoded_t;
+
+// Superinstruction ids for the instruction pairs the block translator
+// fuses into one dispatch (fast core only): ANNN feeding DXYN and 6XNN
+// feeding 3XNN, the pairs that dominate hot loops across the ROM corpus
+#define CHIP8_FUSE_NONE 0
+#define CHIP8_FUSE_INDEX_DRAW 1
+#define CHIP8_FUSE_LOAD_CMP 2
+
+#define CHIP8_MAX_BLOCK 16 // Longest straight-line block we predecode
+
+// Tag for an entry killed by a program-memory write, distinct from 0
+// (never decoded) so the cache statistics can tell the two apart. Valid
+// tags are pc + 1, at most 0x1000 on a 4K build, so neither sentinel
+// ever matches. A 64K build's topmost entry collides with this value
+// and permanently misses — a conservative redecode, never a wrong one.
+#define CHIP8_TAG_INVALIDATED 0xFFFF
+
+#define CHIP8_SPRITE_CACHE 64 // Direct-mapped sprite pattern cache entries
+
+// One cached sprite image: the rows a previous DXYN fetched from memory,
+// each stored left-aligned at bit 63 so a redraw is one shift plus XOR
+// with no per-row memory loads. Keyed by (addr, rows, width); bytes is
+// the memory span the image covers, for write invalidation.
+typedef struct chip8_sprite {
+    uint16_t addr;
+    uint8_t rows;
+    uint8_t width;
+    uint8_t bytes;
+    bool valid;
+    uint64_t bits[16];
+} chip8_sprite_t;
+
+// A quirk profile fixes the contested opcode semantics. One full dispatch
+// table is generated per profile at startup, so selecting a profile swaps
+// a table pointer instead of adding branches to the hot path.
+typedef struct chip8_quirks {
+    bool vf_reset;        // 8XY1/2/3 clear VF (COSMAC)
+    bool shift_uses_y;    // 8XY6/8XYE shift VY into VX (COSMAC) vs. VX in place
+    bool index_increment; // FX55/FX65 advance I past the block (COSMAC)
+    bool display_wait;    // DXYN parks execution until the next 60Hz tick (COSMAC)
+} chip8_quirks_t;
+
+// A dirty display region in pixels (display coordinates of the active mode)
+typedef struct chip8_rect {
+    uint8_t x;
+    uint8_t y;
+    uint8_t w;
+    uint8_t h;
+} chip8_rect_t;
+
+#define CHIP8_DIRTY_RECTS 16
+#define CHIP8_DIRTY_FULL 0xFF // dirty_count sentinel: redraw the whole frame
+
+// Pacing policy: how chip8_tick waits out the remainder of a quantum.
+// Site policy trades CPU for timing precision — kiosks spin for exact
+// 60Hz cadence, servers sleep and absorb the scheduler's overshoot.
+typedef enum chip8_pacing {
+    CHIP8_PACING_HYBRID, // Sleep to a fed-back margin, spin the rest (default)
+    CHIP8_PACING_SLEEP,  // Pure absolute nanosleep; cheapest, least precise
+    CHIP8_PACING_SPIN,   // Busy-wait with pause instructions; exact, one core
+} chip8_pacing_t;
+
+extern chip8_pacing_t chip8_pacing;
+
+typedef enum chip8_profile {
+    CHIP8_PROFILE_COSMAC, // Original COSMAC VIP semantics (default)
+    CHIP8_PROFILE_MODERN, // SCHIP-descended semantics most modern ROMs assume
+    CHIP8_PROFILE_COUNT
+} chip8_profile_t;
+
+// Interpreter core variant, orthogonal to the quirk profile. Both are
+// compile-time specializations of the same handler source: the fast
+// core's handlers and run loop contain no instrumentation branches at
+// all (trace, latency, heatmap, decode stats, watchpoints, and
+// breakpoint traps are compiled out), so sweep rigs pay nothing for
+// hooks they never use. Selected like a profile — a dispatch table swap
+// plus a decode cache flush, never an if-check per handler.
+typedef enum chip8_core {
+    CHIP8_CORE_INSTRUMENTED, // Every hook live behind its enable flag (default)
+    CHIP8_CORE_FAST,         // Zero instrumentation; debugging tools are inert
+    CHIP8_CORE_COUNT
+} chip8_core_t;
+
+struct chip8_state {
+    // Hot-first layout: the fields nearly every instruction touches are
+    // grouped at offset 0 so they share one cache line, instead of sitting
+    // on the far side of the 4KB memory array. Matters at turbo speeds and
+    // in the multi-instance modes where states compete for L2.
+    uint16_t program_counter;
+    uint16_t index_register;
+    uint8_t stack_ptr;
+    uint8_t delay_timer;
+    uint8_t sound_timer;
+    uint8_t registers[16];
+    // Keypad as one atomic bitmask, bit k set while key k is down. The
+    // frontend thread writes it while the emulation thread's key tests
+    // read it; a relaxed 16-bit load per test is both correct under
+    // threading and smaller than the old byte array.
+    _Atomic uint16_t keypad;
+    uint16_t stack[16];
+
+    uint8_t memory[CHIP8_MEMORY_BYTES];
+    // Two XO-CHIP display planes of two packed 64-bit words per row, bit 63
+    // of word 0 = leftmost pixel. Classic and SCHIP ROMs only touch plane
+    // 0; lo-res (64x32) uses word 0 of the top 32 rows, hi-res (SCHIP
+    // 128x64) uses everything.
+    uint64_t vram[2][64][2];
+    // Lazy clear: cls bumps the plane generation instead of zeroing rows.
+    // A row whose stamp lags its plane's generation reads as zero (see
+    // chip8_vram_word) and is materialized on first write, so clear-heavy
+    // ROMs never touch rows they're about to redraw anyway. A uint32
+    // would take over two years of 60Hz clears to wrap.
+    uint32_t plane_generation[2];
+    uint32_t row_generation[2][64];
+    bool hires; // SCHIP 128x64 mode (00FF); 00FE returns to 64x32
+    uint8_t plane_mask; // XO-CHIP plane select (FN01); 1 = classic plane 0
+    bool vram_dirty; // Set when a draw/clear changed vram, cleared by the frontend
+    uint32_t rng_state; // Per-state xorshift32 state, never zero
+    uint32_t ips; // Instructions-per-second target; 0 = uncapped turbo
+    uint8_t rpl_flags[8]; // SCHIP RPL user flags (FX75/FX85)
+    // Dirty regions since the frontend last consumed vram: draws append
+    // their sprite rect, anything larger (clear, scroll, mode switch)
+    // overflows to the whole-frame sentinel
+    chip8_rect_t dirty_rects[CHIP8_DIRTY_RECTS];
+    uint8_t dirty_count; // CHIP8_DIRTY_FULL = redraw everything
+
+    bool idle; // Execution is spinning (self-jump or FX0A key wait); the
+               // frontend may block on events instead of dispatching
+    bool waiting_display; // Parked after a draw until the next 60Hz tick
+                          // (display-wait quirk); cleared by chip8_vblank
+    bool waiting_key; // Parked on FX0A until a key is pressed and released;
+                      // pc stays on the instruction so savestates resume it
+    uint8_t wait_key_reg; // VX destination for the awaited key
+    uint8_t wait_key_latched; // Key seen down, completing on release; 0xFF = none
+
+    // Derived state (rebuilt on demand, never serialized): the quirk
+    // profile's dispatch table and the predecoded instruction cache
+    // indexed by pc >> 1
+    const chip8_handler_t *dispatch;
+    chip8_profile_t profile; // Table row the dispatch pointer came from
+    chip8_core_t core;       // Table column (instrumented or fast)
+    chip8_decoded_t decode_cache[CHIP8_MEMORY_BYTES / 2];
+    // Sprite pattern cache, invalidated alongside the decode cache when
+    // the covered memory range is written
+    chip8_sprite_t sprite_cache[CHIP8_SPRITE_CACHE];
+
+    // Wall-clock pacing state, per instance so multiple cores can run in
+    // one process without sharing (or false-sharing) timing globals
+    uint64_t next_deadline_ns; // Absolute quantum deadline (CLOCK_MONOTONIC)
+    bool deadline_valid; // False forces a re-baseline on the next tick
+    uint64_t sleep_overshoot_ns; // EWMA of nanosleep overshoot, fed back
+                                 // into the hybrid policy's sleep margin
+    uint64_t timer_base_ns; // 60Hz decrement baseline (monotonic ns); 0 = unset
+    uint64_t timer_ticks; // Boundaries applied since the baseline (see clock.c)
+
+    // Virtual clock: timers derive from the executed-instruction count
+    // (ips/60 instructions per 60Hz tick) instead of CLOCK_MONOTONIC, so
+    // runs are bit-deterministic regardless of host load
+    bool virtual_clock;
+    uint64_t next_vblank_cycle; // cycle_count of the next virtual 60Hz tick
+
+    uint64_t cycle_count; // Total instructions executed since init
+    uint64_t rom_hash; // Content hash of the loaded ROM (ROM config key)
+    // cycle_count when this state first faulted (stack underflow/overflow,
+    // unknown opcode); 0 = clean. Per-state where the crash dump is
+    // process-wide, so the parallel bisection probes (bisect.h) each see
+    // their own segment's verdict. Never serialized.
+    uint64_t fault_cycle;
+
+    // Execution counters: per top nibble, with sub-counters keyed by the
+    // distinguishing field for the 0x8 (low nibble) and 0xE/0xF (low byte)
+    // groups
+    uint64_t opcode_count[16];
+    uint64_t opcode_count_8[16];
+    uint64_t opcode_count_e[256];
+    uint64_t opcode_count_f[256];
+};
+
+// The hot block above must stay within the first cache line; reordering
+// that pushes it past 64 bytes is a regression, not a style choice
+_Static_assert(offsetof(struct chip8_state, stack)
+               + sizeof(((struct chip8_state *)0)->stack) <= 64,
+               "hot chip8_state fields must fit in the first cache line");
+
+// Keypad accessors: relaxed atomics are enough — each side only needs to
+// eventually see the other's whole-key updates, never a partial one
+static inline bool chip8_key_down(chip8_state_t *state, uint8_t key) {
+    return (atomic_load_explicit(&state->keypad, memory_order_relaxed) >> (key & 0xF)) & 1;
+}
+
+static inline void chip8_key_set(chip8_state_t *state, uint8_t key, bool down) {
+    if (down) {
+        atomic_fetch_or_explicit(&state->keypad, (uint16_t)(1u << (key & 0xF)),
+                                 memory_order_relaxed);
+    } else {
+        atomic_fetch_and_explicit(&state->keypad, (uint16_t)~(1u << (key & 0xF)),
+                                  memory_order_relaxed);
+    }
+}
+
+// Reads one packed vram word with the lazy clear applied: a row whose
+// generation stamp is stale is architecturally zero even though its bits
+// haven't been written yet. All readers outside the draw path go through
+// this (or chip8_vram_snapshot, which applies it wholesale).
+static inline uint64_t chip8_vram_word(const chip8_state_t *state, int plane,
+                                       int row, int word) {
+    return state->row_generation[plane][row] == state->plane_generation[plane]
+         ? state->vram[plane][row][word] : 0;
+}
+
+// Buzzer edge hook: when set, called at the exact instruction where
+// sound_timer transitions between zero and nonzero (true = tone on), so
+// frontends can timestamp edges for sample-accurate audio scheduling
+extern void (*chip8_sound_hook)(bool on);
+
+// Lifecycle
+void chip8_init(chip8_state_t *state);
+uint64_t chip8_state_hash(const chip8_state_t *state);
+void chip8_seed(chip8_state_t *state, uint32_t seed);
+void chip8_set_profile(chip8_state_t *state, chip8_profile_t profile);
+void chip8_set_core(chip8_state_t *state, chip8_core_t core);
+
+// Quirk-bit mask for the triage tooling: an arbitrary corner of the
+// quirk space, not just the two shipped profiles (COSMAC is all four
+// bits set, MODERN is none)
+#define CHIP8_QUIRK_VF_RESET        0x1
+#define CHIP8_QUIRK_SHIFT_USES_Y    0x2
+#define CHIP8_QUIRK_INDEX_INCREMENT 0x4
+#define CHIP8_QUIRK_DISPLAY_WAIT    0x8
+#define CHIP8_QUIRK_COMBOS          16
+
+// Points the state at a dispatch table for the given quirk combination,
+// building the table on first use. Not thread-safe while building: set
+// up every state before spawning workers.
+void chip8_set_quirk_mask(chip8_state_t *state, unsigned mask);
+
+// Glyph image sizes for chip8_set_font: 16 5-byte low-res characters
+// and 10 10-byte SCHIP hi-res digits
+#define CHIP8_FONT_BYTES 80
+#define CHIP8_BIG_FONT_BYTES 100
+
+// Installs venue fonts into the boot template (every later init carries
+// them) and, when state is non-NULL, patches that state in place. Either
+// set may be NULL to keep the stock glyphs. The fonts live at their
+// usual addresses, so FX29/FX30 and the sprite cache are unaffected.
+void chip8_set_font(chip8_state_t *state, const uint8_t *glyphs,
+                    const uint8_t *big_glyphs);
+
+// Picks the core from the instrumentation layers' enable flags: fast
+// when every layer is off, instrumented when any needs its hooks
+void chip8_core_autoselect(chip8_state_t *state);
+void chip8_set_virtual_clock(chip8_state_t *state, bool enabled);
+bool chip8_load_rom(chip8_state_t *state, char const *filename);
+bool chip8_load_rom_memory(chip8_state_t *state, const uint8_t *data, size_t size);
+
+// Execution
+void chip8_execute(chip8_state_t *state, uint16_t instruction);
+void chip8_step(chip8_state_t *state);
+void chip8_predecode(chip8_state_t *state, uint16_t pc);
+int chip8_run_block(chip8_state_t *state);
+int chip8_run(chip8_state_t *state, int n);
+
+// Why chip8_run_budget returned: the session either spent its grant and
+// should be rescheduled, or parked on an event the host can wait for
+typedef enum chip8_run_exit {
+    CHIP8_RUN_BUDGET,  // Budget exhausted; the session is still runnable
+    CHIP8_RUN_DISPLAY, // Parked until chip8_vblank (display-wait quirk)
+    CHIP8_RUN_KEYWAIT, // Parked on FX0A until a key is pressed and released
+    CHIP8_RUN_IDLE     // Spinning on a self-jump; wake on input
+} chip8_run_exit_t;
+
+// Runs up to `budget` instructions (overshooting by at most one block) and
+// reports the executed count and the exit reason. Does no pacing of its
+// own — the entry point for hosts that own the schedule (see chip8_tick
+// for the self-pacing path).
+chip8_run_exit_t chip8_run_budget(chip8_state_t *state, int budget, int *executed);
+
+void chip8_tick(chip8_state_t *state);
+void chip8_update_timers(chip8_state_t *state);
+void chip8_vblank(chip8_state_t *state);
+
+// Reporting
+bool chip8_counters_write_json(const chip8_state_t *state, const char *filename);
+
+// Fast boot: chip8_capture_boot snapshots the prepared post-load image
+// (including the decode cache); chip8_boot restarts from it with one
+// struct copy — no memory re-zeroing, no ROM file I/O
+void chip8_capture_boot(const chip8_state_t *state, chip8_state_t *boot);
+void chip8_boot(chip8_state_t *state, const chip8_state_t *boot);
+
+// Copies the packed vram planes (2048 bytes, both bit planes) into the
+// caller's buffer; dst must hold sizeof(state->vram)
+void chip8_vram_snapshot(const chip8_state_t *state, void *dst);
+
+// Marks the whole display dirty (state restores, palette changes — anything
+// that invalidates what the frontend has on screen)
+void chip8_mark_all_dirty(chip8_state_t *state);
+
+#endif // CHIP8_H
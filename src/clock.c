@@ -0,0 +1,69 @@
+#include <stdint.h>
+
+#include "clock.h"
+#include "telemetry.h"
+
+uint32_t chip8_clock_budget(const chip8_state_t *state) {
+    uint32_t ips = state->ips != 0 ? state->ips : CHIP8_DEFAULT_IPS;
+    uint32_t budget = ips / QUANTUM_HZ;
+    return budget != 0 ? budget : 1; // Sub-60 ips still makes progress
+}
+
+// Boundary k of the wall-clock schedule: whole seconds are exact, the
+// fractional boundary truncates within its second and resets at the
+// next, so the error stays under one quantum's rounding and never drifts
+static uint64_t clock_boundary_ns(uint64_t base_ns, uint64_t ticks) {
+    return base_ns + ticks / QUANTUM_HZ * 1000000000ULL
+                   + ticks % QUANTUM_HZ * CHIP8_CLOCK_QUANTUM_NS;
+}
+
+int chip8_clock_ticks_due(chip8_state_t *state) {
+    int due = 0;
+
+    if (state->virtual_clock) {
+        // Boundaries derive from the executed-instruction count alone, so
+        // two runs of the same ROM and inputs cross them at identical
+        // cycle counts regardless of host load. A display-wait park counts
+        // as reaching the frame boundary — the draw burned its slice.
+        uint64_t per_tick = chip8_clock_budget(state);
+        if (state->waiting_display && state->cycle_count < state->next_vblank_cycle) {
+            state->next_vblank_cycle = state->cycle_count;
+        }
+        while (state->cycle_count >= state->next_vblank_cycle) {
+            state->next_vblank_cycle += per_tick;
+            due++;
+        }
+        return due;
+    }
+
+    uint64_t now = telemetry_now_ns();
+    if (state->timer_base_ns == 0) {
+        state->timer_base_ns = now; // First call establishes the baseline
+        state->timer_ticks = 0;
+        return 0;
+    }
+    while (now >= clock_boundary_ns(state->timer_base_ns, state->timer_ticks + 1)) {
+        state->timer_ticks++;
+        due++;
+    }
+
+    if (due > CHIP8_CLOCK_STALL_TICKS) {
+        // Host stall: fast-running the backlog would decrement delay
+        // timers and fire buzzer edges at hundreds of Hz for frames the
+        // player never saw. Pay a bounded catch-up, drop the rest, and
+        // re-anchor so pacing resumes in phase at now.
+        telemetry_clock_stalls.value++;
+        telemetry_counter_max(&telemetry_clock_stall_us,
+                              (uint64_t)due * CHIP8_CLOCK_QUANTUM_NS / 1000);
+        state->timer_base_ns = now;
+        state->timer_ticks = 0;
+        state->deadline_valid = false; // The pacing deadline is equally stale
+        due = CHIP8_CLOCK_CATCHUP_MAX;
+    }
+    return due;
+}
+
+void chip8_clock_rebase(chip8_state_t *state) {
+    state->timer_base_ns = 0;
+    state->timer_ticks = 0;
+}
@@ -0,0 +1,43 @@
+#ifndef CLOCK_H
+#define CLOCK_H
+
+#include <stdint.h>
+
+#include "chip8.h"
+
+/**
+ * Unified Virtual Clock
+ *
+ * One owner for the mapping from real time (or executed cycles under
+ * --virtual-clock) to the emulated 60Hz grid. The per-quantum
+ * instruction budget, the timer decrements, the display-wait release,
+ * and the buzzer edges (which fire from the decrements) all derive from
+ * the boundaries this module hands out. Arithmetic is integer
+ * nanoseconds against a fixed baseline — no double seconds, so there is
+ * no accumulated rounding for a second clock to disagree with.
+ */
+
+#define CHIP8_CLOCK_QUANTUM_NS (1000000000ULL / QUANTUM_HZ)
+
+/* Stall policy: a gap of more than STALL_TICKS boundaries (half a second
+   — SIGSTOP, VM migration, compositor freeze) is not a scheduling wobble
+   the ROM should repay. Catch-up is capped at CATCHUP_MAX ticks so short
+   hiccups stay smooth, the rest of the backlog is dropped, and the
+   schedule re-anchors at now; the stall lands in telemetry. */
+#define CHIP8_CLOCK_STALL_TICKS 30
+#define CHIP8_CLOCK_CATCHUP_MAX 3
+
+// Instructions per 60Hz quantum for the state's configured speed (the
+// default when uncapped), never zero
+uint32_t chip8_clock_budget(const chip8_state_t *state);
+
+// 60Hz boundaries crossed since the last call, advancing the stored
+// schedule. The first wall-clock call establishes the baseline and
+// returns 0; under --virtual-clock boundaries come from cycle_count.
+int chip8_clock_ticks_due(chip8_state_t *state);
+
+// Forgets the wall-clock baseline so the next call re-anchors (pausing,
+// frame stepping — anywhere real time passed that the ROM didn't see)
+void chip8_clock_rebase(chip8_state_t *state);
+
+#endif // CLOCK_H
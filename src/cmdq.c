@@ -0,0 +1,61 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <SDL3/SDL.h>
+
+#include "cmdq.h"
+
+/* Classic SPSC ring: the producer owns head, the consumer owns tail,
+   each published with release ordering after the slot is written. Seqs
+   (tickets) are the running push count, so completion is one atomic the
+   producer compares its ticket against — no per-command flags. */
+static cmdq_cmd_t ring[CMDQ_CAPACITY];
+static SDL_AtomicInt cmdq_head;
+static SDL_AtomicInt cmdq_tail;
+static SDL_AtomicInt cmdq_completed; // Ticket of the last acked command
+static uint32_t popped; // Consumer-private: ticket of the last pop
+
+uint32_t cmdq_push(int op, int64_t arg) {
+    int head = SDL_GetAtomicInt(&cmdq_head);
+    int tail = SDL_GetAtomicInt(&cmdq_tail);
+    if (head - tail >= CMDQ_CAPACITY) {
+        SDL_Log("Command queue full; dropping op %d", op);
+        return 0;
+    }
+    ring[head % CMDQ_CAPACITY].op = op;
+    ring[head % CMDQ_CAPACITY].arg = arg;
+    SDL_SetAtomicInt(&cmdq_head, head + 1); // Publishes the slot
+    return (uint32_t)(head + 1); // Tickets start at 1 so 0 means dropped
+}
+
+bool cmdq_pop(cmdq_cmd_t *cmd) {
+    int tail = SDL_GetAtomicInt(&cmdq_tail);
+    if (tail == SDL_GetAtomicInt(&cmdq_head)) {
+        return false;
+    }
+    *cmd = ring[tail % CMDQ_CAPACITY];
+    SDL_SetAtomicInt(&cmdq_tail, tail + 1);
+    popped = (uint32_t)(tail + 1);
+    return true;
+}
+
+void cmdq_ack(void) {
+    SDL_SetAtomicInt(&cmdq_completed, (int)popped);
+}
+
+bool cmdq_done(uint32_t ticket) {
+    return (uint32_t)SDL_GetAtomicInt(&cmdq_completed) >= ticket;
+}
+
+bool cmdq_sync(uint32_t ticket, uint32_t timeout_ms) {
+    if (ticket == 0) {
+        return false; // The push was dropped; nothing will complete it
+    }
+    uint64_t deadline = SDL_GetTicks() + timeout_ms;
+    while (!cmdq_done(ticket)) {
+        if (SDL_GetTicks() >= deadline) {
+            return false;
+        }
+        SDL_Delay(1); // Drains happen every quantum; 1ms polls are plenty
+    }
+    return true;
+}
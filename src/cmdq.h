@@ -0,0 +1,47 @@
+#ifndef CMDQ_H
+#define CMDQ_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * Frontend Command Queue
+ *
+ * Single-producer single-consumer ring between the UI side and the
+ * emulation loop. UI actions (reset, pause, speed changes) are pushed as
+ * small command records and drained at quantum boundaries, so interacting
+ * with the emulator never takes a lock on chip8_state_t — the tick loop
+ * can't stall at exactly the moments users press keys. Each push returns
+ * a ticket; the consumer acknowledges after executing, and cmdq_sync
+ * lets a producer on another thread block until its action has landed,
+ * for synchronous-feeling UI without shared-state mutexing. The command
+ * vocabulary belongs to the frontend; this module only moves records.
+ */
+
+typedef struct cmdq_cmd {
+    int op;
+    int64_t arg;
+} cmdq_cmd_t;
+
+// Ring capacity; a full queue drops the push (UI actions are retryable
+// by their nature — the user sees nothing happened)
+#define CMDQ_CAPACITY 64
+
+// Producer side: queues a command and returns its ticket, or 0 when the
+// ring is full (the action is dropped and logged)
+uint32_t cmdq_push(int op, int64_t arg);
+
+// Consumer side: pops the oldest pending command; false when empty
+bool cmdq_pop(cmdq_cmd_t *cmd);
+
+// Consumer side: publishes completion of the last popped command
+void cmdq_ack(void);
+
+// Producer side: true once the ticket's command has been executed
+bool cmdq_done(uint32_t ticket);
+
+// Producer side: blocks (short sleeps) until the ticket completes or the
+// timeout expires; false on timeout. Never call from the consumer thread.
+bool cmdq_sync(uint32_t ticket, uint32_t timeout_ms);
+
+#endif // CMDQ_H
@@ -0,0 +1,137 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <SDL3/SDL.h>
+
+#include "chip8.h"
+#include "disasm.h"
+#include "crashdump.h"
+
+/**
+ * Fault Flight Recorder
+ *
+ * The ring lives here; recording is the inline in crashdump.h. A fault
+ * copies everything the report needs into a private snapshot while still
+ * on the emulation thread — the interpreter keeps running the instant the
+ * memcpy is done — and a one-shot writer thread formats and writes the
+ * file. Formatting and file I/O never touch the hot path.
+ */
+
+#define CRASHDUMP_FILE "chip8_crash.txt"
+#define CRASHDUMP_DISASM_BEFORE 8 // Instructions shown either side of the fault
+#define CRASHDUMP_DISASM_AFTER 8
+
+crashdump_block_t crashdump_ring[CRASHDUMP_RING_SIZE];
+uint32_t crashdump_head;
+
+// Everything the writer thread reads; filled on the emulation thread
+// before the thread exists, so no locking is needed
+typedef struct crashdump_snapshot {
+    const char *reason;
+    uint16_t program_counter;
+    uint16_t index_register;
+    uint8_t stack_ptr;
+    uint8_t delay_timer;
+    uint8_t sound_timer;
+    uint8_t registers[16];
+    uint16_t stack[16];
+    uint64_t cycle_count;
+    uint8_t memory[CHIP8_MEMORY_BYTES];
+    crashdump_block_t ring[CRASHDUMP_RING_SIZE];
+    uint32_t ring_head;
+} crashdump_snapshot_t;
+
+static crashdump_snapshot_t snapshot;
+static atomic_bool crashdump_taken = false;
+static pthread_t crashdump_thread;
+
+static void *crashdump_write(void *arg) {
+    FILE *file = fopen(CRASHDUMP_FILE, "w");
+    if (file == NULL) {
+        SDL_Log("Couldn't open crash dump file: %s", CRASHDUMP_FILE);
+        return NULL;
+    }
+
+    fprintf(file, "fault: %s\n", snapshot.reason);
+    fprintf(file, "cycle: %llu\n", (unsigned long long)snapshot.cycle_count);
+    fprintf(file, "pc=%03X i=%03X sp=%u dt=%u st=%u\n\n",
+            snapshot.program_counter, snapshot.index_register,
+            snapshot.stack_ptr, snapshot.delay_timer, snapshot.sound_timer);
+
+    for (int i = 0; i < 16; i++) {
+        fprintf(file, "v%X=%02X%s", i, snapshot.registers[i],
+                (i & 7) == 7 ? "\n" : " ");
+    }
+    fprintf(file, "\nstack (sp=%u):\n", snapshot.stack_ptr);
+    for (int i = 0; i < 16; i++) {
+        fprintf(file, "  [%2d] %03X%s\n", i, snapshot.stack[i],
+                i == snapshot.stack_ptr - 1 ? "  <- top" : "");
+    }
+
+    // Recent control flow, oldest first: one line per dispatched block
+    uint32_t head = snapshot.ring_head;
+    uint32_t first = head > CRASHDUMP_RING_SIZE ? head - CRASHDUMP_RING_SIZE : 0;
+    fprintf(file, "\nlast %u blocks:\n", head - first);
+    for (uint32_t i = first; i < head; i++) {
+        const crashdump_block_t *block = &snapshot.ring[i & (CRASHDUMP_RING_SIZE - 1)];
+        char mnemonic[32];
+        uint16_t op = (snapshot.memory[block->pc] << 8) |
+                      snapshot.memory[(block->pc + 1) & CHIP8_ADDR_MASK];
+        disasm_format(op, mnemonic, sizeof(mnemonic));
+        fprintf(file, "  %03X x%-3u %s\n", block->pc, block->len, mnemonic);
+    }
+
+    // Disassembly window around the fault. The pc has already advanced
+    // past the faulting instruction, so the line before the marker is
+    // usually the culprit.
+    fprintf(file, "\ndisassembly:\n");
+    int start = snapshot.program_counter - 2 * CRASHDUMP_DISASM_BEFORE;
+    if (start < 0) {
+        start = 0;
+    }
+    for (int addr = start;
+         addr <= snapshot.program_counter + 2 * CRASHDUMP_DISASM_AFTER && addr < CHIP8_MEMORY_BYTES;
+         addr += 2) {
+        char mnemonic[32];
+        uint16_t op = (snapshot.memory[addr] << 8) | snapshot.memory[(addr + 1) & CHIP8_ADDR_MASK];
+        disasm_format(op, mnemonic, sizeof(mnemonic));
+        fprintf(file, "%s %03X  %04X  %s\n",
+                addr == snapshot.program_counter ? "=>" : "  ", addr, op, mnemonic);
+    }
+
+    fclose(file);
+    SDL_Log("Crash dump written to %s", CRASHDUMP_FILE);
+    return NULL;
+}
+
+void crashdump_fault(const chip8_state_t *state, const char *reason) {
+    // First fault wins: everything after it runs under corrupt control
+    // flow, and re-dumping would overwrite the root cause
+    bool expected = false;
+    if (!atomic_compare_exchange_strong(&crashdump_taken, &expected, true)) {
+        return;
+    }
+
+    snapshot.reason = reason;
+    snapshot.program_counter = state->program_counter;
+    snapshot.index_register = state->index_register;
+    snapshot.stack_ptr = state->stack_ptr;
+    snapshot.delay_timer = state->delay_timer;
+    snapshot.sound_timer = state->sound_timer;
+    memcpy(snapshot.registers, state->registers, sizeof(snapshot.registers));
+    memcpy(snapshot.stack, state->stack, sizeof(snapshot.stack));
+    snapshot.cycle_count = state->cycle_count;
+    memcpy(snapshot.memory, state->memory, sizeof(snapshot.memory));
+    memcpy(snapshot.ring, crashdump_ring, sizeof(snapshot.ring));
+    snapshot.ring_head = crashdump_head;
+
+    pthread_create(&crashdump_thread, NULL, crashdump_write, NULL);
+}
+
+void crashdump_flush(void) {
+    if (atomic_load(&crashdump_taken)) {
+        pthread_join(crashdump_thread, NULL);
+    }
+}
@@ -0,0 +1,45 @@
+#ifndef CRASHDUMP_H
+#define CRASHDUMP_H
+
+#include <stdint.h>
+
+#include "chip8.h"
+
+/**
+ * Fault Flight Recorder
+ *
+ * Always-on post-mortem capture: a tiny ring records the head of every
+ * dispatched block (two stores per block, cheap enough for the fast core),
+ * and the first interpreter fault — stack overflow/underflow or an unknown
+ * opcode — snapshots registers, the stack, the recent control flow, and a
+ * disassembly window around the fault, then writes the report from a
+ * background thread. Production gets crash forensics without ever running
+ * with --trace.
+ */
+
+#define CRASHDUMP_RING_SIZE 256 // Power of two; the last ~256 blocks of control flow
+
+typedef struct crashdump_block {
+    uint16_t pc;  // Block head
+    uint16_t len; // Instructions the dispatch ran from it
+} crashdump_block_t;
+
+extern crashdump_block_t crashdump_ring[CRASHDUMP_RING_SIZE];
+extern uint32_t crashdump_head;
+
+// Called once per dispatched block from the execution loop. Unconditional
+// in both cores, like the opcode counters: no flag test, no branches.
+static inline void crashdump_record(uint16_t pc, uint16_t len) {
+    crashdump_ring[crashdump_head++ & (CRASHDUMP_RING_SIZE - 1)] =
+        (crashdump_block_t){pc, len};
+}
+
+// Snapshots the faulting state and queues the report write. Only the
+// first fault dumps: everything after it executes under corrupt control
+// flow and would bury the root cause in follow-on noise.
+void crashdump_fault(const chip8_state_t *state, const char *reason);
+
+// Joins the writer thread if a dump is still in flight (call at shutdown)
+void crashdump_flush(void);
+
+#endif // CRASHDUMP_H
@@ -0,0 +1,207 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <SDL3/SDL.h>
+
+#include "chip8.h"
+#include "debug.h"
+
+#define DEBUG_MAX_BREAKPOINTS 16
+
+typedef struct debug_breakpoint {
+    uint16_t pc;
+    chip8_handler_t real; // Displaced handler, restored on hit
+    bool used;
+} debug_breakpoint_t;
+
+static debug_breakpoint_t breakpoints[DEBUG_MAX_BREAKPOINTS];
+
+bool debug_active;
+
+static debug_breakpoint_t *debug_find(uint16_t pc) {
+    for (int i = 0; i < DEBUG_MAX_BREAKPOINTS; i++) {
+        if (breakpoints[i].used && breakpoints[i].pc == pc) {
+            return &breakpoints[i];
+        }
+    }
+    return NULL;
+}
+
+/* A decoded block whose head lies before the breakpoint executes its
+   entries without re-checking tags, so arming must invalidate every entry
+   that could head a block spanning the target pc. */
+static void debug_invalidate(chip8_state_t *state, uint16_t pc) {
+    for (int i = 0; i < CHIP8_MAX_BLOCK; i++) {
+        state->decode_cache[((pc - 2 * i) & CHIP8_ADDR_MASK) >> 1].tag = 0;
+    }
+}
+
+static void debug_print_registers(const chip8_state_t *state) {
+    printf("pc=%03x i=%03x sp=%u dt=%u st=%u\n", state->program_counter,
+           state->index_register, state->stack_ptr, state->delay_timer,
+           state->sound_timer);
+    for (int i = 0; i < 16; i++) {
+        printf("v%x=%02x%s", i, state->registers[i], i == 7 || i == 15 ? "\n" : " ");
+    }
+}
+
+static void debug_print_memory(const chip8_state_t *state, uint16_t addr) {
+    for (int row = 0; row < 4; row++) {
+        printf("%03x:", (addr + row * 16) & CHIP8_ADDR_MASK);
+        for (int i = 0; i < 16; i++) {
+            printf(" %02x", state->memory[(addr + row * 16 + i) & CHIP8_ADDR_MASK]);
+        }
+        printf("\n");
+    }
+}
+
+/* The interactive pause loop, shared by breakpoint and watchpoint traps.
+   `real`, when non-NULL, holds a displaced instruction still pending: the
+   first step consumes it so side effects land exactly once. */
+static void debug_console(chip8_state_t *state, chip8_handler_t *real, uint16_t opcode) {
+    char line[128];
+    bool paused = true;
+    while (paused) {
+        printf("dbg> ");
+        fflush(stdout);
+        if (fgets(line, sizeof(line), stdin) == NULL) {
+            break; // No console attached: behave like continue
+        }
+        unsigned addr;
+        switch (line[0]) {
+            case 'c':
+                paused = false;
+                break;
+            case 's':
+                // First step runs the displaced instruction; further steps
+                // go through the normal fetch path
+                if (real != NULL && *real != NULL) {
+                    (*real)(state, opcode);
+                    *real = NULL;
+                } else {
+                    chip8_step(state);
+                }
+                debug_print_registers(state);
+                break;
+            case 'r':
+                debug_print_registers(state);
+                break;
+            case 'm':
+                if (sscanf(line + 1, "%x", &addr) == 1) {
+                    debug_print_memory(state, (uint16_t)addr);
+                }
+                break;
+            case 'b':
+                if (sscanf(line + 1, "%x", &addr) == 1) {
+                    debug_add_breakpoint(state, (uint16_t)addr);
+                }
+                break;
+            case 'd':
+                if (sscanf(line + 1, "%x", &addr) == 1) {
+                    debug_remove_breakpoint(state, (uint16_t)addr);
+                }
+                break;
+            case 'w':
+                if (sscanf(line + 1, "%x", &addr) == 1) {
+                    debug_add_watchpoint((uint16_t)addr);
+                }
+                break;
+            case 'u':
+                if (sscanf(line + 1, "%x", &addr) == 1) {
+                    debug_remove_watchpoint((uint16_t)addr);
+                }
+                break;
+            default:
+                printf("c)ontinue s)tep r)egisters m <addr> b <addr> d <addr> w <addr> u <addr>\n");
+                break;
+        }
+    }
+}
+
+// The trap handler runs in place of the displaced instruction: console
+// first, then the real handler if the user never stepped through it
+static void debug_trap(chip8_state_t *state, uint16_t opcode) {
+    uint16_t pc = (uint16_t)((state->program_counter - 2) & CHIP8_ADDR_MASK);
+    debug_breakpoint_t *bp = debug_find(pc);
+    chip8_handler_t real = bp != NULL ? bp->real : NULL;
+
+    printf("break at %03x: %04x\n", pc, opcode);
+    debug_print_registers(state);
+    debug_console(state, &real, opcode);
+
+    if (real != NULL) {
+        real(state, opcode);
+    }
+}
+
+void debug_patch(chip8_state_t *state, uint16_t pc, chip8_decoded_t *entry) {
+    debug_breakpoint_t *bp = debug_find(pc);
+    if (bp != NULL) {
+        bp->real = entry->handler;
+        entry->handler = debug_trap;
+    }
+}
+
+bool debug_add_breakpoint(chip8_state_t *state, uint16_t pc) {
+    pc &= CHIP8_ADDR_MASK;
+    if (debug_find(pc) != NULL) {
+        return true;
+    }
+    for (int i = 0; i < DEBUG_MAX_BREAKPOINTS; i++) {
+        if (!breakpoints[i].used) {
+            breakpoints[i].pc = pc;
+            breakpoints[i].real = NULL;
+            breakpoints[i].used = true;
+            debug_active = true;
+            debug_invalidate(state, pc); // Re-decode arms the trap
+            SDL_Log("Breakpoint set at %03x", pc);
+            return true;
+        }
+    }
+    SDL_Log("Breakpoint table full (%d)", DEBUG_MAX_BREAKPOINTS);
+    return false;
+}
+
+void debug_remove_breakpoint(chip8_state_t *state, uint16_t pc) {
+    pc &= CHIP8_ADDR_MASK;
+    debug_breakpoint_t *bp = debug_find(pc);
+    if (bp == NULL) {
+        return;
+    }
+    bp->used = false;
+    state->decode_cache[pc >> 1].tag = 0; // Re-decode restores the real handler
+
+    debug_active = false;
+    for (int i = 0; i < DEBUG_MAX_BREAKPOINTS; i++) {
+        debug_active |= breakpoints[i].used;
+    }
+    SDL_Log("Breakpoint cleared at %03x", pc);
+}
+
+bool debug_watch_active;
+uint8_t debug_watch_map[CHIP8_MEMORY_BYTES / 8];
+
+void debug_add_watchpoint(uint16_t addr) {
+    addr &= CHIP8_ADDR_MASK;
+    debug_watch_map[addr >> 3] |= 1 << (addr & 0x7);
+    debug_watch_active = true;
+    SDL_Log("Watchpoint set at %03x", addr);
+}
+
+void debug_remove_watchpoint(uint16_t addr) {
+    addr &= CHIP8_ADDR_MASK;
+    debug_watch_map[addr >> 3] &= ~(1 << (addr & 0x7));
+
+    debug_watch_active = false;
+    for (size_t i = 0; i < sizeof(debug_watch_map); i++) {
+        debug_watch_active |= debug_watch_map[i] != 0;
+    }
+    SDL_Log("Watchpoint cleared at %03x", addr);
+}
+
+void debug_watch_hit(chip8_state_t *state, uint16_t addr, bool is_write, uint8_t value) {
+    uint16_t pc = (uint16_t)((state->program_counter - 2) & CHIP8_ADDR_MASK);
+    printf("watch %s at %03x = %02x (pc=%03x)\n",
+           is_write ? "write" : "read", addr, value, pc);
+    debug_console(state, NULL, 0);
+}
@@ -0,0 +1,50 @@
+#ifndef DEBUG_H
+#define DEBUG_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "chip8.h"
+
+/**
+ * Live Console Debugger
+ *
+ * Breakpoints patch the predecoded dispatch entries for their target pcs:
+ * when one is hit, a trap handler drops into a stdin console
+ * (pause/step/registers/memory) and then runs the real instruction. The
+ * execute loop never checks a breakpoint list — with no breakpoints armed
+ * it is byte-identical to an undebugged build, and the only cost while
+ * armed is one predicted branch on the (cold) decode-miss path.
+ */
+
+// True while any breakpoint is armed; gates the decode-path patch hook
+extern bool debug_active;
+
+// Arms a breakpoint at pc. False when the table is full.
+bool debug_add_breakpoint(chip8_state_t *state, uint16_t pc);
+
+// Disarms the breakpoint at pc, if one is set
+void debug_remove_breakpoint(chip8_state_t *state, uint16_t pc);
+
+// Decode-path hook: swaps the trap handler into a freshly decoded entry
+// when its pc carries a breakpoint. Called by the core under debug_active.
+void debug_patch(chip8_state_t *state, uint16_t pc, chip8_decoded_t *entry);
+
+/* Data watchpoints: a 4096-bit shadow bitmap over memory, consulted only
+   by the memory-writing handlers (FX55, FX33) and sprite fetches, and
+   only behind the debug_watch_active gate — the dispatch fast path never
+   sees a check. For chasing self-modifying ROMs. */
+extern bool debug_watch_active;
+extern uint8_t debug_watch_map[CHIP8_MEMORY_BYTES / 8];
+
+static inline bool debug_watched(uint16_t addr) {
+    return (debug_watch_map[(addr & CHIP8_ADDR_MASK) >> 3] >> (addr & 0x7)) & 1;
+}
+
+void debug_add_watchpoint(uint16_t addr);
+void debug_remove_watchpoint(uint16_t addr);
+
+// Trap entry for the core: logs the access and drops into the console
+void debug_watch_hit(chip8_state_t *state, uint16_t addr, bool is_write, uint8_t value);
+
+#endif // DEBUG_H
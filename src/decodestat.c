@@ -0,0 +1,110 @@
+#include <stdint.h>
+#include <string.h>
+#include <SDL3/SDL.h>
+
+#include "arena.h"
+#include "decodestat.h"
+
+#define DECODESTAT_TOP 16
+
+bool decodestat_enabled;
+
+static uint64_t hits;
+static uint64_t misses[3]; // Indexed by reason
+static uint64_t invalidation_calls;
+static uint64_t invalidation_entries;
+
+// Per-PC miss attribution: count plus the set of reasons seen there,
+// both carved out of one arena block in decodestat_start
+static uint32_t *pc_misses;
+static uint8_t *pc_reasons;
+
+void decodestat_start(void) {
+    uint8_t *block = arena_alloc("decode stats", DECODESTAT_ARENA_BYTES);
+    if (block == NULL) {
+        return;
+    }
+    pc_misses = (uint32_t *)block;
+    pc_reasons = block + CHIP8_MEMORY_BYTES * sizeof(uint32_t);
+    hits = 0;
+    memset(misses, 0, sizeof(misses));
+    invalidation_calls = 0;
+    invalidation_entries = 0;
+    decodestat_enabled = true;
+    SDL_Log("Decode cache statistics armed");
+}
+
+void decodestat_hit(void) {
+    hits++;
+}
+
+void decodestat_miss(uint16_t pc, int reason) {
+    misses[reason]++;
+    pc_misses[pc & CHIP8_ADDR_MASK]++;
+    pc_reasons[pc & CHIP8_ADDR_MASK] |= 1 << reason;
+}
+
+void decodestat_invalidate(int entries) {
+    invalidation_calls++;
+    invalidation_entries += entries;
+}
+
+static const char *reason_names(uint8_t bits) {
+    switch (bits) {
+        case 1 << DECODESTAT_COLD: return "cold";
+        case 1 << DECODESTAT_INVALIDATED: return "invalidated";
+        case 1 << DECODESTAT_CROSSED: return "crossed";
+        default: return "mixed";
+    }
+}
+
+void decodestat_report(void) {
+    if (!decodestat_enabled) {
+        return;
+    }
+
+    uint64_t total_misses = misses[0] + misses[1] + misses[2];
+    uint64_t dispatches = hits + total_misses;
+    SDL_Log("Decode cache: %llu dispatches, %.3f%% miss "
+            "(%llu cold, %llu invalidated, %llu crossed)",
+            (unsigned long long)dispatches,
+            dispatches != 0 ? 100.0 * total_misses / dispatches : 0.0,
+            (unsigned long long)misses[DECODESTAT_COLD],
+            (unsigned long long)misses[DECODESTAT_INVALIDATED],
+            (unsigned long long)misses[DECODESTAT_CROSSED]);
+    SDL_Log("  %llu entries killed over %llu invalidations",
+            (unsigned long long)invalidation_entries,
+            (unsigned long long)invalidation_calls);
+    if (total_misses == 0) {
+        return;
+    }
+
+    // Repeated selection, (count, address) ordered — same scheme as the
+    // PC profiler's report
+    SDL_Log("  hottest missing PCs:");
+    uint32_t floor_count = UINT32_MAX;
+    int floor_addr = -1;
+    for (int rank = 0; rank < DECODESTAT_TOP; rank++) {
+        uint32_t best = 0;
+        int best_addr = -1;
+        for (int addr = 0; addr < CHIP8_MEMORY_BYTES; addr++) {
+            uint32_t count = pc_misses[addr];
+            if (count == 0 || count > floor_count ||
+                (count == floor_count && addr <= floor_addr)) {
+                continue;
+            }
+            if (count > best) {
+                best = count;
+                best_addr = addr;
+            }
+        }
+        if (best_addr < 0 || best * 1000 < total_misses) {
+            break; // Below 0.1% of misses: noise
+        }
+        floor_count = best;
+        floor_addr = best_addr;
+
+        SDL_Log("  %03X: %u misses (%s)", best_addr, best,
+                reason_names(pc_reasons[best_addr]));
+    }
+}
@@ -0,0 +1,44 @@
+#ifndef DECODESTAT_H
+#define DECODESTAT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "chip8.h"
+
+/**
+ * Decode Cache Statistics
+ *
+ * Opt-in hit/miss/invalidation counters for the predecoded instruction
+ * cache, with misses attributed per PC and classified by cause: cold
+ * (never decoded), invalidated (killed by a program-memory write), or
+ * crossed (the entry holds the decode for the other byte parity — data
+ * interleaved with code, or odd-aligned jumps). The report separates a
+ * ROM that defeats the cache through self-modification from one that
+ * simply has a large footprint, which is what decides cache policy.
+ */
+
+enum {
+    DECODESTAT_COLD,
+    DECODESTAT_INVALIDATED,
+    DECODESTAT_CROSSED,
+};
+
+// Arena budget: per-PC miss counts (u32) plus reason bit sets (u8)
+#define DECODESTAT_ARENA_BYTES (CHIP8_MEMORY_BYTES * 5)
+
+extern bool decodestat_enabled;
+
+void decodestat_start(void);
+
+// Dispatch-path hooks (see chip8_step/chip8_run_block)
+void decodestat_hit(void);
+void decodestat_miss(uint16_t pc, int reason);
+
+// One program-memory write killed `entries` live cache entries
+void decodestat_invalidate(int entries);
+
+// Logs totals, the miss breakdown, and the hottest missing PCs
+void decodestat_report(void);
+
+#endif // DECODESTAT_H
@@ -0,0 +1,82 @@
+#include <stdint.h>
+#include <stdbool.h>
+#include <SDL3/SDL.h>
+
+#include "degrade.h"
+#include "telemetry.h"
+#include "eventlog.h"
+
+static bool degrade_enabled;
+
+// Current rung, written by the emulation thread in degrade_observe and
+// polled by the render and audio threads through degrade_active
+static SDL_AtomicInt degrade_current;
+
+static int window_samples;
+static int window_overruns;
+static int clean_seconds;
+
+static const char *const step_names[DEGRADE_STEP_COUNT] = {
+    "full fidelity", "hud off", "half present rate",
+    "effects off", "coarse audio",
+};
+
+void degrade_enable(void) {
+    degrade_enabled = true;
+}
+
+bool degrade_active(degrade_step_t step) {
+    return SDL_GetAtomicInt(&degrade_current) >= (int)step;
+}
+
+static void degrade_transition(int level, const char *direction) {
+    SDL_SetAtomicInt(&degrade_current, level);
+    SDL_Log("Degrade: %s to %s (%d/%d overrun samples last second)",
+            direction, step_names[level], window_overruns, window_samples);
+    telemetry_degrade_steps.value++;
+    eventlog_emit(EVENT_DEGRADE, (uint32_t)level, (uint32_t)window_overruns);
+}
+
+void degrade_disable(void) {
+    degrade_enabled = false;
+    window_samples = 0;
+    window_overruns = 0;
+    clean_seconds = 0;
+    if (SDL_GetAtomicInt(&degrade_current) != DEGRADE_NONE) {
+        degrade_transition(DEGRADE_NONE, "disable");
+    }
+}
+
+void degrade_observe(bool overrun) {
+    if (!degrade_enabled) {
+        return;
+    }
+
+    window_samples++;
+    if (overrun) {
+        window_overruns++;
+    }
+    if (window_samples < 60) {
+        return;
+    }
+
+    // One verdict per accumulated second, mirroring the trip threshold's
+    // denominator: sustained overload escalates, a spotless second
+    // counts toward recovery, anything in between holds the rung
+    int level = SDL_GetAtomicInt(&degrade_current);
+    if (window_overruns >= DEGRADE_TRIP_COUNT) {
+        clean_seconds = 0;
+        if (level + 1 < DEGRADE_STEP_COUNT) {
+            degrade_transition(level + 1, "step up");
+        }
+    } else if (window_overruns == 0) {
+        if (level > DEGRADE_NONE && ++clean_seconds >= DEGRADE_RECOVER_SECONDS) {
+            clean_seconds = 0;
+            degrade_transition(level - 1, "recover");
+        }
+    } else {
+        clean_seconds = 0;
+    }
+    window_samples = 0;
+    window_overruns = 0;
+}
@@ -0,0 +1,53 @@
+#ifndef DEGRADE_H
+#define DEGRADE_H
+
+#include <stdbool.h>
+
+/**
+ * Graceful Degradation Ladder
+ *
+ * An overloaded host should shed fidelity in a fixed, published order,
+ * not collapse into arbitrary timing. The ladder watches the pacing
+ * deadline the main loop already checks and climbs one rung per tripped
+ * second of sustained overrun: drop the HUD first, then halve the
+ * present rate, then disable the CRT composition, then coarsen the
+ * audio refills. Recovery walks back down one rung per stretch of clean
+ * seconds, and every transition is logged and emitted to the event log,
+ * so an operator reading the journal knows exactly what the cabinet was
+ * showing at any point under load.
+ *
+ * The policy only ever touches presentation: emulation pacing, input,
+ * and frame publish keep their cadence at every rung, which is the
+ * point — the steps exist so the core never has to stretch a quantum.
+ */
+
+// Rungs in shedding order; each engages everything above it
+typedef enum degrade_step {
+    DEGRADE_NONE = 0,
+    DEGRADE_HUD,     // Stop compositing the HUD overlay
+    DEGRADE_PRESENT, // Present every other display frame
+    DEGRADE_EFFECTS, // Plain blit instead of the CRT composition
+    DEGRADE_AUDIO,   // Double the refill headroom: fewer, larger fills
+    DEGRADE_STEP_COUNT
+} degrade_step_t;
+
+// Overrun samples within one 60-sample second that trip an escalation
+#define DEGRADE_TRIP_COUNT 12
+// Consecutive fully clean seconds before stepping one rung back down
+#define DEGRADE_RECOVER_SECONDS 3
+
+void degrade_enable(void);
+
+// Drops any engaged rung and stops sampling; full fidelity resumes
+void degrade_disable(void);
+
+// Feeds one per-quantum sample: whether the loop reached housekeeping
+// with the pacing deadline already spent. Evaluated once per accumulated
+// second; transitions log and emit EVENT_DEGRADE themselves.
+void degrade_observe(bool overrun);
+
+// True while the given rung (or a higher one) is engaged. Safe from any
+// thread; the render and audio paths poll it per frame/refill.
+bool degrade_active(degrade_step_t step);
+
+#endif // DEGRADE_H
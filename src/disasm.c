@@ -0,0 +1,272 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <SDL3/SDL.h>
+
+#include "chip8.h"
+#include "disasm.h"
+
+#define DISASM_START 0x200
+
+// Persistent code-map cache (--decode-cache): one small file per ROM
+// under DISASM_CACHE_DIR, named and validated by the ROM hash, holding
+// the reachability walk's verdict. The walk is deterministic per ROM,
+// so a hit skips the analysis entirely and goes straight to predecode
+// seeding — what relaunch-heavy kiosks pay on every title start. The
+// decode cache itself never serializes: its entries carry handler
+// pointers (see savestate.c, which drops them for the same reason).
+#define DISASM_CACHE_DIR "decode_cache"
+#define DISASM_CACHE_VERSION 1
+
+bool disasm_cache_enabled;
+
+// Per-address flags from the reachability walk. A byte can be both an
+// instruction start and the tail of an overlapping one; both bits stick.
+#define DISASM_CODE 0x01 // First byte of a reachable instruction
+#define DISASM_TAIL 0x02 // Second byte of a reachable instruction
+
+static uint8_t code_map[CHIP8_MEMORY_BYTES];
+
+void disasm_format(uint16_t op, char *buf, size_t cap) {
+    unsigned x = (op >> 8) & 0xF;
+    unsigned y = (op >> 4) & 0xF;
+    unsigned n = op & 0xF;
+    unsigned nn = op & 0xFF;
+    unsigned nnn = op & 0xFFF;
+
+    switch (op >> 12) {
+        case 0x0:
+            if (op == 0x00E0) { snprintf(buf, cap, "CLS"); return; }
+            if (op == 0x00EE) { snprintf(buf, cap, "RET"); return; }
+            if (op == 0x00FB) { snprintf(buf, cap, "SCR"); return; }
+            if (op == 0x00FC) { snprintf(buf, cap, "SCL"); return; }
+            if (op == 0x00FD) { snprintf(buf, cap, "EXIT"); return; }
+            if (op == 0x00FE) { snprintf(buf, cap, "LOW"); return; }
+            if (op == 0x00FF) { snprintf(buf, cap, "HIGH"); return; }
+            if ((op & 0xFFF0) == 0x00C0) { snprintf(buf, cap, "SCD %u", n); return; }
+            if ((op & 0xFFF0) == 0x00D0) { snprintf(buf, cap, "SCU %u", n); return; }
+            break;
+        case 0x1: snprintf(buf, cap, "JP %03X", nnn); return;
+        case 0x2: snprintf(buf, cap, "CALL %03X", nnn); return;
+        case 0x3: snprintf(buf, cap, "SE V%X, %02X", x, nn); return;
+        case 0x4: snprintf(buf, cap, "SNE V%X, %02X", x, nn); return;
+        case 0x5:
+            if (n == 0x0) { snprintf(buf, cap, "SE V%X, V%X", x, y); return; }
+            break;
+        case 0x6: snprintf(buf, cap, "LD V%X, %02X", x, nn); return;
+        case 0x7: snprintf(buf, cap, "ADD V%X, %02X", x, nn); return;
+        case 0x8:
+            switch (n) {
+                case 0x0: snprintf(buf, cap, "LD V%X, V%X", x, y); return;
+                case 0x1: snprintf(buf, cap, "OR V%X, V%X", x, y); return;
+                case 0x2: snprintf(buf, cap, "AND V%X, V%X", x, y); return;
+                case 0x3: snprintf(buf, cap, "XOR V%X, V%X", x, y); return;
+                case 0x4: snprintf(buf, cap, "ADD V%X, V%X", x, y); return;
+                case 0x5: snprintf(buf, cap, "SUB V%X, V%X", x, y); return;
+                case 0x6: snprintf(buf, cap, "SHR V%X, V%X", x, y); return;
+                case 0x7: snprintf(buf, cap, "SUBN V%X, V%X", x, y); return;
+                case 0xE: snprintf(buf, cap, "SHL V%X, V%X", x, y); return;
+            }
+            break;
+        case 0x9:
+            if (n == 0x0) { snprintf(buf, cap, "SNE V%X, V%X", x, y); return; }
+            break;
+        case 0xA: snprintf(buf, cap, "LD I, %03X", nnn); return;
+        case 0xB: snprintf(buf, cap, "JP V0, %03X", nnn); return;
+        case 0xC: snprintf(buf, cap, "RND V%X, %02X", x, nn); return;
+        case 0xD: snprintf(buf, cap, "DRW V%X, V%X, %u", x, y, n); return;
+        case 0xE:
+            if (nn == 0x9E) { snprintf(buf, cap, "SKP V%X", x); return; }
+            if (nn == 0xA1) { snprintf(buf, cap, "SKNP V%X", x); return; }
+            break;
+        case 0xF:
+            switch (nn) {
+                case 0x01: snprintf(buf, cap, "PLANE %u", x); return;
+                case 0x07: snprintf(buf, cap, "LD V%X, DT", x); return;
+                case 0x0A: snprintf(buf, cap, "LD V%X, K", x); return;
+                case 0x15: snprintf(buf, cap, "LD DT, V%X", x); return;
+                case 0x18: snprintf(buf, cap, "LD ST, V%X", x); return;
+                case 0x1E: snprintf(buf, cap, "ADD I, V%X", x); return;
+                case 0x29: snprintf(buf, cap, "LD F, V%X", x); return;
+                case 0x33: snprintf(buf, cap, "BCD V%X", x); return;
+                case 0x55: snprintf(buf, cap, "LD [I], V%X", x); return;
+                case 0x65: snprintf(buf, cap, "LD V%X, [I]", x); return;
+                case 0x75: snprintf(buf, cap, "LD R, V%X", x); return;
+                case 0x85: snprintf(buf, cap, "LD V%X, R", x); return;
+            }
+            break;
+    }
+    snprintf(buf, cap, "DW %04X", op);
+}
+
+// Seeds the decode cache over the discovered map: every reachable
+// instruction decodes now instead of on first execution
+static void disasm_seed(chip8_state_t *state) {
+    for (uint16_t addr = DISASM_START; addr + 1 < CHIP8_MEMORY_BYTES; addr += 1) {
+        if ((code_map[addr] & DISASM_CODE) &&
+            state->decode_cache[addr >> 1].tag != (uint16_t)(addr + 1)) {
+            chip8_predecode(state, addr);
+        }
+    }
+}
+
+static void disasm_cache_path(uint64_t rom_hash, char *buf, size_t cap) {
+    snprintf(buf, cap, DISASM_CACHE_DIR "/%016llx.map", (unsigned long long)rom_hash);
+}
+
+// Fills code_map from the cache file for this ROM. Any mismatch —
+// missing, truncated, wrong version, wrong hash — is a miss; the scan
+// that follows rewrites the file.
+static bool disasm_cache_load(uint64_t rom_hash) {
+    char path[64];
+    disasm_cache_path(rom_hash, path, sizeof(path));
+    FILE *fptr = fopen(path, "rb");
+    if (fptr == NULL) {
+        return false;
+    }
+
+    uint8_t header[13];
+    uint64_t stored = 0;
+    bool ok = fread(header, 1, sizeof(header), fptr) == sizeof(header)
+           && memcmp(header, "C8DC", 4) == 0
+           && header[4] == DISASM_CACHE_VERSION;
+    for (int i = 0; i < 8; i++) {
+        stored |= (uint64_t)header[5 + i] << (i * 8);
+    }
+    ok = ok && stored == rom_hash
+            && fread(code_map, 1, sizeof(code_map), fptr) == sizeof(code_map);
+    fclose(fptr);
+    return ok;
+}
+
+static void disasm_cache_store(uint64_t rom_hash) {
+    mkdir(DISASM_CACHE_DIR, 0755); // Existing directory is fine
+
+    char path[64];
+    disasm_cache_path(rom_hash, path, sizeof(path));
+    FILE *fptr = fopen(path, "wb");
+    if (fptr == NULL) {
+        SDL_Log("Couldn't write decode cache %s", path);
+        return;
+    }
+
+    uint8_t header[13] = {'C', '8', 'D', 'C', DISASM_CACHE_VERSION};
+    for (int i = 0; i < 8; i++) {
+        header[5 + i] = (uint8_t)(rom_hash >> (i * 8));
+    }
+    if (fwrite(header, 1, sizeof(header), fptr) != sizeof(header) ||
+        fwrite(code_map, 1, sizeof(code_map), fptr) != sizeof(code_map)) {
+        SDL_Log("Couldn't write decode cache %s", path);
+    }
+    fclose(fptr);
+}
+
+// Pushes a branch target if it hasn't been classified yet
+static void disasm_push(uint16_t *work, int *top, uint16_t target) {
+    if (target + 1 < CHIP8_MEMORY_BYTES && !(code_map[target] & DISASM_CODE) && *top < CHIP8_MEMORY_BYTES) {
+        work[(*top)++] = target;
+    }
+}
+
+void disasm_scan(chip8_state_t *state) {
+    if (disasm_cache_enabled && disasm_cache_load(state->rom_hash)) {
+        SDL_Log("Decode map %016llx from cache; analysis skipped",
+                (unsigned long long)state->rom_hash);
+        disasm_seed(state);
+        return;
+    }
+
+    memset(code_map, 0, sizeof(code_map));
+
+    uint16_t work[CHIP8_MEMORY_BYTES];
+    int top = 0;
+    work[top++] = DISASM_START;
+
+    while (top > 0) {
+        // Wider than an address on purpose: the end-of-path sentinel
+        // below is CHIP8_MEMORY_BYTES itself, one past the top
+        unsigned pc = work[--top];
+
+        // Straight-line walk; branch targets go on the worklist
+        while (pc + 1 < CHIP8_MEMORY_BYTES && !(code_map[pc] & DISASM_CODE)) {
+            code_map[pc] |= DISASM_CODE;
+            code_map[pc + 1] |= DISASM_TAIL;
+            uint16_t op = (state->memory[pc] << 8) | state->memory[pc + 1];
+
+            switch (op >> 12) {
+                case 0x0:
+                    if (op == 0x00EE || op == 0x00FD) {
+                        pc = CHIP8_MEMORY_BYTES; // RET/EXIT: path ends here
+                        continue;
+                    }
+                    break;
+                case 0x1:
+                    pc = op & 0xFFF; // Unconditional: follow in place
+                    continue;
+                case 0x2:
+                    disasm_push(work, &top, op & 0xFFF);
+                    break; // Falls through past the RET
+                case 0xB:
+                    // Runtime-dispatched (V0 offset): the base target is
+                    // the only address we can name statically
+                    disasm_push(work, &top, op & 0xFFF);
+                    pc = CHIP8_MEMORY_BYTES;
+                    continue;
+                case 0x3: case 0x4: case 0x5: case 0x9: case 0xE:
+                    disasm_push(work, &top, (pc + 4) & CHIP8_ADDR_MASK); // Skip-taken arm
+                    break;
+                default:
+                    break;
+            }
+            pc += 2;
+        }
+    }
+
+    disasm_seed(state);
+    if (disasm_cache_enabled) {
+        disasm_cache_store(state->rom_hash);
+    }
+}
+
+bool disasm_is_code(uint16_t addr) {
+    return addr < CHIP8_MEMORY_BYTES && (code_map[addr] & DISASM_CODE) != 0;
+}
+
+bool disasm_dump(const chip8_state_t *state, const char *filename) {
+    FILE *fptr = fopen(filename, "w");
+    if (fptr == NULL) {
+        SDL_Log("Error opening disassembly file: %s", filename);
+        return false;
+    }
+
+    // Stop after the last byte the walk touched or that holds ROM data
+    int end = CHIP8_MEMORY_BYTES - 1;
+    while (end > DISASM_START && state->memory[end] == 0 && code_map[end] == 0) {
+        end--;
+    }
+
+    char text[32];
+    int addr = DISASM_START;
+    while (addr <= end) {
+        if (code_map[addr] & DISASM_CODE) {
+            uint16_t op = (state->memory[addr] << 8) | state->memory[addr + 1];
+            disasm_format(op, text, sizeof(text));
+            fprintf(fptr, "%03X: %04X  %s\n", addr, op, text);
+            addr += 2;
+        } else if (code_map[addr] & DISASM_TAIL) {
+            addr += 1; // Tail of an overlapping instruction already printed
+        } else {
+            // Data run, eight bytes per line
+            fprintf(fptr, "%03X: .db", addr);
+            for (int i = 0; i < 8 && addr <= end && code_map[addr] == 0; i++) {
+                fprintf(fptr, " %02X", state->memory[addr]);
+                addr++;
+            }
+            fprintf(fptr, "\n");
+        }
+    }
+
+    fclose(fptr);
+    return true;
+}
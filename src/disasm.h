@@ -0,0 +1,40 @@
+#ifndef DISASM_H
+#define DISASM_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "chip8.h"
+
+/**
+ * Static Disassembler
+ *
+ * Walks reachable code from the load address at ROM load time, following
+ * jumps, calls, and both arms of every skip, and classifies each byte as
+ * code or data. The discovered code map seeds the predecoded instruction
+ * cache before execution starts (no first-execution decode misses) and
+ * can be dumped as a text disassembly for offline tooling.
+ */
+
+// Persists each ROM's code map under decode_cache/, keyed and validated
+// by ROM hash, so relaunches of a known title skip the reachability
+// walk and go straight to predecode seeding (--decode-cache)
+extern bool disasm_cache_enabled;
+
+// Runs the reachability walk over the loaded ROM and predecodes every
+// discovered instruction (or, with the cache enabled and warm, seeds
+// from the stored map). Call after the ROM (and any quirk profile) is
+// set up, before execution.
+void disasm_scan(chip8_state_t *state);
+
+// True if the scan classified addr as the start of a reachable instruction
+bool disasm_is_code(uint16_t addr);
+
+// Renders one opcode as its mnemonic (unknown patterns come out as DW)
+void disasm_format(uint16_t op, char *buf, size_t cap);
+
+// Writes the code map as text: one line per instruction, data bytes
+// grouped into .db lines. Requires a prior disasm_scan.
+bool disasm_dump(const chip8_state_t *state, const char *filename);
+
+#endif // DISASM_H
@@ -0,0 +1,111 @@
+#include <stdint.h>
+#include <SDL3/SDL.h>
+
+#include "chip8.h"
+#include "clock.h"
+#include "telemetry.h"
+#include "energy.h"
+
+/* Cost weights in ALU-op units. A DXYN rewrites up to 16 vram rows and
+   dirties texture regions downstream; class-0 opcodes (clear, SCHIP
+   scrolls) touch whole planes. Everything else is register arithmetic. */
+#define ENERGY_DRAW_WEIGHT 32
+#define ENERGY_CLEAR_WEIGHT 8
+
+bool energy_enabled;
+
+static uint64_t target_permille;
+
+/* Two-factor model: ns_per_cost is a host property and converges slowly;
+   cost_per_instr is the ROM's current opcode mix and tracks fast, so a
+   title switching from an idle menu to a draw-heavy level re-prices its
+   batches within a few quanta. */
+static double ns_per_cost;
+static double cost_per_instr;
+
+static uint64_t last_cycles;
+static uint64_t last_draws;
+static uint64_t last_class0;
+
+static uint64_t duty_ewma_permille;
+static uint64_t busy_ns_total;
+static uint64_t wall_ns_total;
+static uint64_t throttled_quanta;
+static uint64_t total_quanta;
+
+void energy_start(int target_duty) {
+    if (target_duty < 1) {
+        target_duty = 1;
+    }
+    if (target_duty > 100) {
+        target_duty = 100;
+    }
+    target_permille = (uint64_t)target_duty * 10;
+
+    // Spin pacing burns a core to hit deadlines; the governor always
+    // trades that precision back for sleep
+    chip8_pacing = CHIP8_PACING_SLEEP;
+    energy_enabled = true;
+    SDL_Log("Energy governor: %d%% duty target, sleep pacing", target_duty);
+}
+
+int energy_budget(int budget) {
+    if (ns_per_cost == 0.0) {
+        return budget; // No model yet: the first quanta run the full clock budget
+    }
+
+    double allowed_ns = (double)CHIP8_CLOCK_QUANTUM_NS * (double)target_permille / 1000.0;
+    double predicted_ns_per_instr = ns_per_cost * cost_per_instr;
+    int fit = (int)(allowed_ns / predicted_ns_per_instr);
+    if (fit < 1) {
+        fit = 1; // Never stall outright; timers must keep a pulse of progress
+    }
+
+    if (fit < budget) {
+        throttled_quanta++;
+        return fit;
+    }
+    return budget;
+}
+
+void energy_account(const chip8_state_t *state, uint64_t exec_ns) {
+    uint64_t d_instr = state->cycle_count - last_cycles;
+    uint64_t d_draw = state->opcode_count[0xD] - last_draws;
+    uint64_t d_clear = state->opcode_count[0x0] - last_class0;
+    last_cycles = state->cycle_count;
+    last_draws = state->opcode_count[0xD];
+    last_class0 = state->opcode_count[0x0];
+
+    total_quanta++;
+    busy_ns_total += exec_ns;
+    wall_ns_total += CHIP8_CLOCK_QUANTUM_NS;
+
+    uint64_t duty = exec_ns * 1000 / CHIP8_CLOCK_QUANTUM_NS;
+    duty_ewma_permille = (duty_ewma_permille * 7 + duty) / 8;
+    telemetry_duty_permille.value = duty_ewma_permille;
+
+    if (d_instr == 0) {
+        return;
+    }
+
+    double cost = (double)(d_instr - d_draw - d_clear)
+                + (double)d_draw * ENERGY_DRAW_WEIGHT
+                + (double)d_clear * ENERGY_CLEAR_WEIGHT;
+    double mix = cost / (double)d_instr;
+    double rate = (double)exec_ns / cost;
+
+    cost_per_instr = cost_per_instr == 0.0 ? mix : (cost_per_instr * 3 + mix) / 4;
+    ns_per_cost = ns_per_cost == 0.0 ? rate : (ns_per_cost * 15 + rate) / 16;
+}
+
+void energy_report(void) {
+    if (!energy_enabled || total_quanta == 0) {
+        return;
+    }
+    SDL_Log("Energy governor: %.2f%% mean duty (target %llu%%), "
+            "%llu/%llu quanta throttled, %.1f ns/cost unit",
+            100.0 * (double)busy_ns_total / (double)wall_ns_total,
+            (unsigned long long)(target_permille / 10),
+            (unsigned long long)throttled_quanta,
+            (unsigned long long)total_quanta, ns_per_cost);
+}
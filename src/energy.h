@@ -0,0 +1,38 @@
+#ifndef ENERGY_H
+#define ENERGY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "chip8.h"
+
+/**
+ * Energy Governor (--energy [duty%])
+ *
+ * Battery-class pacing: a fixed 700-IPS batch burns the same power
+ * whether a ROM idles or draws frantically. The governor prices each
+ * quantum with a per-opcode cost model (draws and class-0 clears/scrolls
+ * weigh far more than ALU ops, matching where vram rewrites and texture
+ * uploads land), learns the host's ns-per-cost-unit rate, and sizes the
+ * next batch so the emulation thread's duty cycle holds a target share
+ * of wall time. Pacing is forced to pure sleep while active — spinning
+ * out the margin is the opposite of saving power. The measured duty
+ * lands in telemetry_duty_permille.
+ */
+
+extern bool energy_enabled;
+
+// target_duty is the busy share to hold, in percent of wall time
+void energy_start(int target_duty);
+
+// Clamps the clock's instruction budget for the coming quantum to what
+// the model predicts fits the duty target
+int energy_budget(int budget);
+
+// Per-quantum accounting: folds the opcode counter deltas and measured
+// exec time into the cost model
+void energy_account(const chip8_state_t *state, uint64_t exec_ns);
+
+void energy_report(void);
+
+#endif // ENERGY_H
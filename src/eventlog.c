@@ -0,0 +1,191 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <pthread.h>
+#include <SDL3/SDL.h>
+
+#include "arena.h"
+#include "eventlog.h"
+#include "telemetry.h"
+
+// On-disk format, little-endian: "C8EV" + u32 version, then 16-byte
+// records of [timestamp ns u64][event id u16][a u16][b u32]
+#define EVENTLOG_VERSION 1
+#define EVENTLOG_RECORD 16
+#define EVENTLOG_RING 256
+
+typedef struct event_record {
+    uint64_t when_ns;
+    uint16_t id;
+    uint16_t a;
+    uint32_t b;
+} event_record_t;
+
+_Static_assert(EVENTLOG_RING * sizeof(event_record_t) == EVENTLOG_ARENA_BYTES,
+               "event log arena budget must match the ring size");
+
+bool eventlog_enabled;
+
+static event_record_t *ring; // Arena-backed, carved out in eventlog_start
+static int ring_head;
+static int ring_tail;
+static uint64_t dropped; // Records lost to a full buffer
+
+static FILE *log_file;
+static bool flusher_quit;
+static pthread_t flusher;
+static pthread_mutex_t log_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t log_ready = PTHREAD_COND_INITIALIZER;
+
+static const char *event_name(uint16_t id) {
+    switch (id) {
+        case EVENT_SESSION_START: return "session-start";
+        case EVENT_SESSION_STOP: return "session-stop";
+        case EVENT_ROM_LOADED: return "rom-loaded";
+        case EVENT_ROM_ERROR: return "rom-error";
+        case EVENT_ROM_CONFIG: return "rom-config";
+        case EVENT_STACK_OVERFLOW: return "stack-overflow";
+        case EVENT_STACK_UNDERFLOW: return "stack-underflow";
+        case EVENT_SAVESTATE_ERROR: return "savestate-error";
+        case EVENT_NETPLAY_DROP: return "netplay-drop";
+        case EVENT_WATCHDOG: return "watchdog";
+        case EVENT_DEGRADE: return "degrade";
+        case EVENT_CONFIG_RELOAD: return "config-reload";
+        case EVENT_MIGRATE: return "migrate";
+        default: return "unknown";
+    }
+}
+
+static void encode_record(const event_record_t *record, uint8_t *out) {
+    for (int i = 0; i < 8; i++) {
+        out[i] = (record->when_ns >> (8 * i)) & 0xFF;
+    }
+    out[8] = record->id & 0xFF;
+    out[9] = record->id >> 8;
+    out[10] = record->a & 0xFF;
+    out[11] = record->a >> 8;
+    for (int i = 0; i < 4; i++) {
+        out[12 + i] = (record->b >> (8 * i)) & 0xFF;
+    }
+}
+
+static void *eventlog_flusher(void *arg) {
+    uint8_t encoded[EVENTLOG_RECORD];
+
+    pthread_mutex_lock(&log_lock);
+    while (true) {
+        while (ring_tail == ring_head && !flusher_quit) {
+            pthread_cond_wait(&log_ready, &log_lock);
+        }
+        if (ring_tail == ring_head && flusher_quit) {
+            break;
+        }
+        event_record_t record = ring[ring_tail % EVENTLOG_RING];
+        ring_tail++;
+        pthread_mutex_unlock(&log_lock);
+
+        encode_record(&record, encoded);
+        fwrite(encoded, 1, sizeof(encoded), log_file);
+
+        pthread_mutex_lock(&log_lock);
+    }
+    pthread_mutex_unlock(&log_lock);
+    return NULL;
+}
+
+bool eventlog_start(const char *filename) {
+    ring = arena_alloc("event log ring", EVENTLOG_ARENA_BYTES);
+    if (ring == NULL) {
+        return false;
+    }
+
+    log_file = fopen(filename, "wb");
+    if (log_file == NULL) {
+        SDL_Log("Error opening event log: %s", filename);
+        return false;
+    }
+
+    uint8_t header[8] = {'C', '8', 'E', 'V', EVENTLOG_VERSION, 0, 0, 0};
+    fwrite(header, 1, sizeof(header), log_file);
+
+    ring_head = 0;
+    ring_tail = 0;
+    dropped = 0;
+    flusher_quit = false;
+    pthread_create(&flusher, NULL, eventlog_flusher, NULL);
+    eventlog_enabled = true;
+    eventlog_emit(EVENT_SESSION_START, 0, 0);
+    return true;
+}
+
+void eventlog_emit(uint16_t id, uint16_t a, uint32_t b) {
+    if (!eventlog_enabled) {
+        return;
+    }
+    pthread_mutex_lock(&log_lock);
+    if (ring_head - ring_tail >= EVENTLOG_RING) {
+        dropped++; // Never stall the emitter for the disk
+    } else {
+        event_record_t *record = &ring[ring_head % EVENTLOG_RING];
+        record->when_ns = telemetry_now_ns();
+        record->id = id;
+        record->a = a;
+        record->b = b;
+        ring_head++;
+        pthread_cond_signal(&log_ready);
+    }
+    pthread_mutex_unlock(&log_lock);
+}
+
+void eventlog_stop(void) {
+    if (!eventlog_enabled) {
+        return;
+    }
+    eventlog_emit(EVENT_SESSION_STOP, 0, 0);
+    eventlog_enabled = false;
+
+    pthread_mutex_lock(&log_lock);
+    flusher_quit = true;
+    pthread_cond_signal(&log_ready);
+    pthread_mutex_unlock(&log_lock);
+    pthread_join(flusher, NULL);
+
+    if (dropped != 0) {
+        SDL_Log("Event log dropped %llu records", (unsigned long long)dropped);
+    }
+    fclose(log_file);
+    log_file = NULL;
+}
+
+bool eventlog_dump(const char *filename) {
+    FILE *fptr = fopen(filename, "rb");
+    if (fptr == NULL) {
+        SDL_Log("Error opening event log: %s", filename);
+        return false;
+    }
+
+    uint8_t header[8];
+    if (fread(header, 1, sizeof(header), fptr) != sizeof(header)
+        || memcmp(header, "C8EV", 4) != 0 || header[4] != EVENTLOG_VERSION) {
+        SDL_Log("Not an event log: %s", filename);
+        fclose(fptr);
+        return false;
+    }
+
+    uint8_t encoded[EVENTLOG_RECORD];
+    while (fread(encoded, 1, sizeof(encoded), fptr) == sizeof(encoded)) {
+        uint64_t when_ns = 0;
+        for (int i = 0; i < 8; i++) {
+            when_ns |= (uint64_t)encoded[i] << (8 * i);
+        }
+        uint16_t id = encoded[8] | (uint16_t)encoded[9] << 8;
+        uint16_t a = encoded[10] | (uint16_t)encoded[11] << 8;
+        uint32_t b = 0;
+        for (int i = 0; i < 4; i++) {
+            b |= (uint32_t)encoded[12 + i] << (8 * i);
+        }
+        printf("%14.6f %-16s a=%u b=%u\n", when_ns / 1e9, event_name(id), a, b);
+    }
+    fclose(fptr);
+    return true;
+}
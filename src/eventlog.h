@@ -0,0 +1,52 @@
+#ifndef EVENTLOG_H
+#define EVENTLOG_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * Structured Session Event Log
+ *
+ * Fixed-size binary event records for fleet ingestion, written through a
+ * buffered appender that flushes on a background thread. Emitting an
+ * event while the log is disabled is a single branch, so call sites pay
+ * nothing in normal runs; the human-readable SDL_Log lines stay for
+ * interactive use. `chip8 --logdump file` converts a log back to text.
+ */
+
+// Record ids. Append only — recorded logs must keep decoding.
+enum {
+    EVENT_SESSION_START = 1, // a: 0, b: interpreter version (unused, 0)
+    EVENT_SESSION_STOP = 2,
+    EVENT_ROM_LOADED = 3,    // a: 0, b: ROM size in bytes
+    EVENT_ROM_ERROR = 4,     // a: 0, b: attempted size (0 = open failed)
+    EVENT_ROM_CONFIG = 5,    // a: quirk profile, b: configured ips
+    EVENT_STACK_OVERFLOW = 6,  // a: 0, b: program counter
+    EVENT_STACK_UNDERFLOW = 7, // a: 0, b: program counter
+    EVENT_SAVESTATE_ERROR = 8, // a: 0, b: rejected version (0 = bad image)
+    EVENT_NETPLAY_DROP = 9,    // a: 0, b: simulation frame
+    EVENT_WATCHDOG = 10,       // a: recovery policy, b: program counter
+    EVENT_DEGRADE = 11,        // a: new ladder rung, b: overruns last second
+    EVENT_CONFIG_RELOAD = 12,  // a: config generation, b: new ips (0 = kept)
+    EVENT_MIGRATE = 13,        // a: 1 = handed out, 2 = spliced in; b: paced ips
+};
+
+// Arena budget: ring entries times the 16-byte record
+#define EVENTLOG_ARENA_BYTES (256 * 16)
+
+extern bool eventlog_enabled;
+
+// Opens the log and starts the flusher thread
+bool eventlog_start(const char *filename);
+
+// Appends one record; wait-free for the caller, dropped (and counted)
+// if the buffer is full. No-op while the log is disabled.
+void eventlog_emit(uint16_t id, uint16_t a, uint32_t b);
+
+// Drains and closes the log
+void eventlog_stop(void);
+
+// Converter: prints a recorded log as text on stdout
+bool eventlog_dump(const char *filename);
+
+#endif // EVENTLOG_H
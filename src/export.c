@@ -0,0 +1,174 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <SDL3/SDL.h>
+
+#include "export.h"
+#include "telemetry.h"
+#include "introspect.h"
+
+static char export_path[256];
+static char export_tmp[264];
+static bool export_csv;
+static unsigned export_interval;
+
+static bool worker_started;
+static bool worker_quit;
+static bool write_requested;
+static pthread_t worker;
+static pthread_mutex_t export_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t export_wake = PTHREAD_COND_INITIALIZER;
+
+static void export_write_json(FILE *fptr, const chip8_introspect_page_t *page) {
+    fprintf(fptr, "{\n  \"timestamp_ns\": %llu,\n",
+            (unsigned long long)telemetry_now_ns());
+    fprintf(fptr, "  \"cycle_count\": %llu,\n  \"frame_count\": %llu,\n"
+                  "  \"ips\": %u,\n  \"pc\": %u,\n",
+            (unsigned long long)page->cycle_count,
+            (unsigned long long)page->frame_count,
+            page->ips, page->program_counter);
+
+    fprintf(fptr, "  \"counters\": {");
+    for (int i = 0; i < telemetry_counter_count(); i++) {
+        const telemetry_counter_t *counter = telemetry_counter_at(i);
+        fprintf(fptr, "%s\"%s\": %llu", i == 0 ? "" : ", ",
+                counter->name, (unsigned long long)counter->value);
+    }
+    fprintf(fptr, "},\n  \"histograms\": {");
+    for (int i = 0; i < telemetry_hist_count(); i++) {
+        const telemetry_hist_t *hist = telemetry_hist_at(i);
+        fprintf(fptr, "%s\n    \"%s\": {\"n\": %llu, \"p50_ns\": %llu, "
+                      "\"p95_ns\": %llu, \"p99_ns\": %llu, \"max_ns\": %llu}",
+                i == 0 ? "" : ",", hist->name,
+                (unsigned long long)hist->count,
+                (unsigned long long)telemetry_percentile(hist, 0.50),
+                (unsigned long long)telemetry_percentile(hist, 0.95),
+                (unsigned long long)telemetry_percentile(hist, 0.99),
+                (unsigned long long)hist->max_ns);
+    }
+    fprintf(fptr, "\n  }\n}\n");
+}
+
+static void export_write_csv(FILE *fptr, const chip8_introspect_page_t *page) {
+    fprintf(fptr, "metric,value,n,p50_ns,p95_ns,p99_ns,max_ns\n");
+    fprintf(fptr, "timestamp ns,%llu,,,,,\n",
+            (unsigned long long)telemetry_now_ns());
+    fprintf(fptr, "cycle count,%llu,,,,,\n",
+            (unsigned long long)page->cycle_count);
+    fprintf(fptr, "frame count,%llu,,,,,\n",
+            (unsigned long long)page->frame_count);
+    fprintf(fptr, "ips,%u,,,,,\n", page->ips);
+    for (int i = 0; i < telemetry_counter_count(); i++) {
+        const telemetry_counter_t *counter = telemetry_counter_at(i);
+        fprintf(fptr, "%s,%llu,,,,,\n", counter->name,
+                (unsigned long long)counter->value);
+    }
+    for (int i = 0; i < telemetry_hist_count(); i++) {
+        const telemetry_hist_t *hist = telemetry_hist_at(i);
+        fprintf(fptr, "%s,,%llu,%llu,%llu,%llu,%llu\n", hist->name,
+                (unsigned long long)hist->count,
+                (unsigned long long)telemetry_percentile(hist, 0.50),
+                (unsigned long long)telemetry_percentile(hist, 0.95),
+                (unsigned long long)telemetry_percentile(hist, 0.99),
+                (unsigned long long)hist->max_ns);
+    }
+}
+
+// Runs on the worker thread only; the rename is the publish
+static void export_write(void) {
+    FILE *fptr = fopen(export_tmp, "w");
+    if (fptr == NULL) {
+        SDL_Log("Error opening export file: %s", export_tmp);
+        return;
+    }
+
+    chip8_introspect_page_t page;
+    introspect_read(&page);
+    if (export_csv) {
+        export_write_csv(fptr, &page);
+    } else {
+        export_write_json(fptr, &page);
+    }
+    fclose(fptr);
+
+    if (rename(export_tmp, export_path) != 0) {
+        SDL_Log("Error publishing export file: %s", export_path);
+    }
+}
+
+static void *export_worker(void *arg) {
+    pthread_mutex_lock(&export_lock);
+    while (!worker_quit) {
+        struct timespec deadline;
+        clock_gettime(CLOCK_REALTIME, &deadline);
+        deadline.tv_sec += export_interval;
+        while (!write_requested && !worker_quit) {
+            if (pthread_cond_timedwait(&export_wake, &export_lock, &deadline) != 0) {
+                break; // Cadence expired
+            }
+        }
+        write_requested = false;
+        pthread_mutex_unlock(&export_lock);
+        export_write();
+        pthread_mutex_lock(&export_lock);
+    }
+    pthread_mutex_unlock(&export_lock);
+    return NULL;
+}
+
+bool export_start(const char *filename, unsigned interval_seconds) {
+    if (worker_started) {
+        return false;
+    }
+    strncpy(export_path, filename, sizeof(export_path) - 1);
+    export_path[sizeof(export_path) - 1] = '\0';
+    snprintf(export_tmp, sizeof(export_tmp), "%s.tmp", export_path);
+    size_t len = strlen(export_path);
+    export_csv = len > 4 && strcmp(export_path + len - 4, ".csv") == 0;
+    export_interval = interval_seconds != 0 ? interval_seconds : 10;
+
+    worker_started = true;
+    worker_quit = false;
+    write_requested = false;
+    pthread_create(&worker, NULL, export_worker, NULL);
+    SDL_Log("Exporting %s telemetry to %s every %us",
+            export_csv ? "CSV" : "JSON", export_path, export_interval);
+    return true;
+}
+
+void export_set_interval(unsigned interval_seconds) {
+    if (!worker_started || interval_seconds == 0) {
+        return;
+    }
+    pthread_mutex_lock(&export_lock);
+    export_interval = interval_seconds; // Next deadline arms on the new value
+    pthread_mutex_unlock(&export_lock);
+    SDL_Log("Telemetry export cadence now %us", interval_seconds);
+}
+
+void export_request(void) {
+    if (!worker_started) {
+        return;
+    }
+    pthread_mutex_lock(&export_lock);
+    write_requested = true;
+    pthread_cond_signal(&export_wake);
+    pthread_mutex_unlock(&export_lock);
+}
+
+void export_stop(void) {
+    if (!worker_started) {
+        return;
+    }
+    pthread_mutex_lock(&export_lock);
+    worker_quit = true;
+    pthread_cond_signal(&export_wake);
+    pthread_mutex_unlock(&export_lock);
+    pthread_join(worker, NULL);
+    worker_started = false;
+
+    export_write(); // Final snapshot so the exit state is scrapable
+}
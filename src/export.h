@@ -0,0 +1,37 @@
+#ifndef EXPORT_H
+#define EXPORT_H
+
+#include <stdbool.h>
+
+/**
+ * Telemetry Exporter
+ *
+ * Serializes every telemetry histogram and counter plus the register
+ * introspection page to a file on a background thread, on a fixed
+ * cadence or on demand, so fleet dashboards can scrape per-instance
+ * stats. The emulation thread never formats a byte: the worker reads
+ * the counters directly (each is a single aligned u64 written by one
+ * thread — monitoring-grade, never torn on the targets we ship) and
+ * the register page through its seqlock. Every write lands in a temp
+ * file renamed into place, so a scraper sees either the previous
+ * snapshot or the new one, never a partial file.
+ *
+ * The format follows the filename: a .csv suffix selects one row per
+ * metric, anything else the JSON document.
+ */
+
+// Spawns the worker writing filename every interval_seconds
+bool export_start(const char *filename, unsigned interval_seconds);
+
+// Queues one off-cadence write (the SIGUSR1 path); just a flag and a
+// wakeup, safe to call from the emulation thread every quantum
+void export_request(void);
+
+// Retunes the cadence on a running worker (the live-config path); takes
+// effect once the wait in flight expires. A no-op before export_start.
+void export_set_interval(unsigned interval_seconds);
+
+// Final write, then joins the worker
+void export_stop(void);
+
+#endif // EXPORT_H
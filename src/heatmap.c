@@ -0,0 +1,93 @@
+#include <stdint.h>
+#include <string.h>
+#include <SDL3/SDL.h>
+
+#include "heatmap.h"
+
+// Interpreter memory in 64-byte regions — one cache line
+// each, and the same granularity the decode cache invalidates at
+#define HEATMAP_REGIONS (CHIP8_MEMORY_BYTES / 64)
+#define HEATMAP_REGION_SHIFT 6
+
+bool heatmap_enabled;
+
+static uint64_t region_reads[HEATMAP_REGIONS];
+static uint64_t region_writes[HEATMAP_REGIONS];
+
+void heatmap_start(void) {
+    memset(region_reads, 0, sizeof(region_reads));
+    memset(region_writes, 0, sizeof(region_writes));
+    heatmap_enabled = true;
+    SDL_Log("Memory heatmap armed (64-byte regions)");
+}
+
+static void heatmap_count(uint64_t *regions, uint16_t addr, int len) {
+    int first = (addr & CHIP8_ADDR_MASK) >> HEATMAP_REGION_SHIFT;
+    int last = ((addr + len - 1) & CHIP8_ADDR_MASK) >> HEATMAP_REGION_SHIFT;
+    for (int region = first; ; region = (region + 1) % HEATMAP_REGIONS) {
+        regions[region]++;
+        if (region == last) {
+            break;
+        }
+    }
+}
+
+void heatmap_read(uint16_t addr, int len) {
+    heatmap_count(region_reads, addr, len);
+}
+
+void heatmap_write(uint16_t addr, int len) {
+    heatmap_count(region_writes, addr, len);
+}
+
+// One glyph per region, log2 intensity: ' ' untouched, then hotter
+// through ".:-=+*#@"
+static void heatmap_strip(const uint64_t *regions, char *out) {
+    static const char ramp[] = ".:-=+*#@";
+    for (int region = 0; region < HEATMAP_REGIONS; region++) {
+        if (regions[region] == 0) {
+            out[region] = ' ';
+            continue;
+        }
+        int magnitude = 63 - __builtin_clzll(regions[region]);
+        out[region] = ramp[magnitude * 8 / 64];
+    }
+    out[HEATMAP_REGIONS] = '\0';
+}
+
+void heatmap_report(void) {
+    if (!heatmap_enabled) {
+        return;
+    }
+
+    char strip[HEATMAP_REGIONS + 1];
+    SDL_Log("Memory heatmap (64B/region, 000-FFF left to right):");
+    heatmap_strip(region_reads, strip);
+    SDL_Log("  reads  |%s|", strip);
+    heatmap_strip(region_writes, strip);
+    SDL_Log("  writes |%s|", strip);
+
+    // Working set: regions touched at all, and the subset written. Writes
+    // at or above the load address hit the ROM image itself — decode (and
+    // possibly sprite) invalidation territory.
+    int touched = 0;
+    int written = 0;
+    uint64_t rom_writes = 0;
+    for (int region = 0; region < HEATMAP_REGIONS; region++) {
+        if (region_reads[region] != 0 || region_writes[region] != 0) {
+            touched++;
+        }
+        if (region_writes[region] != 0) {
+            written++;
+            if (region >= 0x200 >> HEATMAP_REGION_SHIFT) {
+                rom_writes += region_writes[region];
+            }
+        }
+    }
+    SDL_Log("  working set %d bytes (%d bytes written)",
+            touched << HEATMAP_REGION_SHIFT, written << HEATMAP_REGION_SHIFT);
+    if (rom_writes != 0) {
+        SDL_Log("  %llu writes into the ROM range: self-modifying, expect "
+                "decode invalidations", (unsigned long long)rom_writes);
+    }
+}
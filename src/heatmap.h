@@ -0,0 +1,31 @@
+#ifndef HEATMAP_H
+#define HEATMAP_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "chip8.h"
+
+/**
+ * Memory Heatmap
+ *
+ * Opt-in read/write counters per 64-byte region of interpreter memory,
+ * fed by the load/store/BCD handlers and the sprite fetch in the draw
+ * path. The exit dump shows the ROM's data working set — the input for
+ * sizing the decode and sprite caches — and flags writes landing in the
+ * code range, which mark self-modifying ROMs that will thrash decode
+ * invalidation.
+ */
+
+extern bool heatmap_enabled;
+
+void heatmap_start(void);
+
+// Counts a read or write of len bytes starting at addr (emulation thread)
+void heatmap_read(uint16_t addr, int len);
+void heatmap_write(uint16_t addr, int len);
+
+// Logs the per-region heatmap and working-set summary
+void heatmap_report(void);
+
+#endif // HEATMAP_H
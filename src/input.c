@@ -1,5 +1,45 @@
+#include <stdio.h>
+#include <string.h>
 #include <SDL3/SDL.h>
 
+#include "input.h"
+#include "rawinput.h"
+#include "latency.h"
+#include "telemetry.h"
+
+/* Contact debounce (--debounce [ms]): arcade matrix encoders chatter on
+   make and break, and a ROM testing EX9E in a tight loop sees every
+   bounce as a distinct press. Lockout scheme keyed on the event's own
+   timestamp: the first transition of a key is accepted and opens a
+   window during which further transitions of that key are dropped. A
+   held key settles on "down" and a released one on "up" because the
+   first edge of each burst is the real one — only the bounces that
+   follow it get eaten. Costs one compare per event, nothing per tick. */
+static uint64_t debounce_window_ns; // 0 = off (the default)
+static uint64_t key_accepted_ns[16]; // Timestamp of the last accepted edge
+static bool key_down_state[16]; // Keypad state as last accepted
+
+// True when the transition is chatter to swallow; updates the accepted
+// state otherwise. Duplicate-state events (OS key repeat) pass through
+// untouched — they are not edges. Exported so the raw evdev backend
+// runs its edges through the same window.
+bool input_debounce_reject(uint8_t key, bool down, uint64_t timestamp) {
+    if (debounce_window_ns == 0 || down == key_down_state[key]) {
+        return false;
+    }
+    if (timestamp - key_accepted_ns[key] < debounce_window_ns) {
+        telemetry_input_chatter.value++;
+        return true;
+    }
+    key_down_state[key] = down;
+    key_accepted_ns[key] = timestamp;
+    return false;
+}
+
+void input_set_debounce(uint32_t window_ms) {
+    debounce_window_ns = (uint64_t)window_ms * 1000000ULL;
+}
+
 static const SDL_Scancode keys[] = {
     SDL_SCANCODE_1,
     SDL_SCANCODE_2,
@@ -25,11 +65,218 @@ static const uint8_t key_map[] = {
     0xA, 0x0, 0xB, 0xF
 };
 
-void get_input(uint8_t *keypad) {
-    const bool* keyboard = SDL_GetKeyboardState(NULL);
+// Scancode-indexed lookup built once from keys[]/key_map[]; 0xFF = unmapped
+static uint8_t scancode_to_key[SDL_SCANCODE_COUNT];
+static bool lut_built = false;
+
+static void build_key_lut(void) {
+    for (int i = 0; i < SDL_SCANCODE_COUNT; i++) {
+        scancode_to_key[i] = 0xFF;
+    }
 
     size_t num_keys = sizeof(keys) / sizeof(keys[0]);
-    for (int i = 0; i < num_keys; i++) {
-        keypad[key_map[i]] = keyboard[keys[i]] ? 1 : 0;
+    for (size_t i = 0; i < num_keys; i++) {
+        scancode_to_key[keys[i]] = key_map[i];
+    }
+    lut_built = true;
+}
+
+/* Gamepad support: cabinets with USB encoders present as gamepads. Buttons
+   route through a preallocated button-indexed LUT exactly like keyboard
+   scancodes, and the left stick synthesizes dpad presses past a dead zone.
+   Hotplug opens/closes pads in a fixed slot table — nothing allocates in
+   the event path. */
+#define MAX_GAMEPADS 4
+#define AXIS_THRESHOLD 16384
+
+static SDL_Gamepad *gamepads[MAX_GAMEPADS];
+static uint8_t button_to_key[SDL_GAMEPAD_BUTTON_COUNT];
+static bool pad_lut_built = false;
+static int axis_state[2]; // Left stick X/Y direction: -1, 0, +1
+
+static void build_pad_lut(void) {
+    for (int i = 0; i < SDL_GAMEPAD_BUTTON_COUNT; i++) {
+        button_to_key[i] = 0xFF;
+    }
+
+    // Dpad on the classic 2/4/6/8 movement keys, face buttons mirroring
+    // them for one-handed play, 5 on the primary action button
+    button_to_key[SDL_GAMEPAD_BUTTON_DPAD_UP] = 0x2;
+    button_to_key[SDL_GAMEPAD_BUTTON_DPAD_LEFT] = 0x4;
+    button_to_key[SDL_GAMEPAD_BUTTON_DPAD_RIGHT] = 0x6;
+    button_to_key[SDL_GAMEPAD_BUTTON_DPAD_DOWN] = 0x8;
+    button_to_key[SDL_GAMEPAD_BUTTON_SOUTH] = 0x5;
+    button_to_key[SDL_GAMEPAD_BUTTON_EAST] = 0x6;
+    button_to_key[SDL_GAMEPAD_BUTTON_WEST] = 0x4;
+    button_to_key[SDL_GAMEPAD_BUTTON_NORTH] = 0x2;
+    button_to_key[SDL_GAMEPAD_BUTTON_START] = 0xF;
+    button_to_key[SDL_GAMEPAD_BUTTON_BACK] = 0xB;
+    pad_lut_built = true;
+}
+
+// Maps one stick axis onto the dpad key pair for that direction, releasing
+// the previously synthesized key when the stick re-centers or flips
+static void route_axis(int axis, int value, chip8_state_t *state) {
+    int direction = value < -AXIS_THRESHOLD ? -1 : value > AXIS_THRESHOLD ? 1 : 0;
+    if (direction == axis_state[axis]) {
+        return;
+    }
+
+    uint8_t negative = button_to_key[axis == 0 ? SDL_GAMEPAD_BUTTON_DPAD_LEFT
+                                               : SDL_GAMEPAD_BUTTON_DPAD_UP];
+    uint8_t positive = button_to_key[axis == 0 ? SDL_GAMEPAD_BUTTON_DPAD_RIGHT
+                                               : SDL_GAMEPAD_BUTTON_DPAD_DOWN];
+    if (axis_state[axis] < 0 && negative != 0xFF) {
+        chip8_key_set(state, negative, false);
+    }
+    if (axis_state[axis] > 0 && positive != 0xFF) {
+        chip8_key_set(state, positive, false);
+    }
+    if (direction < 0 && negative != 0xFF) {
+        chip8_key_set(state, negative, true);
+    }
+    if (direction > 0 && positive != 0xFF) {
+        chip8_key_set(state, positive, true);
+    }
+    axis_state[axis] = direction;
+}
+
+void handle_gamepad_event(const SDL_Event *event, chip8_state_t *state) {
+    if (!pad_lut_built) {
+        build_pad_lut();
+    }
+
+    switch (event->type) {
+        case SDL_EVENT_GAMEPAD_ADDED:
+            for (int i = 0; i < MAX_GAMEPADS; i++) {
+                if (gamepads[i] == NULL) {
+                    gamepads[i] = SDL_OpenGamepad(event->gdevice.which);
+                    SDL_Log("Gamepad connected: %s", SDL_GetGamepadName(gamepads[i]));
+                    break;
+                }
+            }
+            break;
+
+        case SDL_EVENT_GAMEPAD_REMOVED:
+            for (int i = 0; i < MAX_GAMEPADS; i++) {
+                if (gamepads[i] != NULL &&
+                    SDL_GetGamepadID(gamepads[i]) == event->gdevice.which) {
+                    SDL_CloseGamepad(gamepads[i]);
+                    gamepads[i] = NULL;
+                    break;
+                }
+            }
+            break;
+
+        case SDL_EVENT_GAMEPAD_BUTTON_DOWN:
+        case SDL_EVENT_GAMEPAD_BUTTON_UP: {
+            uint8_t key = event->gbutton.button < SDL_GAMEPAD_BUTTON_COUNT
+                        ? button_to_key[event->gbutton.button] : 0xFF;
+            if (key != 0xFF) {
+                bool down = event->type == SDL_EVENT_GAMEPAD_BUTTON_DOWN;
+                if (input_debounce_reject(key, down, event->gbutton.timestamp)) {
+                    break;
+                }
+                if (latency_enabled && down) {
+                    latency_key_event();
+                }
+                chip8_key_set(state, key, down);
+            }
+            break;
+        }
+
+        case SDL_EVENT_GAMEPAD_AXIS_MOTION:
+            if (event->gaxis.axis == SDL_GAMEPAD_AXIS_LEFTX) {
+                route_axis(0, event->gaxis.value, state);
+            } else if (event->gaxis.axis == SDL_GAMEPAD_AXIS_LEFTY) {
+                route_axis(1, event->gaxis.value, state);
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
+// Overrides bindings from a config file, one per line ('#' starts a
+// comment): <SDL key name> <keypad hex digit>. Names are whatever
+// SDL_GetScancodeFromName accepts ("Up", "Keypad 5", "G", ...). Entries
+// override the defaults individually, so a site config only lists the
+// keys its matrix moves.
+bool input_load_bindings(const char *filename) {
+    FILE *fptr = fopen(filename, "r");
+    if (fptr == NULL) {
+        return true; // No config is not an error: keep the defaults
+    }
+    if (!lut_built) {
+        build_key_lut();
+    }
+    if (!pad_lut_built) {
+        build_pad_lut();
+    }
+
+    int loaded = 0;
+    char line[128];
+    while (fgets(line, sizeof(line), fptr) != NULL) {
+        char name[64];
+        unsigned int key;
+        if (line[0] == '#' || sscanf(line, "%63[^\t ] %x", name, &key) != 2 || key > 0xF) {
+            continue;
+        }
+
+        // "pad:" entries bind gamepad buttons by their SDL string name
+        // ("a", "dpup", "start", ...); anything else is a key name
+        if (strncmp(name, "pad:", 4) == 0) {
+            SDL_GamepadButton button = SDL_GetGamepadButtonFromString(name + 4);
+            if (button == SDL_GAMEPAD_BUTTON_INVALID) {
+                SDL_Log("Ignoring key binding: %s", line);
+                continue;
+            }
+            button_to_key[button] = (uint8_t)key;
+        } else {
+            SDL_Scancode scancode = SDL_GetScancodeFromName(name);
+            if (scancode == SDL_SCANCODE_UNKNOWN) {
+                SDL_Log("Ignoring key binding: %s", line);
+                continue;
+            }
+            scancode_to_key[scancode] = (uint8_t)key;
+        }
+        loaded++;
+    }
+    fclose(fptr);
+
+    SDL_Log("Loaded %d key bindings from %s", loaded, filename);
+    return true;
+}
+
+// Updates the keypad from one SDL key event: a single atomic bit flip per
+// keystroke instead of rewriting all 16 entries every tick.
+void handle_key_event(const SDL_Event *event, chip8_state_t *state) {
+    if (event->type != SDL_EVENT_KEY_DOWN && event->type != SDL_EVENT_KEY_UP) {
+        return;
+    }
+    if (rawinput_active) {
+        return; // The evdev backend owns the keyboard; the SDL copy of
+                // the same keystroke would double-fire the edge
+    }
+    if (!lut_built) {
+        build_key_lut();
+    }
+
+    SDL_Scancode scancode = event->key.scancode;
+    if (scancode < 0 || scancode >= SDL_SCANCODE_COUNT) {
+        return;
+    }
+
+    uint8_t key = scancode_to_key[scancode];
+    if (key != 0xFF) {
+        bool down = event->type == SDL_EVENT_KEY_DOWN;
+        if (input_debounce_reject(key, down, event->key.timestamp)) {
+            return;
+        }
+        if (latency_enabled && down) {
+            latency_key_event();
+        }
+        chip8_key_set(state, key, down);
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,38 @@
+#ifndef INPUT_H
+#define INPUT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include <SDL3/SDL.h>
+
+#include "chip8.h"
+
+/**
+ * Chip-8 Keypad Input
+ *
+ * Maps host key events onto the 16-key Chip-8 keypad through a
+ * scancode-indexed lookup table.
+ */
+
+void handle_key_event(const SDL_Event *event, chip8_state_t *state);
+
+// Routes gamepad hotplug, button, and left-stick events onto the keypad
+// through a button-indexed LUT; ignores non-gamepad events
+void handle_gamepad_event(const SDL_Event *event, chip8_state_t *state);
+
+// Overrides default bindings from a config file; a missing file keeps the
+// defaults. One "<SDL key name> <keypad hex digit>" entry per line.
+bool input_load_bindings(const char *filename);
+
+// Shared with the raw evdev backend so both paths sit behind the same
+// chatter window; true when the transition should be swallowed
+bool input_debounce_reject(uint8_t key, bool down, uint64_t timestamp_ns);
+
+// Enables contact debounce with the given lockout window (0 disables):
+// after an accepted keypad transition, further transitions of that key
+// within the window are dropped as encoder chatter and counted into
+// telemetry. Purely event-driven — nothing runs per tick.
+void input_set_debounce(uint32_t window_ms);
+
+#endif // INPUT_H
@@ -0,0 +1,120 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <SDL3/SDL.h>
+
+#include "introspect.h"
+
+#define INTROSPECT_MAGIC 0x54533843u // "C8ST" little-endian
+#define INTROSPECT_VERSION 1
+
+_Static_assert(sizeof(chip8_introspect_page_t) == 64,
+               "introspection page must stay one cache line");
+
+typedef struct introspect_region {
+    uint32_t magic;
+    uint32_t version;
+    chip8_introspect_page_t page;
+} introspect_region_t;
+
+// In-process page; the shm export duplicates the same writes
+static chip8_introspect_page_t local_page;
+
+static introspect_region_t *region;
+static char region_name[64];
+
+static void introspect_write(chip8_introspect_page_t *page,
+                             const chip8_state_t *state, uint64_t frame) {
+    uint32_t seq = atomic_load_explicit(&page->sequence, memory_order_relaxed);
+    atomic_store_explicit(&page->sequence, seq + 1, memory_order_relaxed);
+    // The fence keeps the field writes below from hoisting above the odd
+    // store (a release store only orders what precedes it); it pairs with
+    // the reader's acquire fence after its copy
+    atomic_thread_fence(memory_order_release);
+
+    page->program_counter = state->program_counter;
+    page->index_register = state->index_register;
+    page->stack_ptr = state->stack_ptr;
+    page->delay_timer = state->delay_timer;
+    page->sound_timer = state->sound_timer;
+    page->hires = state->hires;
+    memcpy(page->registers, state->registers, sizeof(page->registers));
+    page->keypad = atomic_load_explicit(&state->keypad, memory_order_relaxed);
+    page->profile = (uint8_t)state->profile;
+    page->core = (uint8_t)state->core;
+    page->cycle_count = state->cycle_count;
+    page->frame_count = frame;
+    page->ips = state->ips;
+
+    atomic_store_explicit(&page->sequence, seq + 2, memory_order_release);
+}
+
+void introspect_publish(const chip8_state_t *state) {
+    static uint64_t frame_count;
+    frame_count++;
+
+    introspect_write(&local_page, state, frame_count);
+    if (region != NULL) {
+        introspect_write(&region->page, state, frame_count);
+    }
+}
+
+void introspect_read(chip8_introspect_page_t *out) {
+    for (;;) {
+        uint32_t before = atomic_load_explicit(&local_page.sequence, memory_order_acquire);
+        if (before & 1) {
+            continue; // Write in flight
+        }
+        memcpy(out, &local_page, sizeof(*out));
+        atomic_thread_fence(memory_order_acquire);
+        if (atomic_load_explicit(&local_page.sequence, memory_order_relaxed) == before) {
+            return;
+        }
+    }
+}
+
+bool introspect_start(const char *name) {
+    snprintf(region_name, sizeof(region_name), "/%s", name);
+    shm_unlink(region_name); // Replace a stale region from a crashed run
+
+    int fd = shm_open(region_name, O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0) {
+        SDL_Log("Couldn't create introspection region %s", region_name);
+        return false;
+    }
+    if (ftruncate(fd, sizeof(introspect_region_t)) != 0) {
+        SDL_Log("Couldn't size introspection region %s", region_name);
+        close(fd);
+        shm_unlink(region_name);
+        return false;
+    }
+    region = mmap(NULL, sizeof(introspect_region_t), PROT_READ | PROT_WRITE,
+                  MAP_SHARED, fd, 0);
+    close(fd); // The mapping keeps the region alive
+    if (region == MAP_FAILED) {
+        SDL_Log("Couldn't map introspection region %s", region_name);
+        region = NULL;
+        shm_unlink(region_name);
+        return false;
+    }
+
+    memset(region, 0, sizeof(*region));
+    region->version = INTROSPECT_VERSION;
+    region->magic = INTROSPECT_MAGIC; // Written last: magic means ready
+
+    SDL_Log("Publishing register file to shared memory %s", region_name);
+    return true;
+}
+
+void introspect_stop(void) {
+    if (region == NULL) {
+        return;
+    }
+    munmap(region, sizeof(introspect_region_t));
+    region = NULL;
+    shm_unlink(region_name);
+}
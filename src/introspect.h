@@ -0,0 +1,56 @@
+#ifndef INTROSPECT_H
+#define INTROSPECT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "chip8.h"
+
+/**
+ * Register-File Introspection Page
+ *
+ * The debugger, HUD, scripting, and remote monitors all want to read
+ * registers/pc/timers without stopping the interpreter. Once per frame
+ * the emulation thread mirrors the hot state into a 64-byte snapshot
+ * guarded by a seqlock — one cache-line write, no lock an observer could
+ * ever contend on. Readers retry until they see a stable even sequence.
+ *
+ * With --introspect [name] the same page is additionally published to
+ * POSIX shared memory (default /chip8-state, same header discipline as
+ * the frame export in shmframe.h), so external tools attach read-only
+ * and poll at whatever rate they like.
+ */
+
+// One cache line: sequence (odd while a write is in flight) plus the
+// fields every observer asks for
+typedef struct chip8_introspect_page {
+    _Atomic uint32_t sequence;
+    uint16_t program_counter;
+    uint16_t index_register;
+    uint8_t stack_ptr;
+    uint8_t delay_timer;
+    uint8_t sound_timer;
+    uint8_t hires;
+    uint8_t registers[16];
+    uint16_t keypad;
+    uint8_t profile;
+    uint8_t core;
+    uint64_t cycle_count;
+    uint64_t frame_count; // Publishes since init; also the write cadence
+    uint32_t ips;
+    uint32_t padding[3]; // Pad to exactly one cache line (introspect.c asserts)
+} chip8_introspect_page_t;
+
+// Mirrors the state into the in-process page; called once per 60Hz
+// quantum on the emulation thread
+void introspect_publish(const chip8_state_t *state);
+
+// Seqlock read of the in-process page; spins past in-flight writes
+// (a handful of cycles at worst — the writer never blocks inside one)
+void introspect_read(chip8_introspect_page_t *out);
+
+// Additionally exports the page to shared memory for external tools
+bool introspect_start(const char *name);
+void introspect_stop(void);
+
+#endif // INTROSPECT_H
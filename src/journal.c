@@ -0,0 +1,110 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <SDL3/SDL.h>
+
+#include "journal.h"
+#include "savestate.h"
+
+#define JOURNAL_MAGIC 0x4C4A3843u // "C8JL" little-endian
+#define JOURNAL_VERSION 1
+#define JOURNAL_SLOTS 2
+
+// Each slot: leading sequence, savestate bytes, trailing sequence. The two
+// sequence copies only match once the whole slot has landed.
+#define JOURNAL_SLOT_SIZE (8 + CHIP8_SAVESTATE_SIZE + 8)
+#define JOURNAL_HEADER_SIZE 16
+#define JOURNAL_FILE_SIZE (JOURNAL_HEADER_SIZE + JOURNAL_SLOTS * JOURNAL_SLOT_SIZE)
+
+static uint8_t *journal_map;
+static uint64_t journal_seq;
+
+static uint8_t *journal_slot(int slot) {
+    return journal_map + JOURNAL_HEADER_SIZE + slot * JOURNAL_SLOT_SIZE;
+}
+
+static uint64_t journal_slot_seq(int slot) {
+    uint64_t lead;
+    uint64_t trail;
+    memcpy(&lead, journal_slot(slot), 8);
+    memcpy(&trail, journal_slot(slot) + 8 + CHIP8_SAVESTATE_SIZE, 8);
+    return lead != 0 && lead == trail ? lead : 0;
+}
+
+bool journal_open(const char *filename, chip8_state_t *state) {
+    int fd = open(filename, O_RDWR | O_CREAT, 0644);
+    if (fd < 0) {
+        SDL_Log("Error opening journal file: %s", filename);
+        return false;
+    }
+    if (ftruncate(fd, JOURNAL_FILE_SIZE) != 0) {
+        SDL_Log("Error sizing journal file: %s", filename);
+        close(fd);
+        return false;
+    }
+
+    journal_map = mmap(NULL, JOURNAL_FILE_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd); // The mapping keeps the file alive
+    if (journal_map == MAP_FAILED) {
+        journal_map = NULL;
+        SDL_Log("Error mapping journal file: %s", filename);
+        return false;
+    }
+
+    uint32_t magic;
+    memcpy(&magic, journal_map, 4);
+    if (magic == JOURNAL_MAGIC) {
+        // Existing journal: restore the newest intact checkpoint, if any
+        int best_slot = -1;
+        uint64_t best_seq = 0;
+        for (int slot = 0; slot < JOURNAL_SLOTS; slot++) {
+            uint64_t seq = journal_slot_seq(slot);
+            if (seq > best_seq) {
+                best_seq = seq;
+                best_slot = slot;
+            }
+        }
+        if (best_slot >= 0 &&
+            chip8_load_state(state, journal_slot(best_slot) + 8, CHIP8_SAVESTATE_SIZE)) {
+            journal_seq = best_seq;
+            SDL_Log("Restored journal checkpoint %llu from %s",
+                    (unsigned long long)best_seq, filename);
+        }
+    } else {
+        // Fresh journal: stamp the header and zero the slots
+        memset(journal_map, 0, JOURNAL_FILE_SIZE);
+        uint32_t header[2] = {JOURNAL_MAGIC, JOURNAL_VERSION};
+        memcpy(journal_map, header, 8);
+    }
+    return true;
+}
+
+void journal_checkpoint(const chip8_state_t *state) {
+    if (journal_map == NULL) {
+        return;
+    }
+
+    // Alternate slots so the previous checkpoint stays intact while this
+    // one is in flight
+    journal_seq++;
+    uint8_t *slot = journal_slot((int)(journal_seq % JOURNAL_SLOTS));
+    memcpy(slot, &journal_seq, 8);
+    chip8_save_state(state, slot + 8, CHIP8_SAVESTATE_SIZE);
+    memcpy(slot + 8 + CHIP8_SAVESTATE_SIZE, &journal_seq, 8);
+
+    // Async: schedules the dirty pages and returns immediately
+    msync(journal_map, JOURNAL_FILE_SIZE, MS_ASYNC);
+}
+
+void journal_close(void) {
+    if (journal_map == NULL) {
+        return;
+    }
+    msync(journal_map, JOURNAL_FILE_SIZE, MS_SYNC);
+    munmap(journal_map, JOURNAL_FILE_SIZE);
+    journal_map = NULL;
+    journal_seq = 0;
+}
@@ -0,0 +1,33 @@
+#ifndef JOURNAL_H
+#define JOURNAL_H
+
+#include <stdbool.h>
+
+#include "chip8.h"
+
+/**
+ * Crash-Safe Session Journal
+ *
+ * Periodically checkpoints the interpreter state into a memory-mapped file
+ * so a hosted session survives power loss. Two slots alternate writes, each
+ * framed by a matching sequence number before and after the savestate
+ * bytes: a torn write corrupts at most the slot being written, and restore
+ * picks the newest slot whose frame is intact.
+ *
+ * A checkpoint is chip8_save_state straight into the mapping plus an async
+ * msync — no allocation, no copy through a scratch buffer — so journaling
+ * at 1Hz does not register in the tick-time histograms.
+ */
+
+// Maps (creating if needed) the journal file. If it holds a valid
+// checkpoint, the newest one is restored into state. Returns false only if
+// the file can't be mapped.
+bool journal_open(const char *filename, chip8_state_t *state);
+
+// Writes the next checkpoint into the older slot and schedules it to disk
+void journal_checkpoint(const chip8_state_t *state);
+
+// Flushes synchronously and unmaps. Safe to call without a journal open.
+void journal_close(void);
+
+#endif // JOURNAL_H
@@ -0,0 +1,74 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <SDL3/SDL.h>
+
+#include "latency.h"
+#include "telemetry.h"
+
+/* One keystroke is tracked at a time and the stages advance in order on
+   the emulation thread; only the final edge (publish -> present) crosses
+   to the render thread, through an atomic arm flag. A keystroke the ROM
+   never tests (menus, unmapped game keys) is simply replaced by the next
+   one rather than counted, so the distributions only contain trips the
+   program actually reacted to. */
+
+bool latency_enabled;
+
+enum {
+    LATENCY_IDLE,
+    LATENCY_KEY,  // Keystroke seen, waiting for EX9E/EXA1 to test it
+    LATENCY_SKIP, // Tested while down, waiting for the next draw
+    LATENCY_DRAW, // Drawn, waiting for the frame publish
+};
+
+static int stage = LATENCY_IDLE;
+static uint64_t key_ns;
+
+// Handoff to the render thread: timestamps are written before the arm
+// flag is set, and SDL atomics are full barriers, so the reader side
+// sees them once the compare-and-swap claims the flag
+static SDL_AtomicInt photon_armed;
+static uint64_t armed_key_ns;
+static uint64_t armed_publish_ns;
+
+void latency_key_event(void) {
+    key_ns = telemetry_now_ns();
+    stage = LATENCY_KEY; // Restart: supersedes an unconsumed keystroke
+}
+
+void latency_skip_consumed(void) {
+    if (stage != LATENCY_KEY) {
+        return;
+    }
+    telemetry_record(&telemetry_latency_consume, telemetry_now_ns() - key_ns);
+    stage = LATENCY_SKIP;
+}
+
+void latency_draw(void) {
+    if (stage != LATENCY_SKIP) {
+        return;
+    }
+    stage = LATENCY_DRAW;
+}
+
+void latency_publish(void) {
+    if (stage != LATENCY_DRAW) {
+        return;
+    }
+    stage = LATENCY_IDLE;
+    if (SDL_GetAtomicInt(&photon_armed)) {
+        return; // Previous trip still waiting on its present
+    }
+    armed_key_ns = key_ns;
+    armed_publish_ns = telemetry_now_ns();
+    SDL_SetAtomicInt(&photon_armed, 1);
+}
+
+void latency_present(void) {
+    if (!SDL_CompareAndSwapAtomicInt(&photon_armed, 1, 0)) {
+        return;
+    }
+    uint64_t now = telemetry_now_ns();
+    telemetry_record(&telemetry_latency_scanout, now - armed_publish_ns);
+    telemetry_record(&telemetry_latency_photon, now - armed_key_ns);
+}
@@ -0,0 +1,33 @@
+#ifndef LATENCY_H
+#define LATENCY_H
+
+#include <stdbool.h>
+
+/**
+ * Input-to-Photon Latency Instrumentation
+ *
+ * Opt-in mode (--latency) that follows a keystroke end to end: the SDL
+ * key event, the EX9E/EXA1 skip test that consumes it, the DXYN that
+ * reacts, the frame publish, and the present that puts the result on
+ * screen. Each completed trip lands in the telemetry histograms, so a
+ * run prints the stage and total distributions on exit and two ROMs (or
+ * two builds) can be A/B'd against the cabinet input-to-display budget.
+ */
+
+extern bool latency_enabled;
+
+// Frontend, emulation thread: a mapped keypad key went down
+void latency_key_event(void);
+
+// Core hooks, emulation thread: an EX9E/EXA1 observed the tracked key
+// down; a draw executed afterwards
+void latency_skip_consumed(void);
+void latency_draw(void);
+
+// Emulation thread: the frame holding the tracked draw was published
+void latency_publish(void);
+
+// Render thread: a published frame reached the present call
+void latency_present(void);
+
+#endif // LATENCY_H
@@ -0,0 +1,179 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <SDL3/SDL.h>
+
+#include "chip8.h"
+#include "library.h"
+#include "romdb.h"
+
+#define LIBRARY_MAGIC 0x584C3843u // "C8LX" little-endian
+#define LIBRARY_VERSION 1
+#define LIBRARY_CAPACITY 4096
+
+static library_entry_t entries[LIBRARY_CAPACITY];
+static size_t entry_count;
+
+const char *library_variant_name(library_variant_t variant) {
+    switch (variant) {
+        case LIBRARY_VARIANT_SCHIP: return "schip";
+        case LIBRARY_VARIANT_XOCHIP: return "xochip";
+        default: return "chip8";
+    }
+}
+
+/* Static opcode scan: walk the image as big-endian words at even offsets
+   and look for opcodes exclusive to each extension. Data bytes can fake a
+   match, but the XO-CHIP markers (long index, plane select) are unlikely
+   byte pairs and SCHIP misdetection is harmless — its quirks only differ
+   where SCHIP opcodes are actually executed. */
+static library_variant_t library_detect_variant(const uint8_t *data, size_t size) {
+    library_variant_t variant = LIBRARY_VARIANT_CHIP8;
+
+    for (size_t i = 0; i + 1 < size; i += 2) {
+        uint16_t word = (uint16_t)(data[i] << 8 | data[i + 1]);
+
+        // XO-CHIP: long index prefix, plane select, audio buffer, scroll-up
+        if (word == 0xF000 || (word & 0xF0FF) == 0xF001 || word == 0xF002 ||
+            (word & 0xFFF0) == 0x00D0) {
+            return LIBRARY_VARIANT_XOCHIP;
+        }
+        // SCHIP: hires switches, scrolls, 16x16 sprites, RPL flags
+        if (word == 0x00FF || word == 0x00FE || word == 0x00FB || word == 0x00FC ||
+            (word & 0xFFF0) == 0x00C0 || (word & 0xF00F) == 0xD000 ||
+            (word & 0xF0FF) == 0xF075 || (word & 0xF0FF) == 0xF085) {
+            variant = LIBRARY_VARIANT_SCHIP;
+        }
+    }
+    return variant;
+}
+
+// Fresh entries are matched by path + size + mtime; anything else re-reads
+static const library_entry_t *library_cached(const library_entry_t *old, size_t old_count,
+                                             const char *path, uint64_t size, uint64_t mtime) {
+    for (size_t i = 0; i < old_count; i++) {
+        if (old[i].size == size && old[i].mtime == mtime &&
+            strcmp(old[i].path, path) == 0) {
+            return &old[i];
+        }
+    }
+    return NULL;
+}
+
+static size_t library_index_read(const char *index_file, library_entry_t *out, size_t capacity) {
+    FILE *fptr = fopen(index_file, "rb");
+    if (fptr == NULL) {
+        return 0; // No index yet; everything gets scanned
+    }
+
+    uint32_t header[3]; // magic, version, count
+    size_t count = 0;
+    if (fread(header, sizeof(header), 1, fptr) == 1 &&
+        header[0] == LIBRARY_MAGIC && header[1] == LIBRARY_VERSION &&
+        header[2] <= capacity) {
+        count = fread(out, sizeof(library_entry_t), header[2], fptr);
+    }
+    fclose(fptr);
+    return count;
+}
+
+static bool library_index_write(const char *index_file) {
+    FILE *fptr = fopen(index_file, "wb");
+    if (fptr == NULL) {
+        SDL_Log("Error writing library index: %s", index_file);
+        return false;
+    }
+
+    uint32_t header[3] = {LIBRARY_MAGIC, LIBRARY_VERSION, (uint32_t)entry_count};
+    bool ok = fwrite(header, sizeof(header), 1, fptr) == 1 &&
+              fwrite(entries, sizeof(library_entry_t), entry_count, fptr) == entry_count;
+    fclose(fptr);
+    return ok;
+}
+
+static bool library_scan_file(const char *path, uint64_t size, uint64_t mtime) {
+    if (entry_count >= LIBRARY_CAPACITY) {
+        return false;
+    }
+
+    FILE *fptr = fopen(path, "rb");
+    if (fptr == NULL) {
+        return false;
+    }
+    // Larger than any loadable ROM in either memory configuration; static
+    // because the 64K build would put it past comfortable stack use
+    static uint8_t data[CHIP8_MEMORY_BYTES];
+    size_t read = fread(data, 1, sizeof(data), fptr);
+    fclose(fptr);
+
+    library_entry_t *entry = &entries[entry_count++];
+    strncpy(entry->path, path, sizeof(entry->path) - 1);
+    entry->path[sizeof(entry->path) - 1] = '\0';
+    entry->size = size;
+    entry->mtime = mtime;
+    entry->hash = romdb_hash(data, read);
+    entry->variant = (uint8_t)library_detect_variant(data, read);
+    return true;
+}
+
+bool library_scan(const char *directory, const char *index_file) {
+    // Previous index moves aside so the rebuilt one can reuse fresh entries
+    static library_entry_t old_entries[LIBRARY_CAPACITY];
+    size_t old_count = library_index_read(index_file, old_entries, LIBRARY_CAPACITY);
+
+    DIR *dir = opendir(directory);
+    if (dir == NULL) {
+        SDL_Log("Error opening ROM directory: %s", directory);
+        return false;
+    }
+
+    entry_count = 0;
+    size_t reused = 0;
+    struct dirent *dent;
+    while ((dent = readdir(dir)) != NULL && entry_count < LIBRARY_CAPACITY) {
+        char path[256];
+        if (SDL_snprintf(path, sizeof(path), "%s/%s", directory, dent->d_name) >= (int)sizeof(path)) {
+            continue;
+        }
+
+        struct stat st;
+        if (stat(path, &st) != 0 || !S_ISREG(st.st_mode)) {
+            continue;
+        }
+
+        const library_entry_t *cached = library_cached(old_entries, old_count, path,
+                                                       (uint64_t)st.st_size,
+                                                       (uint64_t)st.st_mtime);
+        if (cached != NULL) {
+            entries[entry_count++] = *cached;
+            reused++;
+        } else {
+            library_scan_file(path, (uint64_t)st.st_size, (uint64_t)st.st_mtime);
+        }
+    }
+    closedir(dir);
+
+    library_index_write(index_file);
+    SDL_Log("Library: %zu ROMs indexed (%zu from cache)", entry_count, reused);
+    return true;
+}
+
+size_t library_count(void) {
+    return entry_count;
+}
+
+const library_entry_t *library_get(size_t i) {
+    return i < entry_count ? &entries[i] : NULL;
+}
+
+const library_entry_t *library_find(uint64_t hash) {
+    for (size_t i = 0; i < entry_count; i++) {
+        if (entries[i].hash == hash) {
+            return &entries[i];
+        }
+    }
+    return NULL;
+}
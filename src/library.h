@@ -0,0 +1,44 @@
+#ifndef LIBRARY_H
+#define LIBRARY_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * ROM Library Index
+ *
+ * Scans a directory of ROMs once, extracting size, content hash, and the
+ * detected instruction-set variant (plain CHIP-8, SCHIP, or XO-CHIP via a
+ * static opcode scan), and persists the results in a binary index file.
+ * Subsequent scans reuse any cached entry whose size and mtime are
+ * unchanged, so startup over a library of thousands of ROMs only stats
+ * files instead of re-reading them.
+ */
+
+typedef enum library_variant {
+    LIBRARY_VARIANT_CHIP8 = 0,
+    LIBRARY_VARIANT_SCHIP = 1,
+    LIBRARY_VARIANT_XOCHIP = 2,
+} library_variant_t;
+
+typedef struct library_entry {
+    char path[256];
+    uint64_t size;
+    uint64_t mtime;
+    uint64_t hash; // Same FNV-1a as romdb_hash, so entries key romdb configs
+    uint8_t variant;
+} library_entry_t;
+
+// Scans `directory`, reusing `index_file` where entries are still fresh,
+// and rewrites the index. Returns false if the directory can't be read.
+bool library_scan(const char *directory, const char *index_file);
+
+// Access to the in-memory index built by the last scan
+size_t library_count(void);
+const library_entry_t *library_get(size_t i);
+const library_entry_t *library_find(uint64_t hash);
+
+const char *library_variant_name(library_variant_t variant);
+
+#endif // LIBRARY_H
@@ -0,0 +1,161 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <sys/stat.h>
+#include <SDL3/SDL.h>
+
+#include "liveconfig.h"
+
+#define LIVECONFIG_POLL_SECONDS 1
+
+static char watch_path[256];
+static uint64_t watch_mtime; // Last mtime a load was attempted for
+
+static bool watcher_started;
+static bool watcher_quit;
+static pthread_t watcher;
+static pthread_mutex_t watch_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t watch_wake = PTHREAD_COND_INITIALIZER;
+
+// Staged config, written by the watcher under staging_lock, taken by
+// the emulation thread; pending flips only after the copy is complete
+static liveconfig_t staging;
+static unsigned staging_generation;
+static SDL_AtomicInt staging_pending;
+static pthread_mutex_t staging_lock = PTHREAD_MUTEX_INITIALIZER;
+
+// Parses and validates one file into out. Any invalid or unknown line
+// rejects the whole file: a config either applies entirely or not at
+// all, so a half-edited save never lands.
+static bool liveconfig_parse(const char *filename, liveconfig_t *out) {
+    FILE *fptr = fopen(filename, "r");
+    if (fptr == NULL) {
+        return false;
+    }
+
+    memset(out, 0, sizeof(*out));
+    char line[256];
+    int lineno = 0;
+    bool valid = true;
+    while (valid && fgets(line, sizeof(line), fptr) != NULL) {
+        lineno++;
+        if (line[0] == '#' || line[0] == '\n') {
+            continue;
+        }
+
+        char key[16];
+        unsigned value;
+        unsigned palette[4];
+        char toggle[8];
+        if (sscanf(line, "%15s", key) != 1) {
+            continue; // Whitespace-only line
+        }
+
+        if (strcmp(key, "ips") == 0 &&
+            sscanf(line, "%*s %u", &value) == 1 &&
+            value >= 60 && value <= 10000000) {
+            out->has_ips = true;
+            out->ips = value;
+        } else if (strcmp(key, "palette") == 0 &&
+                   sscanf(line, "%*s %6x %6x %6x %6x",
+                          &palette[0], &palette[1], &palette[2], &palette[3]) == 4) {
+            out->has_palette = true;
+            for (int i = 0; i < 4; i++) {
+                out->palette[i] = 0xFF000000 | palette[i];
+            }
+        } else if (strcmp(key, "degrade") == 0 &&
+                   sscanf(line, "%*s %7s", toggle) == 1 &&
+                   (strcmp(toggle, "on") == 0 || strcmp(toggle, "off") == 0)) {
+            out->has_degrade = true;
+            out->degrade = strcmp(toggle, "on") == 0;
+        } else if (strcmp(key, "export") == 0 &&
+                   sscanf(line, "%*s %u", &value) == 1 &&
+                   value >= 1 && value <= 3600) {
+            out->has_export_interval = true;
+            out->export_interval = value;
+        } else {
+            SDL_Log("Rejecting config %s: bad line %d: %s", filename, lineno, line);
+            valid = false;
+        }
+    }
+    fclose(fptr);
+    return valid;
+}
+
+static void *liveconfig_watcher(void *arg) {
+    pthread_mutex_lock(&watch_lock);
+    while (!watcher_quit) {
+        struct timespec deadline;
+        clock_gettime(CLOCK_REALTIME, &deadline);
+        deadline.tv_sec += LIVECONFIG_POLL_SECONDS;
+        while (!watcher_quit) {
+            if (pthread_cond_timedwait(&watch_wake, &watch_lock, &deadline) != 0) {
+                break; // Poll interval expired
+            }
+        }
+        pthread_mutex_unlock(&watch_lock);
+
+        struct stat st;
+        if (stat(watch_path, &st) == 0 && (uint64_t)st.st_mtime != watch_mtime) {
+            // Attempted once per mtime: a rejected file stays rejected
+            // (and logged) until it is edited again
+            watch_mtime = (uint64_t)st.st_mtime;
+            liveconfig_t candidate;
+            if (liveconfig_parse(watch_path, &candidate)) {
+                pthread_mutex_lock(&staging_lock);
+                candidate.generation = ++staging_generation;
+                staging = candidate;
+                pthread_mutex_unlock(&staging_lock);
+                SDL_SetAtomicInt(&staging_pending, 1);
+            }
+        }
+
+        pthread_mutex_lock(&watch_lock);
+    }
+    pthread_mutex_unlock(&watch_lock);
+    return NULL;
+}
+
+bool liveconfig_watch(const char *filename) {
+    if (watcher_started) {
+        return false;
+    }
+    strncpy(watch_path, filename, sizeof(watch_path) - 1);
+    watch_path[sizeof(watch_path) - 1] = '\0';
+
+    // An existing file applies once at startup too: its mtime is unseen
+    watcher_started = true;
+    watcher_quit = false;
+    pthread_create(&watcher, NULL, liveconfig_watcher, NULL);
+    SDL_Log("Watching %s for live config changes", watch_path);
+    return true;
+}
+
+bool liveconfig_pending(void) {
+    return SDL_GetAtomicInt(&staging_pending) != 0;
+}
+
+bool liveconfig_take(liveconfig_t *out) {
+    if (!SDL_GetAtomicInt(&staging_pending)) {
+        return false;
+    }
+    pthread_mutex_lock(&staging_lock);
+    *out = staging;
+    pthread_mutex_unlock(&staging_lock);
+    SDL_SetAtomicInt(&staging_pending, 0);
+    return true;
+}
+
+void liveconfig_stop(void) {
+    if (!watcher_started) {
+        return;
+    }
+    pthread_mutex_lock(&watch_lock);
+    watcher_quit = true;
+    pthread_cond_signal(&watch_wake);
+    pthread_mutex_unlock(&watch_lock);
+    pthread_join(watcher, NULL);
+    watcher_started = false;
+}
@@ -0,0 +1,55 @@
+#ifndef LIVECONFIG_H
+#define LIVECONFIG_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * Live Configuration Reload
+ *
+ * Hosted sessions change tuning — IPS targets, palettes, the
+ * degradation ladder, telemetry export cadence — without a restart:
+ * restarting to recolor a cabinet costs the player, a reload costs a
+ * struct copy. A watcher thread polls the config file's mtime once a
+ * second, and when it moves, parses and validates the whole file off
+ * the emulation thread. Only a fully valid file is staged (one bad line
+ * rejects the load, so a half-edited save never half-applies); the main
+ * loop picks the staged config up at the next quantum boundary through
+ * the command queue, alongside every other UI action.
+ *
+ * File format, one setting per line ('#' starts a comment); omitted
+ * keys leave the running value alone:
+ *   ips <60..10000000>
+ *   palette <4x RRGGBB>
+ *   degrade on|off
+ *   export <seconds, 1..3600>
+ */
+
+// A validated configuration; has_* marks which keys the file carried
+typedef struct liveconfig {
+    bool has_ips;
+    uint32_t ips;
+    bool has_palette;
+    uint32_t palette[4]; // ARGB, same slots as the ROM config palette
+    bool has_degrade;
+    bool degrade;
+    bool has_export_interval;
+    unsigned export_interval;
+    unsigned generation; // Increments per staged load, for the event log
+} liveconfig_t;
+
+// Starts the watcher thread on the given file. A missing file is fine;
+// it is picked up on first appearance.
+bool liveconfig_watch(const char *filename);
+
+// Producer-side check from the main loop: true while a validated config
+// is staged and waiting to be taken
+bool liveconfig_pending(void);
+
+// Copies the staged config out and clears the pending flag; false when
+// nothing is staged. Call from the emulation thread only.
+bool liveconfig_take(liveconfig_t *out);
+
+void liveconfig_stop(void);
+
+#endif // LIVECONFIG_H
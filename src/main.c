@@ -1,138 +1,4202 @@
 #include <SDL3/SDL.h>
 #include <SDL3/SDL_main.h>
 #include <pthread.h>
+#include <sched.h>
+#include <signal.h>
+#include <stdio.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
 
-#include "chip8.c"
-#include "input.c"
+#include "arena.h"
+#include "chip8.h"
+#include "clock.h"
+#include "energy.h"
+#include "crashdump.h"
+#include "archive.h"
+#include "alloctrap.h"
+#include "trace.h"
+#include "replay.h"
+#include "savestate.h"
+#include "romdb.h"
+#include "telemetry.h"
+#include "screenshot.h"
+#include "journal.h"
+#include "library.h"
+#include "stream.h"
+#include "debug.h"
+#include "disasm.h"
+#include "profile.h"
+#include "pool.h"
+#include "netplay.h"
+#include "eventlog.h"
+#include "latency.h"
+#include "heatmap.h"
+#include "script.h"
+#include "decodestat.h"
+#include "shmframe.h"
+#include "introspect.h"
+#include "capture.h"
+#include "cmdq.h"
+#include "bisect.h"
+#include "watchdog.h"
+#include "export.h"
+#include "degrade.h"
+#include "liveconfig.h"
+#include "perfcount.h"
+#include "migrate.h"
+#include "input.h"
+#include "rawinput.h"
+#include "renderprobe.h"
+
+#define ROMDB_FILE "chip8_roms.cfg"
+#define LIVECONFIG_FILE "chip8_live.cfg"
 
 #define WINDOW_WIDTH 768
 #define WINDOW_HEIGHT 384
 
 static SDL_Window *window;
 static SDL_Renderer *renderer;
+static SDL_Texture *framebuffer;
 static SDL_Event event;
 
 static SDL_AudioStream *stream;
 static int sample_rate = 44100;
-static int cur_sine_sample = 0;
 
-static int scale_x = WINDOW_WIDTH / 64;
-static int scale_y = WINDOW_HEIGHT / 32;
+// Exactly 22 periods of the 440Hz tone at 44100Hz (44100/gcd(440,44100)
+// samples), so refills are pure copies that wrap with no phase error
+#define WAVETABLE_SAMPLES 2205
+static float wavetable[WAVETABLE_SAMPLES];
+static int wavetable_pos = 0;
+
+/* build the 440Hz pure tone once; refills just copy from it */
+void build_wavetable(void) {
+    for (int i = 0; i < WAVETABLE_SAMPLES; i++) {
+        const float phase = i * 440 / (float)sample_rate;
+        wavetable[i] = 0.75f * SDL_sinf(phase * 2 * SDL_PI_F);
+    }
+}
+
+/* The audio thread's view of sound_timer > 0, published by the edge hook */
+static SDL_AtomicInt buzzer_on;
+
+/* Buzzer edge queue: the core's sound hook timestamps every sound_timer
+   on/off transition at the instruction that caused it; the audio callback
+   converts those timestamps into sample offsets in the buffer it
+   composes, so tone edges land sample-accurately instead of snapping to
+   callback boundaries. Single producer (emulation thread), single
+   consumer (audio thread). */
+#define AUDIO_EDGES 32
+
+typedef struct audio_edge {
+    uint64_t when_ns;
+    bool on;
+} audio_edge_t;
+
+static audio_edge_t audio_edges[AUDIO_EDGES];
+static SDL_AtomicInt audio_edge_head;
+static SDL_AtomicInt audio_edge_tail;
+
+static void SDLCALL audio_callback(void *userdata, SDL_AudioStream *astream, int additional_amount, int total_amount);
+
+/* Real-time scheduling (--rt [priority]): cabinets share their host with
+   compositors and housekeeping daemons, and under SCHED_OTHER any of them
+   can preempt the emulation loop mid-quantum. The elevated policy goes on
+   the emulation thread only, applied after the render thread is created
+   (new threads inherit the creator's policy), so presents and audio stay
+   at normal priority and a render stall can never starve input handling.
+   Whether it helped is a measurement, not a feeling: compare the sleep
+   overshoot p99 in the exit report against an un-elevated run. */
+static int rt_priority; // Requested SCHED_FIFO/RR priority; 0 = off
+static int rt_policy = -1; // Policy actually applied; -1 while normal
+
+static void rt_apply(void) {
+    int max = sched_get_priority_max(SCHED_FIFO);
+    int min = sched_get_priority_min(SCHED_FIFO);
+    if (rt_priority > max) {
+        rt_priority = max;
+    } else if (rt_priority < min) {
+        rt_priority = min;
+    }
+
+    struct sched_param param = {.sched_priority = rt_priority};
+    int policy = SCHED_FIFO;
+    if (pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) != 0) {
+        policy = SCHED_RR; // Some rtkit-style setups permit only RR
+        if (pthread_setschedparam(pthread_self(), SCHED_RR, &param) != 0) {
+            SDL_Log("Real-time scheduling unavailable (needs CAP_SYS_NICE "
+                    "or an RLIMIT_RTPRIO grant); continuing at normal priority");
+            return;
+        }
+    }
+    rt_policy = policy;
+    SDL_Log("Emulation thread scheduled %s priority %d",
+            policy == SCHED_FIFO ? "SCHED_FIFO" : "SCHED_RR", rt_priority);
+}
+
+// Drop-and-restore bracket for spawning helpers from the emulation thread
+// (SDL's audio thread, the rotation prefetcher): without it they would
+// inherit the real-time priority and compete with the very loop the
+// elevation protects
+static void rt_suspend(void) {
+    if (rt_policy >= 0) {
+        struct sched_param param = {.sched_priority = 0};
+        pthread_setschedparam(pthread_self(), SCHED_OTHER, &param);
+    }
+}
+
+static void rt_resume(void) {
+    if (rt_policy >= 0) {
+        struct sched_param param = {.sched_priority = rt_priority};
+        pthread_setschedparam(pthread_self(), rt_policy, &param);
+    }
+}
+
+/* Slow-motion review: the tone pitch/time-scales with the simulation
+   instead of cutting out. Synthesis stays at the virtual-clock rate; the
+   stream's frequency ratio does the stretch on the resampler side, so a
+   speed change is one parameter update with no resynthesis. The ratio is
+   mirrored in permille for the callback's edge-placement math (wall-clock
+   deltas shrink by the ratio in source-sample terms). */
+static SDL_AtomicInt audio_ratio_permille = {1000};
+
+/* Deferred audio bring-up: the subsystem init and device open together
+   cost milliseconds on our kiosk units and a ROM that never beeps never
+   needs them, so the device opens on the first rising buzzer edge. Runs
+   on the emulation thread; one failure disables further attempts. */
+static bool audio_open(void) {
+    static bool open_failed;
+    if (open_failed) {
+        return false;
+    }
+
+    uint64_t phase_start = telemetry_now_ns();
+    SDL_AudioSpec audio_spec;
+    audio_spec.channels = 1;
+    audio_spec.format = SDL_AUDIO_F32;
+    audio_spec.freq = sample_rate;
+    SDL_AudioStream *opened = NULL;
+    rt_suspend(); // The device thread spawns here; keep it off RT priority
+    if (SDL_InitSubSystem(SDL_INIT_AUDIO)) {
+        opened = SDL_OpenAudioDeviceStream(SDL_AUDIO_DEVICE_DEFAULT_PLAYBACK, &audio_spec, NULL, NULL);
+    }
+    rt_resume();
+    if (opened == NULL) {
+        SDL_Log("Couldn't create audio stream: %s", SDL_GetError());
+        open_failed = true; // Run on silent rather than retrying every beep
+        return false;
+    }
+
+    build_wavetable();
+    // A slow-motion session may predate the first beep; apply its ratio
+    int permille = SDL_GetAtomicInt(&audio_ratio_permille);
+    if (permille != 1000) {
+        SDL_SetAudioStreamFrequencyRatio(opened, (float)(permille / 1000.0));
+    }
+    SDL_SetAudioStreamGetCallback(opened, audio_callback, NULL);
+    SDL_ResumeAudioStreamDevice(opened);
+    stream = opened; // Last: the HUD thread tests the pointer unsynchronized
+    telemetry_counter_max(&telemetry_startup_audio, (telemetry_now_ns() - phase_start) / 1000);
+    return true;
+}
+
+/* Warm start (--warm-audio): the deferred bring-up above trades first-
+   beep latency for startup time — the subsystem init and device open
+   land between FX18 and the first audible sample, tens of milliseconds
+   on the kiosk units. Cabinets that care prime the path instead: the
+   stream opens before the ROM runs and a frame of silence pre-rolls the
+   queue, so the device is already pulling when the first rising edge
+   arrives and the callback splices the tone at its sample offset like
+   any later beep. Onset then costs one device period. */
+static void audio_warm_start(void) {
+    if (!audio_open()) {
+        return; // Logged above; the lazy path will retry nothing either
+    }
+    static const float silence[1024]; // ~23ms queued before the first pull
+    SDL_PutAudioStreamData(stream, silence, sizeof(silence));
+    SDL_Log("Audio warm: stream open and pre-rolled before first beep");
+}
+
+/* Turbo mute: uncapped fast-forward runs the virtual 60Hz clock far
+   ahead of wall time, so buzzer transitions arrive at kHz rates — noise
+   that floods the edge queue and spams the stream. While fast-forwarding
+   the buzzer mutes instead: rising edges are suppressed, and the main
+   loop's timer re-sync restores the true tone state when the cap
+   returns. Tone on/off therefore always follows the 60Hz clock the
+   player hears, never the emulation speed. */
+static bool audio_muted;
+
+static void audio_set_speed(double ratio) {
+    SDL_SetAtomicInt(&audio_ratio_permille, (int)(ratio * 1000.0));
+    if (stream != NULL) {
+        SDL_SetAudioStreamFrequencyRatio(stream, (float)ratio);
+    }
+}
+
+// Installed as chip8_sound_hook; runs on the emulation thread at the
+// transitioning instruction
+static void audio_edge_push(bool on) {
+    if (audio_muted && on) {
+        return; // Falling edges still pass so an active tone cuts off
+    }
+    if (stream == NULL && (!on || !audio_open())) {
+        return; // Nothing is listening until the first rising edge opens it
+    }
+    SDL_SetAtomicInt(&buzzer_on, on);
+    int head = SDL_GetAtomicInt(&audio_edge_head);
+    if (head - SDL_GetAtomicInt(&audio_edge_tail) < AUDIO_EDGES) {
+        audio_edges[head % AUDIO_EDGES].when_ns = telemetry_now_ns();
+        audio_edges[head % AUDIO_EDGES].on = on;
+        SDL_SetAtomicInt(&audio_edge_head, head + 1);
+    }
+}
+
+// Entering or leaving fast-forward; a tone sounding at entry is cut at
+// its sample-accurate position like any other falling edge
+static void audio_set_mute(bool mute) {
+    if (mute == audio_muted) {
+        return;
+    }
+    if (mute && SDL_GetAtomicInt(&buzzer_on)) {
+        audio_edge_push(false);
+    }
+    audio_muted = mute;
+}
+
+// Suspending a session pauses the device behind the stream so the pull
+// callback stops firing entirely; a tone sounding at suspend is cut at
+// its sample position like any other falling edge
+static void audio_suspend(bool suspend) {
+    if (stream == NULL) {
+        return;
+    }
+    if (suspend) {
+        if (SDL_GetAtomicInt(&buzzer_on)) {
+            audio_edge_push(false);
+        }
+        SDL_PauseAudioStreamDevice(stream);
+    } else {
+        SDL_ResumeAudioStreamDevice(stream);
+    }
+}
+
+// Fills [from, to) of the compose buffer with tone or silence; the
+// wavetable position only advances while the tone is on, keeping phase
+// continuous across a single beep
+static void audio_fill(float *buffer, int from, int to, bool on) {
+    if (!on) {
+        SDL_memset(buffer + from, 0, (to - from) * sizeof(float));
+        return;
+    }
+    while (from < to) {
+        int chunk = to - from < WAVETABLE_SAMPLES - wavetable_pos
+                  ? to - from : WAVETABLE_SAMPLES - wavetable_pos;
+        SDL_memcpy(buffer + from, wavetable + wavetable_pos, chunk * sizeof(float));
+        wavetable_pos = (wavetable_pos + chunk) % WAVETABLE_SAMPLES;
+        from += chunk;
+    }
+}
+
+/* Pull callback: composes the whole refill locally — splicing queued
+   buzzer edges at their sample positions — and hands it to the stream in
+   a single SDL_PutAudioStreamData call. An edge sounds at its wall-clock
+   time plus the current queue latency, so edge-to-edge spacing is sample-
+   accurate. */
+static void SDLCALL audio_callback(void *userdata, SDL_AudioStream *astream, int additional_amount, int total_amount) {
+    static float buffer[16384];
+    static bool gen_on; // Tone state at the stream write head
+
+    // The largest single request is the effective device period; refill
+    // sizing adapts to it below
+    telemetry_counter_max(&telemetry_audio_device_period, (uint64_t)additional_amount);
+
+    bool on = SDL_GetAtomicInt(&buzzer_on);
+    int queued = (int)SDL_GetAudioStreamQueued(astream);
+    telemetry_counter_max(&telemetry_audio_queue_peak, (uint64_t)queued);
+
+    // An empty queue mid-tone means the device played silence: that's the
+    // crackle. The first callback after the buzzer turns on is exempt.
+    static bool was_on;
+    if (on && was_on && queued == 0) {
+        telemetry_audio_underruns.value++;
+    }
+    was_on = on;
+
+    // Adaptive refill: top the queue up to the request plus one measured
+    // device period of headroom, so one late callback never drains it.
+    // Under the AUDIO rung the headroom doubles: fewer, larger refills
+    // trade queue latency for callback wakeups on an overloaded host.
+    int headroom = (int)telemetry_audio_device_period.value;
+    if (degrade_active(DEGRADE_AUDIO)) {
+        headroom *= 2;
+    }
+    int target = additional_amount + headroom;
+    int samples = (target - queued) / (int)sizeof(float);
+    if (samples <= 0) {
+        return;
+    }
+    if (samples > (int)(sizeof(buffer) / sizeof(float))) {
+        samples = (int)(sizeof(buffer) / sizeof(float));
+    }
+
+    uint64_t now = telemetry_now_ns();
+    // One wall second consumes sample_rate * ratio source samples when
+    // the resampler is stretching, so edge offsets scale with the ratio
+    double ratio = SDL_GetAtomicInt(&audio_ratio_permille) / 1000.0;
+    int queued_samples = queued / (int)sizeof(float);
+    int pos = 0;
+    int tail = SDL_GetAtomicInt(&audio_edge_tail);
+    while (tail != SDL_GetAtomicInt(&audio_edge_head)) {
+        audio_edge_t edge = audio_edges[tail % AUDIO_EDGES];
+        int64_t offset = (int64_t)((double)(int64_t)(edge.when_ns - now) * sample_rate * ratio / 1e9)
+                       + queued_samples;
+        if (offset >= samples) {
+            break; // Lands in a later refill
+        }
+        if (offset < 0) {
+            offset = 0; // Already overdue: apply at the write head
+        }
+        audio_fill(buffer, pos, (int)offset, gen_on);
+        pos = (int)offset;
+        gen_on = edge.on;
+        tail++;
+        SDL_SetAtomicInt(&audio_edge_tail, tail);
+    }
+    audio_fill(buffer, pos, samples, gen_on);
+
+    SDL_PutAudioStreamData(astream, buffer, samples * sizeof(float));
+}
+
+/* Triple buffer between the emulation and render threads. The emulation
+   thread copies vram into its private slot and publishes it with an atomic
+   swap; the render thread swaps the newest published slot in for its own.
+   Neither side ever waits, and a slow present can no longer stall pacing. */
+#define FRAME_FRESH 4 // Or'd onto the slot index in pending_frame
+
+// A published frame: both packed vram planes, the resolution they were
+// drawn at (SCHIP ROMs switch between 64x32 and 128x64 at runtime), and
+// the regions that changed since the previous published frame
+typedef struct published_frame {
+    uint64_t rows[2][64][2];
+    bool hires;
+    uint8_t dirty_count; // CHIP8_DIRTY_FULL = update the whole texture
+    chip8_rect_t dirty_rects[CHIP8_DIRTY_RECTS];
+} published_frame_t;
+
+// XO-CHIP palette, indexed by the two plane bits per pixel: background,
+// plane 0 only, plane 1 only, both. Overridable per ROM via the config
+// database.
+static uint32_t palette[4] = {
+    0xFF000000, 0xFFFFFFFF, 0xFF3366AA, 0xFF99BBDD
+};
+// Base palette restored before applying the next ROM's config when the
+// kiosk rotation swaps titles: stock colors unless --palette themed it
+static uint32_t palette_default[4] = {
+    0xFF000000, 0xFFFFFFFF, 0xFF3366AA, 0xFF99BBDD
+};
+
+// Built-in venue themes for --palette. The visual suite cycles the same
+// table, so every theme a cabinet can select is covered by the goldens.
+static const struct {
+    const char *name;
+    uint32_t colors[4];
+} palette_presets[] = {
+    {"stock", {0xFF000000, 0xFFFFFFFF, 0xFF3366AA, 0xFF99BBDD}},
+    {"amber", {0xFF100800, 0xFFFFB000, 0xFFAA6600, 0xFFFFD580}},
+    {"green", {0xFF001100, 0xFF33FF66, 0xFF117733, 0xFF99FFBB}},
+};
+#define PALETTE_PRESETS (int)(sizeof(palette_presets) / sizeof(palette_presets[0]))
+
+// Applies a venue theme by preset name or as four RRGGBB fields
+// ("101010:FFB000:AA6600:FFD580", ordered background/plane0/plane1/both):
+// sets the default the rotation restores, not the conversion path — the
+// colors only exist in the expansion LUT, so theming stays free per frame
+static bool palette_select(const char *spec) {
+    for (int p = 0; p < PALETTE_PRESETS; p++) {
+        if (SDL_strcmp(spec, palette_presets[p].name) == 0) {
+            SDL_memcpy(palette_default, palette_presets[p].colors,
+                       sizeof(palette_default));
+            return true;
+        }
+    }
+    unsigned int colors[4];
+    if (SDL_sscanf(spec, "%6x:%6x:%6x:%6x",
+                   &colors[0], &colors[1], &colors[2], &colors[3]) == 4) {
+        for (int i = 0; i < 4; i++) {
+            palette_default[i] = 0xFF000000 | colors[i];
+        }
+        return true;
+    }
+    SDL_Log("Unknown palette: %s", spec);
+    return false;
+}
+
+static published_frame_t frame_slots[3];
+static SDL_AtomicInt pending_frame;
+static SDL_AtomicInt render_running;
+static pthread_t render_thread;
+
+/* Suspended sessions (Space): the render thread parks on a condition
+   variable after its last present instead of pacing no-op iterations, so
+   a paused emulator costs no render CPU at all. The event loop wakes it
+   for a single-step publish, an overlay toggle (nudge: redraw the held
+   frame once), or resume. */
+static SDL_AtomicInt render_parked;
+static SDL_AtomicInt render_nudge;
+/* Invisible window (minimized, hidden, or compositor-occluded): nothing
+   drawn can be seen, so the render thread parks while emulation keeps
+   running. Unlike the pause park, fresh publishes do NOT wake it — the
+   triple buffer absorbs them and the newest frame presents on expose.
+   Minimized admin sessions on kiosks otherwise burn full render cost
+   for output nobody can see. */
+static SDL_AtomicInt render_hidden;
+static pthread_mutex_t render_park_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t render_park_cond = PTHREAD_COND_INITIALIZER;
+
+static void render_wake(void) {
+    pthread_mutex_lock(&render_park_lock);
+    pthread_cond_signal(&render_park_cond);
+    pthread_mutex_unlock(&render_park_lock);
+}
+
+/* Optional CRT post stage (F2), composited entirely on the GPU: the
+   source is scaled into a render target, a linear-filtered additive
+   re-draw approximates phosphor glow, and a tiled one-column pattern
+   darkens every CRT_SCALEth row for scanlines. Three textured quads per
+   frame; the emulation side still pays only the one texture upload.
+   SDL_Renderer exposes no portable shader hook, so curvature is out of
+   scope until we move to SDL_gpu. */
+#define CRT_SCALE 6 // Intermediate target: 128x64 source at 6x = 768x384
+static SDL_Texture *crt_target;
+static SDL_Texture *scanline_texture;
+static SDL_AtomicInt crt_enabled;
+
+/* Presentation geometry, derived once per resize instead of per frame:
+   the window is resizable, so the destination is the largest integer
+   multiple of the source that fits, centered with black bars. Fractional
+   scaling blurs the nearest-filtered pixels and a plain stretch distorts
+   them. The event loop flags resizes; the render thread (the only
+   renderer user) recomputes the cached rects on the next frame. */
+static SDL_AtomicInt window_resized;
+static int present_out_w; // Logical output size at the last recompute
+static int present_out_h;
+static SDL_FRect present_rect[2]; // Letterboxed dst rect, indexed by hires
+
+/* Cocktail-cabinet orientation (--orientation 90|180|270): the panel is
+   mounted rotated, so the finished frame takes one extra GPU blit — the
+   whole logical frame composes into an intermediate target, which is
+   drawn rotated onto the backbuffer at present time. Everything upstream
+   (the expand LUT, dirty rects, letterbox geometry, the HUD) keeps
+   operating in source space at zero added CPU cost; rotating in the vram
+   conversion loop would double its cost and break the 4-pixel LUT
+   stores. Set at startup before the render thread exists, read-only
+   after. */
+static int present_rotation; // Degrees clockwise: 0, 90, 180, 270
+static SDL_Texture *rotation_target; // Logical-orientation backbuffer
+static int rotation_out_w; // Physical output size behind the rotation
+static int rotation_out_h;
+
+/* Present scheduler: one present per display frame. With vsync the
+   swapchain paces the render thread; when vsync is unavailable we pace by
+   the measured refresh interval instead, so a 120/144Hz panel gets its
+   real rate and nothing free-runs into the compositor. */
+static uint64_t refresh_interval_ns = 1000000000ULL / 60;
+
+// main() entry time, read by the render thread to stamp the first present
+static uint64_t startup_epoch_ns;
+
+/* Performance HUD: a 128x24 overlay texture refreshed from pre-rasterized
+   3x5 glyphs, toggled with F1. Rasterizing three short lines is a few
+   thousand stores, far under the 0.1ms budget. */
+#define HUD_WIDTH 128
+#define HUD_HEIGHT 24
+static SDL_Texture *hud_texture;
+static SDL_AtomicInt hud_enabled;
+static SDL_AtomicInt stat_ips; // Actual instructions/sec, published by the emulation thread
+
+// 3x5 glyphs, one byte per row, low three bits = pixels (bit 2 leftmost)
+static const uint8_t hud_font[][5] = {
+    {07, 05, 05, 05, 07}, // 0
+    {02, 06, 02, 02, 07}, // 1
+    {07, 01, 07, 04, 07}, // 2
+    {07, 01, 07, 01, 07}, // 3
+    {05, 05, 07, 01, 01}, // 4
+    {07, 04, 07, 01, 07}, // 5
+    {07, 04, 07, 05, 07}, // 6
+    {07, 01, 01, 02, 02}, // 7
+    {07, 05, 07, 05, 07}, // 8
+    {07, 05, 07, 01, 07}, // 9
+    {02, 05, 07, 05, 05}, // A
+    {06, 05, 06, 05, 06}, // B
+    {07, 04, 04, 04, 07}, // C
+    {06, 05, 05, 05, 06}, // D
+    {07, 04, 06, 04, 07}, // E
+    {07, 04, 06, 04, 04}, // F
+    {07, 02, 02, 02, 07}, // I
+    {05, 05, 06, 05, 05}, // K
+    {06, 05, 06, 04, 04}, // P
+    {07, 05, 05, 07, 01}, // Q
+    {06, 05, 06, 06, 05}, // R
+    {03, 04, 02, 01, 06}, // S
+    {07, 02, 02, 02, 02}, // T
+    {05, 05, 05, 05, 07}, // U
+    {00, 00, 00, 00, 02}, // .
+};
 
-bool run_timers = false;
+static int hud_glyph(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    switch (c) {
+        case 'A': return 10;
+        case 'B': return 11;
+        case 'C': return 12;
+        case 'D': return 13;
+        case 'E': return 14;
+        case 'F': return 15;
+        case 'I': return 16;
+        case 'K': return 17;
+        case 'P': return 18;
+        case 'Q': return 19;
+        case 'R': return 20;
+        case 'S': return 21;
+        case 'T': return 22;
+        case 'U': return 23;
+        case '.': return 24;
+        default: return -1; // Space and anything unmapped
+    }
+}
+
+static void hud_draw_text(uint32_t *pixels, int pitch_px, int x, int y, const char *text) {
+    for (; *text != '\0'; text++, x += 4) {
+        int glyph = hud_glyph(*text);
+        if (glyph < 0 || x + 3 > HUD_WIDTH) continue;
+
+        for (int row = 0; row < 5; row++) {
+            uint32_t *out = pixels + (y + row) * pitch_px + x;
+            uint8_t bits = hud_font[glyph][row];
+            for (int col = 0; col < 3; col++) {
+                if ((bits >> (2 - col)) & 1) {
+                    out[col] = 0xFF00FF66;
+                }
+            }
+        }
+    }
+}
+
+/* Render batching audit: SDL draw calls (clears included), texture
+   uploads, and uploaded bytes are counted per presented frame, all on the
+   render thread. X11, Wayland and KMSDRM backends batch differently, so
+   after a renderer change these numbers — not the code shape — say
+   whether the batching held. The HUD shows the last completed frame; the
+   per-frame peaks go to the telemetry report on exit. */
+static uint32_t audit_draws;
+static uint32_t audit_uploads;
+static uint32_t audit_upload_bytes;
+static uint32_t audit_frame_draws; // Last completed frame, for the HUD
+static uint32_t audit_frame_uploads;
+static uint32_t audit_frame_bytes;
+
+/* Refresh the HUD texture and draw it over the top of the frame. Runs on
+   the render thread, between the framebuffer draw and the present. */
+static void hud_overlay(void) {
+    // Presents per second over a rolling one-second window
+    static uint64_t fps_window_start;
+    static int fps_frames;
+    static int fps;
+    fps_frames++;
+    uint64_t now = telemetry_now_ns();
+    if (now - fps_window_start >= 1000000000ULL) {
+        fps = fps_frames;
+        fps_frames = 0;
+        fps_window_start = now;
+    }
+
+    // Lock-free register snapshot off the introspection page; the same
+    // read path external monitors use against the shm export
+    chip8_introspect_page_t regs;
+    introspect_read(&regs);
+
+    char line0[32];
+    char line1[48];
+    SDL_snprintf(line0, sizeof(line0), "IPS %d FPS %d PC %03X",
+                 SDL_GetAtomicInt(&stat_ips), fps, regs.program_counter);
+    // Frame time and timer drift are the p50 of the pacing histograms, in
+    // milliseconds; AQ is the queued audio backlog in bytes
+    SDL_snprintf(line1, sizeof(line1), "FT %.2f AQ %d DR %.2f",
+                 telemetry_percentile(&telemetry_present, 0.50) / 1e6,
+                 stream != NULL ? SDL_GetAudioStreamQueued(stream) : 0,
+                 telemetry_percentile(&telemetry_sleep_overshoot, 0.50) / 1e6);
+    // Batching audit for the previous frame: draw calls, texture uploads,
+    // kilobytes uploaded
+    char line2[32];
+    SDL_snprintf(line2, sizeof(line2), "DC %u UP %u KB %u",
+                 audit_frame_draws, audit_frame_uploads,
+                 audit_frame_bytes / 1024);
+
+    void *pixels;
+    int pitch;
+    if (SDL_LockTexture(hud_texture, NULL, &pixels, &pitch)) {
+        int pitch_px = pitch / 4;
+        for (int j = 0; j < HUD_HEIGHT; j++) {
+            uint32_t *out = (uint32_t *)pixels + j * pitch_px;
+            for (int i = 0; i < HUD_WIDTH; i++) {
+                out[i] = 0xA0000000; // Translucent backing strip
+            }
+        }
+        hud_draw_text((uint32_t *)pixels, pitch_px, 2, 2, line0);
+        hud_draw_text((uint32_t *)pixels, pitch_px, 2, 9, line1);
+        hud_draw_text((uint32_t *)pixels, pitch_px, 2, 16, line2);
+        SDL_UnlockTexture(hud_texture);
+        audit_uploads++;
+        audit_upload_bytes += HUD_WIDTH * HUD_HEIGHT * 4;
+    }
+
+    SDL_FRect dst_rect = {0, 0, (float)present_out_w,
+                          (float)present_out_h * HUD_HEIGHT / 64.0f};
+    SDL_RenderTexture(renderer, hud_texture, NULL, &dst_rect);
+    audit_draws++;
+}
+
+#define COUNTERS_FILE "chip8_counters.json"
+#define LIBRARY_INDEX_FILE "chip8_library.idx"
+#define KEYBINDS_FILE "chip8_keys.cfg"
+#define WATCHDOG_STATE_FILE "chip8_watchdog.state"
+#define EXPORT_FILE "chip8_stats.json"
+
+/* SIGUSR1 asks for a live opcode-counter dump at the next quantum;
+   SIGUSR2 asks for a pacing telemetry report */
+static volatile sig_atomic_t counters_requested = 0;
+static volatile sig_atomic_t telemetry_requested = 0;
+
+static void request_counters(int sig) {
+    counters_requested = 1;
+}
+
+static void request_telemetry(int sig) {
+    telemetry_requested = 1;
+}
 
-void process_audio(uint8_t sound_timer) {
-    const int min_audio = 2000;
+/* Vram-to-pixel expansion LUT: a plane-1 nibble and a plane-0 nibble
+   (4 pixel columns) index four finished ARGB pixels. The table is 4KB —
+   L1-resident — and each hit becomes a single 16-byte copy the compiler
+   lowers to one vector store, so a full 128x64 frame expands in a few
+   hundred loads instead of per-pixel bit tests. Rebuilt when the palette
+   changes. */
+static uint32_t expand_lut[256][4];
 
-    if (SDL_GetAudioStreamQueued(stream) < min_audio && sound_timer > 0) {
-        static float samples[512];
+static void build_expand_lut(void) {
+    for (int nibbles = 0; nibbles < 256; nibbles++) {
+        for (int pixel = 0; pixel < 4; pixel++) {
+            int bit = 3 - pixel;
+            int index = ((nibbles >> bit) & 1) | ((nibbles >> (4 + bit)) & 1) << 1;
+            expand_lut[nibbles][pixel] = palette[index];
+        }
+    }
+}
 
-        /* generate a 440Hz pure tone */
-        for (int i = 0; i < SDL_arraysize(samples); i++) {
-            const int freq = 440;
-            const float phase = cur_sine_sample * freq / (float)sample_rate;
-            samples[i] = 0.75f * SDL_sinf(phase * 2 * SDL_PI_F);
-            cur_sine_sample++;
+// Rebuilds the cached destination rects for both display modes from the
+// current render output size. Called from the render thread only.
+static void update_present_geometry(void) {
+    SDL_GetRenderOutputSize(renderer, &rotation_out_w, &rotation_out_h);
+    present_out_w = rotation_out_w;
+    present_out_h = rotation_out_h;
+    if (present_rotation == 90 || present_rotation == 270) {
+        // Geometry fits the panel's logical (pre-rotation) orientation
+        present_out_w = rotation_out_h;
+        present_out_h = rotation_out_w;
+    }
+    if (present_rotation != 0) {
+        // The intermediate target tracks the logical size across resizes
+        if (rotation_target != NULL) {
+            float w, h;
+            SDL_GetTextureSize(rotation_target, &w, &h);
+            if ((int)w != present_out_w || (int)h != present_out_h) {
+                SDL_DestroyTexture(rotation_target);
+                rotation_target = NULL;
+            }
+        }
+        if (rotation_target == NULL) {
+            rotation_target = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888,
+                                                SDL_TEXTUREACCESS_TARGET,
+                                                present_out_w, present_out_h);
+            if (rotation_target == NULL) {
+                SDL_Log("Orientation unavailable: %s", SDL_GetError());
+            } else {
+                SDL_SetTextureScaleMode(rotation_target, SDL_SCALEMODE_NEAREST);
+            }
         }
+    }
+    for (int hires = 0; hires < 2; hires++) {
+        int width = hires ? 128 : 64;
+        int height = hires ? 64 : 32;
+        int scale_x = present_out_w / width;
+        int scale_y = present_out_h / height;
+        int scale = scale_x < scale_y ? scale_x : scale_y;
+        if (scale < 1) {
+            scale = 1; // Window smaller than the source: clip, don't blur
+        }
+        present_rect[hires].w = (float)(width * scale);
+        present_rect[hires].h = (float)(height * scale);
+        present_rect[hires].x = (float)((present_out_w - width * scale) / 2);
+        present_rect[hires].y = (float)((present_out_h - height * scale) / 2);
+    }
+}
+
+/* Upload-path switch from the render probe: lock/unlock maps driver
+   memory and expands straight into it; the update path expands into this
+   staging buffer and hands it over in one SDL_UpdateTexture call. Which
+   of the two is cheaper is the probe's cached verdict per host (see
+   renderprobe.h). Render thread only. */
+static uint32_t upload_staging[128 * 64];
+
+static bool framebuffer_begin(const SDL_Rect *rect, void **pixels, int *pitch) {
+    if (renderprobe_use_update) {
+        *pixels = upload_staging;
+        *pitch = rect->w * 4;
+        return true;
+    }
+    return SDL_LockTexture(framebuffer, rect, pixels, pitch);
+}
 
-        /* wrapping around to avoid floating-point errors */
-        cur_sine_sample %= sample_rate;
+static void framebuffer_end(const SDL_Rect *rect, int pitch) {
+    if (renderprobe_use_update) {
+        SDL_UpdateTexture(framebuffer, rect, upload_staging, pitch);
+    } else {
+        SDL_UnlockTexture(framebuffer);
+    }
+}
 
-        /* feed the new data to the stream. It will queue at the end, and trickle out as the hardware needs more data. */
-        SDL_PutAudioStreamData(stream, samples, sizeof (samples));
+// Expands the whole active region of a frame into the streaming texture,
+// compositing both planes 4 pixels at a time through the nibble LUT: one
+// table load and one 16-byte store per 4 columns
+static void expand_full(const published_frame_t *frame, int width, int height) {
+    void *pixels;
+    int pitch;
+    SDL_Rect lock_rect = {0, 0, width, height};
+    if (!framebuffer_begin(&lock_rect, &pixels, &pitch)) {
+        return;
+    }
+    audit_uploads++;
+    audit_upload_bytes += (uint32_t)(width * height) * 4;
+    for (int j = 0; j < height; j++) {
+        uint32_t *out = (uint32_t *)((uint8_t *)pixels + j * pitch);
+        for (int word = 0; word < width / 64; word++) {
+            uint64_t plane0 = frame->rows[0][j][word];
+            uint64_t plane1 = frame->rows[1][j][word];
+            for (int nib = 0; nib < 16; nib++) {
+                int shift = 60 - nib * 4;
+                unsigned combined = (unsigned)((plane1 >> shift) & 0xF) << 4
+                                  | (unsigned)((plane0 >> shift) & 0xF);
+                SDL_memcpy(out, expand_lut[combined], sizeof(expand_lut[combined]));
+                out += 4;
+            }
+        }
     }
+    framebuffer_end(&lock_rect, pitch);
 }
 
-void render(uint8_t *vram) {
-    /* Draw Chip-8 VRAM buffer */
-    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+/* CRT pass: sharp base scale into the target, additive linear re-draw for
+   phosphor glow, scanline pattern tiled over it, then one draw onto `out`
+   (NULL = the window backbuffer; the visual suite passes an offscreen
+   target). */
+static void crt_compose(const SDL_FRect *src_rect, const SDL_FRect *dst_rect, SDL_Texture *out) {
+    SDL_SetRenderTarget(renderer, crt_target);
+    SDL_RenderTexture(renderer, framebuffer, src_rect, NULL);
+    SDL_SetTextureScaleMode(framebuffer, SDL_SCALEMODE_LINEAR);
+    SDL_SetTextureBlendMode(framebuffer, SDL_BLENDMODE_ADD);
+    SDL_SetTextureAlphaMod(framebuffer, 72);
+    SDL_RenderTexture(renderer, framebuffer, src_rect, NULL);
+    SDL_SetTextureAlphaMod(framebuffer, 255);
+    SDL_SetTextureBlendMode(framebuffer, SDL_BLENDMODE_NONE);
+    SDL_SetTextureScaleMode(framebuffer, SDL_SCALEMODE_NEAREST);
+    SDL_RenderTextureTiled(renderer, scanline_texture, NULL, 1.0f, NULL);
+    SDL_SetRenderTarget(renderer, out);
     SDL_RenderClear(renderer);
-    SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
+    SDL_RenderTexture(renderer, crt_target, NULL, dst_rect);
+}
+
+/* Merges overlapping or touching dirty rects in place and returns the new
+   count. Draw-heavy catch-up frames stack several DXYN calls between
+   presents, often over the same sprite cell; merging at the LUT's 4-pixel
+   column granularity means each touched region locks and expands once, so
+   per-present upload cost is bounded by screen area, not draw count. */
+static int coalesce_dirty_rects(chip8_rect_t *rects, int count) {
+    bool merged = true;
+    while (merged) {
+        merged = false;
+        for (int a = 0; a < count; a++) {
+            for (int b = a + 1; b < count; b++) {
+                // Overlap test at upload granularity: x spans widened to
+                // the 4-pixel columns the expansion loop touches anyway
+                int a_x0 = rects[a].x & ~3, a_x1 = (rects[a].x + rects[a].w + 3) & ~3;
+                int b_x0 = rects[b].x & ~3, b_x1 = (rects[b].x + rects[b].w + 3) & ~3;
+                if (a_x0 > b_x1 || b_x0 > a_x1 ||
+                    rects[a].y > rects[b].y + rects[b].h ||
+                    rects[b].y > rects[a].y + rects[a].h) {
+                    continue;
+                }
+                int x0 = rects[a].x < rects[b].x ? rects[a].x : rects[b].x;
+                int y0 = rects[a].y < rects[b].y ? rects[a].y : rects[b].y;
+                int x1 = rects[a].x + rects[a].w > rects[b].x + rects[b].w
+                       ? rects[a].x + rects[a].w : rects[b].x + rects[b].w;
+                int y1 = rects[a].y + rects[a].h > rects[b].y + rects[b].h
+                       ? rects[a].y + rects[a].h : rects[b].y + rects[b].h;
+                rects[a] = (chip8_rect_t){(uint8_t)x0, (uint8_t)y0,
+                                          (uint8_t)(x1 - x0), (uint8_t)(y1 - y0)};
+                rects[b] = rects[--count];
+                merged = true;
+            }
+        }
+    }
+    return count;
+}
+
+void render(const published_frame_t *frame) {
+    /* Expand the packed vram rows into the streaming texture. In lo-res
+       only the 64x32 corner is locked and presented, so the per-pixel cost
+       does not quadruple for classic ROMs. */
+    int width = frame->hires ? 128 : 64;
+    int height = frame->hires ? 64 : 32;
 
-    for (int i = 0; i < 64; i++) {
-        for (int j = 0; j < 32; j++) {
-            int index = (j * 64) + i;
-            uint8_t pixel = vram[index];
+    // Resizes are flagged by the event loop; fold them in here, on the
+    // renderer's thread, so the geometry below is cached between resizes
+    if (SDL_GetAtomicInt(&window_resized)) {
+        SDL_SetAtomicInt(&window_resized, 0);
+        update_present_geometry();
+    }
+    const SDL_FRect *dst_rect = &present_rect[frame->hires ? 1 : 0];
+
+    void *pixels;
+    int pitch;
+    if (frame->dirty_count != CHIP8_DIRTY_FULL) {
+        // Partial update: lock and expand only the sprite regions that
+        // changed, widened to the LUT's 4-pixel granularity. Most ROMs
+        // touch a few sprites per frame, so this replaces a 2048-pixel
+        // rewrite with a few dozen. Overlaps are merged first so catch-up
+        // frames never upload the same cell twice.
+        chip8_rect_t rects[CHIP8_DIRTY_RECTS];
+        SDL_memcpy(rects, frame->dirty_rects, frame->dirty_count * sizeof(chip8_rect_t));
+        int rect_count = coalesce_dirty_rects(rects, frame->dirty_count);
+        for (int r = 0; r < rect_count; r++) {
+            const chip8_rect_t *rect = &rects[r];
+            int x0 = rect->x & ~3;
+            int x1 = (rect->x + rect->w + 3) & ~3;
+            if (x1 > width) {
+                x1 = width;
+            }
 
-            if (pixel) {
-                SDL_FRect rect = {
-                    .x = i * scale_x,
-                    .y = j * scale_y,
-                    .w = scale_x,
-                    .h = scale_y
-                };
-                SDL_RenderFillRect(renderer, &rect);
+            SDL_Rect lock_rect = {x0, rect->y, x1 - x0, rect->h};
+            if (framebuffer_begin(&lock_rect, &pixels, &pitch)) {
+                audit_uploads++;
+                audit_upload_bytes += (uint32_t)(lock_rect.w * lock_rect.h) * 4;
+                for (int j = 0; j < rect->h; j++) {
+                    uint32_t *out = (uint32_t *)((uint8_t *)pixels + j * pitch);
+                    for (int i = x0; i < x1; i += 4) {
+                        int shift = 60 - (i & 63);
+                        unsigned combined =
+                            (unsigned)((frame->rows[1][rect->y + j][i >> 6] >> shift) & 0xF) << 4
+                          | (unsigned)((frame->rows[0][rect->y + j][i >> 6] >> shift) & 0xF);
+                        SDL_memcpy(out, expand_lut[combined], sizeof(expand_lut[combined]));
+                        out += 4;
+                    }
+                }
+                framebuffer_end(&lock_rect, pitch);
             }
         }
+    } else {
+        expand_full(frame, width, height);
     }
 
+    /* Present the active region scaled to the window in a single draw
+       call. The whole frame reaches the GPU as one batched submission
+       (one texture upload, one textured quad) rather than per-pixel
+       rect draws, so render CPU stays flat regardless of lit pixels. */
+    SDL_FRect src_rect = {0, 0, (float)width, (float)height};
+    SDL_Texture *out = present_rotation != 0 ? rotation_target : NULL;
+    if (SDL_GetAtomicInt(&crt_enabled) && crt_target != NULL
+        && !degrade_active(DEGRADE_EFFECTS)) {
+        crt_compose(&src_rect, dst_rect, out);
+        audit_draws += 5;
+    } else {
+        SDL_SetRenderTarget(renderer, out);
+        SDL_RenderClear(renderer);
+        SDL_RenderTexture(renderer, framebuffer, &src_rect, dst_rect);
+        audit_draws += 2;
+    }
+    if (SDL_GetAtomicInt(&hud_enabled) && !degrade_active(DEGRADE_HUD)) {
+        hud_overlay();
+    }
+    if (out != NULL) {
+        // One rotated blit of the finished logical frame: the centered
+        // destination spins about its own center, landing exactly on the
+        // physical backbuffer for every supported angle
+        SDL_SetRenderTarget(renderer, NULL);
+        SDL_RenderClear(renderer);
+        SDL_FRect rotated_dst = {(float)(rotation_out_w - present_out_w) / 2.0f,
+                                 (float)(rotation_out_h - present_out_h) / 2.0f,
+                                 (float)present_out_w, (float)present_out_h};
+        SDL_RenderTextureRotated(renderer, rotation_target, NULL, &rotated_dst,
+                                 present_rotation, NULL, SDL_FLIP_NONE);
+        audit_draws++;
+    }
     SDL_RenderPresent(renderer);
+    if (telemetry_startup_first_frame.value == 0) {
+        // First present: the kiosk-visible end of startup
+        telemetry_counter_max(&telemetry_startup_first_frame,
+                              (telemetry_now_ns() - startup_epoch_ns) / 1000);
+    }
+    if (latency_enabled) {
+        latency_present();
+    }
+
+    // Close out the frame's audit window: fold the counts into the exit
+    // report's watermarks and publish them for the next HUD refresh
+    telemetry_counter_max(&telemetry_render_draw_peak, audit_draws);
+    telemetry_counter_max(&telemetry_render_upload_peak, audit_uploads);
+    telemetry_counter_max(&telemetry_render_upload_bytes, audit_upload_bytes);
+    audit_frame_draws = audit_draws;
+    audit_frame_uploads = audit_uploads;
+    audit_frame_bytes = audit_upload_bytes;
+    audit_draws = 0;
+    audit_uploads = 0;
+    audit_upload_bytes = 0;
 }
 
-int main(int argc, char *argv[]) {
-    
-    // Initialize SDL
-    if (!SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO)) {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't initialize SDL: %s", SDL_GetError());
-        return SDL_APP_FAILURE;
+/* Render thread: swap in the newest published frame and present it. Only
+   this thread touches the renderer after startup. */
+static void *render_thread_main(void *arg) {
+    int render_slot = 2; // Slots 0/1 start with the emulation side
+    perfcount_thread_open(); // No-op unless --perf armed the layer
+    uint64_t next_present_ns = telemetry_now_ns();
+
+    while (SDL_GetAtomicInt(&render_running)) {
+        if (SDL_GetAtomicInt(&render_parked) || SDL_GetAtomicInt(&render_hidden)) {
+            // Paused or invisible: sleep until the event loop signals —
+            // predicates are re-checked under the lock, so a publish
+            // racing the park is never lost. A fresh publish wakes the
+            // pause park (single-step presents) but not the hidden one.
+            pthread_mutex_lock(&render_park_lock);
+            while ((SDL_GetAtomicInt(&render_hidden) ||
+                    (SDL_GetAtomicInt(&render_parked) &&
+                     !(SDL_GetAtomicInt(&pending_frame) & FRAME_FRESH))) &&
+                   !SDL_GetAtomicInt(&render_nudge) &&
+                   SDL_GetAtomicInt(&render_running)) {
+                pthread_cond_wait(&render_park_cond, &render_park_lock);
+            }
+            pthread_mutex_unlock(&render_park_lock);
+            if (SDL_SetAtomicInt(&render_nudge, 0)) {
+                render(&frame_slots[render_slot]); // Redraw under a new overlay state
+            }
+            next_present_ns = telemetry_now_ns(); // Pacing restarts at the wake
+        }
+
+        // One iteration per display frame. With vsync enabled the present
+        // below blocks on the swapchain and this sleep is a no-op; without
+        // it, the sleep is the pacing.
+        uint64_t now = telemetry_now_ns();
+        if (now < next_present_ns) {
+            SDL_DelayNS(next_present_ns - now);
+        } else if (now - next_present_ns > refresh_interval_ns) {
+            next_present_ns = now; // Fell far behind (window drag): re-baseline
+        }
+        // Under the PRESENT rung every other display frame is skipped;
+        // the triple buffer absorbs the unconsumed publishes as usual
+        next_present_ns += degrade_active(DEGRADE_PRESENT)
+                         ? refresh_interval_ns * 2 : refresh_interval_ns;
+
+        int prev = SDL_SetAtomicInt(&pending_frame, render_slot);
+        if (prev & FRAME_FRESH) {
+            render_slot = prev & 3;
+            uint64_t present_start = telemetry_now_ns();
+            if (perfcount_enabled) {
+                perfcount_begin();
+            }
+            render(&frame_slots[render_slot]);
+            if (perfcount_enabled) {
+                perfcount_end(PERF_PHASE_RENDER);
+            }
+            telemetry_record(&telemetry_present, telemetry_now_ns() - present_start);
+        } else if (SDL_GetAtomicInt(&hud_enabled)) {
+            // No new frame, but keep the HUD numbers moving by re-presenting
+            // the last one at 10Hz
+            static uint64_t last_hud_present;
+            if (now - last_hud_present >= 100000000ULL) {
+                last_hud_present = now;
+                render(&frame_slots[render_slot]);
+            }
+        }
     }
+    return NULL;
+}
 
-    // Create Window and Renderer
-    if (!SDL_CreateWindowAndRenderer("Chip-8 Emulator", WINDOW_WIDTH, WINDOW_HEIGHT, SDL_WINDOW_RESIZABLE, &window, &renderer)) {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't create window and renderer: %s", SDL_GetError());
-        return SDL_APP_FAILURE;
+/* Flicker filter (--ghosting [frames]): XOR erase-and-redraw loops light
+   the same pixels on alternating frames, and the pipeline faithfully
+   presents every intermediate blank. When enabled, a pixel stays lit in
+   the presented copy for one to two hold intervals after the ROM last
+   drew it: two accumulators OR up the published packed rows and rotate
+   every ghost_frames publishes, so compositing is a few hundred word ORs
+   folded into the publish copy — never a framebuffer re-scan. Ghosts
+   only expire at a rotation, which forces a full texture update; between
+   rotations every presented change already sits inside the frame's dirty
+   rects. The emulated vram is untouched, so hashes and savestates don't
+   see the filter. */
+static uint32_t ghost_frames; // Hold interval in published frames; 0 = off
+static uint64_t ghost_accum[2][2][64][2]; // [current/previous][plane][row][word]
+static uint32_t ghost_elapsed;
+static bool ghost_hires;
+
+/* Emulation side: copy vram into the write slot and publish it. Dirty
+   regions from a frame the renderer never consumed (overwritten in the
+   slot ring) are carried into the next publish so no texture region goes
+   stale. */
+static void publish_frame(chip8_state_t *state) {
+    static int write_slot = 0;
+    static chip8_rect_t carry_rects[CHIP8_DIRTY_RECTS];
+    static uint8_t carry_count = 0;
+
+    published_frame_t *frame = &frame_slots[write_slot];
+    chip8_vram_snapshot(state, frame->rows); // Resolves the lazy clear
+    frame->hires = state->hires;
+
+    if (ghost_frames != 0) {
+        if (frame->hires != ghost_hires) {
+            // Mode switches start from a blank screen: drop stale ghosts
+            SDL_memset(ghost_accum, 0, sizeof(ghost_accum));
+            ghost_hires = frame->hires;
+        }
+        bool rotate = ++ghost_elapsed >= ghost_frames;
+        for (int p = 0; p < 2; p++) {
+            for (int r = 0; r < 64; r++) {
+                for (int w = 0; w < 2; w++) {
+                    uint64_t live = frame->rows[p][r][w];
+                    if (rotate) {
+                        ghost_accum[1][p][r][w] = ghost_accum[0][p][r][w];
+                        ghost_accum[0][p][r][w] = live;
+                    } else {
+                        ghost_accum[0][p][r][w] |= live;
+                    }
+                    frame->rows[p][r][w] =
+                        live | ghost_accum[0][p][r][w] | ghost_accum[1][p][r][w];
+                }
+            }
+        }
+        if (rotate) {
+            ghost_elapsed = 0;
+            state->dirty_count = CHIP8_DIRTY_FULL; // Expired ghosts need a repaint
+        }
     }
 
-    // Setup audio
-    SDL_AudioSpec audio_spec;
-    audio_spec.channels = 1;
-    audio_spec.format = SDL_AUDIO_F32;
-    audio_spec.freq = 44100;
-    stream = SDL_OpenAudioDeviceStream(SDL_AUDIO_DEVICE_DEFAULT_PLAYBACK, &audio_spec, NULL, NULL);
-    if (!stream) {
-        SDL_Log("Couldn't create audio stream: %s", SDL_GetError());
-        return SDL_APP_FAILURE;
+    if (shmframe_enabled) {
+        // External compositors get exactly what the renderer will show
+        // (ghosting included), straight from the publish copy
+        shmframe_publish(frame->rows, frame->hires);
+    }
+    if (capture_enabled) {
+        capture_push(frame->rows, frame->hires, telemetry_now_ns());
+    }
+
+    // Merge carried regions with this frame's; any overflow falls back to
+    // a full update
+    if (carry_count == CHIP8_DIRTY_FULL || state->dirty_count == CHIP8_DIRTY_FULL ||
+        carry_count + state->dirty_count > CHIP8_DIRTY_RECTS) {
+        frame->dirty_count = CHIP8_DIRTY_FULL;
+    } else {
+        SDL_memcpy(frame->dirty_rects, carry_rects, carry_count * sizeof(chip8_rect_t));
+        SDL_memcpy(frame->dirty_rects + carry_count, state->dirty_rects,
+                   state->dirty_count * sizeof(chip8_rect_t));
+        frame->dirty_count = carry_count + state->dirty_count;
+    }
+    state->dirty_count = 0;
+
+    int prev = SDL_SetAtomicInt(&pending_frame, write_slot | FRAME_FRESH);
+    if (prev & FRAME_FRESH) {
+        // The overwritten frame never reached the texture: its regions
+        // (which already include anything carried into it) carry forward
+        published_frame_t *missed = &frame_slots[prev & 3];
+        carry_count = missed->dirty_count;
+        if (carry_count != CHIP8_DIRTY_FULL) {
+            SDL_memcpy(carry_rects, missed->dirty_rects, carry_count * sizeof(chip8_rect_t));
+        }
+    } else {
+        carry_count = 0;
     }
-    SDL_ResumeAudioStreamDevice(stream);
+    write_slot = prev & 3;
+}
 
-    // Create emulator state
+// Runs the core without any SDL video/audio at uncapped speed and prints a
+// hash of the final vram and register state. Timers decrement on a virtual
+// 60Hz clock derived from the instruction count so runs are deterministic.
+int run_headless(const char *rom, uint64_t cycles, uint32_t seed, const char *replay_file,
+                 const char *screenshot_file) {
     chip8_state_t chip8_state;
     chip8_init(&chip8_state);
+    chip8_seed(&chip8_state, seed);
 
-    // Load ROM
-    if (argc < 2) {
-        SDL_Log("Usage: %s <ROM file>", argv[0]);
+    if (!chip8_load_rom(&chip8_state, rom)) {
+        return SDL_APP_FAILURE;
+    }
+    if (replay_file != NULL && !replay_play_start(replay_file, &chip8_state)) {
         return SDL_APP_FAILURE;
     }
-    chip8_load_rom(&chip8_state, argv[1]);
 
-    // Setup delay and sound timer tick
-    run_timers = true;
-    pthread_t timer_thread;
-    pthread_create(&timer_thread, NULL, chip8_timer_tick, (void*)&chip8_state);
+    const uint64_t instructions_per_timer_tick = CHIP8_DEFAULT_IPS / 60;
 
-    // Main emulator loop
-    while (true) {
+    for (uint64_t i = 0; i < cycles; i++) {
+        replay_play_apply(&chip8_state);
+        chip8_step(&chip8_state);
 
-        // Check for quit
-        SDL_PollEvent(&event);
-        if (event.type == SDL_EVENT_QUIT) {
-            break;
+        // Virtual 60Hz tick; a display-wait park burns the remaining
+        // instruction slots until this boundary releases it
+        if (i % instructions_per_timer_tick == 0) {
+            chip8_vblank(&chip8_state);
         }
+    }
 
-        get_input(chip8_state.keypad);
-        chip8_tick(&chip8_state);
-        process_audio(chip8_state.sound_timer);
-        render(chip8_state.vram);
+    if (counters_requested) {
+        chip8_counters_write_json(&chip8_state, COUNTERS_FILE);
+    }
+    if (screenshot_file != NULL) {
+        screenshot_request(&chip8_state, screenshot_file);
+        screenshot_stop(); // Drain before exit
     }
 
-    run_timers = false;
-    pthread_join(timer_thread, NULL);
+    uint64_t hash = chip8_state_hash(&chip8_state);
 
-    // Destroy resources
-    SDL_DestroyRenderer(renderer);
-    SDL_DestroyWindow(window);
-    SDL_Quit();
+    SDL_Log("Executed %llu cycles", (unsigned long long)cycles);
+    printf("%016llx\n", (unsigned long long)hash);
+    return 0;
+}
+
+/* Pre-deployment analyzer: chip8 --analyze <ROM file> [--seconds N].
+   One report from the disassembler's reachability walk plus a bounded
+   headless run on the virtual clock: opcode mix, draw rate and estimated
+   draw area, input behavior (FX0A waits, EX9E/EXA1 polls),
+   self-modification, and an IPS-sensitivity verdict — what an operator
+   needs to pick quirk/IPS settings and predict host capacity without a
+   trial deployment. Fixed seed, so the report is reproducible. */
+#define ANALYZE_SECONDS 60
+
+static int run_analyze(const char *rom, unsigned seconds) {
+    uint8_t image[CHIP8_MEMORY_BYTES];
+    FILE *fptr = fopen(rom, "rb");
+    if (fptr == NULL) {
+        SDL_Log("Error opening file: %s", rom);
+        return SDL_APP_FAILURE;
+    }
+    size_t size = fread(image, 1, sizeof(image), fptr);
+    fclose(fptr);
+
+    chip8_state_t state;
+    chip8_init(&state);
+    chip8_seed(&state, 1);
+    if (size == 0 || !chip8_load_rom_memory(&state, image, size)) {
+        return SDL_APP_FAILURE;
+    }
+    SDL_Log("Analyzing %s: %zu bytes, hash %016llx", rom, size,
+            (unsigned long long)state.rom_hash);
+
+    // Static pass: reachable instructions vs. data under the loaded
+    // profile's quirks
+    disasm_scan(&state);
+    int code_words = 0;
+    for (size_t addr = 0x200; addr < 0x200 + size; addr++) {
+        if (disasm_is_code((uint16_t)addr)) {
+            code_words++;
+        }
+    }
+    size_t data_bytes = size > (size_t)code_words * 2 ? size - (size_t)code_words * 2 : 0;
+    SDL_Log("Static: %d reachable instructions, %zu data bytes, profile %s, ips %u",
+            code_words, data_bytes,
+            state.profile == CHIP8_PROFILE_COSMAC ? "cosmac" : "modern",
+            state.ips);
+    if (romdb_find(state.rom_hash) == NULL) {
+        SDL_Log("Static: no romdb entry — running the defaults");
+    }
+
+    // Bounded run on the virtual clock, peeking each instruction before
+    // it executes for the draw-area and self-modification signals the
+    // counters alone can't give
+    uint32_t ips = state.ips != 0 ? state.ips : CHIP8_DEFAULT_IPS;
+    uint64_t per_tick = ips / 60 != 0 ? ips / 60 : 1;
+    uint64_t budget = (uint64_t)ips * seconds;
+    uint64_t draw_area = 0; // Source pixels covered by DXYN, pre-clip
+    bool self_mod = false;
+    uint16_t self_mod_pc = 0, self_mod_target = 0;
+    bool blocked_input = false, idle_spin = false;
+    uint64_t executed = 0;
+
+    while (executed < budget) {
+        uint16_t pc = state.program_counter & CHIP8_ADDR_MASK;
+        uint16_t op = (uint16_t)(state.memory[pc] << 8 | state.memory[(pc + 1) & CHIP8_ADDR_MASK]);
+        if ((op >> 12) == 0xD) {
+            int rows = op & 0xF;
+            draw_area += rows == 0 ? 16 * 16 : (uint64_t)rows * 8; // DXY0 = SCHIP 16x16
+        }
+        if ((op & 0xF0FF) == 0xF055 || (op & 0xF0FF) == 0xF033) {
+            int span = (op & 0xF0FF) == 0xF033 ? 3 : ((op >> 8) & 0xF) + 1;
+            for (int b = 0; b < span && !self_mod; b++) {
+                if (disasm_is_code((uint16_t)(state.index_register + b))) {
+                    self_mod = true;
+                    self_mod_pc = pc;
+                    self_mod_target = state.index_register;
+                }
+            }
+        }
+
+        chip8_step(&state);
+        executed++;
+        if (executed % per_tick == 0) {
+            chip8_vblank(&state);
+        }
+        if (state.waiting_key) {
+            blocked_input = true; // No keys ever arrive headless
+            break;
+        }
+        if (state.idle) {
+            idle_spin = true; // Self-jump: terminal without input
+            break;
+        }
+    }
+
+    uint64_t frames = executed / per_tick != 0 ? executed / per_tick : 1;
+    SDL_Log("Run: %llu instructions over %llu virtual frames (%.1fs of 60Hz at %u ips)",
+            (unsigned long long)executed, (unsigned long long)frames,
+            frames / 60.0, ips);
+
+    uint64_t draws = state.opcode_count[0xD]; // Before the mix loop eats it
 
+    // Opcode mix: the top groups by share of executed instructions
+    static const char *const group_names[16] = {
+        "0xxx", "1nnn", "2nnn", "3xnn", "4xnn", "5xy0", "6xnn", "7xnn",
+        "8xyn", "9xy0", "Annn", "Bnnn", "Cxnn", "Dxyn", "Exnn", "Fxnn"};
+    char mix[160];
+    int pos = 0;
+    for (int rank = 0; rank < 6; rank++) {
+        int best = -1;
+        uint64_t best_count = 0;
+        for (int g = 0; g < 16; g++) {
+            if (state.opcode_count[g] > best_count) {
+                best = g;
+                best_count = state.opcode_count[g];
+            }
+        }
+        if (best < 0 || best_count * 100 < state.cycle_count) {
+            break; // Under 1%: noise for a capacity report
+        }
+        pos += snprintf(mix + pos, sizeof(mix) - pos, "%s%s %.1f%%",
+                        rank == 0 ? "" : "  ", group_names[best],
+                        100.0 * best_count / state.cycle_count);
+        state.opcode_count[best] = 0; // Consumed; the report is done with it
+    }
+    SDL_Log("Opcode mix: %s", mix);
+
+    SDL_Log("Draws: %.2f/frame, est. %.0f px/frame drawn",
+            (double)draws / frames, (double)draw_area / frames);
+    SDL_Log("Input: %llu FX0A waits, %llu EX9E/EXA1 polls",
+            (unsigned long long)state.opcode_count_f[0x0A],
+            (unsigned long long)(state.opcode_count_e[0x9E] + state.opcode_count_e[0xA1]));
+    SDL_Log("Self-modifying: %s", self_mod ? "yes" : "no");
+    if (self_mod) {
+        SDL_Log("  first FX55/FX33 into code: pc %03X writing %03X",
+                self_mod_pc, self_mod_target);
+    }
+
+    // The verdict operators size hosts and pick --ips from
+    if (blocked_input) {
+        SDL_Log("Verdict: input-bound — parked on FX0A at pc %03X after %.1f "
+                "virtual seconds; IPS is irrelevant while waiting",
+                state.program_counter, (double)executed / ips);
+    } else if (idle_spin) {
+        SDL_Log("Verdict: terminal idle spin at pc %03X after %.1f virtual "
+                "seconds — likely a title/end screen; IPS-insensitive",
+                state.program_counter, (double)executed / ips);
+    } else if (state.profile == CHIP8_PROFILE_COSMAC && draws >= frames) {
+        SDL_Log("Verdict: display-wait bound (%.2f draws/frame under cosmac "
+                "quirks) — the 60Hz draw gate caps progress; raising IPS "
+                "mostly buys nothing", (double)draws / frames);
+    } else {
+        SDL_Log("Verdict: compute-bound — progress scales with --ips; "
+                "budget hosts for %u ips sustained", ips);
+    }
     return 0;
+}
+
+/* Lockstep A/B harness: runs the same ROM on two in-process interpreter
+   variants — the block executor against the single-step path — with
+   identical seeds and the virtual clock, comparing full state at every
+   block boundary and halting at the first divergence with a field-level
+   diff. Instruction-equal execution makes RNG draws and timer ticks line
+   up, so any mismatch is a real behavior difference. */
+static bool lockstep_compare(const chip8_state_t *a, const chip8_state_t *b) {
+    bool ok = true;
+
+    if (a->program_counter != b->program_counter) {
+        SDL_Log("  pc: %03x vs %03x", a->program_counter, b->program_counter);
+        ok = false;
+    }
+    if (a->index_register != b->index_register) {
+        SDL_Log("  i: %03x vs %03x", a->index_register, b->index_register);
+        ok = false;
+    }
+    if (a->stack_ptr != b->stack_ptr) {
+        SDL_Log("  sp: %u vs %u", a->stack_ptr, b->stack_ptr);
+        ok = false;
+    }
+    if (a->delay_timer != b->delay_timer || a->sound_timer != b->sound_timer) {
+        SDL_Log("  timers: dt %u/%u st %u/%u", a->delay_timer, b->delay_timer,
+                a->sound_timer, b->sound_timer);
+        ok = false;
+    }
+    for (int i = 0; i < 16; i++) {
+        if (a->registers[i] != b->registers[i]) {
+            SDL_Log("  v%x: %02x vs %02x", i, a->registers[i], b->registers[i]);
+            ok = false;
+        }
+        if (a->stack[i] != b->stack[i]) {
+            SDL_Log("  stack[%d]: %03x vs %03x", i, a->stack[i], b->stack[i]);
+            ok = false;
+        }
+    }
+
+    int reported = 0;
+    for (int addr = 0; addr < CHIP8_MEMORY_BYTES && reported < 8; addr++) {
+        if (a->memory[addr] != b->memory[addr]) {
+            SDL_Log("  mem[%03x]: %02x vs %02x", addr, a->memory[addr], b->memory[addr]);
+            ok = false;
+            reported++;
+        }
+    }
+    reported = 0;
+    for (int p = 0; p < 2 && reported < 8; p++) {
+        for (int row = 0; row < 64 && reported < 8; row++) {
+            if (chip8_vram_word(a, p, row, 0) != chip8_vram_word(b, p, row, 0) ||
+                chip8_vram_word(a, p, row, 1) != chip8_vram_word(b, p, row, 1)) {
+                SDL_Log("  vram[%d][%02d]: %016llx %016llx vs %016llx %016llx", p, row,
+                        (unsigned long long)chip8_vram_word(a, p, row, 0),
+                        (unsigned long long)chip8_vram_word(a, p, row, 1),
+                        (unsigned long long)chip8_vram_word(b, p, row, 0),
+                        (unsigned long long)chip8_vram_word(b, p, row, 1));
+                ok = false;
+                reported++;
+            }
+        }
+    }
+    return ok;
+}
+
+static int run_lockstep(const char *rom, uint64_t cycles) {
+    static chip8_state_t a, b; // Too big for the stack, and one-shot mode
+
+    chip8_init(&a);
+    chip8_init(&b);
+    chip8_seed(&a, 1);
+    chip8_seed(&b, 1);
+    chip8_set_virtual_clock(&a, true);
+    chip8_set_virtual_clock(&b, true);
+    if (!chip8_load_rom(&a, rom) || !chip8_load_rom(&b, rom)) {
+        return SDL_APP_FAILURE;
+    }
+
+    uint64_t executed = 0;
+    while (executed < cycles) {
+        chip8_update_timers(&a);
+        chip8_update_timers(&b);
+
+        // B runs a block, A single-steps the same count; both park on the
+        // same draw under display wait, released by the next timer update
+        int ran = chip8_run_block(&b);
+        for (int i = 0; i < ran; i++) {
+            chip8_step(&a);
+        }
+        if (ran == 0) {
+            if (b.idle) {
+                break; // Spin or key wait: nothing more without input
+            }
+            continue;
+        }
+        executed += ran;
+
+        if (!lockstep_compare(&a, &b)) {
+            SDL_Log("Lockstep divergence after %llu instructions (pc around %03x)",
+                    (unsigned long long)executed, b.program_counter);
+            return 1;
+        }
+    }
+
+    SDL_Log("Lockstep match over %llu instructions (hash %016llx)",
+            (unsigned long long)executed, (unsigned long long)chip8_state_hash(&b));
+    return 0;
+}
+
+/* Parallel sweep: runs every ROM in the library index headless for a
+   fixed cycle budget, distributed over one worker per logical core.
+   Workers pull the next ROM from a shared atomic cursor and run it on a
+   pool-allocated state with the virtual 60Hz clock, so results are
+   deterministic and a 3000-ROM validation pass takes minutes instead of
+   hours. The summary prints one line per ROM in index order. */
+typedef struct sweep_result {
+    bool loaded;
+    bool ok; // Architectural invariants held at the end of the run
+    uint64_t hash;
+    uint64_t executed;
+    uint64_t elapsed_ns;
+    uint64_t cpu_ns; // Thread CPU time: the per-ROM session cost that
+                     // feeds the sessions-per-core capacity estimate
+    uint8_t top_opcode; // Most-executed top nibble, a cheap ROM fingerprint
+} sweep_result_t;
+
+static SDL_AtomicInt sweep_cursor;
+static uint64_t sweep_cycles;
+static sweep_result_t *sweep_results;
+
+static void *sweep_worker(void *arg) {
+    chip8_state_t *state = arg; // Pool slab acquired before the spawn
+
+    for (;;) {
+        int i = SDL_AddAtomicInt(&sweep_cursor, 1);
+        if (i >= (int)library_count()) {
+            break;
+        }
+        sweep_result_t *result = &sweep_results[i];
+
+        chip8_init(state);
+        chip8_seed(state, 1); // Same fixed seed as headless runs
+        result->loaded = chip8_load_rom(state, library_get(i)->path);
+        if (!result->loaded) {
+            continue;
+        }
+
+        const uint64_t instructions_per_timer_tick = CHIP8_DEFAULT_IPS / 60;
+        uint64_t start_ns = telemetry_now_ns();
+        // Thread CPU time excludes preemption by the other workers, so
+        // the measured cost belongs to this session alone
+        struct timespec cpu0, cpu1;
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &cpu0);
+        for (uint64_t c = 0; c < sweep_cycles; c++) {
+            chip8_step(state);
+            if (c % instructions_per_timer_tick == 0) {
+                chip8_vblank(state);
+            }
+        }
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &cpu1);
+        result->cpu_ns = (uint64_t)(cpu1.tv_sec - cpu0.tv_sec) * 1000000000ULL
+                       + (uint64_t)(cpu1.tv_nsec - cpu0.tv_nsec);
+        result->elapsed_ns = telemetry_now_ns() - start_ns;
+
+        result->hash = chip8_state_hash(state);
+        result->executed = state->cycle_count;
+        result->ok = state->program_counter < CHIP8_MEMORY_BYTES && state->stack_ptr <= 16;
+        result->top_opcode = 0;
+        for (int n = 1; n < 16; n++) {
+            if (state->opcode_count[n] > state->opcode_count[result->top_opcode]) {
+                result->top_opcode = (uint8_t)n;
+            }
+        }
+    }
+
+    return NULL;
+}
+
+static int run_sweep(const char *directory, uint64_t cycles) {
+    if (!library_scan(directory, LIBRARY_INDEX_FILE) || library_count() == 0) {
+        SDL_Log("Nothing to sweep under %s", directory);
+        return SDL_APP_FAILURE;
+    }
+
+    int workers = SDL_GetNumLogicalCPUCores();
+    if (workers < 1) {
+        workers = 1;
+    }
+    if (workers > (int)library_count()) {
+        workers = (int)library_count();
+    }
+    if (workers > 64) {
+        workers = 64;
+    }
+
+    sweep_cycles = cycles;
+    sweep_results = SDL_calloc(library_count(), sizeof(*sweep_results));
+    if (!pool_init(workers) || sweep_results == NULL) {
+        return SDL_APP_FAILURE;
+    }
+
+    // The pool free list isn't thread-safe, so slabs are handed out here
+    // and each worker keeps its one state for the whole sweep
+    uint64_t start_ns = telemetry_now_ns();
+    pthread_t threads[64];
+    for (int i = 0; i < workers; i++) {
+        pthread_create(&threads[i], NULL, sweep_worker, pool_acquire());
+    }
+    for (int i = 0; i < workers; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    double wall_s = (telemetry_now_ns() - start_ns) / 1e9;
+
+    int failures = 0;
+    uint64_t total_executed = 0;
+    uint64_t total_cpu_ns = 0;
+    // Capacity model: each session's budget spans cycles/ips virtual
+    // seconds on the 60Hz schedule (display-wait parks included — a real
+    // paced session sleeps those for free), for cpu_ns of thread CPU; so
+    // virtual/cpu is how many such sessions one core sustains real-time
+    double virtual_seconds = (double)cycles / CHIP8_DEFAULT_IPS;
+    uint64_t attempted = 0;
+    double worst_density = 0.0;
+    const char *worst_rom = NULL;
+    for (size_t i = 0; i < library_count(); i++) {
+        const sweep_result_t *result = &sweep_results[i];
+        if (!result->loaded) {
+            SDL_Log("LOAD-FAIL %s", library_get(i)->path);
+            failures++;
+            continue;
+        }
+        if (!result->ok) {
+            failures++;
+        }
+        total_executed += result->executed;
+        total_cpu_ns += result->cpu_ns;
+        attempted++;
+        double mips = result->elapsed_ns != 0
+                    ? (double)result->executed * 1e3 / result->elapsed_ns : 0.0;
+        double density = result->cpu_ns != 0
+                       ? virtual_seconds * 1e9 / result->cpu_ns : 0.0;
+        if (density != 0.0 && (worst_rom == NULL || density < worst_density)) {
+            worst_density = density;
+            worst_rom = library_get(i)->path;
+        }
+        SDL_Log("%016llx %7.1f MIPS  %6.0f/core  top %xNNN  %s  %s",
+                (unsigned long long)result->hash, mips, density,
+                result->top_opcode, result->ok ? "ok " : "BAD",
+                library_get(i)->path);
+    }
+    SDL_Log("Swept %zu ROMs (%llu instructions) on %d workers in %.2fs; %d failures",
+            library_count(), (unsigned long long)total_executed, workers, wall_s,
+            failures);
+    if (total_cpu_ns != 0 && worst_rom != NULL) {
+        SDL_Log("Capacity: fleet average %.0f sessions/core at %u ips; "
+                "worst %.0f (%s) — bin-pack against the worst",
+                (double)attempted * virtual_seconds * 1e9 / total_cpu_ns,
+                CHIP8_DEFAULT_IPS, worst_density, worst_rom);
+    }
+
+    SDL_free(sweep_results);
+    pool_shutdown();
+    return failures == 0 ? 0 : SDL_APP_FAILURE;
+}
+
+/* Ultra-dense hosting: chip8 --dense <ROM> [ROM...] [--seconds N].
+   The tier below thread-per-session: one thread round-robins per-frame
+   chip8_run slices across every session. The states are small enough
+   that several sit in L2 together, and a session parked on FX0A — a
+   menu or attract loop waiting for a coin — is skipped outright, so one
+   core hosts dozens of mostly-idle sessions where the one-process-per-
+   session model wastes a whole core each. A utilization line per second
+   tells the operator how much packing headroom is left; --seconds
+   bounds the run (0, the default, hosts until terminated). */
+#define DENSE_MAX_SESSIONS 64
+
+static int run_dense(int count, char *const *roms, unsigned seconds) {
+    if (count > DENSE_MAX_SESSIONS) {
+        SDL_Log("Dense mode caps at %d sessions; ignoring the rest", DENSE_MAX_SESSIONS);
+        count = DENSE_MAX_SESSIONS;
+    }
+
+    // Same shared-image preparation as the wall: each distinct ROM is
+    // read, loaded, and predecoded exactly once, and every session boots
+    // its private copy from the warm read-only image
+    int distinct = 0;
+    int image_of[DENSE_MAX_SESSIONS];
+    const char *image_paths[DENSE_MAX_SESSIONS];
+    for (int i = 0; i < count; i++) {
+        image_of[i] = distinct;
+        for (int j = 0; j < distinct; j++) {
+            if (SDL_strcmp(roms[i], image_paths[j]) == 0) {
+                image_of[i] = j;
+                break;
+            }
+        }
+        if (image_of[i] == distinct) {
+            image_paths[distinct++] = roms[i];
+        }
+    }
+
+    if (!pool_init(count + distinct)) {
+        return SDL_APP_FAILURE;
+    }
+    chip8_state_t *images[DENSE_MAX_SESSIONS];
+    bool image_loaded[DENSE_MAX_SESSIONS];
+    for (int j = 0; j < distinct; j++) {
+        images[j] = pool_acquire();
+        chip8_init(images[j]);
+        image_loaded[j] = chip8_load_rom(images[j], image_paths[j]);
+        if (image_loaded[j]) {
+            disasm_scan(images[j]);
+        }
+    }
+
+    chip8_state_t *states[DENSE_MAX_SESSIONS];
+    bool alive[DENSE_MAX_SESSIONS];
+    for (int i = 0; i < count; i++) {
+        states[i] = pool_acquire();
+        chip8_init(states[i]);
+        alive[i] = image_loaded[image_of[i]];
+        if (alive[i]) {
+            chip8_boot(states[i], images[image_of[i]]);
+        } else {
+            SDL_Log("LOAD-FAIL %s", roms[i]);
+        }
+    }
+    SDL_Log("Dense hosting %d session(s) (%d prepared image(s)) on one thread",
+            count, distinct);
+
+    const uint64_t frame_ns = 1000000000ULL / 60;
+    uint64_t next_frame = telemetry_now_ns();
+    uint64_t deadline = seconds != 0 ? next_frame + (uint64_t)seconds * 1000000000ULL : 0;
+    uint64_t report_epoch = next_frame;
+    uint64_t busy_window = 0; // Scheduler CPU since the last report
+    uint64_t frames_window = 0;
+    uint64_t frames = 0;
+
+    for (;;) {
+        uint64_t frame_start = telemetry_now_ns();
+        if (deadline != 0 && frame_start >= deadline) {
+            break;
+        }
+
+        int awake = 0;
+        for (int k = 0; k < count; k++) {
+            // Rotating start index: when a frame saturates, every
+            // session still gets the front of the frame equally often
+            int i = (int)((frames + k) % count);
+            if (!alive[i]) {
+                continue;
+            }
+            chip8_update_timers(states[i]);
+            if (states[i]->idle) {
+                continue; // Parked on key wait: zero slice cost
+            }
+            awake++;
+            uint32_t ips = states[i]->ips != 0 ? states[i]->ips : CHIP8_DEFAULT_IPS;
+            chip8_run(states[i], (int)(ips / 60));
+        }
+        frames++;
+        frames_window++;
+
+        uint64_t frame_end = telemetry_now_ns();
+        busy_window += frame_end - frame_start;
+        if (frame_end - report_epoch >= 1000000000ULL) {
+            // Headroom model: the average frame's busy span divided by
+            // the sessions that ran it prices one more awake session
+            int parked = 0;
+            for (int i = 0; i < count; i++) {
+                parked += alive[i] && states[i]->idle;
+            }
+            unsigned pct = (unsigned)(busy_window * 100 / (frame_end - report_epoch));
+            uint64_t frame_busy = busy_window / frames_window;
+            uint64_t per_session = awake != 0 ? frame_busy / awake : 0;
+            if (per_session != 0 && frame_busy < frame_ns) {
+                SDL_Log("Dense: %d awake, %d parked, core %u%% busy, "
+                        "room for ~%llu more like these",
+                        awake, parked, pct,
+                        (unsigned long long)((frame_ns - frame_busy) / per_session));
+            } else {
+                SDL_Log("Dense: %d awake, %d parked, core %u%% busy%s",
+                        awake, parked, pct,
+                        frame_busy >= frame_ns ? " — SATURATED, sessions run behind"
+                                               : "");
+            }
+            report_epoch = frame_end;
+            busy_window = 0;
+            frames_window = 0;
+        }
+
+        next_frame += frame_ns;
+        if (next_frame > frame_end) {
+            SDL_DelayNS(next_frame - frame_end);
+        } else {
+            next_frame = frame_end; // Saturated: don't accumulate debt
+        }
+    }
+
+    SDL_Log("Dense hosted %d session(s) for %llu frames:",
+            count, (unsigned long long)frames);
+    for (int i = 0; i < count; i++) {
+        if (alive[i]) {
+            SDL_Log("  %-32s %12llu executed%s", roms[i],
+                    (unsigned long long)states[i]->cycle_count,
+                    states[i]->idle ? "  (parked)" : "");
+        } else {
+            SDL_Log("  %-32s load failed", roms[i]);
+        }
+        pool_release(states[i]);
+    }
+    for (int j = 0; j < distinct; j++) {
+        pool_release(images[j]);
+    }
+    pool_shutdown();
+    return 0;
+}
+
+/* Soak mode: chip8 --soak <ROM> [--seconds N] [--checkpoint N].
+   Multi-week burn-in for one session, wall-clock paced through the
+   unified virtual clock — the run that proves the clock holds frequency
+   over a horizon where any uncorrected sleep overshoot would visibly
+   accumulate. Every checkpoint (default 60s) emits one structured
+   key=value line: cumulative vblank drift against the 60Hz ideal, RSS
+   and its growth since start, the window's tick-time percentiles (a
+   fresh histogram per window, so tail decay over time is visible, not
+   averaged away), executed instructions, and the audio queue health
+   counters — the sound hook is live, so a beeping ROM exercises the
+   real device path. --seconds bounds the run (0, the default, soaks
+   until terminated); the exit summary reports the worst drift seen. */
+static long soak_rss_kb(void) {
+    FILE *fptr = fopen("/proc/self/statm", "r");
+    if (fptr == NULL) {
+        return -1;
+    }
+    long pages = 0;
+    long resident = 0;
+    int got = fscanf(fptr, "%ld %ld", &pages, &resident);
+    fclose(fptr);
+    if (got != 2) {
+        return -1;
+    }
+    return resident * (sysconf(_SC_PAGESIZE) / 1024);
+}
+
+static int run_soak(const char *rom, unsigned seconds, unsigned checkpoint_s) {
+    static chip8_state_t state; // Too big for the stack, and one-shot mode
+
+    chip8_init(&state);
+    if (!chip8_load_rom(&state, rom)) {
+        return SDL_APP_FAILURE;
+    }
+    disasm_scan(&state);
+    chip8_sound_hook = audio_edge_push;
+
+    uint64_t epoch = telemetry_now_ns();
+    uint64_t deadline = seconds != 0 ? epoch + (uint64_t)seconds * 1000000000ULL : 0;
+    uint64_t checkpoint_due = epoch + (uint64_t)checkpoint_s * 1000000000ULL;
+    long rss_start = soak_rss_kb();
+    uint64_t vblanks = 0;
+    unsigned checkpoints = 0;
+    double worst_drift = 0.0;
+    static telemetry_hist_t window = {.name = "soak tick"};
+
+    SDL_Log("Soaking %s: checkpoint every %us, %s", rom, checkpoint_s,
+            seconds != 0 ? "bounded run" : "until terminated");
+    for (;;) {
+        uint64_t now = telemetry_now_ns();
+        if (deadline != 0 && now >= deadline) {
+            break;
+        }
+
+        // The clock module owns the schedule: oversleep here surfaces as
+        // extra due boundaries on the next pass, never as lost ticks —
+        // exactly the correction this mode exists to demonstrate. Each
+        // boundary gets its vblank (timers, display-wait release) and
+        // its instruction budget, the decomposed chip8_update_timers.
+        int due = chip8_clock_ticks_due(&state);
+        for (int t = 0; t < due; t++) {
+            uint64_t tick_start = telemetry_now_ns();
+            chip8_vblank(&state);
+            if (!state.idle) {
+                chip8_run(&state, (int)chip8_clock_budget(&state));
+            }
+            telemetry_record(&window, telemetry_now_ns() - tick_start);
+            vblanks++;
+        }
+
+        if (now >= checkpoint_due) {
+            checkpoint_due += (uint64_t)checkpoint_s * 1000000000ULL;
+            checkpoints++;
+            double elapsed_s = (now - epoch) / 1e9;
+            double drift = (double)vblanks - elapsed_s * QUANTUM_HZ;
+            if (drift < -worst_drift || drift > worst_drift) {
+                worst_drift = drift < 0 ? -drift : drift;
+            }
+            long rss = soak_rss_kb();
+            SDL_Log("SOAK t=%.0fs vblanks=%llu drift_ticks=%+.2f rss_kb=%ld "
+                    "rss_growth_kb=%+ld tick_p50_us=%llu tick_p99_us=%llu "
+                    "tick_max_us=%llu executed=%llu audio_queue_peak=%llu "
+                    "underruns=%llu stalls=%llu",
+                    elapsed_s, (unsigned long long)vblanks, drift, rss,
+                    rss - rss_start,
+                    (unsigned long long)(telemetry_percentile(&window, 0.50) / 1000),
+                    (unsigned long long)(telemetry_percentile(&window, 0.99) / 1000),
+                    (unsigned long long)(window.max_ns / 1000),
+                    (unsigned long long)state.cycle_count,
+                    (unsigned long long)telemetry_audio_queue_peak.value,
+                    (unsigned long long)telemetry_audio_underruns.value,
+                    (unsigned long long)telemetry_clock_stalls.value);
+            // Fresh window per checkpoint so late-life tail growth shows
+            SDL_memset(window.buckets, 0, sizeof(window.buckets));
+            window.count = 0;
+            window.max_ns = 0;
+        }
+
+        SDL_DelayNS(CHIP8_CLOCK_QUANTUM_NS);
+    }
+
+    double total_s = (telemetry_now_ns() - epoch) / 1e9;
+    long rss_end = soak_rss_kb();
+    SDL_Log("Soak finished: %llu vblanks in %.0fs across %u checkpoints, "
+            "worst drift %.2f ticks, RSS %+ld KB",
+            (unsigned long long)vblanks, total_s, checkpoints, worst_drift,
+            rss_end - rss_start);
+    return 0;
+}
+
+/* Verify mode: replays a batch of recordings against one ROM across the
+   thread pool, asserting every hash checkpoint the v3 format embeds in
+   the stream (see replay.h) — one pass/fail for the whole batch, and
+   for each diverged replay the cycle of the first checkpoint that
+   stopped matching. Workers claim replays off one atomic cursor, sweep
+   style, and each replays bisect's exact frame loop, so thousands of
+   nightly recordings verify in wall time bounded by the longest one.
+   Like bisection, only --virtual-clock recordings replay at exact cycle
+   counts; wall-clock files are reported, not verified. */
+
+typedef struct verify_result {
+    bool ok;                 // Opened, right ROM, virtual clock, ran
+    bool passed;             // Every checkpoint matched (and there was one)
+    uint64_t checkpoints;    // Checkpoints asserted before the verdict
+    uint64_t diverged_cycle; // First mismatching checkpoint or fault
+    const char *detail;      // One word for the report line
+} verify_result_t;
+
+static SDL_AtomicInt verify_next;
+static const char *verify_rom_path;
+static char *const *verify_files;
+static int verify_file_count;
+static verify_result_t *verify_results;
+
+static void *verify_worker(void *arg) {
+    chip8_state_t *state = arg; // Pool slab acquired before the spawn
+
+    for (;;) {
+        int i = SDL_AddAtomicInt(&verify_next, 1);
+        if (i >= verify_file_count) {
+            break;
+        }
+        verify_result_t *result = &verify_results[i];
+        result->detail = "";
+
+        replay_cursor_t cursor;
+        if (!replay_cursor_open(&cursor, verify_files[i])) {
+            result->detail = "unreadable";
+            continue;
+        }
+        if (!cursor.virtual_clock) {
+            result->detail = "wall-clock";
+            replay_cursor_close(&cursor);
+            continue;
+        }
+
+        chip8_init(state);
+        if (!chip8_load_rom(state, verify_rom_path)) {
+            result->detail = "rom-load";
+            replay_cursor_close(&cursor);
+            continue;
+        }
+        if (state->rom_hash != cursor.rom_hash) {
+            result->detail = "wrong-rom";
+            replay_cursor_close(&cursor);
+            continue;
+        }
+
+        // Same restore the playback path does: everything the
+        // instruction stream depends on comes from the header
+        chip8_set_profile(state, (chip8_profile_t)cursor.profile);
+        chip8_set_virtual_clock(state, true);
+        state->rng_state = cursor.rng_state;
+        state->ips = cursor.ips;
+        state->next_vblank_cycle = state->cycle_count + chip8_clock_budget(state);
+
+        result->ok = true;
+        result->passed = true;
+        for (;;) {
+            replay_cursor_apply(&cursor, state);
+            if (cursor.check_pending) {
+                cursor.check_pending = false;
+                if (cursor.check_cycle != state->cycle_count ||
+                    cursor.check_hash != chip8_state_hash(state)) {
+                    result->passed = false;
+                    result->diverged_cycle = cursor.check_cycle;
+                    result->detail = "diverged";
+                    break;
+                }
+                result->checkpoints++;
+            }
+            if (replay_cursor_next_cycle(&cursor) == UINT64_MAX) {
+                break; // Recording fully consumed
+            }
+
+            // Bisect's frame loop: the quantum, one timer tick, realign
+            int ran = chip8_run(state, (int)chip8_clock_budget(state));
+            chip8_vblank(state);
+            state->next_vblank_cycle = state->cycle_count + chip8_clock_budget(state);
+
+            if (state->fault_cycle != 0) {
+                result->passed = false;
+                result->diverged_cycle = state->fault_cycle;
+                result->detail = "faulted";
+                break;
+            }
+            if (ran == 0 && !state->waiting_display &&
+                replay_cursor_next_cycle(&cursor) > state->cycle_count) {
+                // Parked with events still ahead the recorded run
+                // consumed: the replay diverged into a wedge
+                result->passed = false;
+                result->diverged_cycle = state->cycle_count;
+                result->detail = "wedged";
+                break;
+            }
+        }
+        if (result->passed && result->checkpoints == 0) {
+            // A v2 recording verifies nothing; don't report it green
+            result->passed = false;
+            result->detail = "no-checkpoints";
+        }
+
+        replay_cursor_close(&cursor);
+    }
+
+    return NULL;
+}
+
+static int run_verify(const char *rom_path, int count, char *const *files) {
+    int workers = SDL_GetNumLogicalCPUCores();
+    if (workers < 1) {
+        workers = 1;
+    }
+    if (workers > count) {
+        workers = count;
+    }
+    if (workers > 64) {
+        workers = 64;
+    }
+
+    verify_rom_path = rom_path;
+    verify_files = files;
+    verify_file_count = count;
+    verify_results = SDL_calloc((size_t)count, sizeof(*verify_results));
+    if (!pool_init(workers) || verify_results == NULL) {
+        return SDL_APP_FAILURE;
+    }
+
+    uint64_t start_ns = telemetry_now_ns();
+    pthread_t threads[64];
+    for (int i = 0; i < workers; i++) {
+        pthread_create(&threads[i], NULL, verify_worker, pool_acquire());
+    }
+    for (int i = 0; i < workers; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    double wall_s = (telemetry_now_ns() - start_ns) / 1e9;
+
+    int failures = 0;
+    uint64_t total_checkpoints = 0;
+    for (int i = 0; i < count; i++) {
+        const verify_result_t *result = &verify_results[i];
+        total_checkpoints += result->checkpoints;
+        if (result->ok && result->passed) {
+            SDL_Log("PASS %4llu checkpoints  %s",
+                    (unsigned long long)result->checkpoints, files[i]);
+            continue;
+        }
+        failures++;
+        if (result->diverged_cycle != 0) {
+            SDL_Log("FAIL %s at cycle %llu after %llu clean checkpoints  %s",
+                    result->detail,
+                    (unsigned long long)result->diverged_cycle,
+                    (unsigned long long)result->checkpoints, files[i]);
+        } else {
+            SDL_Log("FAIL %s  %s", result->detail, files[i]);
+        }
+    }
+    SDL_Log("Verified %d replays (%llu checkpoints) on %d workers in %.2fs: "
+            "%s (%d failed)",
+            count, (unsigned long long)total_checkpoints, workers, wall_s,
+            failures == 0 ? "PASS" : "FAIL", failures);
+
+    SDL_free(verify_results);
+    pool_shutdown();
+    return failures == 0 ? 0 : SDL_APP_FAILURE;
+}
+
+/* Differential quirk triage: a misbehaving ROM used to mean an
+   afternoon of manually toggling quirk profiles. This mode runs the ROM
+   headless under all 16 quirk-bit combinations in parallel — fast-core
+   states on pool slabs, one worker per core pulling combinations from
+   an atomic cursor — then diffs the final state hashes (vram,
+   registers, pc) across the corners. The report groups the runs into
+   behavior classes and, for each quirk bit, counts how many of the 8
+   combination pairs differing only in that bit diverge: a bit with zero
+   diverging pairs is irrelevant to this title, a bit with eight decides
+   its behavior outright. */
+typedef struct triage_result {
+    uint64_t hash;
+    uint64_t executed;
+    uint64_t fault_cycle;
+} triage_result_t;
+
+static SDL_AtomicInt triage_cursor;
+static uint64_t triage_cycles;
+static chip8_state_t *triage_states[CHIP8_QUIRK_COMBOS];
+static triage_result_t triage_results[CHIP8_QUIRK_COMBOS];
+
+static void *triage_worker(void *arg) {
+    (void)arg;
+    for (;;) {
+        int mask = SDL_AddAtomicInt(&triage_cursor, 1);
+        if (mask >= CHIP8_QUIRK_COMBOS) {
+            break;
+        }
+        chip8_state_t *state = triage_states[mask];
+
+        // The real session cadence — ips/60 instructions, then a timer
+        // tick — so display-wait corners park and release exactly as
+        // they would on a cabinet
+        const uint64_t per_frame = CHIP8_DEFAULT_IPS / 60;
+        for (uint64_t budget = triage_cycles; budget > 0;
+             budget -= budget < per_frame ? budget : per_frame) {
+            chip8_run(state, (int)(budget < per_frame ? budget : per_frame));
+            chip8_vblank(state);
+            if (state->fault_cycle != 0) {
+                break;
+            }
+        }
+
+        triage_results[mask].hash = chip8_state_hash(state);
+        triage_results[mask].executed = state->cycle_count;
+        triage_results[mask].fault_cycle = state->fault_cycle;
+    }
+    return NULL;
+}
+
+static int run_triage(const char *rom, uint64_t cycles) {
+    triage_cycles = cycles;
+    if (!pool_init(CHIP8_QUIRK_COMBOS)) {
+        return SDL_APP_FAILURE;
+    }
+    // Table building is lazy and not thread-safe, so every corner is
+    // prepared here before the workers spawn
+    for (int mask = 0; mask < CHIP8_QUIRK_COMBOS; mask++) {
+        chip8_state_t *state = pool_acquire();
+        triage_states[mask] = state;
+        chip8_init(state);
+        chip8_seed(state, 1); // Same fixed seed as headless runs
+        chip8_set_virtual_clock(state, true);
+        chip8_set_core(state, CHIP8_CORE_FAST);
+        if (!chip8_load_rom(state, rom)) {
+            return SDL_APP_FAILURE;
+        }
+        chip8_set_quirk_mask(state, (unsigned)mask);
+    }
+
+    int workers = SDL_GetNumLogicalCPUCores();
+    if (workers < 1) {
+        workers = 1;
+    }
+    if (workers > CHIP8_QUIRK_COMBOS) {
+        workers = CHIP8_QUIRK_COMBOS;
+    }
+    uint64_t start_ns = telemetry_now_ns();
+    pthread_t threads[CHIP8_QUIRK_COMBOS];
+    for (int i = 0; i < workers; i++) {
+        pthread_create(&threads[i], NULL, triage_worker, NULL);
+    }
+    for (int i = 0; i < workers; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    double wall_s = (telemetry_now_ns() - start_ns) / 1e9;
+
+    static const char *const bit_names[4] = {
+        "vf_reset", "shift_uses_y", "index_increment", "display_wait",
+    };
+    SDL_Log("Quirk triage: %s, %llu cycles per corner (%d workers, %.2fs)",
+            rom, (unsigned long long)cycles, workers, wall_s);
+    SDL_Log("  vf shift idx wait  class  hash              executed");
+
+    // Behavior classes: corners sharing a final hash behave identically
+    int class_of[CHIP8_QUIRK_COMBOS];
+    int classes = 0;
+    for (int mask = 0; mask < CHIP8_QUIRK_COMBOS; mask++) {
+        class_of[mask] = classes;
+        for (int j = 0; j < mask; j++) {
+            if (triage_results[j].hash == triage_results[mask].hash) {
+                class_of[mask] = class_of[j];
+                break;
+            }
+        }
+        if (class_of[mask] == classes) {
+            classes++;
+        }
+        SDL_Log("   %c    %c   %c    %c     %c   %016llx %9llu%s",
+                mask & CHIP8_QUIRK_VF_RESET ? 'y' : '-',
+                mask & CHIP8_QUIRK_SHIFT_USES_Y ? 'y' : '-',
+                mask & CHIP8_QUIRK_INDEX_INCREMENT ? 'y' : '-',
+                mask & CHIP8_QUIRK_DISPLAY_WAIT ? 'y' : '-',
+                'A' + class_of[mask],
+                (unsigned long long)triage_results[mask].hash,
+                (unsigned long long)triage_results[mask].executed,
+                triage_results[mask].fault_cycle != 0 ? "  FAULT" : "");
+    }
+
+    SDL_Log("%d behavior class(es) across 16 corners", classes);
+    for (int bit = 0; bit < 4; bit++) {
+        int diverging = 0;
+        for (int mask = 0; mask < CHIP8_QUIRK_COMBOS; mask++) {
+            if ((mask & (1 << bit)) == 0 &&
+                triage_results[mask].hash != triage_results[mask | (1 << bit)].hash) {
+                diverging++;
+            }
+        }
+        SDL_Log("  %-15s %s (%d/8 paired corners diverge)", bit_names[bit],
+                diverging == 0 ? "no effect" : "changes behavior", diverging);
+    }
+
+    pool_shutdown();
+    return 0;
+}
+
+/* Wall mode: one process hosts N sessions sharing a single window and
+   renderer. Each session expands into its own streaming texture through
+   the same nibble LUT as the single-session path, every texture update
+   batches into one submission, and the tiled grid presents once per
+   display frame — no per-session windows, so it scales to a full
+   monitoring wall. */
+#define WALL_MAX_SESSIONS 16
+
+static void wall_expand(SDL_Texture *texture, const chip8_state_t *state) {
+    int width = state->hires ? 128 : 64;
+    int height = state->hires ? 64 : 32;
+
+    void *pixels;
+    int pitch;
+    SDL_Rect lock_rect = {0, 0, width, height};
+    if (!SDL_LockTexture(texture, &lock_rect, &pixels, &pitch)) {
+        return;
+    }
+    for (int j = 0; j < height; j++) {
+        uint32_t *out = (uint32_t *)((uint8_t *)pixels + j * pitch);
+        for (int word = 0; word < width / 64; word++) {
+            uint64_t plane0 = chip8_vram_word(state, 0, j, word);
+            uint64_t plane1 = chip8_vram_word(state, 1, j, word);
+            for (int nib = 0; nib < 16; nib++) {
+                int shift = 60 - nib * 4;
+                unsigned combined = (unsigned)((plane1 >> shift) & 0xF) << 4
+                                  | (unsigned)((plane0 >> shift) & 0xF);
+                SDL_memcpy(out, expand_lut[combined], sizeof(expand_lut[combined]));
+                out += 4;
+            }
+        }
+    }
+    SDL_UnlockTexture(texture);
+}
+
+/* Wall-mode software mixer. Opening a device stream per tile the way the
+   single-session path does would burn one callback thread per session and
+   exhaust device streams well before the wall does; instead the wall runs
+   a single stream whose callback sums one tone voice per session into a
+   shared buffer — trivial adds, one thread, one device. Each voice keeps
+   its own wavetable position (phase stays continuous per tile) and a gain
+   in permille; the default gain splits the headroom equally so a full
+   wall of simultaneous beeps never clips. Voice on/off follows each
+   session's sound timer, polled once per display frame on the wall
+   thread — tiles take no input, so the single-session path's sample-
+   accurate edge splicing buys nothing here. The device opens lazily on
+   the first tone, same as audio_open. */
+typedef struct mixer_voice {
+    SDL_AtomicInt on;            // Session sound_timer > 0, polled per frame
+    SDL_AtomicInt gain_permille; // 0 mutes; per-session volume
+    int pos;                     // Wavetable position; audio thread only
+} mixer_voice_t;
+
+static mixer_voice_t mixer_voices[WALL_MAX_SESSIONS];
+static SDL_AudioStream *mixer_stream;
+static int mixer_count;
+static int mixer_default_gain; // Headroom split; mute toggles restore this
+
+static void SDLCALL mixer_callback(void *userdata, SDL_AudioStream *astream, int additional_amount, int total_amount) {
+    static float buffer[4096];
+
+    int samples = additional_amount / (int)sizeof(float);
+    while (samples > 0) {
+        int chunk = samples < (int)(sizeof(buffer) / sizeof(float))
+                  ? samples : (int)(sizeof(buffer) / sizeof(float));
+        SDL_memset(buffer, 0, chunk * sizeof(float));
+        for (int i = 0; i < mixer_count; i++) {
+            mixer_voice_t *voice = &mixer_voices[i];
+            if (!SDL_GetAtomicInt(&voice->on)) {
+                continue;
+            }
+            float gain = SDL_GetAtomicInt(&voice->gain_permille) / 1000.0f;
+            if (gain <= 0.0f) {
+                continue;
+            }
+            for (int s = 0; s < chunk; s++) {
+                buffer[s] += gain * wavetable[voice->pos];
+                if (++voice->pos == WAVETABLE_SAMPLES) {
+                    voice->pos = 0;
+                }
+            }
+        }
+        SDL_PutAudioStreamData(astream, buffer, chunk * sizeof(float));
+        samples -= chunk;
+    }
+}
+
+// Deferred like audio_open: a wall of silent ROMs never pays for the
+// device. One failure disables further attempts for the run.
+static bool mixer_open(void) {
+    static bool open_failed;
+    if (open_failed) {
+        return false;
+    }
+
+    SDL_AudioSpec audio_spec;
+    audio_spec.channels = 1;
+    audio_spec.format = SDL_AUDIO_F32;
+    audio_spec.freq = sample_rate;
+    SDL_AudioStream *opened = NULL;
+    if (SDL_InitSubSystem(SDL_INIT_AUDIO)) {
+        opened = SDL_OpenAudioDeviceStream(SDL_AUDIO_DEVICE_DEFAULT_PLAYBACK, &audio_spec, NULL, NULL);
+    }
+    if (opened == NULL) {
+        SDL_Log("Couldn't create audio stream: %s", SDL_GetError());
+        open_failed = true;
+        return false;
+    }
+
+    build_wavetable();
+    SDL_SetAudioStreamGetCallback(opened, mixer_callback, NULL);
+    SDL_ResumeAudioStreamDevice(opened);
+    mixer_stream = opened;
+    return true;
+}
+
+static void mixer_toggle_mute(int session) {
+    int gain = SDL_GetAtomicInt(&mixer_voices[session].gain_permille);
+    SDL_SetAtomicInt(&mixer_voices[session].gain_permille,
+                     gain == 0 ? mixer_default_gain : 0);
+    SDL_Log("Session %d %s", session + 1, gain == 0 ? "unmuted" : "muted");
+}
+
+static int run_wall(int count, char *const *roms) {
+    if (count > WALL_MAX_SESSIONS) {
+        SDL_Log("Wall mode caps at %d sessions; ignoring the rest", WALL_MAX_SESSIONS);
+        count = WALL_MAX_SESSIONS;
+    }
+
+    if (!SDL_Init(SDL_INIT_VIDEO)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't initialize SDL: %s", SDL_GetError());
+        return SDL_APP_FAILURE;
+    }
+
+    // Near-square tiling, each cell a 2:1 display
+    int cols = 1;
+    while (cols * cols < count) {
+        cols++;
+    }
+    int grid_rows = (count + cols - 1) / cols;
+
+    if (!SDL_CreateWindowAndRenderer("Chip-8 Wall", cols * 384, grid_rows * 192,
+                                     SDL_WINDOW_RESIZABLE, &window, &renderer)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't create window and renderer: %s", SDL_GetError());
+        return SDL_APP_FAILURE;
+    }
+    if (!SDL_SetRenderVSync(renderer, 1)) {
+        SDL_Log("Vsync unavailable (%s)", SDL_GetError());
+    }
+    const SDL_DisplayMode *mode = SDL_GetCurrentDisplayMode(SDL_GetDisplayForWindow(window));
+    if (mode != NULL && mode->refresh_rate > 0.0f) {
+        refresh_interval_ns = (uint64_t)(1e9 / mode->refresh_rate);
+    }
+    build_expand_lut();
+
+    // Shared ROM images: a tournament wall runs one title on every tile,
+    // so each distinct ROM is prepared exactly once — read, loaded, and
+    // statically predecoded — and every session running it seeds its
+    // private writable copy from that read-only image with one struct
+    // copy. N tiles of the same title never re-read the file or re-run
+    // the predecoder, and each copy starts with the shared warm decode
+    // cache instead of filling its own from cold.
+    int distinct = 0;
+    int image_of[WALL_MAX_SESSIONS];
+    const char *image_paths[WALL_MAX_SESSIONS];
+    for (int i = 0; i < count; i++) {
+        image_of[i] = distinct;
+        for (int j = 0; j < distinct; j++) {
+            if (SDL_strcmp(roms[i], image_paths[j]) == 0) {
+                image_of[i] = j;
+                break;
+            }
+        }
+        if (image_of[i] == distinct) {
+            image_paths[distinct++] = roms[i];
+        }
+    }
+
+    // Session states and shared images come from the pool: one upfront
+    // cache-line-aligned reservation, so per-session setup and teardown
+    // below never malloc
+    if (!pool_init(count + distinct)) {
+        return SDL_APP_FAILURE;
+    }
+    chip8_state_t *images[WALL_MAX_SESSIONS];
+    bool image_loaded[WALL_MAX_SESSIONS];
+    for (int j = 0; j < distinct; j++) {
+        images[j] = pool_acquire();
+        chip8_init(images[j]);
+        image_loaded[j] = chip8_load_rom(images[j], image_paths[j]);
+        if (image_loaded[j]) {
+            disasm_scan(images[j]); // Predecode once for every copy
+        }
+    }
+    if (distinct < count) {
+        SDL_Log("Wall sharing %d prepared image(s) across %d sessions",
+                distinct, count);
+    }
+
+    chip8_state_t *states[WALL_MAX_SESSIONS] = {NULL};
+    SDL_Texture *textures[WALL_MAX_SESSIONS] = {NULL};
+    bool alive[WALL_MAX_SESSIONS] = {false};
+    mixer_count = count;
+    mixer_default_gain = 750 / count; // 0.75 peak shared across the wall
+    for (int i = 0; i < count; i++) {
+        states[i] = pool_acquire();
+        chip8_init(states[i]);
+        alive[i] = image_loaded[image_of[i]];
+        if (alive[i]) {
+            chip8_boot(states[i], images[image_of[i]]);
+        }
+        textures[i] = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888,
+                                        SDL_TEXTUREACCESS_STREAMING, 128, 64);
+        if (textures[i] != NULL) {
+            SDL_SetTextureScaleMode(textures[i], SDL_SCALEMODE_NEAREST);
+        }
+        SDL_SetAtomicInt(&mixer_voices[i].on, 0);
+        SDL_SetAtomicInt(&mixer_voices[i].gain_permille, mixer_default_gain);
+    }
+
+    bool running = true;
+    while (running) {
+        SDL_Event event;
+        while (SDL_PollEvent(&event)) {
+            if (event.type == SDL_EVENT_QUIT) {
+                running = false;
+            }
+            // Number keys mute/unmute individual tiles (first 9 sessions)
+            if (event.type == SDL_EVENT_KEY_DOWN && !event.key.repeat
+                && event.key.key >= SDLK_1 && event.key.key <= SDLK_9
+                && (int)(event.key.key - SDLK_1) < count) {
+                mixer_toggle_mute((int)(event.key.key - SDLK_1));
+            }
+        }
+
+        // One slice per session per display frame, sized by the measured
+        // refresh so a 120Hz panel doesn't run everything at double speed
+        for (int i = 0; i < count; i++) {
+            if (!alive[i]) {
+                continue;
+            }
+            chip8_update_timers(states[i]);
+            uint32_t ips = states[i]->ips != 0 ? states[i]->ips : CHIP8_DEFAULT_IPS;
+            states[i]->idle = false; // No input routing; never park a tile
+            chip8_run(states[i], (int)(ips * refresh_interval_ns / 1000000000ULL));
+            bool tone = states[i]->sound_timer > 0;
+            if (tone && mixer_stream == NULL && !mixer_open()) {
+                tone = false;
+            }
+            SDL_SetAtomicInt(&mixer_voices[i].on, tone);
+        }
+
+        // Batch: upload only sessions whose display changed, then tile
+        // everything into one present
+        SDL_RenderClear(renderer);
+        int out_w, out_h;
+        SDL_GetCurrentRenderOutputSize(renderer, &out_w, &out_h);
+        for (int i = 0; i < count; i++) {
+            if (alive[i] && states[i]->dirty_count != 0 && textures[i] != NULL) {
+                wall_expand(textures[i], states[i]);
+                states[i]->dirty_count = 0;
+            }
+            SDL_FRect src_rect = {0, 0, states[i]->hires ? 128.0f : 64.0f,
+                                  states[i]->hires ? 64.0f : 32.0f};
+            SDL_FRect dst_rect = {(float)(i % cols) * out_w / cols,
+                                  (float)(i / cols) * out_h / grid_rows,
+                                  (float)out_w / cols, (float)out_h / grid_rows};
+            SDL_RenderTexture(renderer, textures[i], &src_rect, &dst_rect);
+        }
+        SDL_RenderPresent(renderer);
+    }
+
+    for (int i = 0; i < count; i++) {
+        SDL_DestroyTexture(textures[i]);
+        pool_release(states[i]);
+    }
+    for (int j = 0; j < distinct; j++) {
+        pool_release(images[j]);
+    }
+    pool_shutdown();
+    SDL_DestroyRenderer(renderer);
+    SDL_DestroyWindow(window);
+    SDL_Quit();
+    return 0;
+}
+
+/* Visual regression suite: chip8 --visual [--print]. Runs the reference
+   ROM deterministically once, then pushes the resulting frame through the
+   actual presentation path — expand LUT, palette, scaling, CRT compose —
+   into offscreen targets across the {scale, palette, effect} matrix, and
+   compares a perceptual hash per cell against the goldens below. The
+   hash is a dHash (9x8 grayscale downsample, each bit one left/right
+   luminance comparison): backend rounding flips at most a bit or two,
+   a real palette/compositing/scaling regression flips many, so the
+   Hamming tolerance separates them. Update the table with
+   --visual --print after intentional renderer changes. */
+
+#define VISUAL_CYCLES 100000
+#define VISUAL_HASH_TOLERANCE 4
+#define VISUAL_ROM "roms/quirks.ch8"
+
+static const int visual_scales[] = {1, 2, 4};
+#define VISUAL_SCALES (int)(sizeof(visual_scales) / sizeof(visual_scales[0]))
+
+// Palettes come from the shared preset table (palette_presets), so a
+// theme a venue can select is by definition a theme the goldens cover
+#define VISUAL_PALETTES PALETTE_PRESETS
+static const char *const visual_effect_names[] = {"plain", "crt"};
+#define VISUAL_EFFECTS 2
+
+// Per-cell golden: the dHash catches structural regressions (scaling,
+// compositing, scanlines), the mean luminance catches palette swaps the
+// gradient-only hash is blind to
+typedef struct visual_golden {
+    uint64_t hash;
+    int mean; // Average luminance over the whole shot, 0-255
+} visual_golden_t;
+
+static const visual_golden_t visual_goldens[3][3][VISUAL_EFFECTS] = {
+    { // stock
+        {{0xdcd4e8a0a4b00303ULL, 39}, {0xdcd4e8a0a4b80303ULL, 28}}, // 1x plain/crt
+        {{0xded4e8a2a4b80302ULL, 39}, {0xded6e8a2a4b8bb02ULL, 42}}, // 2x plain/crt
+        {{0xded6e8a2a4b80302ULL, 39}, {0xded6e8a2a4b8bb06ULL, 35}}, // 4x plain/crt
+    },
+    { // amber
+        {{0xdcd4e8a0a4b00303ULL, 35}, {0xdcd4e8a0a4b80303ULL, 30}},
+        {{0xded4e8a2a4b80302ULL, 35}, {0xded6e8a2a4b8bb02ULL, 42}},
+        {{0xded6e8a2a4b80302ULL, 35}, {0xded6e8a2a4b8bb06ULL, 35}},
+    },
+    { // green
+        {{0xdcd4e8a0a4b00303ULL, 35}, {0xdcd4e8a0a4b80303ULL, 27}},
+        {{0xded4e8a2a4b80302ULL, 34}, {0xded6e8a2a4b8bb02ULL, 40}},
+        {{0xded6e8a2a4b80302ULL, 34}, {0xded6e8a2a4b8bb06ULL, 33}},
+    },
+};
+
+#define VISUAL_MEAN_TOLERANCE 3
+
+// 64-bit dHash: box-average the shot down to 9x8 luminance cells, one bit
+// per horizontal neighbour comparison. Scale-sensitive but tolerant of
+// single-pixel rounding differences between backends. Also reports the
+// overall mean luminance for the palette check.
+static uint64_t visual_dhash(SDL_Surface *shot, int *mean) {
+    SDL_Surface *argb = SDL_ConvertSurface(shot, SDL_PIXELFORMAT_ARGB8888);
+    if (argb == NULL) {
+        return 0;
+    }
+
+    double gray[8][9];
+    for (int gy = 0; gy < 8; gy++) {
+        for (int gx = 0; gx < 9; gx++) {
+            int x0 = gx * argb->w / 9, x1 = (gx + 1) * argb->w / 9;
+            int y0 = gy * argb->h / 8, y1 = (gy + 1) * argb->h / 8;
+            uint64_t sum = 0;
+            for (int y = y0; y < y1; y++) {
+                const uint32_t *row = (const uint32_t *)((const uint8_t *)argb->pixels + y * argb->pitch);
+                for (int x = x0; x < x1; x++) {
+                    uint32_t px = row[x];
+                    // Integer BT.601 luma: close enough for a hash
+                    sum += ((px >> 16 & 0xFF) * 77 + (px >> 8 & 0xFF) * 150 + (px & 0xFF) * 29) >> 8;
+                }
+            }
+            gray[gy][gx] = (double)sum / ((x1 - x0) * (y1 - y0));
+        }
+    }
+    SDL_DestroySurface(argb);
+
+    double total = 0;
+    for (int gy = 0; gy < 8; gy++) {
+        for (int gx = 0; gx < 9; gx++) {
+            total += gray[gy][gx];
+        }
+    }
+    *mean = (int)(total / 72.0 + 0.5);
+
+    uint64_t hash = 0;
+    for (int gy = 0; gy < 8; gy++) {
+        for (int gx = 0; gx < 8; gx++) {
+            hash = hash << 1 | (gray[gy][gx] < gray[gy][gx + 1] ? 1 : 0);
+        }
+    }
+    return hash;
+}
+
+static int run_visual(bool print_only) {
+    // One deterministic emulation feeds every cell: the matrix varies the
+    // presentation, not the vram
+    chip8_state_t *state = SDL_malloc(sizeof(chip8_state_t));
+    chip8_init(state);
+    chip8_seed(state, 1);
+    chip8_set_virtual_clock(state, true);
+    if (!chip8_load_rom(state, VISUAL_ROM)) {
+        SDL_free(state);
+        return 1;
+    }
+    const uint64_t per_tick = CHIP8_DEFAULT_IPS / 60;
+    uint64_t executed = 0, next_tick = 0;
+    while (executed < VISUAL_CYCLES) {
+        int ran = chip8_run_block(state);
+        executed = ran == 0 ? next_tick : executed + ran;
+        while (executed >= next_tick) {
+            next_tick += per_tick;
+            chip8_vblank(state);
+        }
+    }
+
+    published_frame_t frame;
+    SDL_memcpy(frame.rows, state->vram, sizeof(frame.rows));
+    frame.hires = state->hires;
+    int width = frame.hires ? 128 : 64;
+    int height = frame.hires ? 64 : 32;
+    SDL_free(state);
+
+    if (!SDL_Init(SDL_INIT_VIDEO) ||
+        !SDL_CreateWindowAndRenderer("Chip-8 Visual Suite", 640, 320,
+                                     SDL_WINDOW_HIDDEN, &window, &renderer)) {
+        SDL_Log("Couldn't create renderer: %s", SDL_GetError());
+        return 1;
+    }
+    framebuffer = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888,
+                                    SDL_TEXTUREACCESS_STREAMING, 128, 64);
+    crt_target = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888,
+                                   SDL_TEXTUREACCESS_TARGET, 128 * CRT_SCALE, 64 * CRT_SCALE);
+    scanline_texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888,
+                                         SDL_TEXTUREACCESS_STATIC, 1, CRT_SCALE);
+    if (framebuffer == NULL || crt_target == NULL || scanline_texture == NULL) {
+        SDL_Log("Couldn't create textures: %s", SDL_GetError());
+        return 1;
+    }
+    SDL_SetTextureScaleMode(framebuffer, SDL_SCALEMODE_NEAREST);
+    SDL_SetTextureScaleMode(crt_target, SDL_SCALEMODE_LINEAR);
+    uint32_t column[CRT_SCALE] = {0};
+    column[CRT_SCALE - 2] = 0x50000000;
+    column[CRT_SCALE - 1] = 0x90000000;
+    SDL_UpdateTexture(scanline_texture, NULL, column, sizeof(uint32_t));
+    SDL_SetTextureBlendMode(scanline_texture, SDL_BLENDMODE_BLEND);
+
+    int failures = 0;
+    for (int p = 0; p < VISUAL_PALETTES; p++) {
+        SDL_memcpy(palette, palette_presets[p].colors, sizeof(palette));
+        build_expand_lut();
+        expand_full(&frame, width, height);
+
+        for (int s = 0; s < VISUAL_SCALES; s++) {
+            for (int e = 0; e < VISUAL_EFFECTS; e++) {
+                SDL_Texture *target = SDL_CreateTexture(
+                    renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET,
+                    width * visual_scales[s], height * visual_scales[s]);
+                SDL_FRect src_rect = {0, 0, (float)width, (float)height};
+                SDL_FRect dst_rect = {0, 0, (float)(width * visual_scales[s]),
+                                      (float)(height * visual_scales[s])};
+                if (e == 1) {
+                    crt_compose(&src_rect, &dst_rect, target);
+                } else {
+                    SDL_SetRenderTarget(renderer, target);
+                    SDL_RenderClear(renderer);
+                    SDL_RenderTexture(renderer, framebuffer, &src_rect, &dst_rect);
+                }
+
+                SDL_Surface *shot = SDL_RenderReadPixels(renderer, NULL);
+                SDL_SetRenderTarget(renderer, NULL);
+                int mean = 0;
+                uint64_t hash = shot != NULL ? visual_dhash(shot, &mean) : 0;
+                SDL_DestroySurface(shot);
+                SDL_DestroyTexture(target);
+
+                if (print_only) {
+                    printf("        {0x%016llxULL, %3d}, // [%d][%d][%d] %dx %s %s\n",
+                           (unsigned long long)hash, mean, p, s, e, visual_scales[s],
+                           palette_presets[p].name, visual_effect_names[e]);
+                    continue;
+                }
+                const visual_golden_t *golden = &visual_goldens[p][s][e];
+                int distance = __builtin_popcountll(hash ^ golden->hash);
+                int drift = mean > golden->mean ? mean - golden->mean : golden->mean - mean;
+                bool ok = distance <= VISUAL_HASH_TOLERANCE && drift <= VISUAL_MEAN_TOLERANCE;
+                printf("%-6s %dx %-6s %016llx d=%-2d mean=%-3d %s\n", palette_presets[p].name,
+                       visual_scales[s], visual_effect_names[e],
+                       (unsigned long long)hash, distance, mean, ok ? "PASS" : "FAIL");
+                failures += ok ? 0 : 1;
+            }
+        }
+    }
+    SDL_memcpy(palette, palette_default, sizeof(palette));
+
+    SDL_DestroyTexture(scanline_texture);
+    SDL_DestroyTexture(crt_target);
+    SDL_DestroyTexture(framebuffer);
+    SDL_DestroyRenderer(renderer);
+    SDL_DestroyWindow(window);
+    SDL_Quit();
+
+    if (!print_only) {
+        printf("%d/%d cells matched\n",
+               VISUAL_PALETTES * VISUAL_SCALES * VISUAL_EFFECTS - failures,
+               VISUAL_PALETTES * VISUAL_SCALES * VISUAL_EFFECTS);
+    }
+    return failures == 0 ? 0 : 1;
+}
+
+/* Kiosk rotation: while the current title plays, a background thread
+   prepares the next playlist entry's complete boot image — init, ROM
+   load (with its romdb config), and a decode-cache warm over the whole
+   image — so switching titles is chip8_boot plus a palette refresh,
+   with zero load time on the swap. The playlist is the library index of
+   a scanned directory. */
+static chip8_state_t rotate_image;
+static SDL_AtomicInt rotate_image_ready;
+static pthread_t rotate_thread;
+static bool rotate_active;
+static size_t rotate_next; // Playlist index the prefetch thread prepares
+
+static void *rotate_prefetch_main(void *arg) {
+    // Unloadable entries (deleted since the scan) are skipped in place
+    for (size_t tries = library_count(); tries > 0; tries--) {
+        const library_entry_t *entry = library_get(rotate_next % library_count());
+        chip8_init(&rotate_image);
+        if (chip8_load_rom(&rotate_image, entry->path)) {
+            // Predecode every instruction slot in the image so the first
+            // quantum after the swap runs entirely out of warm blocks
+            for (uint32_t pc = 0x200; pc < 0x200 + entry->size; pc += 2) {
+                chip8_predecode(&rotate_image, (uint16_t)pc);
+            }
+            SDL_SetAtomicInt(&rotate_image_ready, 1);
+            return NULL;
+        }
+        rotate_next++;
+    }
+    return NULL;
+}
+
+/* TAS-style stepping for content QA: pause, single-frame advance, and
+   slow motion all run whole 60Hz frames (ips/60 instructions + one
+   timer tick) through the same quantum the virtual clock uses, never by
+   sleeping inside chip8_tick — so a slow-motion run executes the exact
+   instruction stream a realtime one does and replays stay valid. */
+static bool qa_paused;
+// Window minimized or hidden (not merely occluded): the buzzer device
+// pauses too — audio is suspended while either this or qa_paused holds
+static bool window_minimized;
+
+/* Visibility gates the render path while emulation continues.
+   Minimized/hidden suspends the buzzer device too; occluded (Wayland
+   compositors report full occlusion) parks only the renderer, since
+   audio stays audible behind other windows. Called from both event
+   drains on the emulation thread. */
+static void handle_visibility_event(const SDL_Event *event) {
+    if (event->type == SDL_EVENT_WINDOW_MINIMIZED ||
+        event->type == SDL_EVENT_WINDOW_HIDDEN) {
+        window_minimized = true;
+        audio_suspend(true);
+        SDL_SetAtomicInt(&render_hidden, 1);
+    }
+    if (event->type == SDL_EVENT_WINDOW_OCCLUDED) {
+        SDL_SetAtomicInt(&render_hidden, 1);
+    }
+    if (event->type == SDL_EVENT_WINDOW_EXPOSED ||
+        event->type == SDL_EVENT_WINDOW_RESTORED ||
+        event->type == SDL_EVENT_WINDOW_SHOWN) {
+        if (window_minimized) {
+            window_minimized = false;
+            audio_suspend(qa_paused);
+        }
+        if (SDL_GetAtomicInt(&render_hidden)) {
+            SDL_SetAtomicInt(&render_hidden, 0);
+            // The compositor may have dropped the surface: redraw the
+            // held frame even if no new one is pending
+            SDL_SetAtomicInt(&render_nudge, 1);
+            render_wake();
+        }
+    }
+}
+static bool qa_advance;     // One frame queued while paused (F10)
+static int qa_slowmo = 1;   // Realtime divisor: 2 = half speed (F7/F8)
+static uint64_t qa_frame_deadline_ns;
+
+static void qa_run_frame(chip8_state_t *state) {
+    state->idle = false;
+    chip8_run(state, (int)chip8_clock_budget(state));
+    chip8_vblank(state);
+    // Keep the virtual vblank schedule aligned with the tick we just ran
+    // by hand, so resuming chip8_tick doesn't burst-decrement the timers
+    if (state->virtual_clock) {
+        state->next_vblank_cycle = state->cycle_count + chip8_clock_budget(state);
+    }
+}
+
+// Re-baseline wall-clock pacing after stepping took over for a while
+static void qa_resume(chip8_state_t *state) {
+    state->deadline_valid = false;
+    chip8_clock_rebase(state);
+}
+
+/* Run-ahead (--runahead): hides the inherent frame of input latency.
+   After each real frame the loop snapshots the state, runs one extra
+   frame's instructions with the live keypad, publishes that speculative
+   frame, and rewinds — so a keypress shows on screen one display frame
+   before the emulation actually reaches its effect. The snapshot is the
+   whole-struct boot-image copy, not a savestate: it round-trips in
+   microseconds, keeps the decode and sprite caches warm, and restores
+   cycle_count bit-exactly, so pacing, replays, and counters never see
+   the speculative work. The sound hook is parked during the lookahead —
+   its edges would fire again when the real frame executes them. The
+   per-instruction diagnostics (heatmap, profile, trace) do observe the
+   speculative instructions; don't measure with run-ahead on. */
+static bool runahead_enabled;
+static chip8_state_t runahead_shadow;
+
+static void runahead_flip(chip8_state_t *state) {
+    SDL_memcpy(&runahead_shadow, state, sizeof(runahead_shadow));
+    void (*hook)(bool) = chip8_sound_hook;
+    chip8_sound_hook = NULL;
+    state->idle = false; // The frame being hidden may hold the wake-up key
+    chip8_run(state, (int)chip8_clock_budget(state));
+    chip8_vblank(state);
+    chip8_sound_hook = hook;
+}
+
+static void runahead_restore(chip8_state_t *state) {
+    SDL_memcpy(state, &runahead_shadow, sizeof(*state));
+    // The speculative frame is already on screen; the real frame re-draws
+    // the same image next tick and re-marks these itself
+    state->vram_dirty = false;
+    state->dirty_count = 0;
+}
+
+/* UI actions that mutate emulation state go through the SPSC command
+   queue (cmdq.h) instead of touching chip8_state_t in the handler:
+   pushed where the event arrives, drained at the next quantum boundary.
+   Today both ends happen to live on this thread, so draining right after
+   the event loop keeps the feel identical; when emulation moves to its
+   own thread the handlers and this vocabulary stay exactly as they are. */
+enum {
+    CMD_RESET = 1,      // F5: back to the prepared boot image
+    CMD_PAUSE_TOGGLE,   // Space
+    CMD_TURBO_TOGGLE,   // Tab: uncapped fast-forward on/off
+    CMD_SLOWMO_HALVE,   // F7
+    CMD_SLOWMO_RESTORE, // F8
+    CMD_CONFIG_RELOAD,  // A validated live config is staged (liveconfig.h)
+    CMD_MIGRATE_OUT,    // F6: hand the quiesced session to the armed peer
+    CMD_MIGRATE_ARRIVE, // A validated inbound image is staged (migrate.h)
+};
+
+/* Overlapped ROM load for the interactive path: state init, the 4KB ROM
+   read, and the font/decode warm-up run on their own thread while the
+   main thread brings up SDL video and the window — the two longest
+   serial legs of the 250ms kiosk wakeup budget, now concurrent. The
+   join sits right after texture creation, before anything touches
+   chip8_state. */
+typedef struct rom_load_job {
+    chip8_state_t *state;
+    const char *path; // NULL: embedded-ROM builds boot the in-image ROM
+    bool ok;
+} rom_load_job_t;
+
+static void *rom_loader(void *arg) {
+    rom_load_job_t *job = arg;
+    uint64_t start = telemetry_now_ns();
+    chip8_init(job->state);
+#ifdef CHIP8_EMBEDDED_ROM
+    if (job->path == NULL) {
+        extern const unsigned char embedded_rom[];
+        extern const size_t embedded_rom_size;
+        job->ok = chip8_load_rom_memory(job->state, embedded_rom, embedded_rom_size);
+        telemetry_counter_max(&telemetry_startup_rom, (telemetry_now_ns() - start) / 1000);
+        return NULL;
+    }
+#endif
+    job->ok = job->path != NULL && chip8_load_rom(job->state, job->path);
+    telemetry_counter_max(&telemetry_startup_rom, (telemetry_now_ns() - start) / 1000);
+    return NULL;
+}
+
+int main(int argc, char *argv[]) {
+    startup_epoch_ns = telemetry_now_ns(); // Time-to-first-frame baseline
+
+    /* Subcommand surface: `chip8 <cmd> ...` as the documented spelling
+       of the --mode flags below, resolved by one strcmp pass over a
+       dozen names before any subsystem init — no option-table iteration
+       on the common path. `chip8 run rom.ch8` collapses to the plain
+       ROM invocation and stays on the instant-start path; the --flag
+       spellings keep working for existing scripts and services. */
+    static const struct { const char *name; const char *flag; } subcommands[] = {
+        {"run", NULL}, // Interactive session (the default mode)
+        {"headless", "--headless"}, {"lockstep", "--lockstep"},
+        {"logdump", "--logdump"},   {"scan", "--scan"},
+        {"sweep", "--sweep"},       {"wall", "--wall"},
+        {"bisect", "--bisect"},     {"analyze", "--analyze"},
+        {"visual", "--visual"},     {"verify", "--verify"},
+        {"triage", "--triage"},     {"dense", "--dense"},
+        {"soak", "--soak"},
+    };
+    if (argc >= 2 && argv[1][0] != '-') {
+        for (size_t s = 0; s < sizeof(subcommands) / sizeof(subcommands[0]); s++) {
+            if (SDL_strcmp(argv[1], subcommands[s].name) != 0) {
+                continue;
+            }
+            if (subcommands[s].flag == NULL) {
+                for (int i = 1; i < argc; i++) {
+                    argv[i] = argv[i + 1]; // Includes the argv[argc] NULL
+                }
+                argc--;
+            } else {
+                argv[1] = (char *)subcommands[s].flag;
+            }
+            break;
+        }
+    }
+
+    // Heap tripwire: allocations inside a tick window count into
+    // telemetry (or abort under CHIP8_ALLOC_TRIPWIRE builds)
+    alloctrap_install();
+
+    // Per-ROM configs (quirk profile, ips, palette), consulted at ROM load
+    romdb_load(ROMDB_FILE);
+
+    // Site-specific keypad bindings (cabinet key matrices); missing file
+    // keeps the QWERTY defaults
+    input_load_bindings(KEYBINDS_FILE);
+
+    // Headless mode:
+    // chip8 --headless <ROM file> [--cycles N] [--seed N] [--replay file]
+    //                  [--screenshot file.bmp]
+    if (argc >= 3 && SDL_strcmp(argv[1], "--headless") == 0) {
+        uint64_t cycles = 1000000;
+        uint32_t seed = 1; // Fixed default so headless runs are reproducible
+        const char *replay_file = NULL;
+        const char *screenshot_file = NULL;
+
+        for (int i = 3; i < argc; i++) {
+            if (SDL_strcmp(argv[i], "--cycles") == 0 && i + 1 < argc) {
+                cycles = SDL_strtoull(argv[i + 1], NULL, 10);
+            }
+            if (SDL_strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+                seed = (uint32_t)SDL_strtoul(argv[i + 1], NULL, 10);
+            }
+            if (SDL_strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+                replay_file = argv[i + 1];
+            }
+            if (SDL_strcmp(argv[i], "--counters") == 0) {
+                counters_requested = 1; // Dump on exit
+            }
+            if (SDL_strcmp(argv[i], "--screenshot") == 0 && i + 1 < argc) {
+                screenshot_file = argv[i + 1];
+            }
+        }
+        return run_headless(argv[2], cycles, seed, replay_file, screenshot_file);
+    }
+
+    // Lockstep comparison mode: chip8 --lockstep <ROM file> [--cycles N]
+    // A/B-validates the block executor against the single-step path
+    if (argc >= 3 && SDL_strcmp(argv[1], "--lockstep") == 0) {
+        uint64_t cycles = 1000000;
+        for (int i = 3; i < argc; i++) {
+            if (SDL_strcmp(argv[i], "--cycles") == 0 && i + 1 < argc) {
+                cycles = SDL_strtoull(argv[i + 1], NULL, 10);
+            }
+        }
+        return run_lockstep(argv[2], cycles);
+    }
+
+    // Event log converter: chip8 --logdump <file>
+    if (argc >= 3 && SDL_strcmp(argv[1], "--logdump") == 0) {
+        return eventlog_dump(argv[2]) ? 0 : SDL_APP_FAILURE;
+    }
+
+    // Library scan mode: chip8 --scan <directory>
+    // Builds/refreshes the binary index and lists what was found
+    if (argc >= 3 && SDL_strcmp(argv[1], "--scan") == 0) {
+        if (!library_scan(argv[2], LIBRARY_INDEX_FILE)) {
+            return SDL_APP_FAILURE;
+        }
+        for (size_t i = 0; i < library_count(); i++) {
+            const library_entry_t *entry = library_get(i);
+            SDL_Log("%016llx %-6s %5llu %s",
+                    (unsigned long long)entry->hash,
+                    library_variant_name(entry->variant),
+                    (unsigned long long)entry->size,
+                    entry->path);
+        }
+        return 0;
+    }
+
+    // Sweep mode: chip8 --sweep <directory> [--cycles N]
+    // Validates the whole library headless across all cores
+    if (argc >= 3 && SDL_strcmp(argv[1], "--sweep") == 0) {
+        uint64_t cycles = 1000000;
+        for (int i = 3; i < argc; i++) {
+            if (SDL_strcmp(argv[i], "--cycles") == 0 && i + 1 < argc) {
+                cycles = SDL_strtoull(argv[i + 1], NULL, 10);
+            }
+        }
+        return run_sweep(argv[2], cycles);
+    }
+
+    // Wall mode: chip8 --wall <ROM> [ROM...] — N sessions tiled in one
+    // window, sharing one renderer
+    if (argc >= 3 && SDL_strcmp(argv[1], "--wall") == 0) {
+        return run_wall(argc - 2, &argv[2]);
+    }
+
+    // Ultra-dense hosting: chip8 --dense <ROM> [ROM...] [--seconds N] —
+    // one thread cooperatively timeslices every session (see run_dense)
+    if (argc >= 3 && SDL_strcmp(argv[1], "--dense") == 0) {
+        unsigned seconds = 0;
+        int count = 0;
+        char *dense_roms[DENSE_MAX_SESSIONS];
+        for (int i = 2; i < argc; i++) {
+            if (SDL_strcmp(argv[i], "--seconds") == 0 && i + 1 < argc) {
+                seconds = (unsigned)SDL_strtoul(argv[i + 1], NULL, 10);
+                i++;
+            } else if (count < DENSE_MAX_SESSIONS) {
+                dense_roms[count++] = argv[i];
+            }
+        }
+        if (count == 0) {
+            SDL_Log("Dense mode needs at least one ROM");
+            return SDL_APP_FAILURE;
+        }
+        return run_dense(count, dense_roms, seconds);
+    }
+
+    // Burn-in: chip8 --soak <ROM> [--seconds N] [--checkpoint N] —
+    // long-horizon drift, RSS, and tick-tail checkpoints (see run_soak)
+    if (argc >= 3 && SDL_strcmp(argv[1], "--soak") == 0) {
+        unsigned seconds = 0;
+        unsigned checkpoint_s = 60;
+        for (int i = 3; i < argc; i++) {
+            if (SDL_strcmp(argv[i], "--seconds") == 0 && i + 1 < argc) {
+                seconds = (unsigned)SDL_strtoul(argv[i + 1], NULL, 10);
+            }
+            if (SDL_strcmp(argv[i], "--checkpoint") == 0 && i + 1 < argc) {
+                checkpoint_s = (unsigned)SDL_strtoul(argv[i + 1], NULL, 10);
+                if (checkpoint_s == 0) {
+                    checkpoint_s = 60;
+                }
+            }
+        }
+        return run_soak(argv[2], seconds, checkpoint_s);
+    }
+
+    // Crash bisection: chip8 --bisect <archive> <replay> [--workers N]
+    // Binary-searches a recorded run's snapshot archive with parallel
+    // probes to find the first faulting instruction window (see bisect.h)
+    if (argc >= 4 && SDL_strcmp(argv[1], "--bisect") == 0) {
+        int workers = SDL_GetNumLogicalCPUCores();
+        for (int i = 4; i < argc; i++) {
+            if (SDL_strcmp(argv[i], "--workers") == 0 && i + 1 < argc) {
+                workers = SDL_atoi(argv[i + 1]);
+            }
+        }
+        return bisect_run(argv[2], argv[3], workers) ? 0 : SDL_APP_FAILURE;
+    }
+
+    // Replay verification: chip8 --verify <ROM> <replay> [replay...]
+    // Asserts every recording's embedded hash checkpoints in parallel
+    // (see run_verify); one exit status for the whole batch
+    if (argc >= 4 && SDL_strcmp(argv[1], "--verify") == 0) {
+        return run_verify(argv[2], argc - 3, &argv[3]);
+    }
+
+    // Quirk triage: chip8 --triage <ROM> [--cycles N]
+    // Runs the ROM under all 16 quirk-bit combinations in parallel and
+    // reports which bits change its behavior (see run_triage)
+    if (argc >= 3 && SDL_strcmp(argv[1], "--triage") == 0) {
+        uint64_t cycles = 1000000;
+        for (int i = 3; i < argc; i++) {
+            if (SDL_strcmp(argv[i], "--cycles") == 0 && i + 1 < argc) {
+                cycles = SDL_strtoull(argv[i + 1], NULL, 10);
+            }
+        }
+        return run_triage(argv[2], cycles);
+    }
+
+    // Pre-deployment report: chip8 --analyze <ROM file> [--seconds N]
+    if (argc >= 3 && SDL_strcmp(argv[1], "--analyze") == 0) {
+        unsigned seconds = ANALYZE_SECONDS;
+        for (int i = 3; i < argc; i++) {
+            if (SDL_strcmp(argv[i], "--seconds") == 0 && i + 1 < argc) {
+                seconds = (unsigned)SDL_strtoul(argv[i + 1], NULL, 10);
+            }
+        }
+        return run_analyze(argv[2], seconds);
+    }
+
+    // Visual regression suite over the presentation path (see run_visual)
+    if (argc >= 2 && SDL_strcmp(argv[1], "--visual") == 0) {
+        return run_visual(argc > 2 && SDL_strcmp(argv[2], "--print") == 0);
+    }
+
+    // Argument validation before any SDL bring-up: `chip8` with no ROM
+    // prints usage without paying for a video init (embedded builds have
+    // their ROM, so no arguments is a valid invocation there)
+#ifndef CHIP8_EMBEDDED_ROM
+    if (argc < 2) {
+        SDL_Log("Usage: %s [run] <ROM file>", argv[0]);
+        SDL_Log("       %s headless|lockstep|analyze <ROM file> [options]", argv[0]);
+        SDL_Log("       %s scan|sweep <directory> | wall <ROM...> | "
+                "bisect <archive> <replay> | logdump <file> | visual", argv[0]);
+        SDL_Log("       %s verify <ROM> <replay...> | triage <ROM> | dense <ROM...> | soak <ROM>", argv[0]);
+        return SDL_APP_FAILURE;
+    }
+#endif
+
+    // Create the emulator state and load the ROM concurrently with the
+    // video bring-up below (see rom_loader). A cheap existence check
+    // first keeps the common typo failing before any window flashes;
+    // deeper load errors surface at the join after texture creation.
+    chip8_state_t chip8_state;
+    rom_load_job_t load_job = {&chip8_state, argc >= 2 ? argv[1] : NULL, false};
+    if (load_job.path != NULL) {
+        struct stat rom_stat;
+        if (stat(load_job.path, &rom_stat) != 0) {
+            SDL_Log("Error opening file: %s", load_job.path);
+            return SDL_APP_FAILURE;
+        }
+    }
+    pthread_t loader;
+    pthread_create(&loader, NULL, rom_loader, &load_job);
+    uint64_t phase_start;
+
+    // Presentation mode pre-scan: it decides window flags and, for kms,
+    // the video backend, so it must be settled before SDL_Init. Cabinet
+    // deployments run borderless or exclusive to get flips instead of
+    // compositor copies; kms drops the display server entirely.
+    const char *present_arg = NULL;
+    for (int i = 2; i < argc; i++) {
+        if (SDL_strcmp(argv[i], "--present") == 0 && i + 1 < argc) {
+            present_arg = argv[i + 1];
+        }
+    }
+    // Renderer pre-scan for the same reason: the probe's verdict is the
+    // SDL_HINT_RENDER_DRIVER hint, read once at renderer creation.
+    // --probe-renderer discards the cached verdict and measures afresh.
+    bool probe_force = false;
+    for (int i = 2; i < argc; i++) {
+        if (SDL_strcmp(argv[i], "--probe-renderer") == 0) {
+            probe_force = true;
+        }
+    }
+
+    SDL_WindowFlags window_flags = SDL_WINDOW_RESIZABLE;
+    bool exclusive_mode = false;
+    if (present_arg != NULL) {
+        if (SDL_strcmp(present_arg, "borderless") == 0) {
+            window_flags = SDL_WINDOW_FULLSCREEN | SDL_WINDOW_BORDERLESS;
+        } else if (SDL_strcmp(present_arg, "exclusive") == 0) {
+            window_flags = SDL_WINDOW_FULLSCREEN;
+            exclusive_mode = true;
+        } else if (SDL_strcmp(present_arg, "kms") == 0) {
+            // Direct scanout: needs a free VT and DRM access, not an
+            // X/Wayland session. Init fails loudly when neither is there.
+            SDL_SetHint(SDL_HINT_VIDEO_DRIVER, "kmsdrm");
+            window_flags = SDL_WINDOW_FULLSCREEN;
+        } else if (SDL_strcmp(present_arg, "windowed") != 0) {
+            SDL_Log("Unknown presentation mode: %s", present_arg);
+        }
+    }
+
+    // Initialize SDL. Audio is not in the mask: the device opens lazily
+    // on the first buzzer edge (see audio_open), so silent ROMs — most of
+    // the kiosk catalog — never pay for it. Neither is the gamepad: its
+    // bring-up enumerates udev devices, so it waits until the first frame
+    // is on screen (see the one-shot in the main loop).
+    phase_start = telemetry_now_ns();
+    if (!SDL_Init(SDL_INIT_VIDEO)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't initialize SDL: %s", SDL_GetError());
+        return SDL_APP_FAILURE;
+    }
+    telemetry_counter_max(&telemetry_startup_sdl, (telemetry_now_ns() - phase_start) / 1000);
+
+    // Backend selection: the cached per-host probe verdict applies on
+    // every startup; the first run on a fresh host measures and caches
+    // it (see renderprobe.h)
+    renderprobe_select(probe_force);
+    phase_start = telemetry_now_ns();
+
+    // Create Window and Renderer
+    if (!SDL_CreateWindowAndRenderer("Chip-8 Emulator", WINDOW_WIDTH, WINDOW_HEIGHT, window_flags, &window, &renderer)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't create window and renderer: %s", SDL_GetError());
+        return SDL_APP_FAILURE;
+    }
+    if (exclusive_mode) {
+        // Exclusive modeset at the desktop's current mode: the swapchain
+        // gets page flips instead of compositor copies where the stack
+        // honors it. When no mode fits, borderless is the safe fallback.
+        SDL_DisplayID display = SDL_GetDisplayForWindow(window);
+        const SDL_DisplayMode *desktop = SDL_GetDesktopDisplayMode(display);
+        SDL_DisplayMode closest;
+        if (desktop == NULL ||
+            !SDL_GetClosestFullscreenDisplayMode(display, desktop->w, desktop->h,
+                                                 desktop->refresh_rate, false, &closest) ||
+            !SDL_SetWindowFullscreenMode(window, &closest)) {
+            SDL_Log("Exclusive mode unavailable (%s); staying borderless", SDL_GetError());
+        }
+    }
+    if (present_arg != NULL) {
+        // The achieved path matters more than the requested one: present
+        // latency in the exit report (frame present) is only comparable
+        // across runs on the same driver and mode
+        SDL_Log("Presenting via %s driver, %s", SDL_GetCurrentVideoDriver(),
+                (window_flags & SDL_WINDOW_FULLSCREEN) ? "fullscreen" : "windowed");
+    }
+
+    // Vsync-locked presents; when the driver refuses, the render thread
+    // falls back to pacing by the measured refresh interval
+    if (!SDL_SetRenderVSync(renderer, 1)) {
+        SDL_Log("Vsync unavailable (%s); pacing presents by timer", SDL_GetError());
+    }
+    const SDL_DisplayMode *display_mode = SDL_GetCurrentDisplayMode(SDL_GetDisplayForWindow(window));
+    if (display_mode != NULL && display_mode->refresh_rate > 0.0f) {
+        refresh_interval_ns = (uint64_t)(1e9 / display_mode->refresh_rate);
+        SDL_Log("Display refresh: %.1fHz", display_mode->refresh_rate);
+    }
+
+    // Create the streaming framebuffer texture (128x64; lo-res frames only
+    // touch the 64x32 corner)
+    framebuffer = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING, 128, 64);
+    if (!framebuffer) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't create framebuffer texture: %s", SDL_GetError());
+        return SDL_APP_FAILURE;
+    }
+    SDL_SetTextureScaleMode(framebuffer, SDL_SCALEMODE_NEAREST);
+
+    // Performance HUD overlay strip (F1 toggles it)
+    hud_texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING, HUD_WIDTH, HUD_HEIGHT);
+    if (!hud_texture) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't create HUD texture: %s", SDL_GetError());
+        return SDL_APP_FAILURE;
+    }
+    SDL_SetTextureScaleMode(hud_texture, SDL_SCALEMODE_NEAREST);
+    SDL_SetTextureBlendMode(hud_texture, SDL_BLENDMODE_BLEND);
+
+    // CRT post-processing target and scanline pattern (F2 toggles the
+    // effect; failure just leaves the toggle inert)
+    crt_target = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET,
+                                   128 * CRT_SCALE, 64 * CRT_SCALE);
+    scanline_texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC,
+                                         1, CRT_SCALE);
+    if (crt_target != NULL && scanline_texture != NULL) {
+        SDL_SetTextureScaleMode(crt_target, SDL_SCALEMODE_LINEAR);
+        uint32_t column[CRT_SCALE] = {0};
+        column[CRT_SCALE - 2] = 0x50000000; // Soft edge into the gap
+        column[CRT_SCALE - 1] = 0x90000000; // Scanline gap
+        SDL_UpdateTexture(scanline_texture, NULL, column, sizeof(uint32_t));
+        SDL_SetTextureBlendMode(scanline_texture, SDL_BLENDMODE_BLEND);
+    } else {
+        SDL_Log("CRT effect unavailable: %s", SDL_GetError());
+    }
+    telemetry_counter_max(&telemetry_startup_window, (telemetry_now_ns() - phase_start) / 1000);
+
+    // Join the overlapped ROM load: from here on chip8_state is wired
+    // into hooks, flags, and threads. On the kiosks the load finishes
+    // well inside the window bring-up, so the join is free.
+    pthread_join(loader, NULL);
+    if (!load_job.ok) {
+        return SDL_APP_FAILURE;
+    }
+
+    // Instruction-timestamped buzzer edges; the first rising edge opens
+    // the audio device
+    chip8_sound_hook = audio_edge_push;
+
+    // A ROM config palette replaces the default one
+    const romdb_entry_t *rom_config = romdb_find(chip8_state.rom_hash);
+    if (rom_config != NULL && rom_config->has_palette) {
+        for (int i = 0; i < 4; i++) {
+            palette[i] = rom_config->palette[i];
+        }
+    }
+
+    // Optional flags (chip8 <ROM file> [--trace [file]] [--seed N] [--ips N]
+    // [--record [file]] [--replay [file]] [--journal [file]] [--stream [port]]
+    // [--break addr] [--watch addr] [--virtual-clock] [--disasm [file]]
+    // [--sample-pc] [--rotate dir] [--interval seconds]
+    // [--netplay-host [port]] [--netplay addr [port]] [--eventlog [file]]
+    // [--pacing sleep|hybrid|spin] [--latency] [--heatmap]
+    // [--ghosting [frames]] [--script file] [--decode-stats]
+    // [--core fast|instrumented] [--shm [name]] [--capture [file]]
+    // [--energy [duty%]] [--introspect [name]]
+    // [--present windowed|borderless|exclusive|kms] [--archive [file]]
+    // [--rt [priority]] [--debounce [ms]] [--palette name|RRGGBB:RRGGBB:RRGGBB:RRGGBB]
+    // [--watchdog [alert|snapshot|reset|rotate]] [--runahead]
+    // [--export [file] [seconds]] [--orientation 90|180|270] [--degrade]
+    // [--config [file]] [--font file] [--perf] [--mem-budget MB]
+    // [--warm-audio] [--migrate addr [port]] [--migrate-listen [port]]
+    // [--raw-input [device]] [--probe-renderer] [--decode-cache])
+    const char *record_file = NULL;
+    const char *replay_file = NULL;
+    const char *journal_file = NULL;
+    const char *disasm_file = NULL;
+    const char *rotate_dir = NULL;
+    const char *netplay_addr = NULL;
+    bool netplay_listen = false;
+    unsigned short netplay_port = 5589;
+    uint64_t rotate_interval_ns = 30 * 1000000000ULL;
+    unsigned short stream_port = 0;
+    const char *export_file = NULL;
+    unsigned export_seconds = 0;
+    const char *migrate_addr = NULL; // F6 hands the session here when set
+    unsigned short migrate_port = MIGRATE_DEFAULT_PORT;
+    bool migrate_accept = false;
+    unsigned short migrate_accept_port = MIGRATE_DEFAULT_PORT;
+
+    // Instrumentation memory comes from one upfront arena: a first pass
+    // over the flags sums what the enabled features will carve out, so
+    // the *_start calls below never allocate mid-run and the exit report
+    // declares the total cost of the flags
+    size_t arena_budget = 0;
+    size_t mem_budget = 0; // --mem-budget hard cap, 0 = uncapped
+    for (int i = 2; i < argc; i++) {
+        if (SDL_strcmp(argv[i], "--eventlog") == 0) {
+            arena_budget += EVENTLOG_ARENA_BYTES;
+        } else if (SDL_strcmp(argv[i], "--script") == 0) {
+            arena_budget += SCRIPT_ARENA_BYTES;
+        } else if (SDL_strcmp(argv[i], "--decode-stats") == 0) {
+            arena_budget += DECODESTAT_ARENA_BYTES;
+        } else if (SDL_strcmp(argv[i], "--capture") == 0) {
+            arena_budget += CAPTURE_ARENA_BYTES;
+        } else if (SDL_strcmp(argv[i], "--mem-budget") == 0 && i + 1 < argc) {
+            mem_budget = (size_t)SDL_strtoul(argv[i + 1], NULL, 10) << 20;
+        }
+    }
+
+    // Bounded memory mode: hundreds of sessions pack onto a host, so the
+    // per-session worst case is declared up front rather than discovered
+    // in production. The cap never grows anything — the trace ring (the
+    // one shrinkable cache) halves until the flag set fits, and startup
+    // refuses if even the smallest configuration would bust the budget.
+    // The ring is always budgeted so F3 can toggle tracing on a live
+    // instance that never passed --trace.
+    size_t trace_budget = TRACE_ARENA_BYTES;
+    while (mem_budget != 0 && trace_budget > TRACE_ARENA_MIN_BYTES &&
+           sizeof(chip8_state_t) + arena_budget + trace_budget > mem_budget) {
+        trace_budget /= 2;
+    }
+    arena_budget += trace_set_budget(trace_budget);
+
+    size_t session_worst = sizeof(chip8_state_t) + arena_budget;
+    if (mem_budget != 0 && session_worst > mem_budget) {
+        SDL_Log("Session needs %zu KB worst case but --mem-budget allows %zu KB; "
+                "drop instrumentation flags or raise the budget",
+                session_worst / 1024, mem_budget / 1024);
+        return SDL_APP_FAILURE;
+    }
+    SDL_Log("Session memory, worst case: %zu KB (state %zu KB, instrumentation arena %zu KB)",
+            session_worst / 1024, sizeof(chip8_state_t) / 1024, arena_budget / 1024);
+    if (arena_budget != 0 && !arena_init(arena_budget)) {
+        return SDL_APP_FAILURE;
+    }
+
+    bool core_pinned = false; // --core overrides the automatic selection
+    for (int i = 2; i < argc; i++) {
+        if (SDL_strcmp(argv[i], "--trace") == 0) {
+            trace_start(i + 1 < argc ? argv[i + 1] : "trace.bin");
+        }
+        if (SDL_strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            chip8_seed(&chip8_state, (uint32_t)SDL_strtoul(argv[i + 1], NULL, 10));
+        }
+        if (SDL_strcmp(argv[i], "--ips") == 0 && i + 1 < argc) {
+            chip8_state.ips = (uint32_t)SDL_strtoul(argv[i + 1], NULL, 10); // 0 = uncapped
+        }
+        if (SDL_strcmp(argv[i], "--profile") == 0 && i + 1 < argc) {
+            if (SDL_strcmp(argv[i + 1], "modern") == 0) {
+                chip8_set_profile(&chip8_state, CHIP8_PROFILE_MODERN);
+            } else if (SDL_strcmp(argv[i + 1], "cosmac") == 0) {
+                chip8_set_profile(&chip8_state, CHIP8_PROFILE_COSMAC);
+            } else {
+                SDL_Log("Unknown quirk profile: %s", argv[i + 1]);
+            }
+        }
+        if (SDL_strcmp(argv[i], "--record") == 0) {
+            record_file = i + 1 < argc ? argv[i + 1] : "replay.bin";
+        }
+        if (SDL_strcmp(argv[i], "--replay") == 0) {
+            replay_file = i + 1 < argc ? argv[i + 1] : "replay.bin";
+        }
+        if (SDL_strcmp(argv[i], "--journal") == 0) {
+            journal_file = i + 1 < argc ? argv[i + 1] : "journal.bin";
+        }
+        if (SDL_strcmp(argv[i], "--sample-pc") == 0) {
+            profile_start(); // Histogram report lands on exit
+        }
+        if (SDL_strcmp(argv[i], "--disasm") == 0) {
+            disasm_file = i + 1 < argc ? argv[i + 1] : "disasm.txt";
+        }
+        if (SDL_strcmp(argv[i], "--virtual-clock") == 0) {
+            chip8_set_virtual_clock(&chip8_state, true); // Deterministic timers
+        }
+        if (SDL_strcmp(argv[i], "--break") == 0 && i + 1 < argc) {
+            debug_add_breakpoint(&chip8_state, (uint16_t)SDL_strtoul(argv[i + 1], NULL, 16));
+        }
+        if (SDL_strcmp(argv[i], "--watch") == 0 && i + 1 < argc) {
+            debug_add_watchpoint((uint16_t)SDL_strtoul(argv[i + 1], NULL, 16));
+        }
+        if (SDL_strcmp(argv[i], "--pacing") == 0 && i + 1 < argc) {
+            if (SDL_strcmp(argv[i + 1], "sleep") == 0) {
+                chip8_pacing = CHIP8_PACING_SLEEP;
+            } else if (SDL_strcmp(argv[i + 1], "spin") == 0) {
+                chip8_pacing = CHIP8_PACING_SPIN;
+            } else if (SDL_strcmp(argv[i + 1], "hybrid") == 0) {
+                chip8_pacing = CHIP8_PACING_HYBRID;
+            } else {
+                SDL_Log("Unknown pacing policy: %s", argv[i + 1]);
+            }
+        }
+        if (SDL_strcmp(argv[i], "--eventlog") == 0) {
+            eventlog_start(i + 1 < argc ? argv[i + 1] : "events.bin");
+        }
+        if (SDL_strcmp(argv[i], "--latency") == 0) {
+            latency_enabled = true; // Distributions land in the exit report
+        }
+        if (SDL_strcmp(argv[i], "--heatmap") == 0) {
+            heatmap_start(); // Region dump lands on exit
+        }
+        if (SDL_strcmp(argv[i], "--decode-stats") == 0) {
+            decodestat_start(); // Hit/miss report lands on exit
+        }
+        if (SDL_strcmp(argv[i], "--decode-cache") == 0) {
+            // Relaunch-heavy kiosks: the static analysis pass persists
+            // per ROM hash under decode_cache/ and later launches of the
+            // same title skip it (see disasm.h)
+            disasm_cache_enabled = true;
+        }
+        if (SDL_strcmp(argv[i], "--capture") == 0) {
+            bool named = i + 1 < argc && argv[i + 1][0] != '-';
+            if (!capture_start(named ? argv[i + 1] : "capture.y4m")) {
+                return SDL_APP_FAILURE;
+            }
+        }
+        if (SDL_strcmp(argv[i], "--shm") == 0) {
+            bool named = i + 1 < argc && argv[i + 1][0] != '-';
+            if (!shmframe_start(named ? argv[i + 1] : "chip8-frame")) {
+                return SDL_APP_FAILURE;
+            }
+        }
+        if (SDL_strcmp(argv[i], "--archive") == 0) {
+            // Regression-farm snapshots: one savestate per second into a
+            // seekable mmap'd container (see archive.h)
+            bool named = i + 1 < argc && argv[i + 1][0] != '-';
+            if (!archive_open(named ? argv[i + 1] : "chip8.archive")) {
+                return SDL_APP_FAILURE;
+            }
+        }
+        if (SDL_strcmp(argv[i], "--introspect") == 0) {
+            bool named = i + 1 < argc && argv[i + 1][0] != '-';
+            if (!introspect_start(named ? argv[i + 1] : "chip8-state")) {
+                return SDL_APP_FAILURE;
+            }
+        }
+        if (SDL_strcmp(argv[i], "--energy") == 0) {
+            // Battery deployments: throttle batches to a duty-cycle
+            // target priced by the per-opcode cost model
+            bool named = i + 1 < argc && argv[i + 1][0] != '-';
+            energy_start(named ? (int)SDL_strtoul(argv[i + 1], NULL, 10) : 20);
+        }
+        if (SDL_strcmp(argv[i], "--core") == 0 && i + 1 < argc) {
+            if (SDL_strcmp(argv[i + 1], "fast") == 0) {
+                // Throughput deployments: instrumentation and debugging
+                // flags become inert (their hooks are compiled out)
+                chip8_set_core(&chip8_state, CHIP8_CORE_FAST);
+                core_pinned = true;
+            } else if (SDL_strcmp(argv[i + 1], "instrumented") == 0) {
+                chip8_set_core(&chip8_state, CHIP8_CORE_INSTRUMENTED);
+                core_pinned = true;
+            } else {
+                SDL_Log("Unknown core variant: %s", argv[i + 1]);
+            }
+        }
+        if (SDL_strcmp(argv[i], "--script") == 0 && i + 1 < argc) {
+            if (!script_load(argv[i + 1])) {
+                return SDL_APP_FAILURE;
+            }
+        }
+        if (SDL_strcmp(argv[i], "--ghosting") == 0) {
+            ghost_frames = i + 1 < argc ? (uint32_t)SDL_strtoul(argv[i + 1], NULL, 10) : 0;
+            if (ghost_frames == 0) {
+                ghost_frames = 4; // Hold a pixel for 4-8 published frames
+            }
+        }
+        if (SDL_strcmp(argv[i], "--netplay-host") == 0) {
+            netplay_listen = true;
+            if (i + 1 < argc && SDL_strtoul(argv[i + 1], NULL, 10) != 0) {
+                netplay_port = (unsigned short)SDL_strtoul(argv[i + 1], NULL, 10);
+            }
+        }
+        if (SDL_strcmp(argv[i], "--netplay") == 0 && i + 1 < argc) {
+            netplay_addr = argv[i + 1];
+            if (i + 2 < argc && SDL_strtoul(argv[i + 2], NULL, 10) != 0) {
+                netplay_port = (unsigned short)SDL_strtoul(argv[i + 2], NULL, 10);
+            }
+        }
+        if (SDL_strcmp(argv[i], "--migrate") == 0 && i + 1 < argc) {
+            migrate_addr = argv[i + 1];
+            if (i + 2 < argc && SDL_strtoul(argv[i + 2], NULL, 10) != 0) {
+                migrate_port = (unsigned short)SDL_strtoul(argv[i + 2], NULL, 10);
+            }
+        }
+        if (SDL_strcmp(argv[i], "--migrate-listen") == 0) {
+            migrate_accept = true;
+            if (i + 1 < argc && SDL_strtoul(argv[i + 1], NULL, 10) != 0) {
+                migrate_accept_port = (unsigned short)SDL_strtoul(argv[i + 1], NULL, 10);
+            }
+        }
+        if (SDL_strcmp(argv[i], "--rotate") == 0 && i + 1 < argc) {
+            rotate_dir = argv[i + 1];
+        }
+        if (SDL_strcmp(argv[i], "--interval") == 0 && i + 1 < argc) {
+            rotate_interval_ns = SDL_strtoull(argv[i + 1], NULL, 10) * 1000000000ULL;
+        }
+        if (SDL_strcmp(argv[i], "--stream") == 0) {
+            stream_port = i + 1 < argc ? (unsigned short)SDL_strtoul(argv[i + 1], NULL, 10) : 0;
+            if (stream_port == 0) {
+                stream_port = 5588;
+            }
+        }
+        if (SDL_strcmp(argv[i], "--rt") == 0) {
+            rt_priority = i + 1 < argc ? (int)SDL_strtoul(argv[i + 1], NULL, 10) : 0;
+            if (rt_priority == 0) {
+                rt_priority = 10; // Above housekeeping, below audio servers
+            }
+        }
+        if (SDL_strcmp(argv[i], "--debounce") == 0) {
+            uint32_t window_ms = i + 1 < argc ? (uint32_t)SDL_strtoul(argv[i + 1], NULL, 10) : 0;
+            input_set_debounce(window_ms != 0 ? window_ms : 5); // 5ms covers
+                                               // typical leaf-switch chatter
+        }
+        if (SDL_strcmp(argv[i], "--watchdog") == 0) {
+            const char *policy = i + 1 < argc && argv[i + 1][0] != '-'
+                               ? argv[i + 1] : "alert";
+            if (SDL_strcmp(policy, "alert") == 0) {
+                watchdog_enable(WATCHDOG_ALERT);
+            } else if (SDL_strcmp(policy, "snapshot") == 0) {
+                watchdog_enable(WATCHDOG_SNAPSHOT);
+            } else if (SDL_strcmp(policy, "reset") == 0) {
+                watchdog_enable(WATCHDOG_RESET);
+            } else if (SDL_strcmp(policy, "rotate") == 0) {
+                watchdog_enable(WATCHDOG_ROTATE);
+            } else {
+                SDL_Log("Unknown watchdog policy: %s", policy);
+            }
+        }
+        if (SDL_strcmp(argv[i], "--runahead") == 0) {
+            runahead_enabled = true;
+        }
+        if (SDL_strcmp(argv[i], "--degrade") == 0) {
+            degrade_enable();
+        }
+        if (SDL_strcmp(argv[i], "--perf") == 0) {
+            perfcount_start();
+        }
+        if (SDL_strcmp(argv[i], "--warm-audio") == 0) {
+            audio_warm_start();
+        }
+        if (SDL_strcmp(argv[i], "--raw-input") == 0) {
+            // Dedicated cabinets skip the desktop input stack; the named
+            // (or scanned) evdev device feeds the keypad directly
+            bool named = i + 1 < argc && argv[i + 1][0] != '-';
+            rawinput_start(&chip8_state, named ? argv[i + 1] : NULL);
+        }
+        if (SDL_strcmp(argv[i], "--font") == 0 && i + 1 < argc) {
+            // Venue font: raw glyph images, 80 bytes of low-res or 180
+            // with the SCHIP hi-res digits appended
+            uint8_t glyphs[CHIP8_FONT_BYTES + CHIP8_BIG_FONT_BYTES];
+            FILE *font_fptr = fopen(argv[i + 1], "rb");
+            if (font_fptr == NULL) {
+                SDL_Log("Error opening font file: %s", argv[i + 1]);
+            } else {
+                size_t got = fread(glyphs, 1, sizeof(glyphs), font_fptr);
+                fclose(font_fptr);
+                if (got == CHIP8_FONT_BYTES) {
+                    chip8_set_font(&chip8_state, glyphs, NULL);
+                    SDL_Log("Loaded font from %s", argv[i + 1]);
+                } else if (got == sizeof(glyphs)) {
+                    chip8_set_font(&chip8_state, glyphs,
+                                   glyphs + CHIP8_FONT_BYTES);
+                    SDL_Log("Loaded font (with hi-res digits) from %s", argv[i + 1]);
+                } else {
+                    SDL_Log("Font file must be %d or %d bytes: %s",
+                            CHIP8_FONT_BYTES,
+                            CHIP8_FONT_BYTES + CHIP8_BIG_FONT_BYTES, argv[i + 1]);
+                }
+            }
+        }
+        if (SDL_strcmp(argv[i], "--config") == 0) {
+            const char *config_file = LIVECONFIG_FILE;
+            if (i + 1 < argc && argv[i + 1][0] != '-') {
+                config_file = argv[i + 1];
+            }
+            liveconfig_watch(config_file);
+        }
+        if (SDL_strcmp(argv[i], "--orientation") == 0 && i + 1 < argc) {
+            int degrees = (int)SDL_strtoul(argv[i + 1], NULL, 10);
+            if (degrees == 0 || degrees == 90 || degrees == 180 || degrees == 270) {
+                present_rotation = degrees;
+            } else {
+                SDL_Log("Orientation must be 0, 90, 180 or 270 degrees");
+            }
+        }
+        if (SDL_strcmp(argv[i], "--export") == 0) {
+            export_file = EXPORT_FILE;
+            if (i + 1 < argc && argv[i + 1][0] != '-') {
+                export_file = argv[i + 1];
+                if (i + 2 < argc && SDL_isdigit((unsigned char)argv[i + 2][0])) {
+                    export_seconds = (unsigned)SDL_strtoul(argv[i + 2], NULL, 10);
+                }
+            }
+        }
+        if (SDL_strcmp(argv[i], "--palette") == 0 && i + 1 < argc) {
+            // Venue theme: becomes the default every rotated title starts
+            // from; a per-ROM config palette still wins for its title
+            if (palette_select(argv[i + 1]) &&
+                (rom_config == NULL || !rom_config->has_palette)) {
+                SDL_memcpy(palette, palette_default, sizeof(palette));
+            }
+        }
+    }
+    // Unless --core pinned a variant, dispatch follows the layers that
+    // actually enabled: a plain launch runs the fast table and a later F3
+    // trace toggle hot-patches the pointers back in
+    if (!core_pinned) {
+        chip8_core_autoselect(&chip8_state);
+    }
+
+    if (stream_port != 0) {
+        stream_start(stream_port);
+    }
+    if (export_file != NULL) {
+        export_start(export_file, export_seconds);
+    }
+    // Migration receiver: run normally until a drained session arrives,
+    // then splice its image in at a quantum boundary
+    if (migrate_accept) {
+        migrate_listen(&chip8_state, migrate_accept_port);
+    }
+    // Netplay: block until the peer connects, then adopt the host's rng
+    // and pacing so both sides run the same deterministic frames
+    if ((netplay_listen || netplay_addr != NULL)
+        && !netplay_start(&chip8_state, netplay_addr, netplay_port)) {
+        return SDL_APP_FAILURE;
+    }
+
+    // Kiosk rotation: index the playlist directory and start preparing the
+    // first rotation target in the background right away
+    if (rotate_dir != NULL) {
+        if (library_scan(rotate_dir, LIBRARY_INDEX_FILE) && library_count() > 0) {
+            rotate_active = true;
+            pthread_create(&rotate_thread, NULL, rotate_prefetch_main, NULL);
+        } else {
+            SDL_Log("Rotation disabled: nothing indexed under %s", rotate_dir);
+        }
+    }
+    // Crash recovery: resume from the journal's last checkpoint if one
+    // survives from an earlier session
+    if (journal_file != NULL) {
+        journal_open(journal_file, &chip8_state);
+    }
+    if (record_file != NULL) {
+        replay_record_start(record_file, &chip8_state);
+    }
+    if (replay_file != NULL) {
+        replay_play_start(replay_file, &chip8_state);
+    }
+    // Static reachability pass: classify code vs. data and predecode every
+    // reachable instruction before the first one executes. After the
+    // journal restore so a resumed image is what gets scanned.
+    disasm_scan(&chip8_state);
+    if (disasm_file != NULL) {
+        disasm_dump(&chip8_state, disasm_file);
+    }
+    uint32_t paced_ips = chip8_state.ips != 0 ? chip8_state.ips : CHIP8_DEFAULT_IPS;
+    audio_set_mute(chip8_state.ips == 0); // --ips 0 starts in fast-forward
+
+    // Prepared boot image: everything above (init, ROM load, seed, quirk
+    // profile, predecode) baked into one template, so F5 restarts are a
+    // single memcpy with zero file I/O
+    static chip8_state_t boot_image;
+    chip8_capture_boot(&chip8_state, &boot_image);
+
+    // Dump opcode counters on SIGUSR1 and pacing telemetry on SIGUSR2
+    // without stopping the emulator
+    signal(SIGUSR1, request_counters);
+    signal(SIGUSR2, request_telemetry);
+
+    // Bake the (possibly ROM-configured) palette into the expansion LUT
+    build_expand_lut();
+
+    // Seed the presentation geometry: the render thread computes it on
+    // its first frame, then only after resize events
+    SDL_SetAtomicInt(&window_resized, 1);
+
+    // Start the render thread (slot 1 is the initial, stale pending frame)
+    SDL_SetAtomicInt(&pending_frame, 1);
+    SDL_SetAtomicInt(&render_running, 1);
+    pthread_create(&render_thread, NULL, render_thread_main, NULL);
+
+    // Elevate last, once every startup-time thread exists at normal
+    // priority; only helpers spawned later need the rt_suspend bracket
+    if (rt_priority != 0) {
+        rt_apply();
+    }
+
+    // Main emulator loop
+    bool running = true;
+    uint16_t prev_keypad = 0;
+    uint64_t rotate_deadline_ns = telemetry_now_ns() + rotate_interval_ns;
+    uint64_t ips_window_start = 0;
+    uint64_t ips_window_cycles = 0;
+    bool housekeeping_due = false; // 1Hz checkpoint work awaiting budget
+    bool gamepad_deferred = true;  // Subsystem init still owed (see SDL_Init)
+    while (running) {
+
+        // Gamepad bring-up was left out of SDL_Init to keep it off the
+        // first-frame path; it lands here, once, right after the render
+        // thread reports the first present. Keyboard input needs no
+        // subsystem, so nothing is lost in the gap.
+        if (gamepad_deferred && telemetry_startup_first_frame.value != 0) {
+            gamepad_deferred = false;
+            if (!SDL_InitSubSystem(SDL_INIT_GAMEPAD)) {
+                SDL_Log("Gamepad subsystem unavailable: %s", SDL_GetError());
+            }
+        }
+
+        // When the core is spinning in a self-jump or key wait there is
+        // nothing to emulate: block on events for up to one quantum (so the
+        // timers still tick at 60Hz) instead of polling at full speed
+        if (chip8_state.idle) {
+            if (SDL_WaitEventTimeout(&event, 1000 / QUANTUM_HZ)) {
+                if (event.type == SDL_EVENT_QUIT) {
+                    break;
+                }
+                if (event.type == SDL_EVENT_KEY_DOWN || event.type == SDL_EVENT_KEY_UP ||
+                    event.type == SDL_EVENT_GAMEPAD_BUTTON_DOWN ||
+                    event.type == SDL_EVENT_GAMEPAD_BUTTON_UP) {
+                    chip8_state.idle = false; // Let FX0A re-check the keypad
+                }
+                if (event.type == SDL_EVENT_WINDOW_RESIZED ||
+                    event.type == SDL_EVENT_WINDOW_PIXEL_SIZE_CHANGED) {
+                    SDL_SetAtomicInt(&window_resized, 1);
+                }
+                handle_visibility_event(&event);
+                handle_key_event(&event, &chip8_state);
+                handle_gamepad_event(&event, &chip8_state);
+            }
+        }
+
+        // Drain every pending event before running the quantum so input and
+        // quit handling never lag behind the emulation rate
+        while (SDL_PollEvent(&event)) {
+            if (event.type == SDL_EVENT_QUIT) {
+                running = false;
+            }
+            // Window resizes invalidate the cached presentation geometry;
+            // the render thread recomputes it on its next frame
+            if (event.type == SDL_EVENT_WINDOW_RESIZED ||
+                event.type == SDL_EVENT_WINDOW_PIXEL_SIZE_CHANGED) {
+                SDL_SetAtomicInt(&window_resized, 1);
+                if (qa_paused) {
+                    SDL_SetAtomicInt(&render_nudge, 1); // Re-present at the new size
+                    render_wake();
+                }
+            }
+            handle_visibility_event(&event);
+            // Tab toggles uncapped turbo (fast-forward)
+            if (event.type == SDL_EVENT_KEY_DOWN && !event.key.repeat &&
+                event.key.scancode == SDL_SCANCODE_TAB) {
+                cmdq_push(CMD_TURBO_TOGGLE, 0);
+            }
+            // F1 toggles the performance HUD
+            if (event.type == SDL_EVENT_KEY_DOWN && !event.key.repeat &&
+                event.key.scancode == SDL_SCANCODE_F1) {
+                SDL_SetAtomicInt(&hud_enabled, !SDL_GetAtomicInt(&hud_enabled));
+                if (qa_paused) {
+                    SDL_SetAtomicInt(&render_nudge, 1); // Redraw the held frame
+                    render_wake();
+                }
+            }
+            // F2 toggles the CRT post stage
+            if (event.type == SDL_EVENT_KEY_DOWN && !event.key.repeat &&
+                event.key.scancode == SDL_SCANCODE_F2) {
+                SDL_SetAtomicInt(&crt_enabled, !SDL_GetAtomicInt(&crt_enabled));
+                if (qa_paused) {
+                    SDL_SetAtomicInt(&render_nudge, 1);
+                    render_wake();
+                }
+            }
+            // F3 toggles instruction tracing on the live instance; the
+            // dispatch hot-patches between the fast and instrumented
+            // tables, so tracing left off costs nothing
+            if (event.type == SDL_EVENT_KEY_DOWN && !event.key.repeat &&
+                event.key.scancode == SDL_SCANCODE_F3) {
+                if (trace_enabled) {
+                    trace_stop();
+                    SDL_Log("Tracing stopped");
+                } else {
+                    char trace_path[64];
+                    SDL_snprintf(trace_path, sizeof(trace_path), "chip8_%llu.trace",
+                                 (unsigned long long)chip8_state.cycle_count);
+                    trace_start(trace_path);
+                }
+                if (!core_pinned) {
+                    chip8_core_autoselect(&chip8_state);
+                }
+            }
+            // F5 restarts the ROM from the prepared boot image
+            if (event.type == SDL_EVENT_KEY_DOWN && !event.key.repeat &&
+                event.key.scancode == SDL_SCANCODE_F5) {
+                cmdq_push(CMD_RESET, 0);
+            }
+            // F6 drains the session to the --migrate destination
+            if (event.type == SDL_EVENT_KEY_DOWN && !event.key.repeat &&
+                event.key.scancode == SDL_SCANCODE_F6) {
+                if (migrate_addr != NULL) {
+                    cmdq_push(CMD_MIGRATE_OUT, 0);
+                } else {
+                    SDL_Log("No migration destination armed (--migrate addr)");
+                }
+            }
+            // Space pauses; F10 advances exactly one 60Hz frame while
+            // paused; F7/F8 halve/restore the simulation speed
+            if (event.type == SDL_EVENT_KEY_DOWN && !event.key.repeat &&
+                event.key.scancode == SDL_SCANCODE_SPACE) {
+                cmdq_push(CMD_PAUSE_TOGGLE, 0);
+            }
+            if (event.type == SDL_EVENT_KEY_DOWN &&
+                event.key.scancode == SDL_SCANCODE_F10) {
+                qa_advance = true;
+            }
+            if (event.type == SDL_EVENT_KEY_DOWN && !event.key.repeat &&
+                event.key.scancode == SDL_SCANCODE_F7) {
+                cmdq_push(CMD_SLOWMO_HALVE, 0);
+            }
+            if (event.type == SDL_EVENT_KEY_DOWN && !event.key.repeat &&
+                event.key.scancode == SDL_SCANCODE_F8) {
+                cmdq_push(CMD_SLOWMO_RESTORE, 0);
+            }
+            // F12 captures the display (encoded off-thread)
+            if (event.type == SDL_EVENT_KEY_DOWN && !event.key.repeat &&
+                event.key.scancode == SDL_SCANCODE_F12) {
+                char shot_path[64];
+                SDL_snprintf(shot_path, sizeof(shot_path), "chip8_%llu.bmp",
+                             (unsigned long long)chip8_state.cycle_count);
+                screenshot_request(&chip8_state, shot_path);
+            }
+            if (event.type == SDL_EVENT_KEY_DOWN || event.type == SDL_EVENT_KEY_UP ||
+                event.type == SDL_EVENT_GAMEPAD_BUTTON_DOWN ||
+                event.type == SDL_EVENT_GAMEPAD_BUTTON_UP) {
+                chip8_state.idle = false;
+            }
+            // During playback the keypad belongs to the replay stream
+            if (!replay_playing) {
+                handle_key_event(&event, &chip8_state);
+                handle_gamepad_event(&event, &chip8_state);
+            }
+        }
+        if (!running) {
+            break;
+        }
+
+        // A staged live config rides the same queue as the key handlers'
+        // actions, so it lands at the boundary like any other UI change
+        // (the watcher validated it off-thread; take below is a copy)
+        if (liveconfig_pending()) {
+            cmdq_push(CMD_CONFIG_RELOAD, 0);
+        }
+        // An inbound migration image splices in the same way
+        if (migrate_pending()) {
+            cmdq_push(CMD_MIGRATE_ARRIVE, 0);
+        }
+
+        // Raw key edges already flipped the keypad bits from the reader
+        // thread; here the park clears so FX0A re-checks them
+        if (rawinput_active && rawinput_pending()) {
+            chip8_state.idle = false;
+        }
+
+        // Quantum boundary: execute the UI actions the handlers queued,
+        // acknowledging each so a producer on another thread could sync
+        cmdq_cmd_t cmd;
+        while (cmdq_pop(&cmd)) {
+            switch (cmd.op) {
+                case CMD_RESET:
+                    chip8_boot(&chip8_state, &boot_image);
+                    break;
+                case CMD_PAUSE_TOGGLE:
+                    qa_paused = !qa_paused;
+                    // Stop the pull callback while held
+                    audio_suspend(qa_paused || window_minimized);
+                    SDL_SetAtomicInt(&render_parked, qa_paused);
+                    if (!qa_paused) {
+                        qa_resume(&chip8_state);
+                        render_wake();
+                    }
+                    break;
+                case CMD_TURBO_TOGGLE:
+                    chip8_state.ips = chip8_state.ips == 0 ? paced_ips : 0;
+                    audio_set_mute(chip8_state.ips == 0);
+                    break;
+                case CMD_SLOWMO_HALVE:
+                    if (qa_slowmo < 16) {
+                        qa_slowmo *= 2;
+                        audio_set_speed(1.0 / qa_slowmo);
+                        SDL_Log("Speed 1/%d", qa_slowmo);
+                    }
+                    break;
+                case CMD_SLOWMO_RESTORE:
+                    if (qa_slowmo > 1) {
+                        qa_slowmo /= 2;
+                        audio_set_speed(1.0 / qa_slowmo);
+                        SDL_Log("Speed 1/%d", qa_slowmo);
+                        if (qa_slowmo == 1) {
+                            qa_resume(&chip8_state);
+                        }
+                    }
+                    break;
+                case CMD_CONFIG_RELOAD: {
+                    liveconfig_t config;
+                    if (!liveconfig_take(&config)) {
+                        break; // Two pushes raced one staged config
+                    }
+                    if (config.has_ips) {
+                        paced_ips = config.ips;
+                        if (chip8_state.ips != 0) {
+                            // Turbo stays uncapped; Tab lands on the new rate
+                            chip8_state.ips = config.ips;
+                        }
+                    }
+                    if (config.has_palette) {
+                        // Becomes the default too, like --palette, so the
+                        // recolor survives kiosk rotation
+                        SDL_memcpy(palette_default, config.palette, sizeof(palette_default));
+                        SDL_memcpy(palette, config.palette, sizeof(palette));
+                        build_expand_lut();
+                    }
+                    if (config.has_degrade) {
+                        if (config.degrade) {
+                            degrade_enable();
+                        } else {
+                            degrade_disable();
+                        }
+                    }
+                    if (config.has_export_interval) {
+                        export_set_interval(config.export_interval);
+                    }
+                    telemetry_config_reloads.value++;
+                    eventlog_emit(EVENT_CONFIG_RELOAD, config.generation,
+                                  config.has_ips ? config.ips : 0);
+                    SDL_Log("Live config %u applied", config.generation);
+                    break;
+                }
+                case CMD_MIGRATE_OUT:
+                    // The state is quiesced here between quanta; on ack the
+                    // peer owns the session and this process drains
+                    if (migrate_out(&chip8_state, migrate_addr, migrate_port,
+                                    paced_ips)) {
+                        running = false;
+                    }
+                    break;
+                case CMD_MIGRATE_ARRIVE: {
+                    uint8_t image[CHIP8_SAVESTATE_SIZE];
+                    size_t image_size;
+                    uint32_t image_ips;
+                    if (!migrate_take(image, sizeof(image), &image_size, &image_ips)) {
+                        break; // Two pushes raced one staged image
+                    }
+                    if (!chip8_load_state(&chip8_state, image, image_size)) {
+                        break; // Rejected images are logged by the loader
+                    }
+                    // Adopt the sender's pacing like a rotation swap does
+                    paced_ips = image_ips != 0 ? image_ips : CHIP8_DEFAULT_IPS;
+                    chip8_state.ips = image_ips;
+                    audio_set_mute(chip8_state.ips == 0);
+                    chip8_state.idle = false;
+                    eventlog_emit(EVENT_MIGRATE, 2, image_ips);
+                    SDL_Log("Migrated session spliced in at cycle %llu",
+                            (unsigned long long)chip8_state.cycle_count);
+                    break;
+                }
+            }
+            cmdq_ack();
+        }
+
+        // Rotation swap: when the interval expires and the prefetched image
+        // is ready, the title switch is one struct copy plus a palette
+        // refresh — the next prefetch starts immediately
+        if (rotate_active && SDL_GetAtomicInt(&rotate_image_ready)
+            && telemetry_now_ns() >= rotate_deadline_ns) {
+            pthread_join(rotate_thread, NULL);
+            chip8_boot(&chip8_state, &rotate_image);
+            SDL_SetAtomicInt(&rotate_image_ready, 0);
+
+            SDL_memcpy(palette, palette_default, sizeof(palette));
+            const romdb_entry_t *next_config = romdb_find(chip8_state.rom_hash);
+            if (next_config != NULL && next_config->has_palette) {
+                for (int i = 0; i < 4; i++) {
+                    palette[i] = next_config->palette[i];
+                }
+            }
+            build_expand_lut(); // Render thread may see one mixed frame
+
+            paced_ips = chip8_state.ips != 0 ? chip8_state.ips : CHIP8_DEFAULT_IPS;
+            audio_set_mute(chip8_state.ips == 0);
+            rotate_deadline_ns = telemetry_now_ns() + rotate_interval_ns;
+            rotate_next = (rotate_next + 1) % library_count();
+            rt_suspend(); // Prefetch I/O must not inherit RT priority
+            pthread_create(&rotate_thread, NULL, rotate_prefetch_main, NULL);
+            rt_resume();
+        }
+
+        // Keypad changes only land between quanta, so logging transitions
+        // here captures them at their exact instruction count
+        if (replay_recording) {
+            uint16_t keys = atomic_load_explicit(&chip8_state.keypad, memory_order_relaxed);
+            for (int key = 0; key < 16; key++) {
+                if (((keys ^ prev_keypad) >> key) & 1) {
+                    replay_record_key(chip8_state.cycle_count, key, (keys >> key) & 1);
+                }
+            }
+            prev_keypad = keys;
+        }
+        replay_play_apply(&chip8_state);
+
+        bool frame_ran = true;
+        if (perfcount_enabled) {
+            perfcount_begin(); // The quantum below is the emulation phase
+        }
+        if (netplay_active) {
+            netplay_tick(&chip8_state); // Paced 60Hz frames with rollback
+        } else if (qa_paused) {
+            if (qa_advance) {
+                qa_run_frame(&chip8_state); // Exactly one frame, then hold
+                qa_advance = false;
+            } else {
+                // Park without dequeuing: the poll loop above keeps sole
+                // ownership of event handling, and this thread sleeps until
+                // input arrives (1s timeout so SIGUSR dumps still land)
+                SDL_WaitEventTimeout(NULL, 1000);
+                frame_ran = false;
+            }
+        } else if (qa_slowmo > 1) {
+            // One 60Hz frame every qa_slowmo frame intervals
+            uint64_t now = telemetry_now_ns();
+            if (qa_frame_deadline_ns == 0 || now > qa_frame_deadline_ns + 1000000000ULL) {
+                qa_frame_deadline_ns = now;
+            }
+            if (now >= qa_frame_deadline_ns) {
+                qa_run_frame(&chip8_state);
+                qa_frame_deadline_ns += qa_slowmo * 1000000000ULL / 60;
+            } else {
+                uint64_t wait = qa_frame_deadline_ns - now;
+                SDL_DelayNS(wait > 1000000 ? 1000000 : wait);
+                frame_ran = false;
+            }
+        } else {
+            chip8_tick(&chip8_state);
+        }
+        if (perfcount_enabled && frame_ran) {
+            perfcount_end(PERF_PHASE_EMULATION);
+        }
+        // The frame's whole script batch runs here, between quanta — the
+        // interpreter never sees a per-instruction callback
+        if (script_active && frame_ran && !script_tick(&chip8_state)) {
+            running = false;
+        }
+        // The hook catches every transition during execution; this catches
+        // discontinuities it can't see (savestate loads, rewind)
+        if ((bool)SDL_GetAtomicInt(&buzzer_on) != (chip8_state.sound_timer > 0)) {
+            audio_edge_push(chip8_state.sound_timer > 0);
+        }
+
+        // Mirror the hot registers for lock-free observers: one cache-line
+        // seqlocked write per quantum (HUD, scripts, shm monitors)
+        introspect_publish(&chip8_state);
+
+        /* Deadline budget for everything below the tick: the quantum just
+           consumed its share of the frame interval, so the disk-backed
+           housekeeping (journal checkpoint, archive append, on-demand
+           dumps) runs only when wall time remains before the core's next
+           pacing deadline. Under load it slips to a later, lighter
+           iteration instead of stretching the quantum — input, emulation,
+           and frame publish keep their cadence, and every slip is counted
+           rather than silent. */
+        uint64_t hud_now = telemetry_now_ns();
+        // The tick paces to next_deadline_ns before returning, so "on
+        // time" means landing within one quantum interval of it; further
+        // out than that and the loop is carrying a backlog
+        bool budget_left = !chip8_state.deadline_valid ||
+                           hud_now < chip8_state.next_deadline_ns + CHIP8_CLOCK_QUANTUM_NS;
+
+        // One degradation-ladder sample per quantum, on the raw deadline
+        // verdict (before the once-a-second override below forces the
+        // checkpoint through); a deliberate pause is not load
+        if (!qa_paused) {
+            degrade_observe(chip8_state.deadline_valid && !budget_left);
+        }
+
+        // Once a second, publish the achieved instruction rate for the HUD
+        // and mark the checkpoint work due
+        if (hud_now - ips_window_start >= 1000000000ULL) {
+            if (ips_window_start != 0) {
+                SDL_SetAtomicInt(&stat_ips, (int)((chip8_state.cycle_count - ips_window_cycles) *
+                                                  1000000000.0 / (hud_now - ips_window_start)));
+            }
+            ips_window_start = hud_now;
+            ips_window_cycles = chip8_state.cycle_count;
+
+            // One hash checkpoint per second makes the recording
+            // self-verifying: we're at a quantum boundary here, the one
+            // place a verifier crosses the same cycle count
+            if (replay_recording) {
+                replay_record_hash(chip8_state.cycle_count,
+                                   chip8_state_hash(&chip8_state));
+            }
+
+            // Hung-ROM watchdog: one counter-compare sample per second,
+            // never while the operator has the session paused on purpose
+            if (!qa_paused) {
+                watchdog_policy_t verdict = watchdog_observe(&chip8_state);
+                if (verdict != WATCHDOG_OFF) {
+                    eventlog_emit(EVENT_WATCHDOG, (uint32_t)verdict,
+                                  chip8_state.program_counter);
+                }
+                if (verdict == WATCHDOG_SNAPSHOT) {
+                    chip8_save_state_file(&chip8_state, WATCHDOG_STATE_FILE);
+                } else if (verdict == WATCHDOG_RESET) {
+                    cmdq_push(CMD_RESET, 0); // Drained next iteration
+                } else if (verdict == WATCHDOG_ROTATE) {
+                    if (rotate_active) {
+                        rotate_deadline_ns = 0; // Swap on the next ready image
+                    } else {
+                        cmdq_push(CMD_RESET, 0); // No library: reboot instead
+                    }
+                }
+            }
+
+            if (housekeeping_due) {
+                budget_left = true; // A full second behind: sustained overload
+                                    // runs its checkpoint now rather than never
+            }
+            housekeeping_due = true;
+        }
+
+        if (!budget_left && (housekeeping_due || counters_requested || telemetry_requested)) {
+            telemetry_deadline_overruns.value++;
+        }
+        if (housekeeping_due && budget_left) {
+            journal_checkpoint(&chip8_state);
+            archive_append(&chip8_state);
+            housekeeping_due = false;
+        }
+        if (counters_requested && budget_left) {
+            counters_requested = 0;
+            chip8_counters_write_json(&chip8_state, COUNTERS_FILE);
+            export_request(); // Just a flag and a wakeup; the worker formats
+        }
+        if (telemetry_requested && budget_left) {
+            telemetry_requested = 0;
+            telemetry_report();
+        }
+
+        // Speculative frame for run-ahead, bracketing only the publish:
+        // everything above (replay, journal, archive, HUD) already saw the
+        // real state, and everything below next iteration will again. Live
+        // input only — a playback or netplay frame has nothing to hide.
+        bool runahead_flipped = false;
+        if (runahead_enabled && frame_ran && !qa_paused
+            && !replay_playing && !netplay_active) {
+            runahead_flip(&chip8_state);
+            runahead_flipped = true;
+        }
+
+        // Publish a frame only when a draw/clear changed vram; the render
+        // thread presents it without blocking this loop
+        if (chip8_state.vram_dirty) {
+            stream_publish(&chip8_state); // Before publish resets dirty state
+            publish_frame(&chip8_state);
+            chip8_state.vram_dirty = false;
+            if (qa_paused) {
+                render_wake(); // Single-step publish: one present, then re-park
+            }
+            if (latency_enabled) {
+                latency_publish();
+            }
+        }
+        if (runahead_flipped) {
+            runahead_restore(&chip8_state);
+        }
+    }
+
+    SDL_SetAtomicInt(&render_running, 0);
+    render_wake(); // Quitting while paused: unpark so the join completes
+    pthread_join(render_thread, NULL);
+    if (rotate_active) {
+        pthread_join(rotate_thread, NULL); // An in-flight prefetch finishes fast
+    }
+
+    if (replay_recording) {
+        // Final checkpoint: the hash the verify mode asserts last
+        replay_record_hash(chip8_state.cycle_count,
+                           chip8_state_hash(&chip8_state));
+    }
+    replay_record_stop();
+    replay_play_stop();
+    journal_close();
+    archive_close();
+    rawinput_stop();
+    migrate_stop();
+    stream_stop();
+    shmframe_stop();
+    introspect_stop();
+    capture_stop();
+    netplay_stop();
+    eventlog_stop();
+    liveconfig_stop();
+    export_stop();
+    screenshot_stop();
+    trace_stop();
+    crashdump_flush();
+    profile_report(&chip8_state);
+    heatmap_report();
+    decodestat_report();
+    energy_report();
+    perfcount_report();
+    int script_failures = script_report();
+    arena_report();
+    telemetry_report();
+    arena_shutdown();
+
+    // Destroy resources
+    SDL_DestroyTexture(rotation_target);
+    SDL_DestroyTexture(scanline_texture);
+    SDL_DestroyTexture(crt_target);
+    SDL_DestroyTexture(hud_texture);
+    SDL_DestroyTexture(framebuffer);
+    SDL_DestroyRenderer(renderer);
+    SDL_DestroyWindow(window);
+    SDL_Quit();
+
+    return script_failures != 0 ? SDL_APP_FAILURE : 0;
 }
\ No newline at end of file
@@ -0,0 +1,240 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <SDL3/SDL.h>
+
+#include "migrate.h"
+#include "savestate.h"
+#include "eventlog.h"
+
+#define MIGRATE_VERSION 1
+// "C8MG" + version + rom hash (8 LE) + paced ips (4 LE) + image size (4 LE)
+#define MIGRATE_HEADER 21
+
+bool migrate_listening;
+
+static int listen_fd = -1;
+static pthread_t listener;
+
+// Staged inbound image: the listener thread validates and parks it here;
+// the emulation thread copies it out at a quantum boundary
+static pthread_mutex_t migrate_lock = PTHREAD_MUTEX_INITIALIZER;
+static uint8_t staged_image[CHIP8_SAVESTATE_SIZE];
+static size_t staged_size;
+static uint32_t staged_ips;
+static SDL_AtomicInt staged_pending;
+
+static uint64_t expected_rom_hash; // Captured at listen start
+
+// Loops over partial writes, like the netplay sender; a vanished peer
+// surfaces as an error instead of SIGPIPE
+static bool migrate_send(int fd, const void *data, size_t size) {
+    const uint8_t *bytes = data;
+    while (size > 0) {
+        ssize_t sent = send(fd, bytes, size, MSG_NOSIGNAL);
+        if (sent <= 0 && errno != EINTR) {
+            return false;
+        }
+        if (sent > 0) {
+            bytes += sent;
+            size -= (size_t)sent;
+        }
+    }
+    return true;
+}
+
+static bool migrate_recv_exact(int fd, void *data, size_t size) {
+    uint8_t *bytes = data;
+    while (size > 0) {
+        ssize_t got = recv(fd, bytes, size, 0);
+        if (got <= 0 && errno != EINTR) {
+            return false;
+        }
+        if (got > 0) {
+            bytes += got;
+            size -= (size_t)got;
+        }
+    }
+    return true;
+}
+
+// Accepts one handoff at a time. Everything here happens off the
+// emulation thread; only the staging handshake touches shared state.
+static void *migrate_listener_main(void *arg) {
+    (void)arg;
+    for (;;) {
+        int peer = accept(listen_fd, NULL, NULL);
+        if (peer < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break; // migrate_stop shut the listener down
+        }
+        int nodelay = 1;
+        setsockopt(peer, IPPROTO_TCP, TCP_NODELAY, &nodelay, sizeof(nodelay));
+
+        uint8_t header[MIGRATE_HEADER];
+        uint8_t image[CHIP8_SAVESTATE_SIZE];
+        if (!migrate_recv_exact(peer, header, sizeof(header)) ||
+            memcmp(header, "C8MG", 4) != 0 || header[4] != MIGRATE_VERSION) {
+            SDL_Log("Migration handshake mismatch; handoff refused");
+            close(peer);
+            continue;
+        }
+        uint64_t rom_hash = 0;
+        uint32_t ips = 0, size = 0;
+        for (int i = 0; i < 8; i++) {
+            rom_hash |= (uint64_t)header[5 + i] << (8 * i);
+        }
+        for (int i = 0; i < 4; i++) {
+            ips |= (uint32_t)header[13 + i] << (8 * i);
+            size |= (uint32_t)header[17 + i] << (8 * i);
+        }
+        if (rom_hash != expected_rom_hash) {
+            SDL_Log("Migration peer is running a different ROM; handoff refused");
+            close(peer);
+            continue;
+        }
+        if (size > sizeof(image) || !migrate_recv_exact(peer, image, size)) {
+            SDL_Log("Migration image truncated; handoff refused");
+            close(peer);
+            continue;
+        }
+
+        pthread_mutex_lock(&migrate_lock);
+        memcpy(staged_image, image, size);
+        staged_size = size;
+        staged_ips = ips;
+        pthread_mutex_unlock(&migrate_lock);
+        SDL_SetAtomicInt(&staged_pending, 1);
+
+        // The ack transfers ownership: once the sender sees it, the
+        // session lives here and the sender drains
+        uint8_t ack = 'A';
+        migrate_send(peer, &ack, 1);
+        close(peer);
+        SDL_Log("Inbound session image staged (%u bytes)", size);
+    }
+    return NULL;
+}
+
+bool migrate_listen(const chip8_state_t *state, unsigned short port) {
+    listen_fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (listen_fd < 0) {
+        SDL_Log("Migration socket failed");
+        return false;
+    }
+    int reuse = 1;
+    setsockopt(listen_fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons(port);
+    if (bind(listen_fd, (struct sockaddr *)&addr, sizeof(addr)) < 0 ||
+        listen(listen_fd, 1) < 0) {
+        SDL_Log("Migration bind failed on port %u", port);
+        close(listen_fd);
+        listen_fd = -1;
+        return false;
+    }
+
+    expected_rom_hash = state->rom_hash;
+    migrate_listening = true;
+    pthread_create(&listener, NULL, migrate_listener_main, NULL);
+    SDL_Log("Accepting session handoffs on port %u", port);
+    return true;
+}
+
+bool migrate_pending(void) {
+    return SDL_GetAtomicInt(&staged_pending) != 0;
+}
+
+bool migrate_take(uint8_t *image, size_t capacity, size_t *out_size,
+                  uint32_t *out_ips) {
+    if (!SDL_CompareAndSwapAtomicInt(&staged_pending, 1, 0)) {
+        return false;
+    }
+    pthread_mutex_lock(&migrate_lock);
+    bool ok = staged_size <= capacity;
+    if (ok) {
+        memcpy(image, staged_image, staged_size);
+        *out_size = staged_size;
+        *out_ips = staged_ips;
+    }
+    pthread_mutex_unlock(&migrate_lock);
+    return ok;
+}
+
+bool migrate_out(const chip8_state_t *state, const char *host,
+                 unsigned short port, uint32_t paced_ips) {
+    uint8_t image[CHIP8_SAVESTATE_SIZE];
+    size_t size = chip8_save_state(state, image, sizeof(image));
+    if (size == 0) {
+        return false;
+    }
+
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    if (inet_pton(AF_INET, host, &addr.sin_addr) != 1) {
+        SDL_Log("Bad migration address: %s", host);
+        close(fd);
+        return false;
+    }
+    if (fd < 0 || connect(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+        SDL_Log("Couldn't reach migration peer %s:%u; session stays here",
+                host, port);
+        close(fd);
+        return false;
+    }
+    int nodelay = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &nodelay, sizeof(nodelay));
+
+    uint8_t header[MIGRATE_HEADER];
+    memcpy(header, "C8MG", 4);
+    header[4] = MIGRATE_VERSION;
+    for (int i = 0; i < 8; i++) {
+        header[5 + i] = (state->rom_hash >> (8 * i)) & 0xFF;
+    }
+    for (int i = 0; i < 4; i++) {
+        header[13 + i] = (paced_ips >> (8 * i)) & 0xFF;
+        header[17 + i] = ((uint32_t)size >> (8 * i)) & 0xFF;
+    }
+
+    uint8_t ack = 0;
+    if (!migrate_send(fd, header, sizeof(header)) ||
+        !migrate_send(fd, image, size) ||
+        !migrate_recv_exact(fd, &ack, 1) || ack != 'A') {
+        SDL_Log("Migration peer refused the handoff; session stays here");
+        close(fd);
+        return false;
+    }
+    close(fd);
+
+    eventlog_emit(EVENT_MIGRATE, 1, paced_ips);
+    SDL_Log("Session handed to %s:%u at cycle %llu; draining", host, port,
+            (unsigned long long)state->cycle_count);
+    return true;
+}
+
+void migrate_stop(void) {
+    if (!migrate_listening) {
+        return;
+    }
+    migrate_listening = false;
+    shutdown(listen_fd, SHUT_RDWR); // Unblocks the accept
+    pthread_join(listener, NULL);
+    close(listen_fd);
+    listen_fd = -1;
+}
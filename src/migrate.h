@@ -0,0 +1,53 @@
+#ifndef MIGRATE_H
+#define MIGRATE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "chip8.h"
+
+/**
+ * Session Migration
+ *
+ * Live handoff for rolling host maintenance: instead of killing a
+ * session to drain its host, the emulation thread quiesces at a quantum
+ * boundary, ships the savestate image plus pacing config to a peer
+ * already running the same ROM, and drains; the peer splices the image
+ * in at its own quantum boundary. The architectural state is a few KB,
+ * so the handoff is one connect and one write — the player sees a
+ * sub-second pause, and a frame-stream viewer reconnects to the peer's
+ * --stream port, where a fresh connection always opens with a keyframe.
+ *
+ * The listener runs on its own thread like the stream worker, but an
+ * arrived image is only staged there: the emulation thread applies it
+ * through the command queue, so the splice lands between quanta like
+ * any other UI action.
+ */
+
+#define MIGRATE_DEFAULT_PORT 5590
+
+extern bool migrate_listening;
+
+// Receiver: accepts handoffs on the TCP port. Images for a different
+// ROM are refused at the handshake, so a mis-aimed drain can't corrupt
+// an unrelated session.
+bool migrate_listen(const chip8_state_t *state, unsigned short port);
+
+// A validated inbound image is staged, awaiting the quantum boundary
+bool migrate_pending(void);
+
+// Copies the staged image out; returns false if another take won the
+// race. out_ips receives the sender's paced instruction rate.
+bool migrate_take(uint8_t *image, size_t capacity, size_t *out_size,
+                  uint32_t *out_ips);
+
+// Sender: ships the quiesced state to the destination; call only at a
+// quantum boundary. True means the peer acknowledged ownership and this
+// process should drain; false leaves the session running here.
+bool migrate_out(const chip8_state_t *state, const char *host,
+                 unsigned short port, uint32_t paced_ips);
+
+void migrate_stop(void);
+
+#endif // MIGRATE_H
@@ -0,0 +1,341 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <SDL3/SDL.h>
+
+#include "netplay.h"
+#include "rewind.h"
+#include "telemetry.h"
+#include "eventlog.h"
+
+#define NETPLAY_VERSION 1
+#define NETPLAY_FRAME_NS (1000000000ULL / 60)
+// Rollback window in frames; the lockstep throttle keeps the simulation
+// from outrunning confirmations past what the ring can rewind
+#define NETPLAY_HISTORY 64
+#define NETPLAY_HOST_HALF 0x00FF // Host owns keys 0-7, guest keys 8-F
+
+// Per-frame input packet: [frame u32 LE][keypad half bitmask u16 LE]
+#define NETPLAY_PACKET 6
+
+bool netplay_active;
+
+static int peer_fd = -1;
+static uint16_t local_half; // Bitmask of the keys this side owns
+
+static uint32_t frame;      // Next simulation frame number
+static uint32_t confirmed;  // Frames below this have real remote input
+static uint16_t last_remote; // Prediction: the remote holds its last keys
+static uint16_t history_local[NETPLAY_HISTORY];
+static uint16_t history_remote[NETPLAY_HISTORY]; // Predicted or confirmed
+static chip8_rewind_t *rollback_ring;
+static uint64_t next_frame_ns;
+
+static uint8_t recv_buf[NETPLAY_PACKET * NETPLAY_HISTORY];
+static size_t recv_len;
+
+// Loops over partial writes, like the stream sender; a vanished peer
+// surfaces as an error instead of SIGPIPE
+static bool netplay_send(const void *data, size_t size) {
+    const uint8_t *bytes = data;
+    while (size > 0) {
+        ssize_t sent = send(peer_fd, bytes, size, MSG_NOSIGNAL);
+        if (sent <= 0 && errno != EINTR) {
+            return false;
+        }
+        if (sent > 0) {
+            bytes += sent;
+            size -= (size_t)sent;
+        }
+    }
+    return true;
+}
+
+static bool netplay_recv_exact(void *data, size_t size) {
+    uint8_t *bytes = data;
+    while (size > 0) {
+        ssize_t got = recv(peer_fd, bytes, size, 0);
+        if (got <= 0 && errno != EINTR) {
+            return false;
+        }
+        if (got > 0) {
+            bytes += got;
+            size -= (size_t)got;
+        }
+    }
+    return true;
+}
+
+static void netplay_drop(const char *why) {
+    SDL_Log("Netplay session ended: %s", why);
+    eventlog_emit(EVENT_NETPLAY_DROP, 0, frame);
+    close(peer_fd);
+    peer_fd = -1;
+    netplay_active = false;
+}
+
+// One deterministic 60Hz frame: combined keypad in, ips/60 instructions,
+// one timer tick. Rollback re-simulation goes through exactly this path,
+// so a replayed frame is bit-identical to its first run.
+static void netplay_run_frame(chip8_state_t *state, uint16_t local, uint16_t remote) {
+    uint16_t keys = (local & local_half) | (remote & ~local_half);
+    atomic_store_explicit(&state->keypad, keys, memory_order_relaxed);
+    state->idle = false;
+    uint32_t ips = state->ips != 0 ? state->ips : CHIP8_DEFAULT_IPS;
+    chip8_run(state, (int)(ips / 60));
+    chip8_vblank(state);
+}
+
+// Rewinds to frame `to` and replays forward with the corrected remote
+// input. Later unconfirmed frames re-predict from the corrected mask,
+// and each replayed frame re-captures so the ring depth is restored.
+static void netplay_rollback(chip8_state_t *state, uint32_t to) {
+    for (uint32_t i = frame - to; i > 0; i--) {
+        if (!chip8_rewind_step_back(rollback_ring, state)) {
+            netplay_drop("rollback past available history");
+            return;
+        }
+    }
+    for (uint32_t f = to; f < frame; f++) {
+        if (f > to && f >= confirmed) {
+            history_remote[f % NETPLAY_HISTORY] =
+                history_remote[(f - 1) % NETPLAY_HISTORY];
+        }
+        chip8_rewind_capture(rollback_ring, state);
+        netplay_run_frame(state, history_local[f % NETPLAY_HISTORY],
+                          history_remote[f % NETPLAY_HISTORY]);
+    }
+}
+
+// Drains whatever input packets have arrived. TCP keeps them in frame
+// order, so each one either confirms a prediction or triggers a rollback.
+static void netplay_poll(chip8_state_t *state) {
+    ssize_t got = recv(peer_fd, recv_buf + recv_len, sizeof(recv_buf) - recv_len, 0);
+    if (got == 0 || (got < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+        netplay_drop("peer disconnected");
+        return;
+    }
+    if (got > 0) {
+        recv_len += (size_t)got;
+    }
+
+    size_t pos = 0;
+    while (recv_len - pos >= NETPLAY_PACKET) {
+        const uint8_t *p = recv_buf + pos;
+        uint32_t f = p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24;
+        uint16_t mask = p[4] | (uint16_t)p[5] << 8;
+        pos += NETPLAY_PACKET;
+
+        uint16_t predicted = history_remote[f % NETPLAY_HISTORY];
+        history_remote[f % NETPLAY_HISTORY] = mask;
+        last_remote = mask;
+        confirmed = f + 1;
+        if (f < frame && mask != predicted) {
+            netplay_rollback(state, f);
+            if (!netplay_active) {
+                return;
+            }
+        }
+    }
+    memmove(recv_buf, recv_buf + pos, recv_len - pos);
+    recv_len -= pos;
+}
+
+static void netplay_simulate(chip8_state_t *state) {
+    uint16_t local = atomic_load_explicit(&state->keypad, memory_order_relaxed)
+                   & local_half;
+    uint16_t remote = frame < confirmed ? history_remote[frame % NETPLAY_HISTORY]
+                                        : last_remote;
+    history_local[frame % NETPLAY_HISTORY] = local;
+    history_remote[frame % NETPLAY_HISTORY] = remote;
+    chip8_rewind_capture(rollback_ring, state);
+
+    uint8_t packet[NETPLAY_PACKET] = {
+        frame & 0xFF, (frame >> 8) & 0xFF, (frame >> 16) & 0xFF, (frame >> 24) & 0xFF,
+        local & 0xFF, local >> 8
+    };
+    if (!netplay_send(packet, sizeof(packet))) {
+        netplay_drop("send failed");
+        return;
+    }
+
+    netplay_run_frame(state, local, remote);
+    frame++;
+}
+
+void netplay_tick(chip8_state_t *state) {
+    if (!netplay_active) {
+        return;
+    }
+    netplay_poll(state);
+    if (!netplay_active) {
+        return;
+    }
+
+    uint64_t now = telemetry_now_ns();
+    if (next_frame_ns == 0) {
+        next_frame_ns = now;
+    }
+    if (now < next_frame_ns) {
+        // Sleep in short slices so the main loop keeps draining events
+        uint64_t wait = next_frame_ns - now;
+        SDL_DelayNS(wait > 1000000 ? 1000000 : wait);
+        return;
+    }
+
+    // Lockstep throttle: never outrun confirmations past what the ring
+    // can roll back; a stalled peer pauses us instead of desyncing
+    if (frame >= confirmed + NETPLAY_HISTORY - 2) {
+        next_frame_ns = now;
+        return;
+    }
+
+    netplay_simulate(state);
+    next_frame_ns += NETPLAY_FRAME_NS;
+    if (now > next_frame_ns + 8 * NETPLAY_FRAME_NS) {
+        next_frame_ns = now; // Fell far behind (debugger, suspend): rebase
+    }
+}
+
+/* Handshake, both directions: "C8NP" + version u8 + rom hash u64 LE.
+   The host then sends its rng state u32 and ips u32, which the guest
+   adopts, so both sides start the same deterministic run. */
+static bool netplay_handshake(chip8_state_t *state, bool is_host) {
+    uint8_t hello[13];
+    memcpy(hello, "C8NP", 4);
+    hello[4] = NETPLAY_VERSION;
+    for (int i = 0; i < 8; i++) {
+        hello[5 + i] = (state->rom_hash >> (8 * i)) & 0xFF;
+    }
+    if (!netplay_send(hello, sizeof(hello))) {
+        return false;
+    }
+
+    uint8_t peer[13];
+    if (!netplay_recv_exact(peer, sizeof(peer))) {
+        return false;
+    }
+    if (memcmp(peer, "C8NP", 4) != 0 || peer[4] != NETPLAY_VERSION) {
+        SDL_Log("Netplay handshake mismatch");
+        return false;
+    }
+    if (memcmp(peer + 5, hello + 5, 8) != 0) {
+        SDL_Log("Netplay peers are running different ROMs");
+        return false;
+    }
+
+    uint8_t sync[8];
+    if (is_host) {
+        for (int i = 0; i < 4; i++) {
+            sync[i] = (state->rng_state >> (8 * i)) & 0xFF;
+            sync[4 + i] = (state->ips >> (8 * i)) & 0xFF;
+        }
+        return netplay_send(sync, sizeof(sync));
+    }
+    if (!netplay_recv_exact(sync, sizeof(sync))) {
+        return false;
+    }
+    uint32_t seed = 0, ips = 0;
+    for (int i = 0; i < 4; i++) {
+        seed |= (uint32_t)sync[i] << (8 * i);
+        ips |= (uint32_t)sync[4 + i] << (8 * i);
+    }
+    state->rng_state = seed != 0 ? seed : 1;
+    state->ips = ips;
+    return true;
+}
+
+bool netplay_start(chip8_state_t *state, const char *host, unsigned short port) {
+    bool is_host = host == NULL;
+
+    if (is_host) {
+        int listen_fd = socket(AF_INET, SOCK_STREAM, 0);
+        if (listen_fd < 0) {
+            SDL_Log("Netplay socket failed");
+            return false;
+        }
+        int reuse = 1;
+        setsockopt(listen_fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+        struct sockaddr_in addr;
+        memset(&addr, 0, sizeof(addr));
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_ANY);
+        addr.sin_port = htons(port);
+        if (bind(listen_fd, (struct sockaddr *)&addr, sizeof(addr)) < 0 ||
+            listen(listen_fd, 1) < 0) {
+            SDL_Log("Netplay bind failed on port %u", port);
+            close(listen_fd);
+            return false;
+        }
+        SDL_Log("Waiting for a netplay peer on port %u", port);
+        peer_fd = accept(listen_fd, NULL, NULL);
+        close(listen_fd);
+        if (peer_fd < 0) {
+            return false;
+        }
+    } else {
+        peer_fd = socket(AF_INET, SOCK_STREAM, 0);
+        struct sockaddr_in addr;
+        memset(&addr, 0, sizeof(addr));
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(port);
+        if (inet_pton(AF_INET, host, &addr.sin_addr) != 1) {
+            SDL_Log("Bad netplay address: %s", host);
+            close(peer_fd);
+            peer_fd = -1;
+            return false;
+        }
+        if (peer_fd < 0 || connect(peer_fd, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+            SDL_Log("Couldn't reach netplay host %s:%u", host, port);
+            close(peer_fd);
+            peer_fd = -1;
+            return false;
+        }
+    }
+
+    int nodelay = 1;
+    setsockopt(peer_fd, IPPROTO_TCP, TCP_NODELAY, &nodelay, sizeof(nodelay));
+
+    if (!netplay_handshake(state, is_host)) {
+        close(peer_fd);
+        peer_fd = -1;
+        return false;
+    }
+    fcntl(peer_fd, F_SETFL, O_NONBLOCK); // Handshake was the last blocking I/O
+
+    rollback_ring = chip8_rewind_create(0);
+    if (rollback_ring == NULL) {
+        close(peer_fd);
+        peer_fd = -1;
+        return false;
+    }
+
+    local_half = is_host ? NETPLAY_HOST_HALF : (uint16_t)~NETPLAY_HOST_HALF;
+    frame = 0;
+    confirmed = 0;
+    last_remote = 0;
+    next_frame_ns = 0;
+    recv_len = 0;
+    netplay_active = true;
+    SDL_Log("Netplay session up (%s, keys %s)", is_host ? "host" : "guest",
+            is_host ? "0-7" : "8-F");
+    return true;
+}
+
+void netplay_stop(void) {
+    if (peer_fd >= 0) {
+        close(peer_fd);
+        peer_fd = -1;
+    }
+    chip8_rewind_destroy(rollback_ring);
+    rollback_ring = NULL;
+    netplay_active = false;
+}
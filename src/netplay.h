@@ -0,0 +1,35 @@
+#ifndef NETPLAY_H
+#define NETPLAY_H
+
+#include <stdbool.h>
+
+#include "chip8.h"
+
+/**
+ * Chip-8 Netplay
+ *
+ * Two-player lockstep with rollback over TCP. Each side owns half the
+ * keypad (host keys 0-7, guest keys 8-F) and exchanges its half's
+ * bitmask once per 60Hz simulation frame. Frames run immediately with
+ * the remote half predicted as its last known value; when a confirmed
+ * mask contradicts a prediction, the session rolls back through the
+ * delta-compressed rewind ring and re-simulates with the corrected
+ * input. The virtual frame loop keeps both sides instruction-identical,
+ * so only inputs ever cross the wire.
+ */
+
+extern bool netplay_active;
+
+// Connects to `host` (or listens for a peer when host is NULL) on
+// `port` and handshakes: the host's rng state and ips win, and
+// mismatched ROM hashes refuse the session. Blocks until the peer
+// arrives.
+bool netplay_start(chip8_state_t *state, const char *host, unsigned short port);
+
+// Replaces chip8_tick while a session is active: paces 60Hz frames,
+// exchanges inputs, and rolls back on mispredictions
+void netplay_tick(chip8_state_t *state);
+
+void netplay_stop(void);
+
+#endif // NETPLAY_H
@@ -0,0 +1,114 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <SDL3/SDL.h>
+
+#include "patch.h"
+
+// An IPS file can't usefully exceed the 3.5KB ROM space it patches by
+// much; anything bigger than this is rejected as not ours
+#define PATCH_MAX_BYTES 65536
+
+/* IPS, big-endian throughout: "PATCH", then records of [offset u24]
+   [size u16][size bytes], where size 0 means an RLE record of
+   [count u16][value u8] instead, until the offset slot reads "EOF".
+   Offsets are relative to the start of the ROM image. */
+
+#define PATCH_EOF 0x454F46 // "EOF" read as a 24-bit offset
+
+static uint32_t patch_u24(const uint8_t *p) {
+    return ((uint32_t)p[0] << 16) | ((uint32_t)p[1] << 8) | p[2];
+}
+
+static uint32_t patch_u16(const uint8_t *p) {
+    return ((uint32_t)p[0] << 8) | p[1];
+}
+
+/* One walk over the records, shared by both passes: validating with
+   apply == NULL, then writing. Returns the image extent the records
+   reach, or 0 on a malformed or out-of-bounds patch. */
+static size_t patch_walk(const uint8_t *ips, size_t ips_size, size_t capacity,
+                         uint8_t *apply) {
+    size_t pos = 5; // Past the magic
+    size_t extent = 0;
+
+    while (pos + 3 <= ips_size) {
+        uint32_t offset = patch_u24(&ips[pos]);
+        pos += 3;
+        if (offset == PATCH_EOF) {
+            return extent;
+        }
+        if (pos + 2 > ips_size) {
+            return 0;
+        }
+        uint32_t len = patch_u16(&ips[pos]);
+        pos += 2;
+
+        if (len != 0) {
+            if (pos + len > ips_size || offset + len > capacity) {
+                return 0;
+            }
+            if (apply != NULL) {
+                memcpy(apply + offset, &ips[pos], len);
+            }
+            pos += len;
+        } else {
+            // RLE record: a repeat count and one fill byte
+            if (pos + 3 > ips_size) {
+                return 0;
+            }
+            len = patch_u16(&ips[pos]);
+            if (len == 0 || offset + len > capacity) {
+                return 0;
+            }
+            if (apply != NULL) {
+                memset(apply + offset, ips[pos + 2], len);
+            }
+            pos += 3;
+        }
+        if (offset + len > extent) {
+            extent = offset + len;
+        }
+    }
+    return 0; // Ran off the end without an EOF record
+}
+
+size_t patch_apply(const char *rom_path, uint8_t *data, size_t size, size_t capacity) {
+    char path[1024];
+    if ((size_t)snprintf(path, sizeof(path), "%s.ips", rom_path) >= sizeof(path)) {
+        return size;
+    }
+    FILE *fptr = fopen(path, "rb");
+    if (fptr == NULL) {
+        return size; // No sidecar: the common case, not an error
+    }
+
+    static uint8_t ips[PATCH_MAX_BYTES];
+    size_t ips_size = fread(ips, 1, sizeof(ips), fptr);
+    bool oversize = fgetc(fptr) != EOF;
+    fclose(fptr);
+
+    if (oversize || ips_size < 8 || memcmp(ips, "PATCH", 5) != 0) {
+        SDL_Log("Ignoring malformed patch file: %s", path);
+        return size;
+    }
+
+    // Validate every record before touching the image, so a truncated
+    // patch never leaves it half-applied
+    size_t extent = patch_walk(ips, ips_size, capacity, NULL);
+    if (extent == 0) {
+        SDL_Log("Ignoring malformed patch file: %s", path);
+        return size;
+    }
+
+    if (extent > size) {
+        // Records past the base image extend it; zero the gap first so
+        // anything between the old end and the new records is defined
+        memset(data + size, 0, extent - size);
+        size = extent;
+    }
+    patch_walk(ips, ips_size, capacity, data);
+    SDL_Log("Applied patch %s (%zu bytes)", path, ips_size);
+    return size;
+}
@@ -0,0 +1,26 @@
+#ifndef PATCH_H
+#define PATCH_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Load-Time ROM Patching
+ *
+ * Applies an IPS sidecar (<rom>.ips, the standard "PATCH" format with
+ * data and RLE records) to the staged ROM image before it reaches
+ * interpreter memory. Bug fixes and difficulty trainers ship as small
+ * patch files against one base ROM instead of duplicate .ch8 images, and
+ * because patching happens before the content hash is taken, per-ROM
+ * config keys on the patched image — a trainer can carry its own quirk
+ * profile. The patch is validated in full before a byte is written, so a
+ * truncated or malformed file leaves the base image untouched.
+ */
+
+// Applies <rom_path>.ips to the size-byte image at data if the sidecar
+// exists. capacity bounds writes (IPS records may extend the image).
+// Returns the image size after patching; size unchanged when there is no
+// sidecar or it is rejected.
+size_t patch_apply(const char *rom_path, uint8_t *data, size_t size, size_t capacity);
+
+#endif // PATCH_H
@@ -0,0 +1,150 @@
+#include <stdint.h>
+#include <string.h>
+#include <SDL3/SDL.h>
+
+#include "perfcount.h"
+
+bool perfcount_enabled;
+
+#ifdef __linux__
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#define PERFCOUNT_EVENTS 4
+
+// Group read layout with PERF_FORMAT_GROUP: nr, then one value per
+// event in the order they were opened
+struct perfcount_read {
+    uint64_t nr;
+    uint64_t values[PERFCOUNT_EVENTS];
+};
+
+static const uint64_t event_configs[PERFCOUNT_EVENTS] = {
+    PERF_COUNT_HW_CPU_CYCLES,
+    PERF_COUNT_HW_INSTRUCTIONS,
+    PERF_COUNT_HW_BRANCH_MISSES,
+    PERF_COUNT_HW_CACHE_MISSES,
+};
+
+// Per-thread group: the leader fd is what gets reset/armed/read; the
+// members ride along via PERF_FORMAT_GROUP
+static __thread int group_fds[PERFCOUNT_EVENTS] = {-1, -1, -1, -1};
+
+// Phase totals. Each phase is bracketed by exactly one thread, so these
+// are single-writer u64s — monitoring-grade, same convention as the
+// telemetry counters.
+static uint64_t phase_totals[PERF_PHASE_COUNT][PERFCOUNT_EVENTS];
+static uint64_t phase_quanta[PERF_PHASE_COUNT];
+
+static bool perfcount_open_group(void) {
+    for (int i = 0; i < PERFCOUNT_EVENTS; i++) {
+        struct perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        attr.config = event_configs[i];
+        attr.disabled = i == 0; // The leader arms the whole group
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_GROUP;
+
+        int fd = (int)syscall(SYS_perf_event_open, &attr, 0, -1,
+                              i == 0 ? -1 : group_fds[0], 0);
+        if (fd < 0) {
+            for (int j = 0; j < i; j++) {
+                close(group_fds[j]);
+                group_fds[j] = -1;
+            }
+            return false;
+        }
+        group_fds[i] = fd;
+    }
+    return true;
+}
+
+bool perfcount_start(void) {
+    if (!perfcount_open_group()) {
+        SDL_Log("perf_event_open failed (perf_event_paranoid too high?); "
+                "hardware counters disabled");
+        return false;
+    }
+    perfcount_enabled = true;
+    SDL_Log("Hardware counters armed (cycles, instructions, "
+            "branch misses, cache misses)");
+    return true;
+}
+
+void perfcount_thread_open(void) {
+    if (perfcount_enabled && !perfcount_open_group()) {
+        SDL_Log("perf_event_open failed on worker thread; "
+                "its phase goes uncounted");
+    }
+}
+
+void perfcount_begin(void) {
+    if (group_fds[0] < 0) {
+        return;
+    }
+    ioctl(group_fds[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(group_fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+}
+
+void perfcount_end(perf_phase_t phase) {
+    if (group_fds[0] < 0) {
+        return;
+    }
+    ioctl(group_fds[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+    struct perfcount_read sample;
+    if (read(group_fds[0], &sample, sizeof(sample)) != sizeof(sample) ||
+        sample.nr != PERFCOUNT_EVENTS) {
+        return;
+    }
+    for (int i = 0; i < PERFCOUNT_EVENTS; i++) {
+        phase_totals[phase][i] += sample.values[i];
+    }
+    phase_quanta[phase]++;
+}
+
+void perfcount_report(void) {
+    if (!perfcount_enabled) {
+        return;
+    }
+
+    static const char *const phase_names[PERF_PHASE_COUNT] = {
+        "emulation", "render",
+    };
+    SDL_Log("Hardware counters:");
+    for (int phase = 0; phase < PERF_PHASE_COUNT; phase++) {
+        const uint64_t *totals = phase_totals[phase];
+        if (phase_quanta[phase] == 0) {
+            continue;
+        }
+        double kinstr = totals[1] != 0 ? totals[1] / 1000.0 : 1.0;
+        SDL_Log("  %-9s %12llu cycles %12llu instr  IPC %.2f  "
+                "%.2f br-miss/ki  %.2f $-miss/ki  (%llu quanta)",
+                phase_names[phase],
+                (unsigned long long)totals[0],
+                (unsigned long long)totals[1],
+                totals[0] != 0 ? (double)totals[1] / totals[0] : 0.0,
+                totals[2] / kinstr, totals[3] / kinstr,
+                (unsigned long long)phase_quanta[phase]);
+    }
+}
+
+#else // !__linux__
+
+bool perfcount_start(void) {
+    SDL_Log("Hardware counters need perf_event_open; not on this platform");
+    return false;
+}
+
+void perfcount_thread_open(void) {}
+void perfcount_begin(void) {}
+void perfcount_end(perf_phase_t phase) { (void)phase; }
+void perfcount_report(void) {}
+
+#endif // __linux__
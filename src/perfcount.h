@@ -0,0 +1,47 @@
+#ifndef PERFCOUNT_H
+#define PERFCOUNT_H
+
+#include <stdbool.h>
+
+/**
+ * Hardware Performance Counters (--perf)
+ *
+ * Software timing answers "how long", not "why": at nanosecond scales
+ * the clock read itself distorts the answer, and a claim like "the
+ * dispatch table cut branch misses" needs the miss counter, not a
+ * stopwatch. This layer opens a perf_event group per thread — cycles,
+ * instructions, branch misses, cache misses, read together so the four
+ * always cover the same interval — and brackets the two phases that
+ * matter: the emulation quantum on the main thread and the frame
+ * composition on the render thread. Totals per phase are dumped with
+ * the rest of the telemetry at shutdown as IPC and misses per thousand
+ * instructions.
+ *
+ * Linux only (perf_event_open); elsewhere --perf logs and disables
+ * itself. Bracketing costs two ioctls and a read per phase per quantum,
+ * which is why the whole layer is opt-in.
+ */
+
+typedef enum perf_phase {
+    PERF_PHASE_EMULATION = 0, // The tick: dispatch, handlers, timers
+    PERF_PHASE_RENDER,        // Expand, compose, present
+    PERF_PHASE_COUNT
+} perf_phase_t;
+
+extern bool perfcount_enabled;
+
+// Enables the layer and opens the calling (emulation) thread's group
+bool perfcount_start(void);
+
+// Opens a group for an additional thread (the render thread calls this
+// once at startup); counters attribute to whichever phase it brackets
+void perfcount_thread_open(void);
+
+// Phase bracket around one quantum's worth of work on the current
+// thread. Begin resets and arms the group, end reads and accumulates.
+void perfcount_begin(void);
+void perfcount_end(perf_phase_t phase);
+
+void perfcount_report(void);
+
+#endif // PERFCOUNT_H
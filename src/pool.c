@@ -0,0 +1,58 @@
+#include <string.h>
+#include <SDL3/SDL.h>
+
+#include "chip8.h"
+#include "pool.h"
+
+// Slabs are rounded up to whole cache lines so neighboring sessions never
+// share a line, even when the struct size isn't a multiple of 64
+#define POOL_LINE 64
+#define POOL_SLAB ((sizeof(chip8_state_t) + POOL_LINE - 1) / POOL_LINE * POOL_LINE)
+
+static uint8_t *pool_slabs;
+static int *pool_free_list; // LIFO stack of free slab indices
+static int pool_free_count;
+
+bool pool_init(int capacity) {
+    pool_slabs = SDL_aligned_alloc(POOL_LINE, (size_t)capacity * POOL_SLAB);
+    pool_free_list = SDL_malloc(capacity * sizeof(int));
+    if (pool_slabs == NULL || pool_free_list == NULL) {
+        SDL_Log("Couldn't reserve session pool for %d sessions", capacity);
+        pool_shutdown();
+        return false;
+    }
+
+    // Fill the stack in reverse so the first acquires come out in address
+    // order, keeping early sessions contiguous
+    for (int i = 0; i < capacity; i++) {
+        pool_free_list[i] = capacity - 1 - i;
+    }
+    pool_free_count = capacity;
+    return true;
+}
+
+chip8_state_t *pool_acquire(void) {
+    if (pool_free_count == 0) {
+        return NULL;
+    }
+    int slot = pool_free_list[--pool_free_count];
+    uint8_t *slab = pool_slabs + (size_t)slot * POOL_SLAB;
+    memset(slab, 0, POOL_SLAB);
+    return (chip8_state_t *)slab;
+}
+
+void pool_release(chip8_state_t *state) {
+    if (state == NULL) {
+        return;
+    }
+    int slot = (int)(((uint8_t *)state - pool_slabs) / POOL_SLAB);
+    pool_free_list[pool_free_count++] = slot;
+}
+
+void pool_shutdown(void) {
+    SDL_aligned_free(pool_slabs);
+    SDL_free(pool_free_list);
+    pool_slabs = NULL;
+    pool_free_list = NULL;
+    pool_free_count = 0;
+}
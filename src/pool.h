@@ -0,0 +1,31 @@
+#ifndef POOL_H
+#define POOL_H
+
+#include <stdbool.h>
+
+#include "chip8.h"
+
+/**
+ * Session State Pool
+ *
+ * Fixed pool of cache-line-aligned chip8_state_t slabs for the
+ * multi-session modes. All memory is reserved once at init; acquire and
+ * release are O(1) free-list pops and pushes, so session churn never
+ * calls malloc, never fragments the heap, and never injects allocator
+ * latency into a neighboring session's tick.
+ */
+
+// Reserves capacity slabs. Returns false (and logs) if the allocation
+// fails; the pool is single-threaded like the session lifecycle it backs.
+bool pool_init(int capacity);
+
+// Returns a zeroed, 64-byte-aligned state, or NULL when the pool is
+// exhausted. The caller still runs chip8_init on it.
+chip8_state_t *pool_acquire(void);
+
+// Returns a slab to the free list. NULL is a no-op.
+void pool_release(chip8_state_t *state);
+
+void pool_shutdown(void);
+
+#endif // POOL_H
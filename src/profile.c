@@ -0,0 +1,76 @@
+#include <stdint.h>
+#include <string.h>
+#include <SDL3/SDL.h>
+
+#include "chip8.h"
+#include "disasm.h"
+#include "profile.h"
+
+// Every Nth profile_sample call lands in the histogram. Dispatch sites
+// fire once per block, so the effective rate is one sample per
+// PROFILE_INTERVAL blocks — cheap enough to leave on for a whole session.
+#define PROFILE_INTERVAL 64
+#define PROFILE_TOP 16
+
+bool profile_enabled;
+
+static uint32_t histogram[CHIP8_MEMORY_BYTES];
+static uint32_t decimate;
+static uint64_t total_samples;
+
+void profile_start(void) {
+    memset(histogram, 0, sizeof(histogram));
+    decimate = 0;
+    total_samples = 0;
+    profile_enabled = true;
+    SDL_Log("PC profiler armed (1/%d block sampling)", PROFILE_INTERVAL);
+}
+
+void profile_sample(uint16_t pc) {
+    if (++decimate < PROFILE_INTERVAL) {
+        return;
+    }
+    decimate = 0;
+    histogram[pc & CHIP8_ADDR_MASK]++;
+    total_samples++;
+}
+
+void profile_report(const chip8_state_t *state) {
+    if (!profile_enabled || total_samples == 0) {
+        return;
+    }
+
+    SDL_Log("PC profile: %llu samples, hottest addresses:",
+            (unsigned long long)total_samples);
+
+    // Repeated selection over the per-address buckets, (count, address) ordered so
+    // ties survive; report sizes don't justify a sort
+    uint32_t floor_count = UINT32_MAX;
+    int floor_addr = -1;
+    for (int rank = 0; rank < PROFILE_TOP; rank++) {
+        uint32_t best = 0;
+        int best_addr = -1;
+        for (int addr = 0; addr < CHIP8_MEMORY_BYTES; addr++) {
+            uint32_t count = histogram[addr];
+            if (count == 0 || count > floor_count ||
+                (count == floor_count && addr <= floor_addr)) {
+                continue;
+            }
+            if (count > best) {
+                best = count;
+                best_addr = addr;
+            }
+        }
+        if (best_addr < 0 || best * 1000 < total_samples) {
+            break; // Below 0.1%: noise
+        }
+        floor_count = best;
+        floor_addr = best_addr;
+
+        char text[32];
+        uint16_t op = (state->memory[best_addr] << 8) | state->memory[(best_addr + 1) & CHIP8_ADDR_MASK];
+        disasm_format(op, text, sizeof(text));
+        SDL_Log("  %03X: %5.1f%% (%u)  %s", best_addr,
+                100.0 * best / total_samples, best, text);
+    }
+}
@@ -0,0 +1,27 @@
+#ifndef PROFILE_H
+#define PROFILE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "chip8.h"
+
+/**
+ * PC-Histogram Profiler
+ *
+ * Samples the program counter into a 4096-bucket histogram on every Nth
+ * block dispatch and reports the hottest addresses with their
+ * disassembly on exit — enough to tell a delay loop from real work.
+ * Decimated sampling keeps overhead under 1%; disabled, the only cost is
+ * one predicted branch per block.
+ */
+
+extern bool profile_enabled;
+
+void profile_start(void);
+void profile_sample(uint16_t pc);
+
+// Logs the hottest buckets with counts, share, and disassembled opcodes
+void profile_report(const chip8_state_t *state);
+
+#endif // PROFILE_H
@@ -0,0 +1,170 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <SDL3/SDL.h>
+
+#include "rawinput.h"
+#include "input.h"
+#include "latency.h"
+#include "telemetry.h"
+
+bool rawinput_active;
+
+#ifdef __linux__
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sys/ioctl.h>
+#include <linux/input.h>
+
+// Linux keycode -> keypad digit, the evdev mirror of the SDL scancode
+// LUT in input.c (same physical 4x4 block: 1234/QWER/ASDF/ZXCV)
+static uint8_t keycode_to_key[256];
+
+static void build_raw_lut(void) {
+    static const uint16_t codes[] = {
+        KEY_1, KEY_2, KEY_3, KEY_4,
+        KEY_Q, KEY_W, KEY_E, KEY_R,
+        KEY_A, KEY_S, KEY_D, KEY_F,
+        KEY_Z, KEY_X, KEY_C, KEY_V,
+    };
+    static const uint8_t key_map[] = {
+        0x1, 0x2, 0x3, 0xC,
+        0x4, 0x5, 0x6, 0xD,
+        0x7, 0x8, 0x9, 0xE,
+        0xA, 0x0, 0xB, 0xF,
+    };
+    memset(keycode_to_key, 0xFF, sizeof(keycode_to_key));
+    for (size_t i = 0; i < sizeof(codes) / sizeof(codes[0]); i++) {
+        keycode_to_key[codes[i]] = key_map[i];
+    }
+}
+
+static int raw_fd = -1;
+static pthread_t reader;
+static volatile bool reader_quit;
+static chip8_state_t *raw_state;
+static SDL_AtomicInt raw_activity;
+
+// A device qualifies as the cabinet keyboard when it reports EV_KEY
+// with the letter block present (rules out mice and power buttons)
+static bool raw_device_is_keyboard(int fd) {
+    uint8_t bits[KEY_MAX / 8 + 1];
+    memset(bits, 0, sizeof(bits));
+    if (ioctl(fd, EVIOCGBIT(EV_KEY, sizeof(bits)), bits) < 0) {
+        return false;
+    }
+    return ((bits[KEY_Q / 8] >> (KEY_Q % 8)) & 1) != 0 &&
+           ((bits[KEY_1 / 8] >> (KEY_1 % 8)) & 1) != 0;
+}
+
+static int raw_open_scan(void) {
+    for (int i = 0; i < 32; i++) {
+        char path[32];
+        SDL_snprintf(path, sizeof(path), "/dev/input/event%d", i);
+        int fd = open(path, O_RDONLY | O_NONBLOCK);
+        if (fd < 0) {
+            continue;
+        }
+        if (raw_device_is_keyboard(fd)) {
+            SDL_Log("Raw input reading %s", path);
+            return fd;
+        }
+        close(fd);
+    }
+    return -1;
+}
+
+// Blocking poll/read loop on its own thread; each accepted edge flips
+// the keypad bit directly and pokes the SDL queue so an idle-parked
+// emulation thread wakes for FX0A
+static void *raw_reader_main(void *arg) {
+    (void)arg;
+    struct input_event events[16];
+    while (!reader_quit) {
+        struct pollfd pfd = {.fd = raw_fd, .events = POLLIN};
+        if (poll(&pfd, 1, 500) <= 0) {
+            continue;
+        }
+        ssize_t got = read(raw_fd, events, sizeof(events));
+        if (got <= 0) {
+            continue;
+        }
+        for (int i = 0; i < (int)(got / sizeof(events[0])); i++) {
+            if (events[i].type != EV_KEY || events[i].value > 1 ||
+                events[i].code >= sizeof(keycode_to_key)) {
+                continue; // value 2 is autorepeat, not an edge
+            }
+            uint8_t key = keycode_to_key[events[i].code];
+            if (key == 0xFF) {
+                continue;
+            }
+            bool down = events[i].value == 1;
+            if (input_debounce_reject(key, down, telemetry_now_ns())) {
+                continue;
+            }
+            if (latency_enabled && down) {
+                latency_key_event();
+            }
+            chip8_key_set(raw_state, key, down);
+            SDL_SetAtomicInt(&raw_activity, 1);
+
+            SDL_Event wake;
+            SDL_zero(wake);
+            wake.type = SDL_EVENT_USER;
+            SDL_PushEvent(&wake); // Unblocks SDL_WaitEventTimeout
+        }
+    }
+    return NULL;
+}
+
+bool rawinput_start(chip8_state_t *state, const char *device) {
+    build_raw_lut();
+    raw_fd = device != NULL ? open(device, O_RDONLY | O_NONBLOCK) : raw_open_scan();
+    if (raw_fd < 0) {
+        SDL_Log("No evdev keyboard available%s%s; staying on the SDL path",
+                device != NULL ? ": " : "", device != NULL ? device : "");
+        return false;
+    }
+    if (device != NULL) {
+        SDL_Log("Raw input reading %s", device);
+    }
+
+    raw_state = state;
+    reader_quit = false;
+    rawinput_active = true;
+    pthread_create(&reader, NULL, raw_reader_main, NULL);
+    return true;
+}
+
+bool rawinput_pending(void) {
+    return SDL_CompareAndSwapAtomicInt(&raw_activity, 1, 0);
+}
+
+void rawinput_stop(void) {
+    if (!rawinput_active) {
+        return;
+    }
+    reader_quit = true;
+    pthread_join(reader, NULL);
+    close(raw_fd);
+    raw_fd = -1;
+    rawinput_active = false;
+}
+
+#else // !__linux__
+
+bool rawinput_start(chip8_state_t *state, const char *device) {
+    (void)state;
+    (void)device;
+    SDL_Log("Raw input needs evdev; staying on the SDL path");
+    return false;
+}
+
+bool rawinput_pending(void) { return false; }
+void rawinput_stop(void) {}
+
+#endif // __linux__
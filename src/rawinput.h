@@ -0,0 +1,39 @@
+#ifndef RAWINPUT_H
+#define RAWINPUT_H
+
+#include <stdbool.h>
+
+#include "chip8.h"
+
+/**
+ * Raw Keyboard Backend (--raw-input)
+ *
+ * SDL key events on the X11 kiosks traverse the whole desktop input
+ * stack — evdev, the server, the compositor, the event queue — adding
+ * several milliseconds before handle_key_event sees the press. On a
+ * dedicated cabinet this backend reads the evdev device directly from
+ * its own thread and flips the keypad bit the moment the kernel reports
+ * the edge, feeding the same keypad mapping, debounce, and latency
+ * instrumentation as the SDL path. While active it owns the keyboard:
+ * the SDL copies of the same keystrokes are ignored so a press can't
+ * double-fire. Hotkeys (F1..F12, Tab, Space) still ride the SDL path.
+ *
+ * Linux only (evdev); elsewhere --raw-input logs and stays on SDL.
+ * Prove the gain with --latency on input.ch8: compare the key-to-skip
+ * stage distribution against an SDL-path run.
+ */
+
+extern bool rawinput_active;
+
+// Opens the evdev device (NULL scans /dev/input/event* for a keyboard)
+// and starts the reader thread. Failure logs and leaves the SDL path
+// in charge.
+bool rawinput_start(chip8_state_t *state, const char *device);
+
+// Emulation thread: true once per batch of raw key activity since the
+// last call, so the main loop can clear the idle park for FX0A
+bool rawinput_pending(void);
+
+void rawinput_stop(void);
+
+#endif // RAWINPUT_H
@@ -0,0 +1,230 @@
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <SDL3/SDL.h>
+
+#include "renderprobe.h"
+#include "telemetry.h"
+
+#define RENDERPROBE_FILE "chip8_render.cfg"
+
+// Swapchains settle over the first few presents; they are excluded from
+// the timed window
+#define PROBE_WARMUP 30
+#define PROBE_FRAMES 180
+
+bool renderprobe_use_update;
+
+enum { STRATEGY_LOCK, STRATEGY_UPDATE, STRATEGY_FILLRECT, STRATEGY_COUNT };
+static const char *strategy_names[STRATEGY_COUNT] = {"lock", "update", "fillrect"};
+
+// ~Half-lit 64x32 frames, different every iteration so no driver can
+// recognize a repeated upload and skip the work being measured
+static uint32_t pattern_state = 0x2545F491;
+
+static uint32_t pattern_next(void) {
+    pattern_state ^= pattern_state << 13;
+    pattern_state ^= pattern_state >> 17;
+    pattern_state ^= pattern_state << 5;
+    return pattern_state;
+}
+
+static void pattern_fill(uint32_t *pixels, int pitch_px) {
+    for (int y = 0; y < 32; y++) {
+        for (int x = 0; x < 64; x++) {
+            pixels[y * pitch_px + x] = (pattern_next() & 1) ? 0xFFFFFFFF : 0xFF000000;
+        }
+    }
+}
+
+// One timed run of a strategy: PROBE_FRAMES full-frame uploads, each
+// followed by a scaled draw and a present — the same shape the render
+// thread produces per vblank. Returns total ns, 0 when the strategy
+// can't run on this renderer.
+static uint64_t probe_strategy(SDL_Renderer *probe_renderer, int strategy) {
+    SDL_Texture *tex = NULL;
+    if (strategy != STRATEGY_FILLRECT) {
+        tex = SDL_CreateTexture(probe_renderer, SDL_PIXELFORMAT_ARGB8888,
+                                strategy == STRATEGY_LOCK ? SDL_TEXTUREACCESS_STREAMING
+                                                          : SDL_TEXTUREACCESS_STATIC,
+                                64, 32);
+        if (tex == NULL) {
+            return 0;
+        }
+        SDL_SetTextureScaleMode(tex, SDL_SCALEMODE_NEAREST);
+    }
+
+    static uint32_t staging[64 * 32];
+    static SDL_FRect rects[64 * 32];
+    uint64_t start = 0;
+    for (int frame = -PROBE_WARMUP; frame < PROBE_FRAMES; frame++) {
+        if (frame == 0) {
+            start = telemetry_now_ns();
+        }
+        if (strategy == STRATEGY_LOCK) {
+            void *pixels;
+            int pitch;
+            if (!SDL_LockTexture(tex, NULL, &pixels, &pitch)) {
+                SDL_DestroyTexture(tex);
+                return 0;
+            }
+            pattern_fill(pixels, pitch / 4);
+            SDL_UnlockTexture(tex);
+        } else if (strategy == STRATEGY_UPDATE) {
+            pattern_fill(staging, 64);
+            SDL_UpdateTexture(tex, NULL, staging, 64 * 4);
+        }
+        SDL_SetRenderDrawColor(probe_renderer, 0, 0, 0, 255);
+        SDL_RenderClear(probe_renderer);
+        if (strategy == STRATEGY_FILLRECT) {
+            // One rect per lit pixel at 10x scale, batched into a single
+            // FillRects call — the naive frontend everyone writes first
+            int count = 0;
+            for (int y = 0; y < 32; y++) {
+                for (int x = 0; x < 64; x++) {
+                    if (pattern_next() & 1) {
+                        rects[count++] = (SDL_FRect){x * 10.0f, y * 10.0f, 10.0f, 10.0f};
+                    }
+                }
+            }
+            SDL_SetRenderDrawColor(probe_renderer, 255, 255, 255, 255);
+            SDL_RenderFillRects(probe_renderer, rects, count);
+        } else {
+            SDL_RenderTexture(probe_renderer, tex, NULL, NULL);
+        }
+        SDL_RenderPresent(probe_renderer);
+    }
+    uint64_t elapsed = telemetry_now_ns() - start;
+    if (tex != NULL) {
+        SDL_DestroyTexture(tex);
+    }
+    return elapsed;
+}
+
+// Benchmarks every render driver through a hidden window (vsync off, so
+// the measurement sees the work, not the refresh rate) and leaves the
+// fastest texture strategy in best_driver/best_strategy
+static bool renderprobe_measure(char *best_driver, size_t driver_cap, int *best_strategy) {
+    uint64_t best_ns = 0;
+    best_driver[0] = '\0';
+    *best_strategy = STRATEGY_LOCK;
+    for (int d = 0; d < SDL_GetNumRenderDrivers(); d++) {
+        const char *name = SDL_GetRenderDriver(d);
+        SDL_Window *win = SDL_CreateWindow("chip8 render probe", 640, 320, SDL_WINDOW_HIDDEN);
+        if (win == NULL) {
+            continue;
+        }
+        SDL_Renderer *probe_renderer = SDL_CreateRenderer(win, name);
+        if (probe_renderer == NULL) {
+            SDL_Log("  %-10s unavailable: %s", name, SDL_GetError());
+            SDL_DestroyWindow(win);
+            continue;
+        }
+        uint64_t ns[STRATEGY_COUNT];
+        for (int s = 0; s < STRATEGY_COUNT; s++) {
+            ns[s] = probe_strategy(probe_renderer, s);
+        }
+        SDL_DestroyRenderer(probe_renderer);
+        SDL_DestroyWindow(win);
+        SDL_Log("  %-10s lock %7.2fms  update %7.2fms  fillrect %7.2fms", name,
+                ns[STRATEGY_LOCK] / 1e6, ns[STRATEGY_UPDATE] / 1e6,
+                ns[STRATEGY_FILLRECT] / 1e6);
+        /* Fillrects are measured for the record but never selected: the
+           CRT and rotation passes composite from the framebuffer
+           texture, which a rect-drawn frame doesn't populate. */
+        for (int s = 0; s < STRATEGY_FILLRECT; s++) {
+            if (ns[s] != 0 && (best_ns == 0 || ns[s] < best_ns)) {
+                best_ns = ns[s];
+                *best_strategy = s;
+                SDL_strlcpy(best_driver, name, driver_cap);
+            }
+        }
+    }
+    return best_driver[0] != '\0';
+}
+
+static bool cache_load(char *driver, size_t driver_cap, int *strategy) {
+    FILE *fptr = fopen(RENDERPROBE_FILE, "r");
+    if (fptr == NULL) {
+        return false;
+    }
+    bool have_driver = false;
+    bool have_upload = false;
+    char upload[16] = "";
+    char line[128];
+    while (fgets(line, sizeof(line), fptr) != NULL) {
+        if (line[0] == '#' || line[0] == '\n') {
+            continue;
+        }
+        char key[16];
+        char value[32];
+        if (sscanf(line, "%15s %31s", key, value) != 2) {
+            continue;
+        }
+        if (strcmp(key, "driver") == 0) {
+            SDL_strlcpy(driver, value, driver_cap);
+            have_driver = true;
+        } else if (strcmp(key, "upload") == 0) {
+            SDL_strlcpy(upload, value, sizeof(upload));
+            have_upload = true;
+        }
+    }
+    fclose(fptr);
+    if (!have_driver || !have_upload) {
+        return false;
+    }
+    *strategy = strcmp(upload, "update") == 0 ? STRATEGY_UPDATE : STRATEGY_LOCK;
+
+    // The cached driver must still exist: an SDL upgrade that drops it
+    // triggers a fresh probe instead of a failed renderer at startup
+    for (int d = 0; d < SDL_GetNumRenderDrivers(); d++) {
+        if (strcmp(SDL_GetRenderDriver(d), driver) == 0) {
+            return true;
+        }
+    }
+    SDL_Log("Cached render driver %s no longer exists; re-probing", driver);
+    return false;
+}
+
+static void cache_save(const char *driver, int strategy) {
+    FILE *fptr = fopen(RENDERPROBE_FILE, "w");
+    if (fptr == NULL) {
+        SDL_Log("Couldn't cache the probe verdict in " RENDERPROBE_FILE
+                "; next startup probes again");
+        return;
+    }
+    fprintf(fptr,
+            "# Render backend probe verdict for this host. Delete this file or\n"
+            "# run with --probe-renderer to measure again.\n"
+            "driver %s\n"
+            "upload %s\n",
+            driver, strategy_names[strategy]);
+    fclose(fptr);
+}
+
+bool renderprobe_select(bool force) {
+    char driver[32];
+    int strategy;
+    if (!force && cache_load(driver, sizeof(driver), &strategy)) {
+        SDL_SetHint(SDL_HINT_RENDER_DRIVER, driver);
+        renderprobe_use_update = strategy == STRATEGY_UPDATE;
+        SDL_Log("Render probe: cached verdict %s, %s uploads (" RENDERPROBE_FILE ")",
+                driver, strategy_names[strategy]);
+        return true;
+    }
+
+    uint64_t start = telemetry_now_ns();
+    SDL_Log("Probing render backends (%d frames per path)...", PROBE_FRAMES);
+    if (!renderprobe_measure(driver, sizeof(driver), &strategy)) {
+        SDL_Log("Render probe found no usable backend; keeping SDL's default");
+        return false;
+    }
+    cache_save(driver, strategy);
+    SDL_SetHint(SDL_HINT_RENDER_DRIVER, driver);
+    renderprobe_use_update = strategy == STRATEGY_UPDATE;
+    SDL_Log("Render probe: %s with %s uploads wins (probed in %llu ms, cached for later runs)",
+            driver, strategy_names[strategy],
+            (unsigned long long)((telemetry_now_ns() - start) / 1000000));
+    return true;
+}
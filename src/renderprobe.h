@@ -0,0 +1,32 @@
+#ifndef RENDERPROBE_H
+#define RENDERPROBE_H
+
+#include <stdbool.h>
+
+/**
+ * Render Backend Probe (--probe-renderer)
+ *
+ * The cheapest way to put a 64x32 frame on screen differs per GPU: an
+ * Intel iGPU wants the streaming lock/unlock path, some Mali stacks
+ * upload faster through SDL_UpdateTexture, and which SDL render driver
+ * wins varies with the driver generation installed at the venue. On the
+ * first windowed startup this probe microbenchmarks every available
+ * render driver against the emulator's real present workload — full
+ * lock/unlock upload, UpdateTexture from a staging buffer, and
+ * per-pixel fill rects as a baseline — and caches the winner in
+ * chip8_render.cfg. Later startups apply the cached verdict without
+ * re-probing; --probe-renderer (or deleting the file) measures again
+ * after a driver update or hardware swap.
+ */
+
+// True when the probe picked UpdateTexture over lock/unlock for
+// framebuffer uploads; the render thread's expand paths honor it
+extern bool renderprobe_use_update;
+
+// Applies the cached verdict, or probes and caches one when the file is
+// missing, stale, or force is set. The winning driver lands in
+// SDL_HINT_RENDER_DRIVER, so call between SDL_Init and renderer
+// creation. Failure keeps SDL's own default; never fatal.
+bool renderprobe_select(bool force);
+
+#endif // RENDERPROBE_H
@@ -0,0 +1,361 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <pthread.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <SDL3/SDL.h>
+
+#include "chip8.h"
+#include "replay.h"
+
+static const uint8_t replay_magic[4] = {'C', '8', 'R', 'C'};
+
+#define REPLAY_VERSION 3
+#define REPLAY_HEADER_SIZE (4 + 4 + 4 + 4 + 8)
+
+// Event byte bit marking a v3 hash checkpoint (u64 hash follows); v2
+// writers only ever set the low five bits, so the reader takes both
+#define REPLAY_EVENT_HASH 0x20
+
+/* Each event is a varint gap (7 bits per byte, high bit = continue) plus
+   one key byte, so a typical transition costs 3-4 bytes instead of the
+   10 the old fixed records took; multi-hour sessions stay in the tens of
+   kilobytes. Buffers hand off to a flusher thread when full, so the
+   emulation thread never blocks on the filesystem. */
+#define REPLAY_BUFFER 4096
+
+bool replay_recording = false;
+bool replay_playing = false;
+
+static FILE *record_file;
+static uint64_t record_last_cycle;
+
+// Double buffer: the emulation thread appends to the active half and
+// hands the other to the flusher under the lock
+static uint8_t write_buffers[2][REPLAY_BUFFER];
+static int write_active;
+static size_t write_fill;
+static uint8_t *flush_buf;
+static size_t flush_len;
+static pthread_mutex_t flush_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t flush_cond = PTHREAD_COND_INITIALIZER;
+static bool flusher_running;
+static pthread_t flusher;
+
+// The global playback iterator is one cursor; --replay playback walks it
+// forward-only with one event decoded ahead, nothing parsed or allocated
+// up front
+static replay_cursor_t play_cursor;
+
+static void put_u32(uint8_t *out, uint32_t value) {
+    for (int i = 0; i < 4; i++) {
+        out[i] = (value >> (8 * i)) & 0xFF;
+    }
+}
+
+static uint32_t get_u32(const uint8_t *in) {
+    uint32_t value = 0;
+    for (int i = 0; i < 4; i++) {
+        value |= (uint32_t)in[i] << (8 * i);
+    }
+    return value;
+}
+
+static void *replay_flusher(void *arg) {
+    pthread_mutex_lock(&flush_lock);
+    while (flusher_running || flush_len != 0) {
+        if (flush_len == 0) {
+            pthread_cond_wait(&flush_cond, &flush_lock);
+            continue;
+        }
+        uint8_t *buf = flush_buf;
+        size_t len = flush_len;
+        pthread_mutex_unlock(&flush_lock);
+
+        fwrite(buf, 1, len, record_file);
+
+        pthread_mutex_lock(&flush_lock);
+        flush_len = 0;
+        pthread_cond_signal(&flush_cond); // The recorder may wait for the buffer
+    }
+    pthread_mutex_unlock(&flush_lock);
+    return NULL;
+}
+
+bool replay_record_start(const char *filename, const chip8_state_t *state) {
+    record_file = fopen(filename, "wb");
+    if (record_file == NULL) {
+        SDL_Log("Error opening replay file: %s", filename);
+        return false;
+    }
+
+    uint8_t header[REPLAY_HEADER_SIZE];
+    memcpy(header, replay_magic, 4);
+    header[4] = REPLAY_VERSION;
+    header[5] = (uint8_t)state->profile;
+    header[6] = state->virtual_clock;
+    header[7] = 0;
+    put_u32(header + 8, state->rng_state);
+    put_u32(header + 12, state->ips);
+    for (int i = 0; i < 8; i++) {
+        header[16 + i] = (state->rom_hash >> (8 * i)) & 0xFF;
+    }
+    fwrite(header, 1, sizeof(header), record_file);
+
+    record_last_cycle = 0;
+    write_active = 0;
+    write_fill = 0;
+    flush_len = 0;
+    flusher_running = true;
+    pthread_create(&flusher, NULL, replay_flusher, NULL);
+
+    replay_recording = true;
+    SDL_Log("Recording input to %s", filename);
+    return true;
+}
+
+// Delta-encodes the gap to the previous event; same-cycle events encode
+// a zero gap
+static int replay_encode_gap(uint8_t *encoded, uint64_t cycle) {
+    int n = 0;
+    uint64_t gap = cycle - record_last_cycle;
+    record_last_cycle = cycle;
+    while (gap >= 0x80) {
+        encoded[n++] = (uint8_t)(gap | 0x80);
+        gap >>= 7;
+    }
+    encoded[n++] = (uint8_t)gap;
+    return n;
+}
+
+static void replay_record_bytes(const uint8_t *encoded, int n) {
+    if (write_fill + (size_t)n > REPLAY_BUFFER) {
+        // Hand the full buffer to the flusher and switch halves. Waiting
+        // for a still-busy flusher only happens if the disk is slower
+        // than key events arrive — never in practice.
+        pthread_mutex_lock(&flush_lock);
+        while (flush_len != 0) {
+            pthread_cond_wait(&flush_cond, &flush_lock);
+        }
+        flush_buf = write_buffers[write_active];
+        flush_len = write_fill;
+        pthread_cond_signal(&flush_cond);
+        pthread_mutex_unlock(&flush_lock);
+
+        write_active ^= 1;
+        write_fill = 0;
+    }
+    memcpy(&write_buffers[write_active][write_fill], encoded, (size_t)n);
+    write_fill += (size_t)n;
+}
+
+void replay_record_key(uint64_t cycle, uint8_t key, bool down) {
+    if (!replay_recording) {
+        return;
+    }
+
+    uint8_t encoded[11];
+    int n = replay_encode_gap(encoded, cycle);
+    encoded[n++] = (uint8_t)((key & 0x0F) | (down ? 0x10 : 0));
+    replay_record_bytes(encoded, n);
+}
+
+void replay_record_hash(uint64_t cycle, uint64_t hash) {
+    if (!replay_recording) {
+        return;
+    }
+
+    uint8_t encoded[19];
+    int n = replay_encode_gap(encoded, cycle);
+    encoded[n++] = REPLAY_EVENT_HASH;
+    for (int i = 0; i < 8; i++) {
+        encoded[n++] = (uint8_t)((hash >> (8 * i)) & 0xFF);
+    }
+    replay_record_bytes(encoded, n);
+}
+
+void replay_record_stop(void) {
+    if (!replay_recording) {
+        return;
+    }
+    replay_recording = false;
+
+    pthread_mutex_lock(&flush_lock);
+    while (flush_len != 0) {
+        pthread_cond_wait(&flush_cond, &flush_lock);
+    }
+    flusher_running = false;
+    pthread_cond_signal(&flush_cond);
+    pthread_mutex_unlock(&flush_lock);
+    pthread_join(flusher, NULL);
+
+    if (write_fill != 0) {
+        fwrite(write_buffers[write_active], 1, write_fill, record_file);
+    }
+    fclose(record_file);
+    record_file = NULL;
+}
+
+// Decodes the next event off a cursor; clears has_event at the end of
+// the stream (a truncated trailing event is dropped)
+static void replay_decode_next(replay_cursor_t *cursor) {
+    uint64_t gap = 0;
+    int shift = 0;
+
+    while (cursor->pos < cursor->end) {
+        uint8_t byte = *cursor->pos++;
+        gap |= (uint64_t)(byte & 0x7F) << shift;
+        shift += 7;
+        if ((byte & 0x80) == 0) {
+            if (cursor->pos < cursor->end) {
+                cursor->cycle += gap;
+                cursor->event = *cursor->pos++;
+                if (cursor->event & REPLAY_EVENT_HASH) {
+                    // v3 checkpoint: the hash rides behind the event byte
+                    if (cursor->end - cursor->pos < 8) {
+                        break;
+                    }
+                    cursor->event_hash = 0;
+                    for (int i = 0; i < 8; i++) {
+                        cursor->event_hash |= (uint64_t)*cursor->pos++ << (8 * i);
+                    }
+                }
+                return;
+            }
+            break;
+        }
+    }
+    cursor->has_event = false;
+}
+
+bool replay_cursor_open(replay_cursor_t *cursor, const char *filename) {
+    memset(cursor, 0, sizeof(*cursor));
+
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) {
+        SDL_Log("Error opening replay file: %s", filename);
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < REPLAY_HEADER_SIZE) {
+        SDL_Log("Not a replay file: %s", filename);
+        close(fd);
+        return false;
+    }
+    cursor->map_size = (size_t)st.st_size;
+    cursor->map = mmap(NULL, cursor->map_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // The mapping keeps the file alive
+    if (cursor->map == MAP_FAILED) {
+        SDL_Log("Couldn't map replay file: %s", filename);
+        cursor->map = NULL;
+        return false;
+    }
+
+    const uint8_t *header = cursor->map;
+    if (memcmp(header, replay_magic, 4) != 0) {
+        SDL_Log("Not a replay file: %s", filename);
+        replay_cursor_close(cursor);
+        return false;
+    }
+    if (header[4] != 2 && header[4] != REPLAY_VERSION) {
+        SDL_Log("Unsupported replay version: %u", header[4]);
+        replay_cursor_close(cursor);
+        return false;
+    }
+
+    cursor->rom_hash = 0;
+    for (int i = 0; i < 8; i++) {
+        cursor->rom_hash |= (uint64_t)header[16 + i] << (8 * i);
+    }
+    cursor->profile = header[5];
+    cursor->virtual_clock = header[6] != 0;
+    cursor->rng_state = get_u32(header + 8);
+    cursor->ips = get_u32(header + 12);
+
+    cursor->pos = cursor->map + REPLAY_HEADER_SIZE;
+    cursor->end = cursor->map + cursor->map_size;
+    cursor->cycle = 0;
+    cursor->has_event = true;
+    replay_decode_next(cursor);
+    return true;
+}
+
+void replay_cursor_seek(replay_cursor_t *cursor, uint64_t cycle) {
+    while (cursor->has_event && cursor->cycle <= cycle) {
+        replay_decode_next(cursor);
+    }
+}
+
+void replay_cursor_apply(replay_cursor_t *cursor, chip8_state_t *state) {
+    while (cursor->has_event && cursor->cycle <= state->cycle_count) {
+        if (cursor->event & REPLAY_EVENT_HASH) {
+            // Surface the checkpoint for a verifying caller; plain
+            // playback leaves it pending harmlessly
+            cursor->check_cycle = cursor->cycle;
+            cursor->check_hash = cursor->event_hash;
+            cursor->check_pending = true;
+        } else {
+            chip8_key_set(state, cursor->event & 0x0F, (cursor->event & 0x10) != 0);
+            state->idle = false; // An injected key can satisfy a FX0A wait
+        }
+        replay_decode_next(cursor);
+    }
+}
+
+uint64_t replay_cursor_next_cycle(const replay_cursor_t *cursor) {
+    return cursor->has_event ? cursor->cycle : UINT64_MAX;
+}
+
+void replay_cursor_close(replay_cursor_t *cursor) {
+    if (cursor->map == NULL) {
+        return;
+    }
+    cursor->has_event = false;
+    munmap((void *)cursor->map, cursor->map_size);
+    cursor->map = NULL;
+}
+
+bool replay_play_start(const char *filename, chip8_state_t *state) {
+    if (!replay_cursor_open(&play_cursor, filename)) {
+        return false;
+    }
+
+    if (state->rom_hash != play_cursor.rom_hash) {
+        SDL_Log("Replay %s was recorded from a different ROM", filename);
+        replay_play_stop();
+        return false;
+    }
+
+    // Restore everything the instruction stream depends on, so every
+    // event's cycle timestamp lines up exactly: quirk profile, clock
+    // mode, rng, and pacing
+    const uint8_t *header = play_cursor.map;
+    chip8_set_profile(state, (chip8_profile_t)header[5]);
+    chip8_set_virtual_clock(state, play_cursor.virtual_clock);
+    state->rng_state = get_u32(header + 8);
+    state->ips = get_u32(header + 12);
+
+    replay_playing = true;
+    SDL_Log("Replaying input from %s (%zu bytes)", filename, play_cursor.map_size);
+    return true;
+}
+
+void replay_play_apply(chip8_state_t *state) {
+    if (!replay_playing) {
+        return;
+    }
+
+    replay_cursor_apply(&play_cursor, state);
+
+    if (!play_cursor.has_event) {
+        replay_play_stop();
+    }
+}
+
+void replay_play_stop(void) {
+    replay_playing = false;
+    replay_cursor_close(&play_cursor);
+}
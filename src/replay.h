@@ -0,0 +1,105 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "chip8.h"
+
+/**
+ * Chip-8 Input Recording and Playback
+ *
+ * Records keypad transitions with their instruction-count timestamps and
+ * re-injects them at the same counts on playback. The recording captures
+ * everything the instruction stream depends on — PRNG state, ips, quirk
+ * profile, clock mode, and the ROM's content hash — so a replayed run is
+ * bit-identical and a recording against the wrong ROM is refused. This
+ * is the interchange format for the regression farm.
+ *
+ * File format (v3, little-endian): magic "C8RC", u8 version, u8 profile,
+ * u8 virtual_clock, u8 pad, u32 rng_state, u32 ips, u64 rom_hash; then a
+ * stream of events, each a varint instruction-count gap from the
+ * previous event (7 bits per byte, high bit = continue) followed by one
+ * byte of key (low nibble) and down flag (bit 4). Typical transitions
+ * cost 3-4 bytes, so multi-hour sessions stay tiny.
+ *
+ * v3 adds hash checkpoints to the stream: an event byte with bit 5 set
+ * followed by the u64 state hash at that cycle, written once a second
+ * while recording and once at stop. They make a recording
+ * self-verifying — the verify mode replays it and asserts every
+ * checkpoint, pinning a divergence to the second it first appears. The
+ * reader still accepts v2 files (which never set bit 5); playback skips
+ * checkpoints either way.
+ *
+ * The writer double-buffers and flushes off the emulation thread; the
+ * reader is a forward-only iterator over the mmap'd file, so playback
+ * startup parses nothing.
+ */
+
+extern bool replay_recording;
+extern bool replay_playing;
+
+// Recording. The header snapshots the state's rng and pacing so playback
+// can restore them; call right after seeding, before execution starts.
+bool replay_record_start(const char *filename, const chip8_state_t *state);
+void replay_record_key(uint64_t cycle, uint8_t key, bool down);
+
+// Appends a hash checkpoint (chip8_state_hash at the given cycle). Call
+// at quantum boundaries only, so a verifier replaying frame by frame
+// crosses the exact cycle the hash was taken at.
+void replay_record_hash(uint64_t cycle, uint64_t hash);
+
+void replay_record_stop(void);
+
+// Playback. replay_play_start loads the event list and restores the
+// recorded rng and ips; replay_play_apply injects every event whose cycle
+// is due at the state's current cycle_count (cheap no-op between events).
+bool replay_play_start(const char *filename, chip8_state_t *state);
+void replay_play_apply(chip8_state_t *state);
+void replay_play_stop(void);
+
+// A positionable playback cursor, independent of the global iterator
+// above: each cursor owns its own mapping of the file, so parallel
+// consumers (the bisection probes in bisect.h) can walk different
+// segments of one recording concurrently. The header fields are exposed
+// rather than applied — a caller resuming from a mid-run snapshot wants
+// the recording's profile, clock mode, and ips, but the snapshot's rng.
+typedef struct replay_cursor {
+    const uint8_t *map;
+    size_t map_size;
+    const uint8_t *pos;
+    const uint8_t *end;
+    uint64_t cycle;      // Absolute cycle of the decoded-ahead event
+    uint8_t event;       // Its key (low nibble) and down flag (bit 4)
+    uint64_t event_hash; // Its hash, when the event is a v3 checkpoint
+    bool has_event;
+    uint64_t rom_hash;  // From the header, for the caller to validate
+    uint8_t profile;    // Quirk profile the recording ran under
+    bool virtual_clock; // Clock mode the recording ran under
+    uint32_t ips;       // Pacing target the recording ran under
+    uint32_t rng_state; // Seed the recording started from
+    // Latest hash checkpoint the apply crossed; the verify mode checks
+    // and clears pending, playback just clears it
+    uint64_t check_cycle;
+    uint64_t check_hash;
+    bool check_pending;
+} replay_cursor_t;
+
+// Maps the file, validates magic and version, and decodes ahead to the
+// first event
+bool replay_cursor_open(replay_cursor_t *cursor, const char *filename);
+
+// Discards events stamped at or before `cycle`: a snapshot taken there
+// already reflects them in its keypad bits
+void replay_cursor_seek(replay_cursor_t *cursor, uint64_t cycle);
+
+// Injects every event due at the state's cycle_count, FX0A wakeups
+// included; mirrors replay_play_apply
+void replay_cursor_apply(replay_cursor_t *cursor, chip8_state_t *state);
+
+// Cycle of the next pending event, or UINT64_MAX when exhausted
+uint64_t replay_cursor_next_cycle(const replay_cursor_t *cursor);
+
+void replay_cursor_close(replay_cursor_t *cursor);
+
+#endif // REPLAY_H
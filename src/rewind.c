@@ -0,0 +1,185 @@
+#include <stdint.h>
+#include <string.h>
+#include <SDL3/SDL.h>
+
+#include "chip8.h"
+#include "savestate.h"
+#include "rewind.h"
+
+#define REWIND_MAX_FRAMES 8192
+#define REWIND_DEFAULT_ARENA (4 << 20)
+
+// One stored delta: a run of [u32 offset][u32 len][len XOR bytes] chunks
+// (32-bit because the savestate image outgrows a u16 offset in the
+// CHIP8_MEMORY_BYTES=65536 configuration)
+typedef struct rewind_frame {
+    size_t offset; // Into the arena
+    size_t size;
+} rewind_frame_t;
+
+struct chip8_rewind {
+    uint8_t current[CHIP8_SAVESTATE_SIZE]; // Snapshot of the newest captured frame
+    bool has_current;
+
+    uint8_t *arena; // Circular delta storage
+    size_t arena_size;
+    size_t write_pos;
+
+    rewind_frame_t frames[REWIND_MAX_FRAMES]; // FIFO ring, tail = oldest
+    int frame_tail;
+    int frame_count;
+};
+
+chip8_rewind_t *chip8_rewind_create(size_t arena_bytes) {
+    if (arena_bytes == 0) {
+        arena_bytes = REWIND_DEFAULT_ARENA;
+    }
+
+    chip8_rewind_t *rewind = SDL_calloc(1, sizeof(chip8_rewind_t));
+    if (rewind == NULL) {
+        return NULL;
+    }
+    rewind->arena = SDL_malloc(arena_bytes);
+    if (rewind->arena == NULL) {
+        SDL_free(rewind);
+        return NULL;
+    }
+    rewind->arena_size = arena_bytes;
+    return rewind;
+}
+
+void chip8_rewind_destroy(chip8_rewind_t *rewind) {
+    if (rewind != NULL) {
+        SDL_free(rewind->arena);
+        SDL_free(rewind);
+    }
+}
+
+int chip8_rewind_depth(const chip8_rewind_t *rewind) {
+    return rewind->frame_count;
+}
+
+static void rewind_drop_oldest(chip8_rewind_t *rewind) {
+    rewind->frame_tail = (rewind->frame_tail + 1) % REWIND_MAX_FRAMES;
+    rewind->frame_count--;
+}
+
+// Finds a contiguous region of `need` bytes in the circular arena, evicting
+// the oldest frames (and wrapping to the start) as required.
+static size_t rewind_reserve(chip8_rewind_t *rewind, size_t need) {
+    for (;;) {
+        if (rewind->frame_count == 0) {
+            rewind->write_pos = 0;
+            return 0;
+        }
+
+        size_t oldest = rewind->frames[rewind->frame_tail].offset;
+        size_t limit = oldest >= rewind->write_pos ? oldest : rewind->arena_size;
+
+        if (rewind->write_pos + need <= limit) {
+            return rewind->write_pos;
+        }
+        if (oldest < rewind->write_pos) {
+            rewind->write_pos = 0; // Not enough room at the arena tail; wrap
+            continue;
+        }
+        rewind_drop_oldest(rewind); // Free region is bounded by the oldest frame
+    }
+}
+
+void chip8_rewind_capture(chip8_rewind_t *rewind, const chip8_state_t *state) {
+    uint8_t snapshot[CHIP8_SAVESTATE_SIZE];
+    chip8_save_state(state, snapshot, sizeof(snapshot));
+
+    if (!rewind->has_current) {
+        memcpy(rewind->current, snapshot, sizeof(snapshot));
+        rewind->has_current = true;
+        return;
+    }
+
+    // Encode the XOR delta against the previous snapshot as
+    // [u32 offset][u32 len][XOR bytes] chunks, skipping unchanged runs.
+    // Worst case is an isolated changed byte every other position: one
+    // 9-byte chunk per 2 image bytes, so 5x the image is always enough.
+    uint8_t delta[5 * CHIP8_SAVESTATE_SIZE];
+    size_t delta_size = 0;
+
+    for (size_t i = 0; i < CHIP8_SAVESTATE_SIZE;) {
+        if (snapshot[i] == rewind->current[i]) {
+            i++;
+            continue;
+        }
+        size_t run_start = i;
+        while (i < CHIP8_SAVESTATE_SIZE && snapshot[i] != rewind->current[i]) {
+            i++;
+        }
+        size_t run_length = i - run_start;
+
+        delta[delta_size++] = run_start & 0xFF;
+        delta[delta_size++] = (run_start >> 8) & 0xFF;
+        delta[delta_size++] = (run_start >> 16) & 0xFF;
+        delta[delta_size++] = (run_start >> 24) & 0xFF;
+        delta[delta_size++] = run_length & 0xFF;
+        delta[delta_size++] = (run_length >> 8) & 0xFF;
+        delta[delta_size++] = (run_length >> 16) & 0xFF;
+        delta[delta_size++] = (run_length >> 24) & 0xFF;
+        for (size_t j = 0; j < run_length; j++) {
+            delta[delta_size++] = snapshot[run_start + j] ^ rewind->current[run_start + j];
+        }
+    }
+
+    // A delta the arena can't hold even empty would overflow the memcpy
+    // below no matter how much rewind_reserve evicts. The history before
+    // this frame is unreachable without it, so drop everything and let the
+    // snapshot stand as a fresh baseline.
+    if (delta_size > rewind->arena_size) {
+        rewind->frame_tail = 0;
+        rewind->frame_count = 0;
+        rewind->write_pos = 0;
+        memcpy(rewind->current, snapshot, sizeof(snapshot));
+        return;
+    }
+
+    if (rewind->frame_count == REWIND_MAX_FRAMES) {
+        rewind_drop_oldest(rewind);
+    }
+
+    size_t offset = rewind_reserve(rewind, delta_size);
+    memcpy(rewind->arena + offset, delta, delta_size);
+    rewind->write_pos = offset + delta_size;
+
+    int head = (rewind->frame_tail + rewind->frame_count) % REWIND_MAX_FRAMES;
+    rewind->frames[head].offset = offset;
+    rewind->frames[head].size = delta_size;
+    rewind->frame_count++;
+
+    memcpy(rewind->current, snapshot, sizeof(snapshot));
+}
+
+bool chip8_rewind_step_back(chip8_rewind_t *rewind, chip8_state_t *state) {
+    if (rewind->frame_count == 0) {
+        return false;
+    }
+
+    // Pop the newest delta and XOR it back into the current snapshot
+    int head = (rewind->frame_tail + rewind->frame_count - 1) % REWIND_MAX_FRAMES;
+    const uint8_t *delta = rewind->arena + rewind->frames[head].offset;
+    size_t delta_size = rewind->frames[head].size;
+    rewind->frame_count--;
+    rewind->write_pos = rewind->frames[head].offset;
+
+    for (size_t i = 0; i + 8 <= delta_size;) {
+        size_t run_start = delta[i] | (size_t)delta[i + 1] << 8
+                         | (size_t)delta[i + 2] << 16 | (size_t)delta[i + 3] << 24;
+        size_t run_length = delta[i + 4] | (size_t)delta[i + 5] << 8
+                          | (size_t)delta[i + 6] << 16 | (size_t)delta[i + 7] << 24;
+        i += 8;
+
+        for (size_t j = 0; j < run_length && run_start + j < CHIP8_SAVESTATE_SIZE; j++) {
+            rewind->current[run_start + j] ^= delta[i + j];
+        }
+        i += run_length;
+    }
+
+    return chip8_load_state(state, rewind->current, CHIP8_SAVESTATE_SIZE);
+}
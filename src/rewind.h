@@ -0,0 +1,36 @@
+#ifndef REWIND_H
+#define REWIND_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "chip8.h"
+
+/**
+ * Chip-8 Rewind
+ *
+ * Captures a savestate every frame into a preallocated ring, storing each
+ * frame as an XOR delta against the previous snapshot with zero runs
+ * elided. Because most of memory and vram is static between frames, deltas
+ * are tiny and minutes of history fit in a few MB. XOR deltas are their own
+ * inverse, so stepping back just re-applies the newest delta.
+ */
+
+typedef struct chip8_rewind chip8_rewind_t;
+
+// Allocates a rewind ring with the given delta arena size (0 = 4MB default)
+chip8_rewind_t *chip8_rewind_create(size_t arena_bytes);
+void chip8_rewind_destroy(chip8_rewind_t *rewind);
+
+// Captures the current state; call once per frame
+void chip8_rewind_capture(chip8_rewind_t *rewind, const chip8_state_t *state);
+
+// Steps one captured frame back, restoring into state. Returns false when
+// no more history is available.
+bool chip8_rewind_step_back(chip8_rewind_t *rewind, chip8_state_t *state);
+
+// Frames of history currently held
+int chip8_rewind_depth(const chip8_rewind_t *rewind);
+
+#endif // REWIND_H
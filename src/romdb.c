@@ -0,0 +1,82 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <SDL3/SDL.h>
+
+#include "chip8.h"
+#include "romdb.h"
+
+// Power-of-two open-addressed table; an entry with hash 0 is an empty slot
+#define ROMDB_CAPACITY 256
+
+static romdb_entry_t table[ROMDB_CAPACITY];
+static int entry_count;
+
+uint64_t romdb_hash(const uint8_t *data, size_t size) {
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= data[i];
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+static romdb_entry_t *romdb_slot(uint64_t rom_hash) {
+    uint32_t index = (uint32_t)(rom_hash ^ (rom_hash >> 32)) & (ROMDB_CAPACITY - 1);
+
+    while (table[index].hash != 0 && table[index].hash != rom_hash) {
+        index = (index + 1) & (ROMDB_CAPACITY - 1);
+    }
+    return &table[index];
+}
+
+bool romdb_load(const char *filename) {
+    FILE *fptr = fopen(filename, "r");
+    if (fptr == NULL) {
+        return true; // No database is a valid configuration
+    }
+
+    char line[256];
+    while (fgets(line, sizeof(line), fptr) != NULL) {
+        unsigned long long hash;
+        char profile_name[16];
+        unsigned int ips;
+        unsigned int palette[4];
+
+        if (line[0] == '#' || line[0] == '\n') {
+            continue;
+        }
+
+        int fields = sscanf(line, "%llx %15s %u %6x %6x %6x %6x",
+                            &hash, profile_name, &ips,
+                            &palette[0], &palette[1], &palette[2], &palette[3]);
+        if (fields < 3 || hash == 0 || entry_count >= ROMDB_CAPACITY / 2) {
+            SDL_Log("Skipping bad ROM config line: %s", line);
+            continue;
+        }
+
+        romdb_entry_t *entry = romdb_slot(hash);
+        entry->hash = hash;
+        entry->ips = ips;
+        entry->profile = strcmp(profile_name, "modern") == 0 ? CHIP8_PROFILE_MODERN
+                                                             : CHIP8_PROFILE_COSMAC;
+        entry->has_palette = fields == 7;
+        for (int i = 0; i < 4 && entry->has_palette; i++) {
+            entry->palette[i] = 0xFF000000 | palette[i];
+        }
+        entry_count++;
+    }
+    fclose(fptr);
+
+    SDL_Log("Loaded %d ROM config entries from %s", entry_count, filename);
+    return true;
+}
+
+const romdb_entry_t *romdb_find(uint64_t rom_hash) {
+    if (entry_count == 0 || rom_hash == 0) {
+        return NULL;
+    }
+
+    const romdb_entry_t *entry = romdb_slot(rom_hash);
+    return entry->hash == rom_hash ? entry : NULL;
+}
@@ -0,0 +1,39 @@
+#ifndef ROMDB_H
+#define ROMDB_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "chip8.h"
+
+/**
+ * Per-ROM Configuration Database
+ *
+ * One flat text file mapping ROM content hashes to the settings a title
+ * needs: quirk profile, IPS target, and optionally a palette. Loaded once
+ * at startup into an open-addressed table; chip8_load_rom consults it so
+ * the right profile applies automatically without per-title builds.
+ *
+ * File format, one entry per line ('#' starts a comment):
+ *   <rom hash, 16 hex digits> <cosmac|modern> <ips> [<4x RRGGBB palette>]
+ */
+
+typedef struct romdb_entry {
+    uint64_t hash;
+    chip8_profile_t profile;
+    uint32_t ips; // 0 = uncapped
+    uint32_t palette[4]; // ARGB, background/plane0/plane1/both
+    bool has_palette;
+} romdb_entry_t;
+
+// Parses the database file. A missing file is not an error (no entries).
+bool romdb_load(const char *filename);
+
+// O(1) lookup by ROM content hash; NULL when the ROM has no entry
+const romdb_entry_t *romdb_find(uint64_t rom_hash);
+
+// FNV-1a over the ROM image, the key chip8_load_rom stores and looks up
+uint64_t romdb_hash(const uint8_t *data, size_t size);
+
+#endif // ROMDB_H
@@ -0,0 +1,192 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <SDL3/SDL.h>
+
+#include "chip8.h"
+#include "savestate.h"
+#include "eventlog.h"
+
+static const uint8_t savestate_magic[4] = {'C', '8', 'S', 'V'};
+
+static uint8_t *put_u16(uint8_t *out, uint16_t value) {
+    out[0] = value & 0xFF;
+    out[1] = value >> 8;
+    return out + 2;
+}
+
+static uint8_t *put_u32(uint8_t *out, uint32_t value) {
+    for (int i = 0; i < 4; i++) {
+        out[i] = (value >> (8 * i)) & 0xFF;
+    }
+    return out + 4;
+}
+
+static uint8_t *put_u64(uint8_t *out, uint64_t value) {
+    for (int i = 0; i < 8; i++) {
+        out[i] = (value >> (8 * i)) & 0xFF;
+    }
+    return out + 8;
+}
+
+static const uint8_t *get_u16(const uint8_t *in, uint16_t *value) {
+    *value = in[0] | (uint16_t)in[1] << 8;
+    return in + 2;
+}
+
+static const uint8_t *get_u32(const uint8_t *in, uint32_t *value) {
+    *value = 0;
+    for (int i = 0; i < 4; i++) {
+        *value |= (uint32_t)in[i] << (8 * i);
+    }
+    return in + 4;
+}
+
+static const uint8_t *get_u64(const uint8_t *in, uint64_t *value) {
+    *value = 0;
+    for (int i = 0; i < 8; i++) {
+        *value |= (uint64_t)in[i] << (8 * i);
+    }
+    return in + 8;
+}
+
+size_t chip8_save_state(const chip8_state_t *state, uint8_t *buffer, size_t capacity) {
+    if (capacity < CHIP8_SAVESTATE_SIZE) {
+        return 0;
+    }
+
+    uint8_t *out = buffer;
+    memcpy(out, savestate_magic, 4);
+    out += 4;
+    out = put_u32(out, CHIP8_SAVESTATE_VERSION);
+
+    memcpy(out, state->memory, sizeof(state->memory));
+    out += sizeof(state->memory);
+    out = put_u16(out, state->program_counter);
+    out = put_u16(out, state->index_register);
+    for (int i = 0; i < 16; i++) {
+        out = put_u16(out, state->stack[i]);
+    }
+    *out++ = state->stack_ptr;
+    *out++ = state->delay_timer;
+    *out++ = state->sound_timer;
+    memcpy(out, state->registers, sizeof(state->registers));
+    out += sizeof(state->registers);
+    for (int p = 0; p < 2; p++) {
+        for (int i = 0; i < 64; i++) {
+            // Resolved through the lazy clear, so stale rows serialize as
+            // the zeros they architecturally are
+            out = put_u64(out, chip8_vram_word(state, p, i, 0));
+            out = put_u64(out, chip8_vram_word(state, p, i, 1));
+        }
+    }
+    out = put_u32(out, state->rng_state);
+    out = put_u16(out, atomic_load_explicit(&state->keypad, memory_order_relaxed));
+    *out++ = state->hires;
+    memcpy(out, state->rpl_flags, sizeof(state->rpl_flags));
+    out += sizeof(state->rpl_flags);
+    *out++ = state->plane_mask;
+
+    return (size_t)(out - buffer);
+}
+
+bool chip8_load_state(chip8_state_t *state, const uint8_t *buffer, size_t size) {
+    if (size < CHIP8_SAVESTATE_SIZE || memcmp(buffer, savestate_magic, 4) != 0) {
+        SDL_Log("Not a savestate");
+        eventlog_emit(EVENT_SAVESTATE_ERROR, 0, 0);
+        return false;
+    }
+
+    const uint8_t *in = buffer + 4;
+    uint32_t version;
+    in = get_u32(in, &version);
+    if (version != CHIP8_SAVESTATE_VERSION) {
+        SDL_Log("Unsupported savestate version: %u", version);
+        eventlog_emit(EVENT_SAVESTATE_ERROR, 0, version);
+        return false;
+    }
+
+    // Images can arrive from outside this process (migrate.c accepts them
+    // over the wire), so anything that indexes a fixed array is checked
+    // before the state is touched. stack_ptr sits right after the header,
+    // memory image, pc, index register and 16 stack slots.
+    uint8_t stack_ptr = buffer[4 + 4 + sizeof(state->memory) + 2 + 2 + 32];
+    if (stack_ptr > 16) {
+        SDL_Log("Savestate stack pointer out of range: %u", stack_ptr);
+        eventlog_emit(EVENT_SAVESTATE_ERROR, 0, stack_ptr);
+        return false;
+    }
+
+    memcpy(state->memory, in, sizeof(state->memory));
+    in += sizeof(state->memory);
+    in = get_u16(in, &state->program_counter);
+    state->program_counter &= CHIP8_ADDR_MASK;
+    in = get_u16(in, &state->index_register);
+    for (int i = 0; i < 16; i++) {
+        in = get_u16(in, &state->stack[i]);
+    }
+    state->stack_ptr = *in++;
+    state->delay_timer = *in++;
+    state->sound_timer = *in++;
+    memcpy(state->registers, in, sizeof(state->registers));
+    in += sizeof(state->registers);
+    for (int p = 0; p < 2; p++) {
+        state->plane_generation[p] = 0; // Restored rows are all live
+        for (int i = 0; i < 64; i++) {
+            in = get_u64(in, &state->vram[p][i][0]);
+            in = get_u64(in, &state->vram[p][i][1]);
+            state->row_generation[p][i] = 0;
+        }
+    }
+    in = get_u32(in, &state->rng_state);
+    uint16_t keypad;
+    in = get_u16(in, &keypad);
+    atomic_store_explicit(&state->keypad, keypad, memory_order_relaxed);
+    state->hires = *in++ != 0;
+    memcpy(state->rpl_flags, in, sizeof(state->rpl_flags));
+    in += sizeof(state->rpl_flags);
+    state->plane_mask = *in++;
+
+    // Memory contents changed wholesale: derived state is stale
+    for (int i = 0; i < CHIP8_MEMORY_BYTES / 2; i++) {
+        state->decode_cache[i].tag = 0;
+    }
+    for (int i = 0; i < CHIP8_SPRITE_CACHE; i++) {
+        state->sprite_cache[i].valid = false;
+    }
+    chip8_mark_all_dirty(state);
+    state->idle = false; // Re-detect spins at the restored pc
+    state->waiting_display = false;
+    state->waiting_key = false; // pc sits on FX0A mid-wait; it re-parks itself
+
+    return true;
+}
+
+bool chip8_save_state_file(const chip8_state_t *state, const char *filename) {
+    uint8_t buffer[CHIP8_SAVESTATE_SIZE];
+    size_t size = chip8_save_state(state, buffer, sizeof(buffer));
+
+    FILE *fptr = fopen(filename, "wb");
+    if (fptr == NULL) {
+        SDL_Log("Error opening savestate file: %s", filename);
+        return false;
+    }
+
+    bool ok = fwrite(buffer, 1, size, fptr) == size;
+    fclose(fptr);
+    return ok;
+}
+
+bool chip8_load_state_file(chip8_state_t *state, const char *filename) {
+    FILE *fptr = fopen(filename, "rb");
+    if (fptr == NULL) {
+        SDL_Log("Error opening savestate file: %s", filename);
+        return false;
+    }
+
+    uint8_t buffer[CHIP8_SAVESTATE_SIZE];
+    size_t size = fread(buffer, 1, sizeof(buffer), fptr);
+    fclose(fptr);
+
+    return chip8_load_state(state, buffer, size);
+}
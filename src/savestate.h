@@ -0,0 +1,40 @@
+#ifndef SAVESTATE_H
+#define SAVESTATE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "chip8.h"
+
+/**
+ * Chip-8 Savestates
+ *
+ * Serializes the architecturally visible interpreter state (not the decode
+ * cache or other derived data) into a versioned, endian-stable buffer.
+ * Snapshots are a few KB and cheap enough to take every frame.
+ */
+
+// Magic "C8SV" + u32 version + architectural fields, all little-endian.
+// Version 2 widened vram to 128x64 and added the SCHIP hires flag and RPL
+// user flags; version 3 added the second XO-CHIP plane and plane mask;
+// version 4 packed the keypad into one u16 bitmask. Extended-memory
+// builds (see CHIP8_MEMORY_BYTES) write a larger memory block at version
+// 5, so a 4K image and a 64K image reject each other cleanly instead of
+// misaligning every field after the memory copy.
+#define CHIP8_SAVESTATE_VERSION (CHIP8_MEMORY_BYTES == 4096 ? 4 : 5)
+#define CHIP8_SAVESTATE_SIZE (4 + 4 + CHIP8_MEMORY_BYTES + 2 + 2 + 32 + 1 + 1 + 1 + 16 + 2048 + 4 + 2 + 1 + 8 + 1)
+
+// Writes a snapshot into buffer; returns bytes written, or 0 if capacity is
+// less than CHIP8_SAVESTATE_SIZE.
+size_t chip8_save_state(const chip8_state_t *state, uint8_t *buffer, size_t capacity);
+
+// Restores a snapshot. Rejects bad magic, version, or size. The decode
+// cache is invalidated and the next frame re-presents.
+bool chip8_load_state(chip8_state_t *state, const uint8_t *buffer, size_t size);
+
+// File convenience wrappers around the buffer API
+bool chip8_save_state_file(const chip8_state_t *state, const char *filename);
+bool chip8_load_state_file(chip8_state_t *state, const char *filename);
+
+#endif // SAVESTATE_H
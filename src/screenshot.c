@@ -0,0 +1,114 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <pthread.h>
+#include <SDL3/SDL.h>
+
+#include "screenshot.h"
+
+#define SCREENSHOT_RING 8
+
+typedef struct screenshot_job {
+    uint64_t rows[2][64][2];
+    bool hires;
+    char path[256];
+} screenshot_job_t;
+
+// Fixed-size ring: the emulation thread pushes at head, the worker pops at
+// tail. A full ring drops the capture rather than blocking the emulator.
+static screenshot_job_t jobs[SCREENSHOT_RING];
+static int job_head;
+static int job_tail;
+static bool worker_started;
+static bool worker_quit;
+static pthread_t worker;
+static pthread_mutex_t job_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t job_ready = PTHREAD_COND_INITIALIZER;
+
+// Same plane compositing as the frontend: two bits index a 4-entry ARGB
+// palette (defaults match the renderer's)
+static const uint32_t screenshot_palette[4] = {0xFF000000, 0xFFFFFFFF, 0xFF3366AA, 0xFF99BBDD};
+
+static void screenshot_encode(const screenshot_job_t *job) {
+    int width = job->hires ? 128 : 64;
+    int height = job->hires ? 64 : 32;
+    uint32_t pixels[128 * 64];
+
+    for (int j = 0; j < height; j++) {
+        for (int i = 0; i < width; i++) {
+            int shift = 63 - (i & 63);
+            int index = ((job->rows[0][j][i >> 6] >> shift) & 1)
+                      | ((job->rows[1][j][i >> 6] >> shift) & 1) << 1;
+            pixels[j * width + i] = screenshot_palette[index];
+        }
+    }
+
+    SDL_Surface *surface = SDL_CreateSurfaceFrom(width, height, SDL_PIXELFORMAT_ARGB8888,
+                                                 pixels, width * 4);
+    if (surface == NULL || !SDL_SaveBMP(surface, job->path)) {
+        SDL_Log("Screenshot failed for %s: %s", job->path, SDL_GetError());
+    } else {
+        SDL_Log("Screenshot written to %s", job->path);
+    }
+    SDL_DestroySurface(surface);
+}
+
+static void *screenshot_worker(void *arg) {
+    pthread_mutex_lock(&job_lock);
+    while (true) {
+        while (job_tail == job_head && !worker_quit) {
+            pthread_cond_wait(&job_ready, &job_lock);
+        }
+        if (job_tail == job_head && worker_quit) {
+            break;
+        }
+
+        // Encode outside the lock so a slow disk never backs up captures
+        screenshot_job_t job = jobs[job_tail % SCREENSHOT_RING];
+        job_tail++;
+        pthread_mutex_unlock(&job_lock);
+        screenshot_encode(&job);
+        pthread_mutex_lock(&job_lock);
+    }
+    pthread_mutex_unlock(&job_lock);
+    return NULL;
+}
+
+bool screenshot_request(const chip8_state_t *state, const char *path) {
+    pthread_mutex_lock(&job_lock);
+    if (job_head - job_tail >= SCREENSHOT_RING) {
+        pthread_mutex_unlock(&job_lock);
+        SDL_Log("Screenshot ring full, dropping capture of %s", path);
+        return false;
+    }
+
+    screenshot_job_t *job = &jobs[job_head % SCREENSHOT_RING];
+    chip8_vram_snapshot(state, job->rows); // Resolves the lazy clear
+    job->hires = state->hires;
+    strncpy(job->path, path, sizeof(job->path) - 1);
+    job->path[sizeof(job->path) - 1] = '\0';
+    job_head++;
+
+    if (!worker_started) {
+        worker_started = true;
+        pthread_create(&worker, NULL, screenshot_worker, NULL);
+    }
+    pthread_cond_signal(&job_ready);
+    pthread_mutex_unlock(&job_lock);
+    return true;
+}
+
+void screenshot_stop(void) {
+    pthread_mutex_lock(&job_lock);
+    if (!worker_started) {
+        pthread_mutex_unlock(&job_lock);
+        return;
+    }
+    worker_quit = true;
+    pthread_cond_signal(&job_ready);
+    pthread_mutex_unlock(&job_lock);
+
+    pthread_join(worker, NULL);
+    worker_started = false;
+    worker_quit = false;
+}
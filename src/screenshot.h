@@ -0,0 +1,30 @@
+#ifndef SCREENSHOT_H
+#define SCREENSHOT_H
+
+#include <stdbool.h>
+
+#include "chip8.h"
+
+/**
+ * Async Screenshot Capture
+ *
+ * Snapshots vram into a fixed job ring and encodes it to a BMP file on a
+ * background worker thread, so automated sweeps can capture thousands of
+ * frames without stalling the emulation loop. The capture itself is one
+ * 2KB memcpy; all compositing and file I/O happens off-thread.
+ *
+ * BMP rather than PNG: the tree carries no image codec, and SDL can write
+ * BMP losslessly with no new dependency. Visual-regression hashing works
+ * the same either way.
+ */
+
+// Snapshots vram + hires flag and queues an encode to `path`. Returns
+// false if the job ring is full (the capture is dropped, not blocked on).
+// The worker thread starts lazily on the first call.
+bool screenshot_request(const chip8_state_t *state, const char *path);
+
+// Drains the job ring and joins the worker. Safe to call without any
+// preceding request.
+void screenshot_stop(void);
+
+#endif // SCREENSHOT_H
@@ -0,0 +1,168 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <SDL3/SDL.h>
+
+#include "arena.h"
+#include "script.h"
+
+#define SCRIPT_MAX_COMMANDS 1024
+
+enum {
+    SCRIPT_PRESS,
+    SCRIPT_RELEASE,
+    SCRIPT_ASSERT_PIXEL,
+    SCRIPT_ASSERT_REG,
+    SCRIPT_QUIT,
+};
+
+typedef struct script_command {
+    uint32_t frame;
+    uint8_t op;
+    uint8_t a; // Key, register, or x
+    uint8_t b; // Expected value or y
+    uint8_t c; // Expected pixel state
+} script_command_t;
+
+_Static_assert(SCRIPT_MAX_COMMANDS * sizeof(script_command_t) == SCRIPT_ARENA_BYTES,
+               "script arena budget must match the command list");
+
+bool script_active;
+
+static script_command_t *commands; // Arena-backed, carved out in script_load
+static int command_count;
+static int cursor;          // Next command to run; commands are frame-sorted
+static uint64_t frame;      // Executed 60Hz quanta since boot
+static int assertions_run;
+static int assertions_failed;
+
+bool script_load(const char *filename) {
+    commands = arena_alloc("script commands", SCRIPT_ARENA_BYTES);
+    if (commands == NULL) {
+        return false;
+    }
+
+    FILE *fptr = fopen(filename, "r");
+    if (fptr == NULL) {
+        SDL_Log("Error opening script: %s", filename);
+        return false;
+    }
+
+    char line[128];
+    int line_no = 0;
+    while (fgets(line, sizeof(line), fptr) != NULL) {
+        line_no++;
+        if (line[0] == '#' || line[0] == '\n') {
+            continue;
+        }
+
+        script_command_t cmd = {0};
+        char verb[16];
+        unsigned int args[3] = {0};
+        int fields = sscanf(line, "%u %15s %x %x %x", &cmd.frame, verb,
+                            &args[0], &args[1], &args[2]);
+        if (fields < 2) {
+            SDL_Log("Bad script line %d: %s", line_no, line);
+            fclose(fptr);
+            return false;
+        }
+
+        if (strcmp(verb, "press") == 0 && fields == 3 && args[0] <= 0xF) {
+            cmd.op = SCRIPT_PRESS;
+        } else if (strcmp(verb, "release") == 0 && fields == 3 && args[0] <= 0xF) {
+            cmd.op = SCRIPT_RELEASE;
+        } else if (strcmp(verb, "assert-pixel") == 0 && fields == 5 &&
+                   args[0] < 128 && args[1] < 64 && args[2] <= 1) {
+            cmd.op = SCRIPT_ASSERT_PIXEL;
+        } else if (strcmp(verb, "assert-reg") == 0 && fields == 4 &&
+                   args[0] <= 0xF && args[1] <= 0xFF) {
+            cmd.op = SCRIPT_ASSERT_REG;
+        } else if (strcmp(verb, "quit") == 0 && fields == 2) {
+            cmd.op = SCRIPT_QUIT;
+        } else {
+            SDL_Log("Bad script line %d: %s", line_no, line);
+            fclose(fptr);
+            return false;
+        }
+        cmd.a = (uint8_t)args[0];
+        cmd.b = (uint8_t)args[1];
+        cmd.c = (uint8_t)args[2];
+
+        if (command_count == SCRIPT_MAX_COMMANDS) {
+            SDL_Log("Script too long: %s (max %d commands)", filename, SCRIPT_MAX_COMMANDS);
+            fclose(fptr);
+            return false;
+        }
+
+        // Insertion keeps the list frame-ordered so the tick only looks
+        // at the cursor; equal frames keep file order
+        int at = command_count++;
+        while (at > 0 && commands[at - 1].frame > cmd.frame) {
+            commands[at] = commands[at - 1];
+            at--;
+        }
+        commands[at] = cmd;
+    }
+    fclose(fptr);
+
+    script_active = true;
+    SDL_Log("Loaded %d script commands from %s", command_count, filename);
+    return true;
+}
+
+// assert-pixel tests the composite: lit on either plane counts as lit,
+// matching what the display shows for any palette
+static bool script_pixel(const chip8_state_t *state, int x, int y) {
+    int shift = 63 - (x & 63);
+    uint64_t lit = chip8_vram_word(state, 0, y, x >> 6)
+                 | chip8_vram_word(state, 1, y, x >> 6);
+    return (lit >> shift) & 1;
+}
+
+bool script_tick(chip8_state_t *state) {
+    frame++;
+    bool keep_running = true;
+    while (cursor < command_count && commands[cursor].frame <= frame) {
+        const script_command_t *cmd = &commands[cursor++];
+        switch (cmd->op) {
+            case SCRIPT_PRESS:
+                chip8_key_set(state, cmd->a, true);
+                state->idle = false; // A scripted key ends an idle wait
+                break;
+            case SCRIPT_RELEASE:
+                chip8_key_set(state, cmd->a, false);
+                break;
+            case SCRIPT_ASSERT_PIXEL: {
+                assertions_run++;
+                bool lit = script_pixel(state, cmd->a, cmd->b);
+                if (lit != (cmd->c != 0)) {
+                    assertions_failed++;
+                    SDL_Log("Script frame %u: pixel (%u,%u) is %d, expected %u",
+                            cmd->frame, cmd->a, cmd->b, lit, cmd->c);
+                }
+                break;
+            }
+            case SCRIPT_ASSERT_REG:
+                assertions_run++;
+                if (state->registers[cmd->a] != cmd->b) {
+                    assertions_failed++;
+                    SDL_Log("Script frame %u: V%X is %02X, expected %02X",
+                            cmd->frame, cmd->a, state->registers[cmd->a], cmd->b);
+                }
+                break;
+            case SCRIPT_QUIT:
+                keep_running = false;
+                break;
+        }
+    }
+    return keep_running;
+}
+
+int script_report(void) {
+    if (!script_active) {
+        return 0;
+    }
+    SDL_Log("Script: %d/%d assertions passed%s", assertions_run - assertions_failed,
+            assertions_run, cursor < command_count ? " (commands left unreached)" : "");
+    return assertions_failed;
+}
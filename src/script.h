@@ -0,0 +1,41 @@
+#ifndef SCRIPT_H
+#define SCRIPT_H
+
+#include <stdbool.h>
+
+#include "chip8.h"
+
+/**
+ * Frame-Scheduled Automation Scripts
+ *
+ * QA runs from a text script (--script file) of frame-stamped commands:
+ * press and release keypad keys, assert pixels and registers, stop the
+ * session. The whole batch for a frame executes in one call between
+ * quanta — never per instruction — and assertions read the live
+ * chip8_state_t directly (packed vram words, register file), so a
+ * scripted run stays within a few percent of native speed. Failed
+ * assertions are logged and counted; the exit code reflects them.
+ *
+ * Script lines ('#' starts a comment):
+ *   <frame> press <key 0-F>
+ *   <frame> release <key 0-F>
+ *   <frame> assert-pixel <x> <y> <0|1>
+ *   <frame> assert-reg <reg 0-F> <hex value>
+ *   <frame> quit
+ */
+
+// Arena budget: max commands times the 8-byte command record
+#define SCRIPT_ARENA_BYTES (1024 * 8)
+
+extern bool script_active;
+
+bool script_load(const char *filename);
+
+// Runs every command scheduled for the next frame; call once per
+// executed 60Hz quantum. Returns false once a quit command fires.
+bool script_tick(chip8_state_t *state);
+
+// Logs the outcome; returns the number of failed assertions
+int script_report(void);
+
+#endif // SCRIPT_H
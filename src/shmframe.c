@@ -0,0 +1,98 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <SDL3/SDL.h>
+
+#include "shmframe.h"
+
+#define SHMFRAME_MAGIC 0x48533843u // "C8SH" little-endian
+#define SHMFRAME_VERSION 1
+#define SHMFRAME_RING 4
+#define SHMFRAME_BYTES 2048 // Both packed bit planes (see chip8_vram_snapshot)
+
+typedef struct shmframe_slot {
+    _Atomic uint64_t sequence; // 2n-1 while frame n is being copied, 2n after
+    uint32_t hires;
+    uint32_t padding;
+    uint8_t vram[SHMFRAME_BYTES];
+} shmframe_slot_t;
+
+typedef struct shmframe_region {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t ring;        // Slot count
+    uint32_t frame_bytes; // Bytes per slot payload
+    _Atomic uint64_t latest; // Newest complete frame n; its slot is n % ring
+    shmframe_slot_t slots[SHMFRAME_RING];
+} shmframe_region_t;
+
+bool shmframe_enabled;
+
+static shmframe_region_t *region;
+static char region_name[64];
+static uint64_t frame_counter;
+
+bool shmframe_start(const char *name) {
+    snprintf(region_name, sizeof(region_name), "/%s", name);
+    shm_unlink(region_name); // Replace a stale region from a crashed run
+
+    int fd = shm_open(region_name, O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0) {
+        SDL_Log("Couldn't create shared frame region %s", region_name);
+        return false;
+    }
+    if (ftruncate(fd, sizeof(shmframe_region_t)) != 0) {
+        SDL_Log("Couldn't size shared frame region %s", region_name);
+        close(fd);
+        shm_unlink(region_name);
+        return false;
+    }
+    region = mmap(NULL, sizeof(shmframe_region_t), PROT_READ | PROT_WRITE,
+                  MAP_SHARED, fd, 0);
+    close(fd); // The mapping keeps the region alive
+    if (region == MAP_FAILED) {
+        SDL_Log("Couldn't map shared frame region %s", region_name);
+        region = NULL;
+        shm_unlink(region_name);
+        return false;
+    }
+
+    memset(region, 0, sizeof(*region));
+    region->ring = SHMFRAME_RING;
+    region->frame_bytes = SHMFRAME_BYTES;
+    region->version = SHMFRAME_VERSION;
+    region->magic = SHMFRAME_MAGIC; // Written last: magic means ready
+
+    frame_counter = 0;
+    shmframe_enabled = true;
+    SDL_Log("Publishing frames to shared memory %s", region_name);
+    return true;
+}
+
+void shmframe_publish(const void *vram, bool hires) {
+    if (region == NULL) {
+        return;
+    }
+    uint64_t n = ++frame_counter;
+    shmframe_slot_t *slot = &region->slots[n % SHMFRAME_RING];
+
+    atomic_store_explicit(&slot->sequence, 2 * n - 1, memory_order_release);
+    memcpy(slot->vram, vram, SHMFRAME_BYTES);
+    slot->hires = hires;
+    atomic_store_explicit(&slot->sequence, 2 * n, memory_order_release);
+    atomic_store_explicit(&region->latest, n, memory_order_release);
+}
+
+void shmframe_stop(void) {
+    if (region == NULL) {
+        return;
+    }
+    shmframe_enabled = false;
+    munmap(region, sizeof(shmframe_region_t));
+    region = NULL;
+    shm_unlink(region_name);
+}
@@ -0,0 +1,36 @@
+#ifndef SHMFRAME_H
+#define SHMFRAME_H
+
+#include <stdbool.h>
+
+/**
+ * Shared-Memory Frame Export
+ *
+ * Publishes every presented frame into a POSIX shared-memory ring that
+ * an external compositor maps read-only — zero-copy, no pipe or socket
+ * serialization, no GPU readback. Each slot holds the packed vram
+ * snapshot (both bit planes, 2048 bytes) plus the display mode, guarded
+ * by a per-slot seqlock: the writer stamps an odd sequence before the
+ * copy and the even one after, and a header word names the newest
+ * complete frame. A reader copies the slot and re-checks the sequence;
+ * a mismatch means the writer lapped it and the copy is retried. The
+ * writer never blocks on readers.
+ *
+ * Region layout (see shmframe_region_t): "C8SH" magic, version, ring
+ * geometry, then the slots. Readers should verify magic and version
+ * before trusting the geometry.
+ */
+
+extern bool shmframe_enabled;
+
+// Creates and maps /<name> (shm_open namespace), replacing any stale
+// region from a previous run
+bool shmframe_start(const char *name);
+
+// Publishes one frame; vram is the packed 2048-byte snapshot
+void shmframe_publish(const void *vram, bool hires);
+
+// Unmaps and unlinks the region
+void shmframe_stop(void);
+
+#endif // SHMFRAME_H
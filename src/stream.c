@@ -0,0 +1,272 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <SDL3/SDL.h>
+
+#include "stream.h"
+
+#define STREAM_RING 8
+#define STREAM_FRAME_BYTES sizeof(((chip8_state_t *)0)->vram)
+// One packed plane-row: both uint64 halves of one scanline of one plane
+#define STREAM_ROW_BYTES 16
+#define STREAM_ROWS (STREAM_FRAME_BYTES / STREAM_ROW_BYTES)
+// A fresh keyframe every few seconds bounds how long a wire hiccup can
+// leave the viewer showing garbage deltas
+#define STREAM_KEYFRAME_INTERVAL 300
+// Worst case: count byte, then per row an index byte plus 32 nibbles at
+// five bits each (20 bytes), plus the final padding byte
+#define STREAM_ENCODE_MAX (1 + STREAM_ROWS * (1 + 5 * STREAM_ROW_BYTES / 2) + 1)
+
+typedef struct stream_frame {
+    uint8_t data[STREAM_FRAME_BYTES];
+    bool hires;
+} stream_frame_t;
+
+/* Fixed-size ring between the emulation thread and the sender: push at
+   head, pop at tail, and a full ring drops the oldest frame so a stalled
+   viewer only costs staleness, never emulation time. `latest` always
+   holds the newest published frame for keyframing new connections. */
+static stream_frame_t ring[STREAM_RING];
+static int ring_head;
+static int ring_tail;
+static stream_frame_t latest;
+static bool have_latest;
+
+static int listen_fd = -1;
+static int client_fd = -1;
+static bool worker_started;
+static bool worker_quit;
+static pthread_t worker;
+static pthread_mutex_t stream_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t frame_ready = PTHREAD_COND_INITIALIZER;
+
+/* Wire format, all little-endian: "C8ST" once on connect, then packets of
+   [type 'K'|'D'][hires u8][payload length u16][payload]. A keyframe
+   payload is the raw packed vram; a delta payload is [changed row count
+   u8][row indices u8 each] followed by one MSB-first bitstream holding,
+   for each listed row in order, its 16 XOR-against-previous bytes as 32
+   Huffman-coded nibbles, padded with zero bits to a byte boundary. */
+
+/* Static canonical Huffman code over delta nibbles. Sprites move a pixel
+   or two between frames, so XOR rows are overwhelmingly zero nibbles with
+   the occasional fully flipped one; lengths 1/4/5 fill Kraft exactly and
+   put a lone changed pixel on the wire in about six bytes. Static because
+   the distribution barely varies across games and shipping a table per
+   packet would cost more than it saves at these payload sizes. */
+static const struct {
+    uint8_t code;
+    uint8_t bits;
+} huff_nibble[16] = {
+    {0x00, 1}, {0x12, 5}, {0x13, 5}, {0x14, 5}, {0x15, 5}, {0x16, 5},
+    {0x17, 5}, {0x18, 5}, {0x19, 5}, {0x1A, 5}, {0x1B, 5}, {0x1C, 5},
+    {0x1D, 5}, {0x1E, 5}, {0x1F, 5}, {0x08, 4},
+};
+
+// Cost is O(changed rows) beyond one fixed memcmp pass over the snapshot;
+// an idle screen encodes to a single zero byte
+static size_t stream_encode_delta(const uint8_t *prev, const uint8_t *cur, uint8_t *out) {
+    uint8_t rows[STREAM_ROWS];
+    int count = 0;
+    for (int row = 0; row < (int)STREAM_ROWS; row++) {
+        if (memcmp(cur + row * STREAM_ROW_BYTES, prev + row * STREAM_ROW_BYTES,
+                   STREAM_ROW_BYTES) != 0) {
+            rows[count++] = (uint8_t)row;
+        }
+    }
+
+    out[0] = (uint8_t)count;
+    memcpy(out + 1, rows, (size_t)count);
+    size_t len = 1 + (size_t)count;
+
+    uint32_t acc = 0;
+    int pending = 0;
+    for (int i = 0; i < count; i++) {
+        const uint8_t *c = cur + rows[i] * STREAM_ROW_BYTES;
+        const uint8_t *p = prev + rows[i] * STREAM_ROW_BYTES;
+        for (int byte = 0; byte < STREAM_ROW_BYTES; byte++) {
+            uint8_t delta = c[byte] ^ p[byte];
+            for (int shift = 4; shift >= 0; shift -= 4) {
+                uint8_t nibble = (delta >> shift) & 0xF;
+                acc = (acc << huff_nibble[nibble].bits) | huff_nibble[nibble].code;
+                pending += huff_nibble[nibble].bits;
+                while (pending >= 8) {
+                    pending -= 8;
+                    out[len++] = (acc >> pending) & 0xFF;
+                }
+            }
+        }
+    }
+    if (pending > 0) {
+        out[len++] = (acc << (8 - pending)) & 0xFF;
+    }
+    return len;
+}
+
+// Loops over partial writes; MSG_NOSIGNAL so a vanished viewer surfaces as
+// an error instead of SIGPIPE
+static bool stream_send(int fd, const void *data, size_t size) {
+    const uint8_t *bytes = data;
+    while (size > 0) {
+        ssize_t sent = send(fd, bytes, size, MSG_NOSIGNAL);
+        if (sent <= 0) {
+            return false;
+        }
+        bytes += sent;
+        size -= (size_t)sent;
+    }
+    return true;
+}
+
+static bool stream_send_packet(int fd, uint8_t type, bool hires,
+                               const uint8_t *payload, size_t size) {
+    uint8_t header[4] = {type, hires, size & 0xFF, (size >> 8) & 0xFF};
+    return stream_send(fd, header, sizeof(header)) && stream_send(fd, payload, size);
+}
+
+static void *stream_worker(void *arg) {
+    static uint8_t encoded[STREAM_ENCODE_MAX];
+    stream_frame_t baseline;
+
+    while (true) {
+        int client = accept(listen_fd, NULL, NULL);
+        if (client < 0) {
+            if (worker_quit) {
+                break;
+            }
+            continue;
+        }
+        int nodelay = 1;
+        setsockopt(client, IPPROTO_TCP, TCP_NODELAY, &nodelay, sizeof(nodelay));
+
+        // New viewer: skip any backlog and open with a keyframe of the
+        // newest published frame, which becomes the delta baseline
+        pthread_mutex_lock(&stream_lock);
+        client_fd = client;
+        ring_tail = ring_head;
+        baseline = latest;
+        bool ready = have_latest;
+        pthread_mutex_unlock(&stream_lock);
+
+        if (!stream_send(client, "C8ST", 4) ||
+            (ready && !stream_send_packet(client, 'K', baseline.hires,
+                                          baseline.data, STREAM_FRAME_BYTES))) {
+            close(client);
+            continue;
+        }
+
+        bool connected = true;
+        int since_keyframe = 0;
+        while (connected) {
+            pthread_mutex_lock(&stream_lock);
+            while (ring_tail == ring_head && !worker_quit) {
+                pthread_cond_wait(&frame_ready, &stream_lock);
+            }
+            if (worker_quit) {
+                pthread_mutex_unlock(&stream_lock);
+                connected = false;
+                break;
+            }
+            stream_frame_t frame = ring[ring_tail % STREAM_RING];
+            ring_tail++;
+            pthread_mutex_unlock(&stream_lock);
+
+            // Encode and send outside the lock; the emulation side keeps
+            // publishing into the ring meanwhile
+            size_t size = ready ? stream_encode_delta(baseline.data, frame.data, encoded)
+                                : STREAM_FRAME_BYTES;
+            if (!ready || since_keyframe >= STREAM_KEYFRAME_INTERVAL ||
+                size >= STREAM_FRAME_BYTES) {
+                // Scene cuts can inflate a delta past the raw frame; raw is
+                // also what resyncs a viewer that lost bytes to the wire
+                connected = stream_send_packet(client, 'K', frame.hires,
+                                               frame.data, STREAM_FRAME_BYTES);
+                ready = true;
+                since_keyframe = 0;
+            } else {
+                connected = stream_send_packet(client, 'D', frame.hires, encoded, size);
+                since_keyframe++;
+            }
+            baseline = frame;
+        }
+
+        pthread_mutex_lock(&stream_lock);
+        client_fd = -1;
+        pthread_mutex_unlock(&stream_lock);
+        close(client);
+        if (worker_quit) {
+            break;
+        }
+    }
+    return NULL;
+}
+
+bool stream_start(unsigned short port) {
+    listen_fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (listen_fd < 0) {
+        SDL_Log("Stream socket failed");
+        return false;
+    }
+    int reuse = 1;
+    setsockopt(listen_fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons(port);
+    if (bind(listen_fd, (struct sockaddr *)&addr, sizeof(addr)) < 0 ||
+        listen(listen_fd, 1) < 0) {
+        SDL_Log("Stream bind failed on port %u", port);
+        close(listen_fd);
+        listen_fd = -1;
+        return false;
+    }
+
+    worker_started = true;
+    pthread_create(&worker, NULL, stream_worker, NULL);
+    SDL_Log("Streaming frames on port %u", port);
+    return true;
+}
+
+void stream_publish(const chip8_state_t *state) {
+    if (!worker_started) {
+        return;
+    }
+    pthread_mutex_lock(&stream_lock);
+    if (ring_head - ring_tail >= STREAM_RING) {
+        ring_tail++; // Viewer is behind: drop the oldest frame
+    }
+    stream_frame_t *frame = &ring[ring_head % STREAM_RING];
+    chip8_vram_snapshot(state, frame->data); // Resolves the lazy clear
+    frame->hires = state->hires;
+    latest = *frame;
+    have_latest = true;
+    ring_head++;
+    pthread_cond_signal(&frame_ready);
+    pthread_mutex_unlock(&stream_lock);
+}
+
+void stream_stop(void) {
+    if (!worker_started) {
+        return;
+    }
+    pthread_mutex_lock(&stream_lock);
+    worker_quit = true;
+    if (client_fd >= 0) {
+        shutdown(client_fd, SHUT_RDWR); // Unblocks a send in flight
+    }
+    pthread_cond_signal(&frame_ready);
+    pthread_mutex_unlock(&stream_lock);
+
+    shutdown(listen_fd, SHUT_RDWR); // Unblocks the accept
+    pthread_join(worker, NULL);
+    close(listen_fd);
+    listen_fd = -1;
+    worker_started = false;
+    worker_quit = false;
+}
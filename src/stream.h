@@ -0,0 +1,31 @@
+#ifndef STREAM_H
+#define STREAM_H
+
+#include <stdbool.h>
+
+#include "chip8.h"
+
+/**
+ * Network Frame Streaming
+ *
+ * Ships vram frames to a remote viewer over TCP from a dedicated thread.
+ * Frames are per-row XOR-deltas against the previously sent frame,
+ * entropy-coded with a static Huffman table tuned on typical delta
+ * statistics, so a quiet game stays under a kilobyte per second. Periodic
+ * keyframes bound how long a dropped byte can corrupt the picture. The
+ * emulation loop only ever copies into a bounded ring with drop-oldest
+ * semantics; a slow or stalled client can never block it.
+ */
+
+// Starts the listener on the given TCP port. One viewer at a time; a new
+// connection always opens with a full keyframe.
+bool stream_start(unsigned short port);
+
+// Queues the current display for transmission. Cheap (one vram copy);
+// drops the oldest queued frame when the viewer is behind.
+void stream_publish(const chip8_state_t *state);
+
+// Shuts the listener and worker down and closes any connected viewer.
+void stream_stop(void);
+
+#endif // STREAM_H
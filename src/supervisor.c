@@ -0,0 +1,251 @@
+#define _GNU_SOURCE // pthread_setaffinity_np, sched_getcpu
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdatomic.h>
+#include <time.h>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include <SDL3/SDL.h>
+
+#include "chip8.h"
+#include "telemetry.h"
+#include "supervisor.h"
+
+#define SUPERVISOR_MAX_THREADS 64
+#define SUPERVISOR_MAX_CPUS 64
+
+static chip8_affinity_t affinity_policy = CHIP8_AFFINITY_NONE;
+static int affinity_cpus[SUPERVISOR_MAX_CPUS];
+static int affinity_cpu_count;
+
+typedef struct supervisor_pool {
+    const chip8_session_spec_t *specs;
+    int count;
+    uint64_t cycles;
+    chip8_session_result_t *results;
+    atomic_int next_session; // Workers claim sessions from this shared index
+    atomic_int completed;
+} supervisor_pool_t;
+
+// Runs one session to completion: init, load, execute the budget with a
+// virtual 60Hz timer clock, record the result.
+static void supervisor_run_session(supervisor_pool_t *pool, int index) {
+    const chip8_session_spec_t *spec = &pool->specs[index];
+    chip8_session_result_t *result = &pool->results[index];
+    result->rom = spec->rom;
+    result->cycles_executed = 0;
+    result->state_hash = 0;
+    result->seconds = 0.0;
+    result->cpu_seconds = 0.0;
+
+    chip8_state_t *state = SDL_malloc(sizeof(chip8_state_t));
+    chip8_init(state);
+    chip8_seed(state, 1); // Fixed seed: supervisor runs are reproducible
+    chip8_set_profile(state, spec->profile);
+    chip8_set_core(state, spec->core);
+
+    result->loaded = chip8_load_rom(state, spec->rom);
+    if (!result->loaded) {
+        SDL_free(state);
+        return;
+    }
+
+    const uint64_t instructions_per_timer_tick = CHIP8_DEFAULT_IPS / 60;
+    uint64_t executed = 0;
+    uint64_t next_timer_tick = 0;
+    uint64_t t0 = SDL_GetPerformanceCounter();
+    // Thread CPU time brackets the run: unlike the wall delta it excludes
+    // scheduler preemption, so the cost is the session's alone
+    struct timespec cpu0;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &cpu0);
+
+    while (executed < pool->cycles) {
+        int ran = chip8_run_block(state);
+        if (ran == 0) {
+            // Parked for display wait: skip ahead to the virtual vblank
+            executed = next_timer_tick;
+        } else {
+            executed += ran;
+        }
+
+        while (executed >= next_timer_tick) {
+            next_timer_tick += instructions_per_timer_tick;
+            chip8_vblank(state);
+        }
+    }
+
+    struct timespec cpu1;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &cpu1);
+    result->cpu_seconds = (double)(cpu1.tv_sec - cpu0.tv_sec)
+                        + (double)(cpu1.tv_nsec - cpu0.tv_nsec) / 1e9;
+    result->seconds = (double)(SDL_GetPerformanceCounter() - t0) / SDL_GetPerformanceFrequency();
+    result->cycles_executed = executed;
+    result->state_hash = chip8_state_hash(state);
+
+    atomic_fetch_add(&pool->completed, 1);
+    SDL_free(state);
+}
+
+typedef struct supervisor_worker_arg {
+    supervisor_pool_t *pool;
+    int index;   // Worker ordinal, drives the placement policy
+    int threads; // Workers in this run, for the scatter stride
+} supervisor_worker_arg_t;
+
+// Pins the calling worker per the configured policy. Session state is
+// malloc'd and first-touched on this thread, so pinning also fixes which
+// NUMA node the state lives on.
+static void supervisor_pin_worker(const supervisor_worker_arg_t *warg) {
+    int ncpu = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    if (ncpu <= 0) {
+        return;
+    }
+
+    int cpu;
+    switch (affinity_policy) {
+        case CHIP8_AFFINITY_COMPACT:
+            cpu = warg->index % ncpu;
+            break;
+        case CHIP8_AFFINITY_SCATTER:
+            cpu = (warg->index * ncpu / warg->threads) % ncpu;
+            break;
+        case CHIP8_AFFINITY_EXPLICIT:
+            cpu = affinity_cpus[warg->index % affinity_cpu_count];
+            break;
+        default:
+            return;
+    }
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+}
+
+static void *supervisor_worker(void *arg) {
+    const supervisor_worker_arg_t *warg = arg;
+    supervisor_pool_t *pool = warg->pool;
+
+    supervisor_pin_worker(warg);
+    int home_cpu = sched_getcpu();
+
+    for (;;) {
+        int index = atomic_fetch_add(&pool->next_session, 1);
+        if (index >= pool->count) {
+            return NULL;
+        }
+        supervisor_run_session(pool, index);
+
+        // A worker that wandered off its home CPU may have dragged its
+        // sessions' state across a node boundary; unpinned fleets see
+        // this as run-to-run throughput variance
+        int cpu = sched_getcpu();
+        if (cpu != home_cpu) {
+            telemetry_worker_migrations.value++;
+            home_cpu = cpu;
+        }
+    }
+}
+
+void chip8_supervisor_set_affinity(chip8_affinity_t policy, const int *cpus, int count) {
+    if (policy == CHIP8_AFFINITY_EXPLICIT) {
+        if (count <= 0) {
+            return;
+        }
+        if (count > SUPERVISOR_MAX_CPUS) {
+            count = SUPERVISOR_MAX_CPUS;
+        }
+        for (int i = 0; i < count; i++) {
+            affinity_cpus[i] = cpus[i];
+        }
+        affinity_cpu_count = count;
+    }
+    affinity_policy = policy;
+}
+
+bool chip8_supervisor_affinity_arg(const char *arg) {
+    if (SDL_strcmp(arg, "compact") == 0) {
+        chip8_supervisor_set_affinity(CHIP8_AFFINITY_COMPACT, NULL, 0);
+        return true;
+    }
+    if (SDL_strcmp(arg, "scatter") == 0) {
+        chip8_supervisor_set_affinity(CHIP8_AFFINITY_SCATTER, NULL, 0);
+        return true;
+    }
+    if (arg[0] >= '0' && arg[0] <= '9') {
+        int cpus[SUPERVISOR_MAX_CPUS];
+        int count = 0;
+        const char *p = arg;
+        while (count < SUPERVISOR_MAX_CPUS) {
+            char *end;
+            long cpu = strtol(p, &end, 10);
+            if (end == p || cpu < 0) {
+                return false;
+            }
+            cpus[count++] = (int)cpu;
+            if (*end == '\0') {
+                chip8_supervisor_set_affinity(CHIP8_AFFINITY_EXPLICIT, cpus, count);
+                return true;
+            }
+            if (*end != ',') {
+                return false;
+            }
+            p = end + 1;
+        }
+    }
+    return false;
+}
+
+int chip8_supervisor_run(const char *const *roms, int count, int threads,
+                         uint64_t cycles, chip8_session_result_t *results) {
+    // Plain runs are a matrix of one column: default profile and core
+    chip8_session_spec_t *specs = SDL_malloc((size_t)count * sizeof(*specs));
+    for (int i = 0; i < count; i++) {
+        specs[i].rom = roms[i];
+        specs[i].profile = CHIP8_PROFILE_COSMAC;
+        specs[i].core = CHIP8_CORE_INSTRUMENTED;
+    }
+
+    int completed = chip8_supervisor_run_matrix(specs, count, threads, cycles, results);
+    SDL_free(specs);
+    return completed;
+}
+
+int chip8_supervisor_run_matrix(const chip8_session_spec_t *specs, int count,
+                                int threads, uint64_t cycles,
+                                chip8_session_result_t *results) {
+    if (threads <= 0) {
+        threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+        if (threads <= 0) {
+            threads = 1;
+        }
+    }
+    if (threads > SUPERVISOR_MAX_THREADS) {
+        threads = SUPERVISOR_MAX_THREADS;
+    }
+    if (threads > count) {
+        threads = count;
+    }
+
+    supervisor_pool_t pool = {
+        .specs = specs,
+        .count = count,
+        .cycles = cycles,
+        .results = results,
+    };
+    atomic_init(&pool.next_session, 0);
+    atomic_init(&pool.completed, 0);
+
+    pthread_t workers[SUPERVISOR_MAX_THREADS];
+    supervisor_worker_arg_t wargs[SUPERVISOR_MAX_THREADS];
+    for (int i = 0; i < threads; i++) {
+        wargs[i] = (supervisor_worker_arg_t){ .pool = &pool, .index = i, .threads = threads };
+        pthread_create(&workers[i], NULL, supervisor_worker, &wargs[i]);
+    }
+    for (int i = 0; i < threads; i++) {
+        pthread_join(workers[i], NULL);
+    }
+
+    return atomic_load(&pool.completed);
+}
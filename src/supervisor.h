@@ -0,0 +1,70 @@
+#ifndef SUPERVISOR_H
+#define SUPERVISOR_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "chip8.h"
+
+/**
+ * Chip-8 Session Supervisor
+ *
+ * Runs many independent interpreter instances across a pool of worker
+ * threads. Sessions are self-contained (one chip8_state_t each) and workers
+ * claim them from a shared queue, so one host can execute hundreds of
+ * sessions instead of one.
+ */
+
+// One configured session for a matrix run: the ROM plus the interpreter
+// variant (quirk profile and core) it should execute under
+typedef struct chip8_session_spec {
+    const char *rom;
+    chip8_profile_t profile;
+    chip8_core_t core;
+} chip8_session_spec_t;
+
+/* Thread placement for big multi-socket hosts. Session state is
+   allocated and first-touched by the worker that runs it, so with the
+   workers pinned the memory lands on the worker's own NUMA node and
+   stays there. Without a policy the kernel migrates workers freely and
+   comparable sweep runs diverge. */
+typedef enum chip8_affinity {
+    CHIP8_AFFINITY_NONE,    // Scheduler's choice (default)
+    CHIP8_AFFINITY_COMPACT, // Consecutive CPUs from 0: fill one node first
+    CHIP8_AFFINITY_SCATTER, // Spread workers evenly across the CPU range
+    CHIP8_AFFINITY_EXPLICIT // Caller-supplied CPU list, worker i on cpus[i % n]
+} chip8_affinity_t;
+
+typedef struct chip8_session_result {
+    const char *rom;
+    bool loaded; // False if the ROM failed to load
+    uint64_t cycles_executed;
+    uint64_t state_hash; // chip8_state_hash after the run
+    double seconds; // Wall time this session took on its worker
+    double cpu_seconds; // Thread CPU time the session consumed — the
+                        // capacity-model input: a draw-heavy title costs
+                        // several times an idle menu for the same budget
+} chip8_session_result_t;
+
+// Runs each ROM headless for the given instruction budget, distributed over
+// `threads` workers (0 = one per online CPU). Results land in the caller's
+// array, one entry per ROM, in input order. Returns the number of sessions
+// that loaded and ran.
+int chip8_supervisor_run(const char *const *roms, int count, int threads,
+                         uint64_t cycles, chip8_session_result_t *results);
+
+// As above, but each session carries its own profile and core, so one run
+// can cover a whole variant matrix. Specs may repeat the same ROM.
+int chip8_supervisor_run_matrix(const chip8_session_spec_t *specs, int count,
+                                int threads, uint64_t cycles,
+                                chip8_session_result_t *results);
+
+// Sets the placement policy for subsequent runs. For EXPLICIT, cpus/count
+// give the pin list; the other policies ignore them.
+void chip8_supervisor_set_affinity(chip8_affinity_t policy, const int *cpus, int count);
+
+// Parses a policy argument: "compact", "scatter", or a comma-separated
+// CPU list like "0,2,4,6". Returns false (policy unchanged) on junk.
+bool chip8_supervisor_affinity_arg(const char *arg);
+
+#endif // SUPERVISOR_H
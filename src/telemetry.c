@@ -0,0 +1,190 @@
+#include <stdint.h>
+#include <time.h>
+#include <SDL3/SDL.h>
+
+#include "telemetry.h"
+
+telemetry_hist_t telemetry_tick_exec = {.name = "tick exec"};
+telemetry_hist_t telemetry_sleep_overshoot = {.name = "sleep overshoot"};
+telemetry_hist_t telemetry_present = {.name = "frame present"};
+
+telemetry_hist_t telemetry_latency_consume = {.name = "input consume"};
+telemetry_hist_t telemetry_latency_scanout = {.name = "publish present"};
+telemetry_hist_t telemetry_latency_photon = {.name = "input to photon"};
+
+telemetry_counter_t telemetry_audio_underruns = {.name = "audio underruns"};
+telemetry_counter_t telemetry_audio_queue_peak = {.name = "audio queue peak"};
+telemetry_counter_t telemetry_audio_device_period = {.name = "audio dev period"};
+
+telemetry_counter_t telemetry_startup_sdl = {.name = "startup sdl"};
+telemetry_counter_t telemetry_startup_window = {.name = "startup window"};
+telemetry_counter_t telemetry_startup_rom = {.name = "startup rom"};
+telemetry_counter_t telemetry_startup_audio = {.name = "startup audio"};
+telemetry_counter_t telemetry_startup_first_frame = {.name = "first frame"};
+
+telemetry_counter_t telemetry_clock_stalls = {.name = "host stalls"};
+telemetry_counter_t telemetry_clock_stall_us = {.name = "longest stall"};
+
+telemetry_counter_t telemetry_duty_permille = {.name = "duty cycle"};
+
+telemetry_counter_t telemetry_tick_allocs = {.name = "tick allocs"};
+
+telemetry_counter_t telemetry_worker_migrations = {.name = "worker migrations"};
+
+telemetry_counter_t telemetry_deadline_overruns = {.name = "deadline overruns"};
+
+telemetry_counter_t telemetry_input_chatter = {.name = "chatter dropped"};
+
+telemetry_counter_t telemetry_watchdog_trips = {.name = "watchdog trips"};
+
+telemetry_counter_t telemetry_degrade_steps = {.name = "degrade steps"};
+
+telemetry_counter_t telemetry_config_reloads = {.name = "config reloads"};
+
+telemetry_counter_t telemetry_render_draw_peak = {.name = "draw call peak"};
+telemetry_counter_t telemetry_render_upload_peak = {.name = "tex upload peak"};
+telemetry_counter_t telemetry_render_upload_bytes = {.name = "upload byte peak"};
+
+uint64_t telemetry_now_ns(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+}
+
+void telemetry_record(telemetry_hist_t *hist, uint64_t ns) {
+    // Bucket i holds [2^(i-1), 2^i); zero lands in bucket 0
+    int bucket = ns == 0 ? 0 : 64 - __builtin_clzll(ns);
+    if (bucket >= TELEMETRY_BUCKETS) {
+        bucket = TELEMETRY_BUCKETS - 1;
+    }
+
+    hist->buckets[bucket]++;
+    hist->count++;
+    if (ns > hist->max_ns) {
+        hist->max_ns = ns;
+    }
+}
+
+void telemetry_counter_max(telemetry_counter_t *counter, uint64_t v) {
+    if (v > counter->value) {
+        counter->value = v;
+    }
+}
+
+uint64_t telemetry_percentile(const telemetry_hist_t *hist, double p) {
+    if (hist->count == 0) {
+        return 0;
+    }
+
+    uint64_t target = (uint64_t)(p * hist->count);
+    uint64_t cumulative = 0;
+
+    for (int bucket = 0; bucket < TELEMETRY_BUCKETS; bucket++) {
+        cumulative += hist->buckets[bucket];
+        if (cumulative > target) {
+            return bucket == 0 ? 0 : 1ULL << bucket; // Bucket upper bound
+        }
+    }
+    return hist->max_ns;
+}
+
+static void telemetry_report_hist(const telemetry_hist_t *hist) {
+    if (hist->count == 0) {
+        return;
+    }
+    SDL_Log("%-16s n=%-8llu p50=%.3fms p95=%.3fms p99=%.3fms max=%.3fms",
+            hist->name,
+            (unsigned long long)hist->count,
+            telemetry_percentile(hist, 0.50) / 1e6,
+            telemetry_percentile(hist, 0.95) / 1e6,
+            telemetry_percentile(hist, 0.99) / 1e6,
+            hist->max_ns / 1e6);
+}
+
+static void telemetry_report_counter(const telemetry_counter_t *counter, const char *unit) {
+    if (counter->value == 0) {
+        return;
+    }
+    SDL_Log("%-16s %llu%s", counter->name, (unsigned long long)counter->value, unit);
+}
+
+void telemetry_report(void) {
+    telemetry_report_hist(&telemetry_tick_exec);
+    telemetry_report_hist(&telemetry_sleep_overshoot);
+    telemetry_report_hist(&telemetry_present);
+    telemetry_report_hist(&telemetry_latency_consume);
+    telemetry_report_hist(&telemetry_latency_scanout);
+    telemetry_report_hist(&telemetry_latency_photon);
+    telemetry_report_counter(&telemetry_audio_underruns, "");
+    telemetry_report_counter(&telemetry_audio_queue_peak, " bytes");
+    telemetry_report_counter(&telemetry_audio_device_period, " bytes");
+    telemetry_report_counter(&telemetry_startup_sdl, " us");
+    telemetry_report_counter(&telemetry_startup_window, " us");
+    telemetry_report_counter(&telemetry_startup_rom, " us");
+    telemetry_report_counter(&telemetry_startup_audio, " us");
+    telemetry_report_counter(&telemetry_startup_first_frame, " us");
+    telemetry_report_counter(&telemetry_clock_stalls, "");
+    telemetry_report_counter(&telemetry_clock_stall_us, " us");
+    telemetry_report_counter(&telemetry_duty_permille, " permille");
+    telemetry_report_counter(&telemetry_tick_allocs, "");
+    telemetry_report_counter(&telemetry_worker_migrations, "");
+    telemetry_report_counter(&telemetry_deadline_overruns, "");
+    telemetry_report_counter(&telemetry_input_chatter, "");
+    telemetry_report_counter(&telemetry_watchdog_trips, "");
+    telemetry_report_counter(&telemetry_degrade_steps, "");
+    telemetry_report_counter(&telemetry_config_reloads, "");
+    telemetry_report_counter(&telemetry_render_draw_peak, "/frame");
+    telemetry_report_counter(&telemetry_render_upload_peak, "/frame");
+    telemetry_report_counter(&telemetry_render_upload_bytes, " bytes/frame");
+}
+
+// Enumeration tables for serializers, in the same order as the report
+// above; a new signal gets a row here when it gets its report line
+static const telemetry_hist_t *const all_hists[] = {
+    &telemetry_tick_exec,
+    &telemetry_sleep_overshoot,
+    &telemetry_present,
+    &telemetry_latency_consume,
+    &telemetry_latency_scanout,
+    &telemetry_latency_photon,
+};
+
+static const telemetry_counter_t *const all_counters[] = {
+    &telemetry_audio_underruns,
+    &telemetry_audio_queue_peak,
+    &telemetry_audio_device_period,
+    &telemetry_startup_sdl,
+    &telemetry_startup_window,
+    &telemetry_startup_rom,
+    &telemetry_startup_audio,
+    &telemetry_startup_first_frame,
+    &telemetry_clock_stalls,
+    &telemetry_clock_stall_us,
+    &telemetry_duty_permille,
+    &telemetry_tick_allocs,
+    &telemetry_worker_migrations,
+    &telemetry_deadline_overruns,
+    &telemetry_input_chatter,
+    &telemetry_watchdog_trips,
+    &telemetry_degrade_steps,
+    &telemetry_config_reloads,
+    &telemetry_render_draw_peak,
+    &telemetry_render_upload_peak,
+    &telemetry_render_upload_bytes,
+};
+
+int telemetry_hist_count(void) {
+    return (int)(sizeof(all_hists) / sizeof(all_hists[0]));
+}
+
+const telemetry_hist_t *telemetry_hist_at(int index) {
+    return all_hists[index];
+}
+
+int telemetry_counter_count(void) {
+    return (int)(sizeof(all_counters) / sizeof(all_counters[0]));
+}
+
+const telemetry_counter_t *telemetry_counter_at(int index) {
+    return all_counters[index];
+}
@@ -0,0 +1,133 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <stdint.h>
+
+/**
+ * Pacing Telemetry
+ *
+ * Fixed-size log2 histograms for the timing signals that decide pacing
+ * quality: how long a tick's execution batch takes, how far the scheduler
+ * sleep overshoots its deadline, and how long a frame present takes.
+ * Recording is one increment into a static bucket — no allocation, cheap
+ * enough for the hot path. Percentiles come out on exit or on demand.
+ */
+
+#define TELEMETRY_BUCKETS 64 // One per log2(ns); covers anything representable
+
+typedef struct telemetry_hist {
+    const char *name;
+    uint64_t buckets[TELEMETRY_BUCKETS];
+    uint64_t count;
+    uint64_t max_ns;
+} telemetry_hist_t;
+
+// A plain named value for signals where a distribution is overkill:
+// event counts and watermarks
+typedef struct telemetry_counter {
+    const char *name;
+    uint64_t value;
+} telemetry_counter_t;
+
+// The three pacing signals. Each is written from exactly one thread
+// (present from the render thread, the others from the emulation thread).
+extern telemetry_hist_t telemetry_tick_exec;
+extern telemetry_hist_t telemetry_sleep_overshoot;
+extern telemetry_hist_t telemetry_present;
+
+// Input-to-photon stages, filled by the --latency mode (see latency.h):
+// key event to the EX9E/EXA1 that tested it, frame publish to present,
+// and the end-to-end trip
+extern telemetry_hist_t telemetry_latency_consume;
+extern telemetry_hist_t telemetry_latency_scanout;
+extern telemetry_hist_t telemetry_latency_photon;
+
+// Audio health, written from the audio callback thread: times the queue
+// drained while the buzzer should be sounding, the deepest the queue got,
+// and the largest single device request (the effective device period)
+extern telemetry_counter_t telemetry_audio_underruns;
+extern telemetry_counter_t telemetry_audio_queue_peak;
+extern telemetry_counter_t telemetry_audio_device_period;
+
+// Startup phase durations in microseconds, each set once during boot:
+// SDL init, window/renderer/texture creation, ROM load, the deferred
+// audio device open, and main() entry to the first present
+extern telemetry_counter_t telemetry_startup_sdl;
+extern telemetry_counter_t telemetry_startup_window;
+extern telemetry_counter_t telemetry_startup_rom;
+extern telemetry_counter_t telemetry_startup_audio;
+extern telemetry_counter_t telemetry_startup_first_frame;
+
+// Host stalls the clock module detected (gaps past the catch-up cap in
+// clock.h) and the longest one observed, in microseconds
+extern telemetry_counter_t telemetry_clock_stalls;
+extern telemetry_counter_t telemetry_clock_stall_us;
+
+// Emulation duty cycle in permille of wall time, an EWMA maintained by
+// the energy governor (--energy); stays zero otherwise
+extern telemetry_counter_t telemetry_duty_permille;
+
+// Allocations that landed inside a tick window — the hot path is supposed
+// to be heap-free, so anything nonzero here is a regression (see
+// alloctrap.h; a CHIP8_ALLOC_TRIPWIRE build aborts instead of counting)
+extern telemetry_counter_t telemetry_tick_allocs;
+
+// Times a supervisor worker came back from a session on a different CPU
+// than it started on — a proxy for cross-node memory traffic on NUMA
+// hosts. Stays zero under a pinning policy (see supervisor.h).
+extern telemetry_counter_t telemetry_worker_migrations;
+
+// Keypad transitions dropped as encoder contact chatter by the input
+// debounce window (see input.h); anything here on a healthy keyboard
+// setup means the window is too wide
+extern telemetry_counter_t telemetry_input_chatter;
+
+// Times the hung-ROM watchdog fired its recovery policy (see watchdog.h);
+// on a curated library this staying zero is the health signal
+extern telemetry_counter_t telemetry_watchdog_trips;
+
+// Loop iterations that reached the housekeeping stage with the quantum's
+// pacing deadline already spent: the disk-backed work (journal
+// checkpoint, archive append, on-demand dumps) was deferred to a later,
+// lighter iteration so input and frame publish kept their cadence (see
+// the deadline budget block in main.c)
+extern telemetry_counter_t telemetry_deadline_overruns;
+
+// Degradation-ladder transitions, escalations and recoveries both (see
+// degrade.h); a busy counter here means the host is marginal for its
+// load and the session spent time below full fidelity
+extern telemetry_counter_t telemetry_degrade_steps;
+
+// Validated live-config loads applied at a quantum boundary (see
+// liveconfig.h); rejected files don't count — they only log
+extern telemetry_counter_t telemetry_config_reloads;
+
+// Render batching health, written from the render thread: the most SDL
+// draw calls issued in a single presented frame, the most texture
+// uploads, and the most bytes uploaded. A renderer change that breaks
+// batching raises one of these on the affected backend.
+extern telemetry_counter_t telemetry_render_draw_peak;
+extern telemetry_counter_t telemetry_render_upload_peak;
+extern telemetry_counter_t telemetry_render_upload_bytes;
+
+uint64_t telemetry_now_ns(void);
+void telemetry_record(telemetry_hist_t *hist, uint64_t ns);
+
+// Raises the counter to v if v is larger (watermark semantics)
+void telemetry_counter_max(telemetry_counter_t *counter, uint64_t v);
+
+// Approximate percentile (upper bound of the bucket holding it), p in [0,1]
+uint64_t telemetry_percentile(const telemetry_hist_t *hist, double p);
+
+// Logs n/p50/p95/p99/max for every histogram with samples
+void telemetry_report(void);
+
+// Stable enumeration in declaration order, for serializers that want
+// every signal without hand-listing them (see export.h). Indexes are
+// valid for the life of the process.
+int telemetry_hist_count(void);
+const telemetry_hist_t *telemetry_hist_at(int index);
+int telemetry_counter_count(void);
+const telemetry_counter_t *telemetry_counter_at(int index);
+
+#endif // TELEMETRY_H
@@ -0,0 +1,476 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <pthread.h>
+#include <SDL3/SDL.h>
+
+#include "chip8.h"
+#include "supervisor.h"
+
+/**
+ * Chip-8 Golden-Output Test Runner
+ *
+ * Executes the bundled test ROMs headless for a fixed instruction count
+ * (fixed seed, virtual 60Hz timers) and compares the final vram/register
+ * hash against stored goldens. Runs all ROMs in parallel through the
+ * supervisor, so it doubles as a throughput smoke test. Any intentional
+ * core behavior change must update the table below; run with --print to
+ * get the new values.
+ */
+
+#define TEST_CYCLES 100000
+
+typedef struct golden_entry {
+    const char *rom;
+    uint64_t hash;
+} golden_entry_t;
+
+static const golden_entry_t goldens[] = {
+    {"roms/corax.ch8",  0xb88383dda1bc1cf3ULL},
+    {"roms/flags.ch8",  0x771477fcd3ebdb29ULL},
+    {"roms/quirks.ch8", 0x75f41dcbc1ec1f38ULL},
+    {"roms/input.ch8",  0x1cd0bc9da22084fbULL},
+};
+
+#define GOLDEN_COUNT (int)(sizeof(goldens) / sizeof(goldens[0]))
+
+/* Conformance matrix (--conformance): runs the behavior-reporting ROMs
+   under every quirk profile crossed with every core variant in one
+   parallel batch. The expected hash depends only on ROM and profile —
+   the stored goldens below are per profile, so a specialized core that
+   diverges from its instrumented twin fails its cell. Update the table
+   with --conformance --print after intentional behavior changes. */
+
+static const char *const conformance_roms[] = {
+    "roms/quirks.ch8",
+    "roms/input.ch8",
+};
+
+#define CONFORMANCE_ROMS (int)(sizeof(conformance_roms) / sizeof(conformance_roms[0]))
+
+static const uint64_t conformance_goldens[CONFORMANCE_ROMS][CHIP8_PROFILE_COUNT] = {
+    {0x75f41dcbc1ec1f38ULL, 0xeeab85211ba7ec3dULL}, // roms/quirks.ch8
+    {0x1cd0bc9da22084fbULL, 0xfa55015b33286e80ULL}, // roms/input.ch8
+};
+
+static const char *const profile_names[CHIP8_PROFILE_COUNT] = {"cosmac", "modern"};
+static const char *const core_names[CHIP8_CORE_COUNT] = {"instrumented", "fast"};
+
+static int run_conformance(bool print_only) {
+    chip8_session_spec_t specs[CONFORMANCE_ROMS * CHIP8_PROFILE_COUNT * CHIP8_CORE_COUNT];
+    chip8_session_result_t results[CONFORMANCE_ROMS * CHIP8_PROFILE_COUNT * CHIP8_CORE_COUNT];
+
+    int count = 0;
+    for (int r = 0; r < CONFORMANCE_ROMS; r++) {
+        for (int p = 0; p < CHIP8_PROFILE_COUNT; p++) {
+            for (int c = 0; c < CHIP8_CORE_COUNT; c++) {
+                specs[count].rom = conformance_roms[r];
+                specs[count].profile = (chip8_profile_t)p;
+                specs[count].core = (chip8_core_t)c;
+                count++;
+            }
+        }
+    }
+
+    chip8_supervisor_run_matrix(specs, count, 0, TEST_CYCLES, results);
+
+    int failures = 0;
+    for (int r = 0; r < CONFORMANCE_ROMS; r++) {
+        if (print_only) {
+            printf("    {");
+            for (int p = 0; p < CHIP8_PROFILE_COUNT; p++) {
+                int cell = (r * CHIP8_PROFILE_COUNT + p) * CHIP8_CORE_COUNT;
+                printf("%s0x%016llxULL", p == 0 ? "" : ", ",
+                       (unsigned long long)results[cell].state_hash);
+            }
+            printf("}, // %s\n", conformance_roms[r]);
+            continue;
+        }
+
+        for (int p = 0; p < CHIP8_PROFILE_COUNT; p++) {
+            printf("%-18s %-8s", conformance_roms[r], profile_names[p]);
+
+            bool row_ok = true;
+            for (int c = 0; c < CHIP8_CORE_COUNT; c++) {
+                int cell = (r * CHIP8_PROFILE_COUNT + p) * CHIP8_CORE_COUNT + c;
+                bool cell_ok = results[cell].loaded &&
+                               results[cell].state_hash == conformance_goldens[r][p];
+                row_ok = row_ok && cell_ok;
+                printf("  %s=%016llx%s", core_names[c],
+                       (unsigned long long)results[cell].state_hash,
+                       cell_ok ? "" : "!");
+            }
+            printf("  %s\n", row_ok ? "PASS" : "FAIL");
+            failures += row_ok ? 0 : 1;
+        }
+    }
+
+    if (!print_only) {
+        printf("%d/%d matrix rows conformant\n",
+               CONFORMANCE_ROMS * CHIP8_PROFILE_COUNT - failures,
+               CONFORMANCE_ROMS * CHIP8_PROFILE_COUNT);
+    }
+    return failures == 0 ? 0 : 1;
+}
+
+/* ALU sweep (--alu): every 8XYN handler exhaustively checked against an
+   independent reference model over all 256x256 operand values, crossed
+   with both quirk profiles, both core variants, and the register
+   aliasing shapes (X==Y, X==F, Y==F) that exercise the flag-write-order
+   corners. One shard per opcode/profile cell runs on its own thread, so
+   the ~12M single-steps finish in seconds and can gate any handler
+   rewrite. No goldens: the reference model below is the spec. */
+
+static const uint8_t alu_sweep_ops[] = {0x0, 0x1, 0x2, 0x3, 0x4, 0x5, 0x6, 0x7, 0xE};
+#define ALU_SWEEP_OPS (int)(sizeof(alu_sweep_ops) / sizeof(alu_sweep_ops[0]))
+
+// The plain pair plus every aliasing shape: VF is both an operand
+// register and the flag destination, so X or Y being F changes which
+// write survives
+static const struct { uint8_t x, y; } alu_sweep_pairs[] = {
+    {0x0, 0x1}, {0x2, 0x2}, {0xF, 0x1}, {0x1, 0xF}, {0xF, 0xF},
+};
+#define ALU_SWEEP_PAIRS (int)(sizeof(alu_sweep_pairs) / sizeof(alu_sweep_pairs[0]))
+
+#define ALU_SWEEP_REPORT_CAP 5 // Mismatch lines printed per shard
+
+// Reference semantics, written from the specification rather than the
+// handlers: both operands read first, the result stored to VX, then the
+// flag (or the COSMAC VF reset) stored last so it wins when X is F
+static void alu_sweep_reference(uint8_t regs[16], uint8_t n, uint8_t x, uint8_t y,
+                                bool cosmac) {
+    uint8_t rx = regs[x];
+    uint8_t ry = regs[y];
+    switch (n) {
+        case 0x0:
+            regs[x] = ry;
+            break;
+        case 0x1:
+            regs[x] = rx | ry;
+            if (cosmac) regs[0xF] = 0;
+            break;
+        case 0x2:
+            regs[x] = rx & ry;
+            if (cosmac) regs[0xF] = 0;
+            break;
+        case 0x3:
+            regs[x] = rx ^ ry;
+            if (cosmac) regs[0xF] = 0;
+            break;
+        case 0x4:
+            regs[x] = (uint8_t)(rx + ry);
+            regs[0xF] = rx + ry > 255 ? 1 : 0;
+            break;
+        case 0x5:
+            regs[x] = (uint8_t)(rx - ry);
+            regs[0xF] = rx >= ry ? 1 : 0;
+            break;
+        case 0x6: {
+            uint8_t src = cosmac ? ry : rx; // COSMAC shifts VY into VX
+            regs[x] = src >> 1;
+            regs[0xF] = src & 1;
+            break;
+        }
+        case 0x7:
+            regs[x] = (uint8_t)(ry - rx);
+            regs[0xF] = ry >= rx ? 1 : 0;
+            break;
+        case 0xE: {
+            uint8_t src = cosmac ? ry : rx;
+            regs[x] = (uint8_t)(src << 1);
+            regs[0xF] = (src >> 7) & 1;
+            break;
+        }
+    }
+}
+
+typedef struct alu_sweep_shard {
+    uint8_t op;
+    chip8_profile_t profile;
+    uint64_t checked;
+    int failures;
+    pthread_t thread;
+} alu_sweep_shard_t;
+
+static void *alu_sweep_main(void *arg) {
+    alu_sweep_shard_t *shard = arg;
+    bool cosmac = shard->profile == CHIP8_PROFILE_COSMAC;
+
+    chip8_state_t *state = SDL_malloc(sizeof(chip8_state_t));
+    if (state == NULL) {
+        shard->failures = 1;
+        return NULL;
+    }
+    chip8_init(state);
+
+    for (int c = 0; c < CHIP8_CORE_COUNT; c++) {
+        for (int pair = 0; pair < ALU_SWEEP_PAIRS; pair++) {
+            uint8_t x = alu_sweep_pairs[pair].x;
+            uint8_t y = alu_sweep_pairs[pair].y;
+            uint8_t rom[2] = {(uint8_t)(0x80 | x), (uint8_t)(y << 4 | shard->op)};
+            chip8_load_rom_memory(state, rom, sizeof(rom));
+            chip8_set_profile(state, shard->profile);
+            chip8_set_core(state, (chip8_core_t)c);
+
+            for (int a = 0; a < 256; a++) {
+                for (int b = 0; b < 256; b++) {
+                    memset(state->registers, 0, sizeof(state->registers));
+                    state->registers[x] = (uint8_t)a;
+                    state->registers[y] = (uint8_t)b; // X==Y: b wins, a is a dup pass
+                    state->program_counter = 0x200;
+                    chip8_step(state);
+
+                    uint8_t expected[16] = {0};
+                    expected[x] = (uint8_t)a;
+                    expected[y] = (uint8_t)b;
+                    alu_sweep_reference(expected, shard->op, x, y, cosmac);
+
+                    if (memcmp(expected, state->registers, sizeof(expected)) != 0 ||
+                        state->program_counter != 0x202) {
+                        if (shard->failures < ALU_SWEEP_REPORT_CAP) {
+                            printf("FAIL 8%X%X%X %s %s v%X=%02X v%X=%02X: "
+                                   "vx=%02X vf=%02X, expected vx=%02X vf=%02X\n",
+                                   x, y, shard->op,
+                                   profile_names[shard->profile], core_names[c],
+                                   x, a, y, b,
+                                   state->registers[x], state->registers[0xF],
+                                   expected[x], expected[0xF]);
+                        }
+                        shard->failures++;
+                    }
+                    shard->checked++;
+                }
+            }
+        }
+    }
+
+    SDL_free(state);
+    return NULL;
+}
+
+static int run_alu_sweep(void) {
+    alu_sweep_shard_t shards[ALU_SWEEP_OPS * CHIP8_PROFILE_COUNT];
+
+    int count = 0;
+    for (int op = 0; op < ALU_SWEEP_OPS; op++) {
+        for (int p = 0; p < CHIP8_PROFILE_COUNT; p++) {
+            shards[count].op = alu_sweep_ops[op];
+            shards[count].profile = (chip8_profile_t)p;
+            shards[count].checked = 0;
+            shards[count].failures = 0;
+            pthread_create(&shards[count].thread, NULL, alu_sweep_main, &shards[count]);
+            count++;
+        }
+    }
+
+    int failures = 0;
+    uint64_t checked = 0;
+    for (int i = 0; i < count; i++) {
+        pthread_join(shards[i].thread, NULL);
+        failures += shards[i].failures;
+        checked += shards[i].checked;
+        printf("8XY%X %-8s %llu cases %s\n", shards[i].op,
+               profile_names[shards[i].profile],
+               (unsigned long long)shards[i].checked,
+               shards[i].failures == 0 ? "PASS" : "FAIL");
+    }
+
+    printf("%llu ALU cases swept, %d mismatches\n",
+           (unsigned long long)checked, failures);
+    return failures == 0 ? 0 : 1;
+}
+
+/* Flag-semantics suite (--flags): the VF corner cases that make handler
+   rewrites dangerous, gated as its own target so a speed change to the
+   8XYN family can't land without it. Two halves: flags.ch8 (written to
+   validate exactly these semantics) runs under every profile crossed
+   with every core against per-profile goldens, then a property sweep
+   executes random straight-line 8XYN blocks through the block executor
+   and compares the whole register file against the reference model
+   applied op by op. The sweep goes through chip8_run rather than
+   chip8_step, so flag-write ordering inside fused/block execution is
+   covered too — the exhaustive --alu sweep only ever single-steps. */
+
+static const uint64_t flags_goldens[CHIP8_PROFILE_COUNT] = {
+    0x771477fcd3ebdb29ULL, // cosmac
+    0x771477fcd3ebdb29ULL, // modern
+};
+
+#define FLAGS_TRIALS 4096
+#define FLAGS_BLOCK_OPS 16
+
+// Fixed-seed xorshift: a failing trial reproduces by its number
+static uint32_t flags_rand_state;
+static uint32_t flags_rand(void) {
+    flags_rand_state ^= flags_rand_state << 13;
+    flags_rand_state ^= flags_rand_state >> 17;
+    flags_rand_state ^= flags_rand_state << 5;
+    return flags_rand_state;
+}
+
+static int run_flags(bool print_only) {
+    // flags.ch8 under every profile x core, conformance-style
+    chip8_session_spec_t specs[CHIP8_PROFILE_COUNT * CHIP8_CORE_COUNT];
+    chip8_session_result_t results[CHIP8_PROFILE_COUNT * CHIP8_CORE_COUNT];
+    int count = 0;
+    for (int p = 0; p < CHIP8_PROFILE_COUNT; p++) {
+        for (int c = 0; c < CHIP8_CORE_COUNT; c++) {
+            specs[count].rom = "roms/flags.ch8";
+            specs[count].profile = (chip8_profile_t)p;
+            specs[count].core = (chip8_core_t)c;
+            count++;
+        }
+    }
+    chip8_supervisor_run_matrix(specs, count, 0, TEST_CYCLES, results);
+
+    int failures = 0;
+    for (int p = 0; p < CHIP8_PROFILE_COUNT; p++) {
+        if (print_only) {
+            printf("    0x%016llxULL, // %s\n",
+                   (unsigned long long)results[p * CHIP8_CORE_COUNT].state_hash,
+                   profile_names[p]);
+            continue;
+        }
+        for (int c = 0; c < CHIP8_CORE_COUNT; c++) {
+            int cell = p * CHIP8_CORE_COUNT + c;
+            bool ok = results[cell].loaded &&
+                      results[cell].state_hash == flags_goldens[p];
+            printf("flags.ch8 %-8s %-12s %016llx %s\n", profile_names[p],
+                   core_names[c], (unsigned long long)results[cell].state_hash,
+                   ok ? "PASS" : "FAIL");
+            failures += ok ? 0 : 1;
+        }
+    }
+    if (print_only) {
+        return 0;
+    }
+
+    // Property sweep: random 8XYN blocks, executed whole, checked whole
+    chip8_state_t *state = SDL_malloc(sizeof(chip8_state_t));
+    chip8_init(state);
+    flags_rand_state = 1;
+
+    uint64_t block_failures = 0;
+    for (int p = 0; p < CHIP8_PROFILE_COUNT; p++) {
+        for (int c = 0; c < CHIP8_CORE_COUNT; c++) {
+            for (int trial = 0; trial < FLAGS_TRIALS; trial++) {
+                uint8_t program[FLAGS_BLOCK_OPS * 2 + 2];
+                uint8_t ops[FLAGS_BLOCK_OPS], xs[FLAGS_BLOCK_OPS], ys[FLAGS_BLOCK_OPS];
+                for (int i = 0; i < FLAGS_BLOCK_OPS; i++) {
+                    ops[i] = alu_sweep_ops[flags_rand() % ALU_SWEEP_OPS];
+                    xs[i] = flags_rand() & 0xF;
+                    ys[i] = flags_rand() & 0xF;
+                    program[i * 2] = 0x80 | xs[i];
+                    program[i * 2 + 1] = (uint8_t)(ys[i] << 4 | ops[i]);
+                }
+                // Jump-to-self tail: terminates the block, parks the pc
+                uint16_t tail = 0x200 + FLAGS_BLOCK_OPS * 2;
+                program[FLAGS_BLOCK_OPS * 2] = (uint8_t)(0x10 | tail >> 8);
+                program[FLAGS_BLOCK_OPS * 2 + 1] = (uint8_t)tail;
+
+                chip8_load_rom_memory(state, program, sizeof(program));
+                chip8_set_profile(state, (chip8_profile_t)p);
+                chip8_set_core(state, (chip8_core_t)c);
+
+                uint8_t expected[16];
+                for (int r = 0; r < 16; r++) {
+                    expected[r] = (uint8_t)flags_rand();
+                    state->registers[r] = expected[r];
+                }
+                state->program_counter = 0x200;
+                state->idle = false; // The previous tail parked us
+                chip8_run(state, FLAGS_BLOCK_OPS);
+                for (int i = 0; i < FLAGS_BLOCK_OPS; i++) {
+                    alu_sweep_reference(expected, ops[i], xs[i], ys[i],
+                                        p == CHIP8_PROFILE_COSMAC);
+                }
+
+                if (memcmp(expected, state->registers, sizeof(expected)) != 0) {
+                    if (block_failures < ALU_SWEEP_REPORT_CAP) {
+                        printf("FAIL block trial %d %s %s: register file diverged\n",
+                               trial, profile_names[p], core_names[c]);
+                    }
+                    block_failures++;
+                }
+            }
+        }
+    }
+    SDL_free(state);
+
+    printf("%d random blocks swept, %llu mismatches\n",
+           FLAGS_TRIALS * CHIP8_PROFILE_COUNT * CHIP8_CORE_COUNT,
+           (unsigned long long)block_failures);
+    return failures == 0 && block_failures == 0 ? 0 : 1;
+}
+
+int main(int argc, char *argv[]) {
+    // Placement policy for the worker pool, e.g. --affinity compact when
+    // benchmarking on a multi-socket host (see supervisor.h)
+    if (argc > 2 && SDL_strcmp(argv[1], "--affinity") == 0) {
+        if (!chip8_supervisor_affinity_arg(argv[2])) {
+            printf("bad affinity policy: %s\n", argv[2]);
+            return 1;
+        }
+        argv += 2;
+        argc -= 2;
+    }
+
+    if (argc > 1 && SDL_strcmp(argv[1], "--conformance") == 0) {
+        return run_conformance(argc > 2 && SDL_strcmp(argv[2], "--print") == 0);
+    }
+
+    if (argc > 1 && SDL_strcmp(argv[1], "--alu") == 0) {
+        return run_alu_sweep();
+    }
+
+    if (argc > 1 && SDL_strcmp(argv[1], "--flags") == 0) {
+        return run_flags(argc > 2 && SDL_strcmp(argv[2], "--print") == 0);
+    }
+
+    bool print_only = argc > 1 && SDL_strcmp(argv[1], "--print") == 0;
+
+    const char *roms[GOLDEN_COUNT];
+    for (int i = 0; i < GOLDEN_COUNT; i++) {
+        roms[i] = goldens[i].rom;
+    }
+
+    chip8_session_result_t results[GOLDEN_COUNT];
+    int completed = chip8_supervisor_run(roms, GOLDEN_COUNT, 0, TEST_CYCLES, results);
+
+    int failures = 0;
+    double total_seconds = 0.0;
+
+    for (int i = 0; i < GOLDEN_COUNT; i++) {
+        if (!results[i].loaded) {
+            printf("FAIL %-18s could not load\n", goldens[i].rom);
+            failures++;
+            continue;
+        }
+        total_seconds += results[i].seconds;
+
+        if (print_only) {
+            printf("    {\"%s\", 0x%016llxULL},\n", goldens[i].rom,
+                   (unsigned long long)results[i].state_hash);
+            continue;
+        }
+
+        if (results[i].state_hash != goldens[i].hash) {
+            printf("FAIL %-18s expected %016llx got %016llx\n", goldens[i].rom,
+                   (unsigned long long)goldens[i].hash,
+                   (unsigned long long)results[i].state_hash);
+            failures++;
+        } else {
+            printf("PASS %-18s %016llx (%.0fk inst/s)\n", goldens[i].rom,
+                   (unsigned long long)results[i].state_hash,
+                   results[i].cycles_executed / results[i].seconds / 1e3);
+        }
+    }
+
+    if (print_only) {
+        return 0;
+    }
+
+    printf("%d/%d passed, %d sessions, %.3fs total cpu\n",
+           GOLDEN_COUNT - failures, GOLDEN_COUNT, completed, total_seconds);
+    return failures == 0 ? 0 : 1;
+}
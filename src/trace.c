@@ -0,0 +1,127 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <SDL3/SDL.h>
+
+#include "trace.h"
+#include "arena.h"
+
+/**
+ * Chip-8 Execution Tracing
+ *
+ * Opt-in instruction tracing. When enabled, the execution loop pushes
+ * fixed-size binary records into a preallocated ring buffer; a background
+ * thread drains the ring to a file. When disabled (the default), the hot
+ * path pays a single flag test and no formatting or I/O.
+ */
+
+#define TRACE_RING_SIZE 65536 // Default entries; must be a power of two
+
+typedef struct trace_record {
+    uint64_t timestamp_ns;
+    uint16_t program_counter;
+    uint16_t opcode;
+    uint32_t padding;
+} trace_record_t;
+
+_Static_assert(TRACE_RING_SIZE * sizeof(trace_record_t) == TRACE_ARENA_BYTES,
+               "trace arena budget must match the ring size");
+
+bool trace_enabled = false;
+
+static trace_record_t *trace_ring; // Arena-backed, carved out in trace_start
+static size_t trace_ring_entries = TRACE_RING_SIZE; // Shrunk under --mem-budget
+static atomic_uint_fast64_t trace_head = 0; // Next slot to write (producer)
+static atomic_uint_fast64_t trace_tail = 0; // Next slot to read (consumer)
+
+static FILE *trace_file = NULL;
+static pthread_t trace_thread;
+static atomic_bool trace_running = false;
+
+// Called from the execution loop. Single producer; drops records when the
+// drain thread falls behind rather than ever blocking emulation.
+void trace_emit(uint16_t program_counter, uint16_t opcode) {
+    uint64_t head = atomic_load_explicit(&trace_head, memory_order_relaxed);
+    uint64_t tail = atomic_load_explicit(&trace_tail, memory_order_acquire);
+
+    if (head - tail >= trace_ring_entries) {
+        return; // Ring full, drop
+    }
+
+    trace_record_t *record = &trace_ring[head & (trace_ring_entries - 1)];
+    record->timestamp_ns = SDL_GetTicksNS();
+    record->program_counter = program_counter;
+    record->opcode = opcode;
+    record->padding = 0;
+
+    atomic_store_explicit(&trace_head, head + 1, memory_order_release);
+}
+
+static void *trace_drain(void *arg) {
+    while (atomic_load_explicit(&trace_running, memory_order_acquire) ||
+           atomic_load(&trace_tail) != atomic_load(&trace_head)) {
+        uint64_t head = atomic_load_explicit(&trace_head, memory_order_acquire);
+        uint64_t tail = atomic_load_explicit(&trace_tail, memory_order_relaxed);
+
+        if (tail == head) {
+            SDL_DelayNS(1000000); // Nothing queued, back off 1ms
+            continue;
+        }
+
+        while (tail != head) {
+            fwrite(&trace_ring[tail & (trace_ring_entries - 1)], sizeof(trace_record_t), 1, trace_file);
+            tail++;
+        }
+        atomic_store_explicit(&trace_tail, tail, memory_order_release);
+    }
+    return NULL;
+}
+
+size_t trace_set_budget(size_t bytes) {
+    if (trace_ring != NULL) {
+        return trace_ring_entries * sizeof(trace_record_t); // Already carved
+    }
+    size_t entries = TRACE_RING_SIZE;
+    while (entries * sizeof(trace_record_t) > bytes &&
+           entries * sizeof(trace_record_t) > TRACE_ARENA_MIN_BYTES) {
+        entries /= 2; // Halving keeps the index mask valid
+    }
+    trace_ring_entries = entries;
+    return entries * sizeof(trace_record_t);
+}
+
+bool trace_start(const char *filename) {
+    // A live toggle may start tracing repeatedly; the ring is carved once
+    // and reused across sessions
+    if (trace_ring == NULL) {
+        trace_ring = arena_alloc("trace ring", trace_ring_entries * sizeof(trace_record_t));
+    }
+    if (trace_ring == NULL) {
+        return false;
+    }
+
+    trace_file = fopen(filename, "wb");
+    if (trace_file == NULL) {
+        SDL_Log("Couldn't open trace file: %s", filename);
+        return false;
+    }
+
+    atomic_store(&trace_running, true);
+    pthread_create(&trace_thread, NULL, trace_drain, NULL);
+    trace_enabled = true;
+
+    SDL_Log("Tracing to %s", filename);
+    return true;
+}
+
+void trace_stop(void) {
+    if (!trace_enabled) {
+        return;
+    }
+    trace_enabled = false;
+    atomic_store(&trace_running, false);
+    pthread_join(trace_thread, NULL);
+    fclose(trace_file);
+    trace_file = NULL;
+}
@@ -0,0 +1,32 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * Chip-8 Execution Tracing
+ *
+ * Opt-in binary instruction tracing through a lock-free ring buffer. See
+ * trace.c for the record layout and draining model.
+ */
+
+// Arena budget: ring entries times the 16-byte record (layout is fixed;
+// trace.c asserts the product)
+#define TRACE_ARENA_BYTES (65536 * 16)
+
+// Smallest ring bounded memory mode may shrink to (1024 entries)
+#define TRACE_ARENA_MIN_BYTES (1024 * 16)
+
+extern bool trace_enabled;
+
+// Caps the ring's arena budget below the default (--mem-budget); call
+// before the ring is carved. Rounds down to a power-of-two entry count,
+// floored at TRACE_ARENA_MIN_BYTES, and returns the bytes adopted.
+size_t trace_set_budget(size_t bytes);
+
+bool trace_start(const char *filename);
+void trace_stop(void);
+void trace_emit(uint16_t program_counter, uint16_t opcode);
+
+#endif // TRACE_H
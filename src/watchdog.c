@@ -0,0 +1,60 @@
+#include <stdint.h>
+#include <stdbool.h>
+#include <SDL3/SDL.h>
+
+#include "watchdog.h"
+#include "telemetry.h"
+
+static watchdog_policy_t watchdog_policy = WATCHDOG_OFF;
+
+// Previous sample; primed on the first observe so a fresh session gets a
+// full grace period before its first verdict
+static uint64_t last_cycles;
+static uint64_t last_draws;
+static uint64_t last_inputs;
+static bool primed;
+static int stalled_seconds;
+
+void watchdog_enable(watchdog_policy_t policy) {
+    watchdog_policy = policy;
+    primed = false;
+    stalled_seconds = 0;
+}
+
+watchdog_policy_t watchdog_observe(const chip8_state_t *state) {
+    if (watchdog_policy == WATCHDOG_OFF) {
+        return WATCHDOG_OFF;
+    }
+
+    uint64_t cycles = state->cycle_count;
+    uint64_t draws = state->opcode_count[0xD];
+    uint64_t inputs = state->opcode_count_e[0x9E] + state->opcode_count_e[0xA1]
+                    + state->opcode_count_f[0x0A];
+
+    // Alive: the screen changed, the ROM looked at the keypad, or it is
+    // parked on FX0A waiting for the player (cycles frozen by design).
+    // Retiring instructions alone is not life — a wedged spin does that.
+    bool alive = !primed
+              || draws != last_draws
+              || inputs != last_inputs
+              || (cycles == last_cycles && state->waiting_key);
+
+    last_cycles = cycles;
+    last_draws = draws;
+    last_inputs = inputs;
+    primed = true;
+
+    if (alive) {
+        stalled_seconds = 0;
+        return WATCHDOG_OFF;
+    }
+    if (++stalled_seconds < WATCHDOG_GRACE_SECONDS) {
+        return WATCHDOG_OFF;
+    }
+
+    SDL_Log("Watchdog: no draw or input read for %d seconds at pc %03X",
+            stalled_seconds, state->program_counter);
+    telemetry_watchdog_trips.value++;
+    stalled_seconds = 0; // Re-arm: a recovery that fails trips again
+    return watchdog_policy;
+}
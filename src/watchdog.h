@@ -0,0 +1,45 @@
+#ifndef WATCHDOG_H
+#define WATCHDOG_H
+
+#include <stdbool.h>
+
+#include "chip8.h"
+
+/**
+ * Hung-ROM Watchdog
+ *
+ * Hosted sessions sometimes wedge: a bad ROM spins forever without
+ * drawing, reading the keypad, or waiting for one. The watchdog detects
+ * that from liveness signals the core already maintains — instructions
+ * retired (cycle_count), draws (the DXYN counter), and input reads (the
+ * EX9E/EXA1/FX0A counters) — sampled once per second at the frontend's
+ * housekeeping boundary. Detection is a handful of counter compares on
+ * already-published values; it never pauses, locks, or signals the
+ * emulation, and the recovery policy is the frontend's to execute.
+ *
+ * A session counts as alive while any of draws, input reads, or a key
+ * wait moves between samples. Draw-free ALU grinding trips it too once
+ * the grace runs out — on a cabinet, seconds of black screen are a hang
+ * whether or not the ROM is technically computing.
+ */
+
+// Consecutive no-progress seconds before the policy fires
+#define WATCHDOG_GRACE_SECONDS 5
+
+typedef enum watchdog_policy {
+    WATCHDOG_OFF = 0,
+    WATCHDOG_ALERT,    // Log and emit an event, keep running
+    WATCHDOG_SNAPSHOT, // Alert plus a savestate for offline triage
+    WATCHDOG_RESET,    // Alert plus a reboot of the wedged title
+    WATCHDOG_ROTATE,   // Alert plus an immediate kiosk rotation
+} watchdog_policy_t;
+
+void watchdog_enable(watchdog_policy_t policy);
+
+// Feeds one 1Hz liveness sample. Returns WATCHDOG_OFF while the session
+// is alive or still within grace, the armed policy on the sample that
+// trips; the stall count re-arms so a failed recovery trips again a
+// grace period later.
+watchdog_policy_t watchdog_observe(const chip8_state_t *state);
+
+#endif // WATCHDOG_H